@@ -0,0 +1,83 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace minidl::bench {
+
+// Per-run timing state, used as
+//     while (state.keep_running()) { ...timed body... }
+class State {
+   public:
+    explicit State(std::size_t iterations) : max_iters_(iterations) {}
+
+    bool keep_running() {
+        if (!started_) {
+            started_ = true;
+            start_ = Clock::now();
+        }
+        if (iters_ < max_iters_) {
+            ++iters_;
+            return true;
+        }
+        elapsed_ = std::chrono::duration<double>(Clock::now() - start_).count();
+        return false;
+    }
+
+    // work done by one iteration, used for the throughput columns.
+    void set_items_processed(std::size_t n) noexcept { items_ = n; }
+    void set_bytes_processed(std::size_t n) noexcept { bytes_ = n; }
+    void set_label(std::string label) { label_ = std::move(label); }
+
+    std::size_t iterations() const noexcept { return iters_; }
+    double elapsed_seconds() const noexcept { return elapsed_; }
+    double seconds_per_iteration() const noexcept { return iters_ == 0 ? 0.0 : elapsed_ / iters_; }
+    std::size_t items_processed() const noexcept { return items_; }
+    std::size_t bytes_processed() const noexcept { return bytes_; }
+    const std::string& label() const noexcept { return label_; }
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t max_iters_;
+    std::size_t iters_ = 0;
+    bool started_ = false;
+    Clock::time_point start_;
+    double elapsed_ = 0.0;
+    std::size_t items_ = 0;
+    std::size_t bytes_ = 0;
+    std::string label_;
+};
+
+using BenchFn = std::function<void(State&)>;
+
+// registers a benchmark; within a file, benchmarks run in registration order.
+void register_benchmark(std::string name, BenchFn fn);
+
+struct Registrar {
+    Registrar(std::string name, BenchFn fn) { register_benchmark(std::move(name), std::move(fn)); }
+};
+
+// keeps the compiler from discarding a computed value.
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+}  // namespace minidl::bench
+
+#define MINIDL_BENCH_CONCAT_(a, b) a##b
+#define MINIDL_BENCH_CONCAT(a, b) MINIDL_BENCH_CONCAT_(a, b)
+
+// MINIDL_BENCH(name) { while (state.keep_running()) ...; }
+#define MINIDL_BENCH(name)                                                                                   \
+    static void name(::minidl::bench::State& state);                                                          \
+    static ::minidl::bench::Registrar MINIDL_BENCH_CONCAT(minidl_bench_registrar_, __LINE__)(#name, name); \
+    static void name(::minidl::bench::State& state)
@@ -0,0 +1,59 @@
+#include <minidl/allocators/system_allocator.h>
+#include <minidl/detail/binary_ops.h>
+#include <minidl/detail/kernels_simd.h>
+
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+namespace {
+
+using AddF32 = detail::AddOp<float>;
+
+// z/x/y element offsets from 64-byte aligned buffers.
+struct Layout {
+    const char* name;
+    std::size_t zo, xo, yo;
+};
+
+constexpr Layout kLayouts[] = {
+    {"aligned", 0, 0, 0},     // aligned fast path
+    {"all_off4B", 1, 1, 1},   // one peeled head, then aligned
+    {"x_off4B", 0, 1, 0},     // aligned stores, unaligned x loads
+    {"all_mixed", 3, 1, 2},   // aligned stores, unaligned loads
+};
+
+const bool registered = [] {
+    // L1-, L2- and DRAM-resident working sets (3 operands of 4 bytes).
+    for (std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 15, std::size_t{1} << 24}) {
+        for (const Layout& l : kLayouts) {
+            bench::register_benchmark("align/add_f32/" + std::string(l.name) + "/" + std::to_string(n),
+                                      [=](bench::State& state) {
+                                          SystemAllocator sys;
+                                          Allocator& alloc = sys;
+                                          const std::size_t bytes = (n + 16) * sizeof(float);
+                                          auto* z = static_cast<float*>(alloc.allocate(bytes));
+                                          auto* x = static_cast<float*>(alloc.allocate(bytes));
+                                          auto* y = static_cast<float*>(alloc.allocate(bytes));
+                                          for (std::size_t i = 0; i < n + 16; ++i) x[i] = y[i] = 1.0f;
+
+                                          const auto fn = kernels::select_binary_contig<float, AddF32>();
+                                          while (state.keep_running()) {
+                                              fn(z + l.zo, x + l.xo, y + l.yo, n);
+                                              bench::do_not_optimize(z[0]);
+                                          }
+                                          state.set_items_processed(n);
+                                          state.set_bytes_processed(3 * n * sizeof(float));
+
+                                          alloc.deallocate(z);
+                                          alloc.deallocate(x);
+                                          alloc.deallocate(y);
+                                      });
+        }
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,120 @@
+#include <minidl/allocators/arena_allocator.h>
+#include <minidl/allocators/caching_allocator.h>
+#include <minidl/allocators/system_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+using namespace minidl;
+
+namespace {
+
+constexpr std::size_t kChain = 16;
+
+// the allocation pattern of a kChain-op chain: every intermediate is allocated, used once, freed.
+void raw_chain(bench::State& state, Allocator& alloc, std::size_t nbytes) {
+    while (state.keep_running()) {
+        void* prev = alloc.allocate(nbytes);
+        for (std::size_t i = 1; i < kChain; ++i) {
+            void* next = alloc.allocate(nbytes);
+            static_cast<char*>(next)[0] = static_cast<char*>(prev)[0];
+            alloc.deallocate(prev);
+            prev = next;
+        }
+        alloc.deallocate(prev);
+    }
+    state.set_items_processed(kChain);
+}
+
+void op_chain(bench::State& state, const std::shared_ptr<Allocator>& alloc, std::size_t n) {
+    Tensor x = Tensor::ones({n}, DType::f32, alloc);
+    Tensor y = Tensor::ones({n}, DType::f32, alloc);
+    while (state.keep_running()) {
+        Tensor t = ops::add(x, y);
+        for (std::size_t i = 1; i < kChain; ++i) t = (i % 2) ? ops::mul(t, y) : ops::add(t, x);
+        bench::do_not_optimize(t.data());
+    }
+    state.set_items_processed(kChain * n);
+    state.set_bytes_processed(kChain * 3 * n * sizeof(float));
+}
+
+// same chain written in place: one output buffer for the whole chain.
+void op_chain_inplace(bench::State& state, const std::shared_ptr<Allocator>& alloc, std::size_t n) {
+    Tensor x = Tensor::ones({n}, DType::f32, alloc);
+    Tensor y = Tensor::ones({n}, DType::f32, alloc);
+    Tensor t = Tensor::zeros({n}, DType::f32, alloc);
+    while (state.keep_running()) {
+        ops::add_out(x, y, t);
+        for (std::size_t i = 1; i < kChain; ++i) (i % 2) ? ops::mul_(t, y) : ops::add_(t, x);
+        bench::do_not_optimize(t.data());
+    }
+    state.set_items_processed(kChain * n);
+    state.set_bytes_processed(kChain * 3 * n * sizeof(float));
+}
+
+// an inference step of kStep ops, every intermediate freed by the end of the step; with an
+// arena, each step runs in a Scope.
+constexpr std::size_t kStep = 50;
+
+void step_chain(bench::State& state, const std::shared_ptr<Allocator>& alloc, ArenaAllocator* arena,
+                std::size_t n) {
+    Tensor x = Tensor::ones({n}, DType::f32);
+    Tensor y = Tensor::ones({n}, DType::f32);
+    while (state.keep_running()) {
+        std::optional<ArenaAllocator::Scope> scope;
+        if (arena) scope.emplace(*arena);
+        Tensor t = Tensor::empty({n}, DType::f32, alloc);
+        ops::add_out(x, y, t);
+        for (std::size_t i = 1; i < kStep; ++i) t = (i % 2) ? ops::mul(t, y) : ops::add(t, x);
+        bench::do_not_optimize(t.data());
+    }
+    state.set_items_processed(kStep * n);
+    state.set_bytes_processed(kStep * 3 * n * sizeof(float));
+}
+
+const bool registered = [] {
+    for (std::size_t n : {std::size_t{256}, std::size_t{1} << 14, std::size_t{1} << 20}) {
+        const std::string suffix = "/" + std::to_string(n);
+        bench::register_benchmark("alloc/raw_chain/system" + suffix, [=](bench::State& state) {
+            SystemAllocator alloc;
+            raw_chain(state, alloc, n * sizeof(float));
+        });
+        bench::register_benchmark("alloc/raw_chain/caching" + suffix, [=](bench::State& state) {
+            CachingAllocator alloc;
+            raw_chain(state, alloc, n * sizeof(float));
+        });
+        bench::register_benchmark("alloc/op_chain/system" + suffix, [=](bench::State& state) {
+            op_chain(state, std::make_shared<SystemAllocator>(), n);
+        });
+        bench::register_benchmark("alloc/op_chain/caching" + suffix, [=](bench::State& state) {
+            auto alloc = std::make_shared<CachingAllocator>();
+            op_chain(state, alloc, n);
+            state.set_label("hit_rate=" + std::to_string(alloc->stats().hit_rate()));
+        });
+        bench::register_benchmark("alloc/op_chain/inplace" + suffix, [=](bench::State& state) {
+            op_chain_inplace(state, std::make_shared<SystemAllocator>(), n);
+        });
+        bench::register_benchmark("alloc/step/system" + suffix, [=](bench::State& state) {
+            step_chain(state, std::make_shared<SystemAllocator>(), nullptr, n);
+        });
+        bench::register_benchmark("alloc/step/caching" + suffix, [=](bench::State& state) {
+            step_chain(state, std::make_shared<CachingAllocator>(), nullptr, n);
+        });
+        bench::register_benchmark("alloc/step/arena" + suffix, [=](bench::State& state) {
+            auto arena = std::make_shared<ArenaAllocator>();
+            step_chain(state, arena, arena.get(), n);
+            const auto s = arena->stats();
+            state.set_label("upstream_allocs=" + std::to_string(s.num_upstream_allocs) +
+                            " high_water=" + std::to_string(s.high_water_mark));
+        });
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,60 @@
+#include <minidl/allocators/caching_allocator.h>
+#include <minidl/autograd.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <memory>
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// A training step of a two-layer MLP (kIn -> kHidden -> kOut, relu, mean of the outputs as
+// the loss): the forward pass alone under NoGradGuard, against forward + backward. The
+// backward frees every gradient buffer once its node has run, so with a CachingAllocator the
+// step reuses the same few buffers.
+// Names are autograd/mlp/{forward,train}/{system,caching}/<batch>.
+namespace {
+
+constexpr std::size_t kIn = 256, kHidden = 256, kOut = 16;
+
+void mlp_step(bench::State& state, const std::shared_ptr<Allocator>& alloc, std::size_t batch, bool train) {
+    const Tensor x = Tensor::ones({batch, kIn}, DType::f32, alloc);
+    Tensor w1 = Tensor::ones({kIn, kHidden}, DType::f32, alloc).set_requires_grad();
+    Tensor b1 = Tensor::zeros({kHidden}, DType::f32, alloc).set_requires_grad();
+    Tensor w2 = Tensor::ones({kHidden, kOut}, DType::f32, alloc).set_requires_grad();
+    while (state.keep_running()) {
+        std::unique_ptr<autograd::NoGradGuard> no_grad;
+        if (!train) no_grad = std::make_unique<autograd::NoGradGuard>();
+        const Tensor h = ops::relu(ops::add(ops::matmul(x, w1), b1));
+        const Tensor loss = ops::mean(ops::matmul(h, w2));
+        if (train) {
+            w1.zero_grad();
+            b1.zero_grad();
+            w2.zero_grad();
+            autograd::backward(loss);
+            bench::do_not_optimize(w1.grad()->data());
+        }
+        bench::do_not_optimize(loss.data());
+    }
+    state.set_items_processed(batch);
+}
+
+const bool registered = [] {
+    for (std::size_t batch : {std::size_t{8}, std::size_t{128}}) {
+        for (const bool train : {false, true}) {
+            const std::string prefix = std::string("autograd/mlp/") + (train ? "train" : "forward");
+            const std::string suffix = "/" + std::to_string(batch);
+            bench::register_benchmark(prefix + "/system" + suffix, [=](bench::State& state) {
+                mlp_step(state, nullptr, batch, train);
+            });
+            bench::register_benchmark(prefix + "/caching" + suffix, [=](bench::State& state) {
+                mlp_step(state, std::make_shared<CachingAllocator>(), batch, train);
+            });
+        }
+    }
+    return true;
+}();
+
+}  // namespace
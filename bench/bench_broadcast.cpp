@@ -0,0 +1,60 @@
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+namespace {
+
+// [B, N] + [N] and a transposed operand against the same-size contiguous add.
+std::map<std::size_t, double>& contig_time() {
+    static std::map<std::size_t, double> m;
+    return m;
+}
+
+void run_add(bench::State& state, const Tensor& a, const Tensor& b, std::size_t key, bool baseline = false) {
+    while (state.keep_running()) {
+        Tensor c = ops::add(a, b);
+        bench::do_not_optimize(c.data());
+    }
+    const std::size_t n = a.numel();
+    state.set_items_processed(n);
+    state.set_bytes_processed((2 * n + b.numel()) * sizeof(float));
+
+    if (baseline) {
+        contig_time()[key] = state.seconds_per_iteration();
+        return;
+    }
+    const auto it = contig_time().find(key);
+    if (it == contig_time().end()) return;
+    char label[64];
+    std::snprintf(label, sizeof(label), "%.2fx contiguous time", state.seconds_per_iteration() / it->second);
+    state.set_label(label);
+}
+
+const bool registered = [] {
+    for (auto [rows, cols] : {std::pair<std::size_t, std::size_t>{4096, 64}, {1024, 1024}, {64, 65536}}) {
+        const std::string shape = std::to_string(rows) + "x" + std::to_string(cols);
+        const std::size_t key = rows * 1000003 + cols;
+        bench::register_benchmark("iter/add_contig/" + shape, [=](bench::State& state) {
+            run_add(state, Tensor::ones({rows, cols}), Tensor::ones({rows, cols}), key, true);
+        });
+        bench::register_benchmark("iter/add_bcast_row/" + shape, [=](bench::State& state) {
+            run_add(state, Tensor::ones({rows, cols}), Tensor::ones({cols}), key);
+        });
+        bench::register_benchmark("iter/add_bcast_col/" + shape, [=](bench::State& state) {
+            run_add(state, Tensor::ones({rows, cols}), Tensor::ones({rows, 1}), key);
+        });
+        bench::register_benchmark("iter/add_transposed/" + shape, [=](bench::State& state) {
+            run_add(state, Tensor::ones({rows, cols}), Tensor::ones({cols, rows}).transpose({1, 0}), key);
+        });
+    }
+    return true;
+}();
+
+}  // namespace
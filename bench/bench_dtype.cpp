@@ -0,0 +1,71 @@
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// Tensor::to between f32 and the narrower dtypes, add on f16 / bf16 (computed in f32
+// blocks) against add on f32, and mixed-dtype add reading each operand in its own dtype
+// against converting the narrower operand with to() first.
+// Names are dtype/to/<src>_<dst>/<n>, dtype/add/<dtype>/<n> and
+// dtype/add_{mixed,cast}/<a>_<b>/<n>.
+namespace {
+
+const bool registered = [] {
+    constexpr std::size_t kN = std::size_t{1} << 22;
+    const std::pair<DType, DType> conversions[] = {
+        {DType::f32, DType::f16}, {DType::f16, DType::f32}, {DType::f32, DType::bf16},
+        {DType::bf16, DType::f32}, {DType::f32, DType::i8},  {DType::f32, DType::f64},
+    };
+    for (const auto& [src, dst] : conversions) {
+        const std::string name = std::string("dtype/to/") + to_string(src) + "_" + to_string(dst) + "/" +
+                                 std::to_string(kN);
+        bench::register_benchmark(name, [src = src, dst = dst](bench::State& state) {
+            const Tensor x = Tensor::arange(kN).to(src);
+            while (state.keep_running()) {
+                Tensor r = x.to(dst);
+                bench::do_not_optimize(r.data());
+            }
+            state.set_items_processed(kN);
+            state.set_bytes_processed(kN * (size_of(src) + size_of(dst)));
+        });
+    }
+
+    for (DType dt : {DType::f32, DType::f16, DType::bf16}) {
+        bench::register_benchmark(std::string("dtype/add/") + to_string(dt) + "/" + std::to_string(kN),
+                                  [dt](bench::State& state) {
+                                      const Tensor a = Tensor::arange(kN).to(dt);
+                                      const Tensor b = Tensor::ones({kN}, dt);
+                                      while (state.keep_running()) {
+                                          Tensor r = ops::add(a, b);
+                                          bench::do_not_optimize(r.data());
+                                      }
+                                      state.set_items_processed(kN);
+                                      state.set_bytes_processed(3 * kN * size_of(dt));
+                                  });
+    }
+
+    for (const auto& [da, db] : {std::pair{DType::i32, DType::f32}, std::pair{DType::bf16, DType::f32}}) {
+        const std::string pair = std::string(to_string(da)) + "_" + to_string(db) + "/" + std::to_string(kN);
+        const std::size_t bytes = kN * (size_of(da) + size_of(db) + size_of(promote_types(da, db)));
+        for (const bool cast : {false, true}) {
+            bench::register_benchmark(std::string("dtype/add_") + (cast ? "cast/" : "mixed/") + pair,
+                                      [da = da, db = db, cast, bytes](bench::State& state) {
+                                          const Tensor a = Tensor::arange(kN).to(da);
+                                          const Tensor b = Tensor::ones({kN}, db);
+                                          while (state.keep_running()) {
+                                              Tensor r = cast ? ops::add(a.to(db), b) : ops::add(a, b);
+                                              bench::do_not_optimize(r.data());
+                                          }
+                                          state.set_items_processed(kN);
+                                          state.set_bytes_processed(bytes);
+                                      });
+        }
+    }
+    return true;
+}();
+
+}  // namespace
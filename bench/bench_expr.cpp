@@ -0,0 +1,47 @@
+#include <minidl/expr.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+namespace {
+
+// d = ((a + b) * c + a) * b: four ops over three inputs.
+constexpr std::size_t kOps = 4;
+
+const bool registered = [] {
+    for (std::size_t n : {std::size_t{1} << 14, std::size_t{1} << 20, std::size_t{1} << 24}) {
+        const std::string suffix = "/" + std::to_string(n);
+        bench::register_benchmark("expr/eager" + suffix, [=](bench::State& state) {
+            Tensor a = Tensor::arange(n), b = Tensor::ones({n}), c = Tensor::ones({n});
+            Tensor out = Tensor::empty({n});
+            while (state.keep_running()) {
+                ops::add_out(a, b, out);
+                ops::mul_(out, c);
+                ops::add_(out, a);
+                ops::mul_(out, b);
+                bench::do_not_optimize(out.data());
+            }
+            state.set_items_processed(kOps * n);
+            state.set_bytes_processed(kOps * 3 * n * sizeof(float));
+        });
+        bench::register_benchmark("expr/fused" + suffix, [=](bench::State& state) {
+            Tensor a = Tensor::arange(n), b = Tensor::ones({n}), c = Tensor::ones({n});
+            Tensor out = Tensor::empty({n});
+            while (state.keep_running()) {
+                expr::eval_out(((expr::lazy(a) + b) * c + a) * b, out);
+                bench::do_not_optimize(out.data());
+            }
+            state.set_items_processed(kOps * n);
+            // three distinct inputs read once, one output written.
+            state.set_bytes_processed(4 * n * sizeof(float));
+        });
+    }
+    return true;
+}();
+
+}  // namespace
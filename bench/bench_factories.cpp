@@ -0,0 +1,106 @@
+#include <minidl/allocators/system_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+namespace {
+
+// 1GB of f32: every iteration pays for fresh pages, so this measures first touch as well as the fill.
+constexpr std::size_t kLarge = std::size_t{1} << 28;
+
+// the old factory: one thread memsets the whole buffer.
+void serial_zeros(bench::State& state, std::size_t n) {
+    SystemAllocator system;
+    Allocator& alloc = system;
+    while (state.keep_running()) {
+        void* p = alloc.allocate(n * sizeof(float));
+        std::memset(p, 0, n * sizeof(float));
+        bench::do_not_optimize(p);
+        alloc.deallocate(p);
+    }
+    state.set_items_processed(n);
+    state.set_bytes_processed(n * sizeof(float));
+}
+
+template <class Factory>
+void factory(bench::State& state, std::size_t n, Factory make) {
+    auto alloc = std::make_shared<SystemAllocator>();
+    std::size_t nbytes = 0;
+    while (state.keep_running()) {
+        Tensor t = make(n, alloc);
+        bench::do_not_optimize(t.data());
+        nbytes = t.nbytes();
+    }
+    state.set_items_processed(n);
+    state.set_bytes_processed(nbytes);
+    state.set_label("threads=" + std::to_string(get_num_threads()));
+}
+
+const bool registered = [] {
+    bench::register_benchmark("factory/zeros_serial_memset/1GB",
+                              [](bench::State& state) { serial_zeros(state, kLarge); });
+    bench::register_benchmark("factory/empty/1GB", [](bench::State& state) {
+        factory(state, kLarge, [](std::size_t n, const std::shared_ptr<Allocator>& a) {
+            return Tensor::empty({n}, DType::f32, a);
+        });
+    });
+    bench::register_benchmark("factory/zeros/1GB", [](bench::State& state) {
+        factory(state, kLarge, [](std::size_t n, const std::shared_ptr<Allocator>& a) {
+            return Tensor::zeros({n}, DType::f32, a);
+        });
+    });
+    bench::register_benchmark("factory/ones/1GB", [](bench::State& state) {
+        factory(state, kLarge, [](std::size_t n, const std::shared_ptr<Allocator>& a) {
+            return Tensor::ones({n}, DType::f32, a);
+        });
+    });
+    bench::register_benchmark("factory/arange/1GB", [](bench::State& state) {
+        factory(state, kLarge, [](std::size_t n, const std::shared_ptr<Allocator>& a) {
+            return Tensor::arange(n, DType::f32, a);
+        });
+    });
+    // cache-resident to memory-bound sizes, both dtypes.
+    for (DType dt : {DType::f32, DType::i32}) {
+        const std::string dname = dt == DType::f32 ? "f32" : "i32";
+        for (std::size_t n : {std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 24}) {
+            const std::string suffix = "/" + dname + "/" + std::to_string(n);
+            bench::register_benchmark("factory/zeros" + suffix, [=](bench::State& state) {
+                factory(state, n, [=](std::size_t m, const std::shared_ptr<Allocator>& a) {
+                    return Tensor::zeros({m}, dt, a);
+                });
+            });
+            bench::register_benchmark("factory/ones" + suffix, [=](bench::State& state) {
+                factory(state, n, [=](std::size_t m, const std::shared_ptr<Allocator>& a) {
+                    return Tensor::ones({m}, dt, a);
+                });
+            });
+            bench::register_benchmark("factory/arange" + suffix, [=](bench::State& state) {
+                factory(state, n, [=](std::size_t m, const std::shared_ptr<Allocator>& a) {
+                    return Tensor::arange(m, dt, a);
+                });
+            });
+        }
+    }
+    // output of an op: previously zeros() + kernel, now empty() + kernel.
+    bench::register_benchmark("factory/add_fresh_output/1GB", [](bench::State& state) {
+        auto alloc = std::make_shared<SystemAllocator>();
+        Tensor x = Tensor::ones({kLarge}, DType::f32, alloc);
+        while (state.keep_running()) {
+            Tensor z = ops::add(x, x);
+            bench::do_not_optimize(z.data());
+        }
+        state.set_items_processed(kLarge);
+        state.set_bytes_processed(2 * kLarge * sizeof(float));
+    });
+    return true;
+}();
+
+}  // namespace
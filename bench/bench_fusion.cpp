@@ -0,0 +1,75 @@
+#include <minidl/allocators/caching_allocator.h>
+#include <minidl/graph.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// A long elementwise tail (affine with broadcast rows, gelu, a gated tanh, a clamp), run eager
+// with a CachingAllocator, as a graph::Plan with one kernel per op, and as a Plan with the
+// chain fused into one kernel. The label gives the plan's steps and buffer.
+// Names are fusion/tail/{eager,plan,fused}/<rows>.
+namespace {
+
+constexpr std::size_t kWidth = 1024;
+
+Tensor filled(const Shape& shape, float v, std::shared_ptr<Allocator> alloc = nullptr) {
+    Tensor t = Tensor::empty(shape, DType::f32, std::move(alloc));
+    std::fill_n(static_cast<float*>(t.data()), t.numel(), v);
+    return t;
+}
+
+Tensor tail(const Tensor& x, const Tensor& scale, const Tensor& shift) {
+    Tensor h = ops::add(ops::mul(x, scale), shift);
+    h = ops::gelu(h);
+    h = ops::mul(ops::tanh(ops::mul(h, scale)), shift);
+    h = ops::sub(ops::exp(ops::minimum(h, scale)), shift);
+    return ops::maximum(ops::div(h, scale), shift);
+}
+
+struct Params {
+    Tensor scale = filled({kWidth}, 0.5f), shift = filled({kWidth}, 0.25f);
+};
+
+void eager(bench::State& state, std::size_t rows) {
+    const Params p;
+    auto alloc = std::make_shared<CachingAllocator>();
+    const Tensor x = filled({rows, kWidth}, 0.1f, alloc);
+    while (state.keep_running()) bench::do_not_optimize(tail(x, p.scale, p.shift).data());
+    state.set_items_processed(rows * kWidth);
+}
+
+void replay(bench::State& state, std::size_t rows, bool fuse) {
+    const Params p;
+    graph::Trace trace;
+    trace.output(tail(trace.input({rows, kWidth}), p.scale, p.shift));
+    graph::CompileOptions options;
+    options.fuse = fuse;
+    graph::Plan plan = trace.compile(nullptr, options);
+    const Tensor x = filled({rows, kWidth}, 0.1f);
+    while (state.keep_running()) bench::do_not_optimize(plan.run({x})[0].data());
+    state.set_items_processed(rows * kWidth);
+    state.set_label("steps=" + std::to_string(plan.num_steps()) + ", " + std::to_string(plan.arena_bytes() >> 10) +
+                    " KiB");
+}
+
+const bool registered = [] {
+    for (std::size_t rows : {std::size_t{16}, std::size_t{1024}}) {
+        const std::string suffix = "/" + std::to_string(rows);
+        bench::register_benchmark("fusion/tail/eager" + suffix, [=](bench::State& state) { eager(state, rows); });
+        bench::register_benchmark("fusion/tail/plan" + suffix,
+                                  [=](bench::State& state) { replay(state, rows, false); });
+        bench::register_benchmark("fusion/tail/fused" + suffix,
+                                  [=](bench::State& state) { replay(state, rows, true); });
+    }
+    return true;
+}();
+
+}  // namespace
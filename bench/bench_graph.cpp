@@ -0,0 +1,72 @@
+#include <minidl/allocators/caching_allocator.h>
+#include <minidl/graph.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <memory>
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// Fixed-shape inference of a block of kWidth-wide layers with a long elementwise tail:
+// eager ops allocating every intermediate (from the system allocator or a CachingAllocator),
+// against the same ops traced once and replayed by a graph::Plan. The label gives the plan's
+// buffer against the bytes eager allocates per run.
+// Names are graph/block/{eager_system,eager_caching,plan}/<batch>.
+namespace {
+
+constexpr std::size_t kWidth = 256, kLayers = 4;
+
+Tensor block(const Tensor& x, const Tensor& w, const Tensor& b, const Tensor& scale) {
+    Tensor h = x;
+    for (std::size_t l = 0; l < kLayers; ++l) {
+        h = ops::add(ops::matmul(h, w), b);
+        h = ops::mul(ops::sigmoid(h), h);  // silu
+        h = ops::add(ops::mul(h, scale), b);
+    }
+    return h;
+}
+
+struct Weights {
+    Tensor w, b, scale;
+    explicit Weights(const std::shared_ptr<Allocator>& alloc)
+        : w(Tensor::ones({kWidth, kWidth}, DType::f32, alloc)),
+          b(Tensor::zeros({kWidth}, DType::f32, alloc)),
+          scale(Tensor::ones({kWidth}, DType::f32, alloc)) {}
+};
+
+void eager(bench::State& state, const std::shared_ptr<Allocator>& alloc, std::size_t batch) {
+    const Weights p(alloc);
+    const Tensor x = Tensor::ones({batch, kWidth}, DType::f32, alloc);
+    while (state.keep_running()) bench::do_not_optimize(block(x, p.w, p.b, p.scale).data());
+    state.set_items_processed(batch);
+}
+
+void replay(bench::State& state, std::size_t batch) {
+    const Weights p(nullptr);
+    graph::Trace trace;
+    trace.output(block(trace.input({batch, kWidth}), p.w, p.b, p.scale));
+    graph::Plan plan = trace.compile();
+    const Tensor x = Tensor::ones({batch, kWidth});
+    while (state.keep_running()) bench::do_not_optimize(plan.run({x})[0].data());
+    state.set_items_processed(batch);
+    state.set_label(std::to_string(plan.arena_bytes() >> 10) + "/" + std::to_string(plan.eager_bytes() >> 10) +
+                    " KiB");
+}
+
+const bool registered = [] {
+    for (std::size_t batch : {std::size_t{1}, std::size_t{64}}) {
+        const std::string suffix = "/" + std::to_string(batch);
+        bench::register_benchmark("graph/block/eager_system" + suffix,
+                                  [=](bench::State& state) { eager(state, nullptr, batch); });
+        bench::register_benchmark("graph/block/eager_caching" + suffix, [=](bench::State& state) {
+            eager(state, std::make_shared<CachingAllocator>(), batch);
+        });
+        bench::register_benchmark("graph/block/plan" + suffix, [=](bench::State& state) { replay(state, batch); });
+    }
+    return true;
+}();
+
+}  // namespace
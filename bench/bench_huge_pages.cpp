@@ -0,0 +1,102 @@
+#include <minidl/allocators/huge_page_allocator.h>
+#include <minidl/allocators/system_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "bench.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace minidl;
+
+// Transposed reads of square f32 matrices on 4 KiB pages from the SystemAllocator against
+// 2 MiB pages from a HugePageAllocator: copies (out.copy_(x.transpose()), through the blocked
+// transpose kernel) and an elementwise add of x and its transpose (a strided walk down the
+// columns). The label gives the data TLB read misses per run from the perf counters, or says
+// they could not be opened (a non-Linux host, perf_event_paranoid, or a container without
+// them).
+// Names are huge_pages/{transpose,add_transposed}/{system,huge}/<n>.
+namespace {
+
+// user-space dTLB read misses of the calling thread while it is alive.
+class TlbMissCounter {
+   public:
+    TlbMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd_ >= 0) {
+            ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    ~TlbMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) ::close(fd_);
+#endif
+    }
+    TlbMissCounter(const TlbMissCounter&) = delete;
+    TlbMissCounter& operator=(const TlbMissCounter&) = delete;
+
+    bool available() const noexcept { return fd_ >= 0; }
+    std::uint64_t read() const {
+        std::uint64_t count = 0;
+#if defined(__linux__)
+        if (fd_ < 0 || ::read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) return 0;
+#endif
+        return count;
+    }
+
+   private:
+    int fd_ = -1;
+};
+
+void transposed(bench::State& state, std::shared_ptr<Allocator> alloc, std::size_t n, bool add) {
+    const Tensor x = Tensor::ones({n, n}, DType::f32, alloc);
+    const Tensor xt = x.transpose({1, 0});
+    Tensor out = Tensor::zeros({n, n}, DType::f32, alloc);  // pages faulted in before counting
+    const TlbMissCounter counter;
+    while (state.keep_running()) {
+        bench::do_not_optimize(add ? ops::add_out(x, xt, out).data() : out.copy_(xt).data());
+    }
+    const std::uint64_t misses = counter.read();
+    state.set_bytes_processed((add ? 3 : 2) * x.nbytes());
+    state.set_label(counter.available() && state.iterations() != 0
+                        ? std::to_string(misses / state.iterations()) + " dTLB misses/run"
+                        : "no perf counters");
+}
+
+const bool registered = [] {
+    for (bool add : {false, true}) {
+        for (std::size_t n : {std::size_t{1024}, std::size_t{4096}}) {
+            const std::string name = std::string("huge_pages/") + (add ? "add_transposed" : "transpose");
+            const std::string suffix = "/" + std::to_string(n);
+            bench::register_benchmark(name + "/system" + suffix, [=](bench::State& state) {
+                transposed(state, std::make_shared<SystemAllocator>(), n, add);
+            });
+            bench::register_benchmark(name + "/huge" + suffix, [=](bench::State& state) {
+                transposed(state, std::make_shared<HugePageAllocator>(), n, add);
+            });
+        }
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,99 @@
+#include <minidl/ops.h>
+#include <minidl/serialize.h>
+#include <minidl/tensor.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// Loading a file of weights: load() mapping it, against reading it into a buffer and copying
+// every payload into a freshly allocated tensor. load_sum then reads every element, which
+// moves the mapping's page faults into the timed region.
+// Names are io/{load,load_sum}/{mmap,read}/<MiB>.
+namespace {
+
+constexpr std::size_t kTensors = 16;
+
+std::string weight_file(std::size_t mib) {
+    const auto path = std::filesystem::temp_directory_path() / ("minidl_bench_" + std::to_string(mib) + "mib.bin");
+    NamedTensors tensors;
+    const std::size_t n = (mib << 20) / sizeof(float) / kTensors;
+    for (std::size_t i = 0; i < kTensors; ++i) tensors.emplace_back("w" + std::to_string(i), Tensor::arange(n));
+    save(path.string(), tensors);
+    return path.string();
+}
+
+struct Entry {
+    std::string name;
+    Shape shape;
+    DType dtype;
+    std::size_t offset;  // payload position in the file
+};
+
+// what read_copy needs to know of the file, taken from one load() outside the timed loop.
+std::vector<Entry> layout_of(const std::string& path) {
+    std::vector<Entry> entries;
+    for (const auto& [name, t] : load(path)) {
+        const auto* file = static_cast<const MappedFileAllocator*>(t.storage()->owner.get());
+        entries.push_back({name, t.shape(), t.dtype(),
+                           static_cast<std::size_t>(static_cast<const std::byte*>(t.data()) - file->data())});
+    }
+    return entries;
+}
+
+// the way weights were loaded before load(): the whole file into a buffer, then copies.
+NamedTensors read_copy(const std::string& path, const std::vector<Entry>& entries) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<char> file(std::filesystem::file_size(path));
+    in.read(file.data(), static_cast<std::streamsize>(file.size()));
+    NamedTensors out;
+    for (const Entry& e : entries) {
+        Tensor t = Tensor::empty(e.shape, e.dtype);
+        std::memcpy(t.data(), file.data() + e.offset, t.nbytes());
+        out.emplace_back(e.name, std::move(t));
+    }
+    return out;
+}
+
+const bool registered = [] {
+    for (std::size_t mib : {std::size_t{16}, std::size_t{256}}) {
+        for (const bool touch : {false, true}) {
+            const std::string suffix = std::string(touch ? "load_sum" : "load");
+            const std::string size = "/" + std::to_string(mib);
+            bench::register_benchmark("io/" + suffix + "/mmap" + size, [=](bench::State& state) {
+                const std::string path = weight_file(mib);
+                while (state.keep_running()) {
+                    NamedTensors w = load(path);
+                    if (touch) {
+                        for (const auto& [name, t] : w) bench::do_not_optimize(ops::sum(t).data());
+                    }
+                    bench::do_not_optimize(w.data());
+                }
+                state.set_bytes_processed(mib << 20);
+                std::filesystem::remove(path);
+            });
+            bench::register_benchmark("io/" + suffix + "/read" + size, [=](bench::State& state) {
+                const std::string path = weight_file(mib);
+                const std::vector<Entry> entries = layout_of(path);
+                while (state.keep_running()) {
+                    NamedTensors w = read_copy(path, entries);
+                    if (touch) {
+                        for (const auto& [name, t] : w) bench::do_not_optimize(ops::sum(t).data());
+                    }
+                    bench::do_not_optimize(w.data());
+                }
+                state.set_bytes_processed(mib << 20);
+                std::filesystem::remove(path);
+            });
+        }
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,169 @@
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// The kernel matrix: every binary path (contiguous, same-shape strided, broadcast) and
+// contiguous() copies across dtypes, sizes and ranks. Ops write into a preallocated output
+// so only the kernel is timed. Names are kernel/<op>/<dtype>/<layout>/r<rank>/<numel>.
+namespace {
+
+const std::size_t kSizes[] = {std::size_t{1} << 12, std::size_t{1} << 16, std::size_t{1} << 20, std::size_t{1} << 24};
+
+const char* dtype_name(DType dt) { return dt == DType::f32 ? "f32" : "i32"; }
+
+// numel = 2^log2n split as evenly as possible over `rank` dims, larger dims innermost.
+std::vector<std::size_t> dims_for(std::size_t log2n, std::size_t rank) {
+    std::vector<std::size_t> dims(rank);
+    for (std::size_t d = 0; d < rank; ++d) {
+        const std::size_t bits = log2n / rank + (d >= rank - log2n % rank ? 1 : 0);
+        dims[d] = std::size_t{1} << bits;
+    }
+    return dims;
+}
+
+std::size_t log2_of(std::size_t n) {
+    std::size_t k = 0;
+    while ((std::size_t{1} << k) < n) ++k;
+    return k;
+}
+
+// a view of `dims` whose memory order is reversed, i.e. fully transposed.
+Tensor reversed_layout(const std::vector<std::size_t>& dims, DType dt) {
+    const std::vector<std::size_t> rev(dims.rbegin(), dims.rend());
+    std::size_t n = 1;
+    for (auto d : dims) n *= d;
+    const Tensor base = Tensor::ones({n}, dt).view(Shape(rev));
+    switch (dims.size()) {
+        case 2:
+            return base.transpose({1, 0});
+        case 3:
+            return base.transpose({2, 1, 0});
+        default:
+            return base.transpose({3, 2, 1, 0});
+    }
+}
+
+enum class Layout { contig, transposed, broadcast };
+
+const char* layout_name(Layout l) {
+    switch (l) {
+        case Layout::contig:
+            return "contig";
+        case Layout::transposed:
+            return "transposed";
+        default:
+            return "broadcast";
+    }
+}
+
+using OutOp = Tensor& (*)(const Tensor&, const Tensor&, Tensor&);
+
+void run_binary(bench::State& state, OutOp op, DType dt, Layout layout, const std::vector<std::size_t>& dims) {
+    Tensor a = Tensor::ones(Shape(dims), dt);
+    Tensor b = a;
+    if (layout == Layout::transposed) {
+        a = reversed_layout(dims, dt);
+        b = reversed_layout(dims, dt);
+    } else if (layout == Layout::broadcast) {
+        b = Tensor::ones({dims.back()}, dt);  // one row against every row of a
+    }
+    Tensor out = Tensor::empty(Shape(dims), dt);
+
+    while (state.keep_running()) {
+        op(a, b, out);
+        bench::do_not_optimize(out.data());
+    }
+    const std::size_t n = out.numel();
+    state.set_items_processed(n);
+    state.set_bytes_processed((2 * n + b.numel()) * size_of(dt));
+}
+
+void run_contiguous(bench::State& state, DType dt, const std::vector<std::size_t>& dims) {
+    const Tensor a = reversed_layout(dims, dt);
+    while (state.keep_running()) {
+        Tensor c = a.contiguous();
+        bench::do_not_optimize(c.data());
+    }
+    state.set_items_processed(a.numel());
+    state.set_bytes_processed(2 * a.nbytes());
+}
+
+const bool registered = [] {
+    const std::pair<const char*, OutOp> op_list[] = {{"add", ops::add_out}, {"mul", ops::mul_out}};
+
+    // every path at every size, rank 2.
+    for (const auto& [op_name, op] : op_list) {
+        for (DType dt : {DType::f32, DType::i32}) {
+            for (Layout layout : {Layout::contig, Layout::transposed, Layout::broadcast}) {
+                for (std::size_t n : kSizes) {
+                    const auto dims = dims_for(log2_of(n), 2);
+                    const std::string name = std::string("kernel/") + op_name + "/" + dtype_name(dt) + "/" +
+                                             layout_name(layout) + "/r2/" + std::to_string(n);
+                    bench::register_benchmark(name, [=](bench::State& state) {
+                        run_binary(state, op, dt, layout, dims);
+                    });
+                }
+            }
+        }
+    }
+
+    // rank sweep at 1M elements: coalescing makes contiguous/broadcast rank-independent,
+    // transposed layouts are not.
+    constexpr std::size_t kRankSize = std::size_t{1} << 20;
+    for (DType dt : {DType::f32, DType::i32}) {
+        for (Layout layout : {Layout::transposed, Layout::broadcast}) {
+            for (std::size_t rank : {3, 4}) {
+                const auto dims = dims_for(log2_of(kRankSize), rank);
+                const std::string name = std::string("kernel/add/") + dtype_name(dt) + "/" + layout_name(layout) +
+                                         "/r" + std::to_string(rank) + "/" + std::to_string(kRankSize);
+                bench::register_benchmark(name, [=](bench::State& state) {
+                    run_binary(state, ops::add_out, dt, layout, dims);
+                });
+            }
+        }
+    }
+
+    for (DType dt : {DType::f32, DType::i32}) {
+        for (std::size_t rank : {2, 3, 4}) {
+            for (std::size_t n : kSizes) {
+                const auto dims = dims_for(log2_of(n), rank);
+                const std::string name = std::string("kernel/contiguous/") + dtype_name(dt) + "/transposed/r" +
+                                         std::to_string(rank) + "/" + std::to_string(n);
+                bench::register_benchmark(name, [=](bench::State& state) { run_contiguous(state, dt, dims); });
+            }
+        }
+    }
+
+    // the large square transpose against a plain copy of the same bytes.
+    constexpr std::size_t kSide = 8192;
+    bench::register_benchmark("kernel/contiguous/f32/memcpy/8192x8192", [](bench::State& state) {
+        const Tensor a = Tensor::ones({kSide, kSide});
+        Tensor b = Tensor::zeros({kSide, kSide});  // pages faulted in before timing
+        while (state.keep_running()) {
+            std::memcpy(b.data(), a.data(), a.nbytes());
+            bench::do_not_optimize(b.data());
+        }
+        state.set_items_processed(a.numel());
+        state.set_bytes_processed(2 * a.nbytes());
+    });
+    bench::register_benchmark("kernel/contiguous/f32/transposed/8192x8192", [](bench::State& state) {
+        const Tensor a = Tensor::ones({kSide, kSide}).transpose({1, 0});
+        Tensor b = Tensor::zeros({kSide, kSide});  // pages faulted in before timing
+        while (state.keep_running()) {
+            b.copy_(a);
+            bench::do_not_optimize(b.data());
+        }
+        state.set_items_processed(a.numel());
+        state.set_bytes_processed(2 * a.nbytes());
+    });
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,161 @@
+#include <minidl/detail/cpu_features.h>
+#include <minidl/parallel.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+namespace minidl::bench {
+
+namespace {
+struct Entry {
+    std::string name;
+    BenchFn fn;
+};
+
+std::vector<Entry>& registry() {
+    static std::vector<Entry> r;
+    return r;
+}
+
+State run_one(const BenchFn& fn, double min_time) {
+    std::size_t iters = 1;
+    while (true) {
+        State state(iters);
+        fn(state);
+        const double t = state.elapsed_seconds();
+        if (t >= min_time || iters >= (std::size_t{1} << 30)) return state;
+
+        // aim a bit past min_time, growing at least 2x and at most 100x per round.
+        double grow = t > 0.0 ? 1.4 * min_time / t : 100.0;
+        if (grow < 2.0) grow = 2.0;
+        if (grow > 100.0) grow = 100.0;
+        iters = static_cast<std::size_t>(static_cast<double>(iters) * grow);
+    }
+}
+
+struct Result {
+    std::string name;
+    std::size_t iterations;
+    double seconds_per_iteration;
+    double items_per_second;
+    double bytes_per_second;
+    std::string label;
+};
+
+void write_json_string(std::FILE* f, const std::string& s) {
+    std::fputc('"', f);
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', f);
+            std::fputc(c, f);
+        } else if (c < 0x20) {
+            std::fprintf(f, "\\u%04x", c);
+        } else {
+            std::fputc(c, f);
+        }
+    }
+    std::fputc('"', f);
+}
+
+// Same layout as Google Benchmark's --benchmark_out, so its compare.py can diff two runs.
+bool write_json(const char* path, const char* executable, const std::vector<Result>& results) {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fprintf(f, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": ", date);
+    write_json_string(f, executable);
+    std::fprintf(f, ",\n    \"num_threads\": %zu,\n    \"cpu_capability\": \"%s\",\n", minidl::get_num_threads(),
+                 minidl::detail::to_string(minidl::detail::cpu_capability()));
+#ifdef NDEBUG
+    std::fprintf(f, "    \"library_build_type\": \"release\"\n  },\n");
+#else
+    std::fprintf(f, "    \"library_build_type\": \"debug\"\n  },\n");
+#endif
+
+    std::fprintf(f, "  \"benchmarks\": [");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(f, "%s\n    {\n      \"name\": ", i == 0 ? "" : ",");
+        write_json_string(f, r.name);
+        std::fprintf(f, ",\n      \"run_name\": ");
+        write_json_string(f, r.name);
+        std::fprintf(f,
+                     ",\n      \"run_type\": \"iteration\",\n      \"iterations\": %zu,\n"
+                     "      \"real_time\": %.6g,\n      \"cpu_time\": %.6g,\n      \"time_unit\": \"ns\",\n"
+                     "      \"items_per_second\": %.6g,\n      \"bytes_per_second\": %.6g,\n      \"label\": ",
+                     r.iterations, r.seconds_per_iteration * 1e9, r.seconds_per_iteration * 1e9, r.items_per_second,
+                     r.bytes_per_second);
+        write_json_string(f, r.label);
+        std::fprintf(f, "\n    }");
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+}  // namespace
+
+void register_benchmark(std::string name, BenchFn fn) { registry().push_back({std::move(name), std::move(fn)}); }
+
+}  // namespace minidl::bench
+
+int main(int argc, char** argv) {
+    using namespace minidl::bench;
+
+    std::string filter;
+    std::string json_path;
+    double min_time = 0.5;
+    bool list_only = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            min_time = std::atof(argv[i] + 11);
+        } else if (std::strncmp(argv[i], "--json=", 7) == 0) {
+            json_path = argv[i] + 7;
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list_only = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=substring] [--min-time=seconds] [--json=path] [--list]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    if (list_only) {
+        for (const auto& e : registry()) {
+            if (filter.empty() || e.name.find(filter) != std::string::npos) std::printf("%s\n", e.name.c_str());
+        }
+        return 0;
+    }
+
+    std::vector<Result> results;
+
+    std::printf("%-48s %14s %12s %14s %12s  %s\n", "benchmark", "time/iter", "iters", "items/s", "GB/s", "label");
+    for (const auto& e : registry()) {
+        if (!filter.empty() && e.name.find(filter) == std::string::npos) continue;
+
+        const State s = run_one(e.fn, min_time);
+        const double t = s.seconds_per_iteration();
+        const double items = t > 0.0 ? static_cast<double>(s.items_processed()) / t : 0.0;
+        const double gbps = t > 0.0 ? static_cast<double>(s.bytes_processed()) / t * 1e-9 : 0.0;
+        std::printf("%-48s %11.3f us %12zu %14.4g %12.3f  %s\n", e.name.c_str(), t * 1e6, s.iterations(), items, gbps,
+                    s.label().c_str());
+        std::fflush(stdout);
+        results.push_back({e.name, s.iterations(), t, items, gbps * 1e9, s.label()});
+    }
+
+    if (!json_path.empty() && !write_json(json_path.c_str(), argv[0], results)) {
+        std::fprintf(stderr, "could not write %s\n", json_path.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <minidl/detail/gemm.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// GEMM throughput. items/s is FLOP/s (2*M*N*K per product). The label compares it with the
+// peak of the selected micro-kernel: that kernel timed on L1-resident packed panels, times
+// the thread count, i.e. the best the packed driver could do with no memory traffic.
+// Names are matmul/<dtype>/<layout>/<size>; the layout letters say whether A and B are
+// plain (n) or transposed views (t).
+namespace {
+
+// micro-kernel GFLOP/s on one core, measured once.
+template <typename T>
+double micro_peak_gflops() {
+    static const double peak = [] {
+        const auto uk = kernels::select_gemm_micro<T>();
+        const std::size_t kc = 128;
+        std::vector<T> a(uk.mr * kc, T(1)), b(uk.nr * kc, T(1)), c(uk.mr * uk.nr);
+        const double flops = 2.0 * uk.mr * uk.nr * kc;
+
+        using Clock = std::chrono::steady_clock;
+        std::size_t calls = 0;
+        const auto start = Clock::now();
+        double elapsed = 0;
+        while (elapsed < 0.2) {
+            for (int i = 0; i < 1000; ++i) uk.fn(kc, a.data(), b.data(), c.data(), uk.nr, false);
+            bench::do_not_optimize(c.data());
+            calls += 1000;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        return flops * static_cast<double>(calls) / elapsed * 1e-9;
+    }();
+    return peak;
+}
+
+template <typename T>
+void set_peak_label(bench::State& state, double flops) {
+    const double gflops = flops * static_cast<double>(state.iterations()) / state.elapsed_seconds() * 1e-9;
+    const double peak = micro_peak_gflops<T>() * static_cast<double>(get_num_threads());
+    char buf[96];
+    std::snprintf(buf, sizeof buf, "%.1f GFLOP/s, %.0f%% of %.1f peak", gflops, 100.0 * gflops / peak, peak);
+    state.set_label(buf);
+}
+
+template <typename T>
+void run_matmul(bench::State& state, DType dt, std::size_t n, bool ta, bool tb) {
+    const Tensor a = ta ? Tensor::ones({n, n}, dt).transpose({1, 0}) : Tensor::ones({n, n}, dt);
+    const Tensor b = tb ? Tensor::ones({n, n}, dt).transpose({1, 0}) : Tensor::ones({n, n}, dt);
+    Tensor c = Tensor::zeros({n, n}, dt);
+    while (state.keep_running()) {
+        ops::matmul_out(a, b, c);
+        bench::do_not_optimize(c.data());
+    }
+    const double flops = 2.0 * static_cast<double>(n) * n * n;
+    state.set_items_processed(static_cast<std::size_t>(flops));
+    state.set_bytes_processed(3 * n * n * size_of(dt));
+    set_peak_label<T>(state, flops);
+}
+
+const bool registered = [] {
+    // the micro-kernel alone on L1-resident panels: the per-core ceiling for everything below.
+    bench::register_benchmark("matmul/peak/f32/micro-kernel", [](bench::State& state) {
+        const auto uk = kernels::select_gemm_micro<float>();
+        const std::size_t kc = 128;
+        std::vector<float> a(uk.mr * kc, 1.0f), b(uk.nr * kc, 1.0f), c(uk.mr * uk.nr);
+        while (state.keep_running()) {
+            uk.fn(kc, a.data(), b.data(), c.data(), uk.nr, false);
+            bench::do_not_optimize(c.data());
+        }
+        state.set_items_processed(2 * uk.mr * uk.nr * kc);
+        state.set_label(std::to_string(uk.mr) + "x" + std::to_string(uk.nr) + " tile");
+    });
+
+    for (std::size_t n : {64, 256, 512, 1024, 2048}) {
+        const std::pair<const char*, std::pair<bool, bool>> layouts[] = {
+            {"nn", {false, false}}, {"tn", {true, false}}, {"nt", {false, true}}};
+        for (const auto& [layout, t] : layouts) {
+            const auto [ta, tb] = t;
+            bench::register_benchmark(std::string("matmul/f32/") + layout + "/" + std::to_string(n),
+                                      [=](bench::State& state) { run_matmul<float>(state, DType::f32, n, ta, tb); });
+        }
+    }
+    for (std::size_t n : {256, 1024}) {
+        bench::register_benchmark("matmul/i32/nn/" + std::to_string(n), [=](bench::State& state) {
+            run_matmul<std::int32_t>(state, DType::i32, n, false, false);
+        });
+    }
+
+    // many small products: a batch of 128x128 against one shared (broadcast) weight.
+    bench::register_benchmark("matmul/f32/batched/64x128x128", [](bench::State& state) {
+        const Tensor a = Tensor::ones({64, 128, 128});
+        const Tensor w = Tensor::ones({128, 128});
+        Tensor c = Tensor::zeros({64, 128, 128});
+        while (state.keep_running()) {
+            ops::matmul_out(a, w, c);
+            bench::do_not_optimize(c.data());
+        }
+        const double flops = 2.0 * 64 * 128 * 128 * 128;
+        state.set_items_processed(static_cast<std::size_t>(flops));
+        state.set_bytes_processed((2 * 64 + 1) * 128 * 128 * sizeof(float));
+        set_peak_label<float>(state, flops);
+    });
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,79 @@
+#include <minidl/allocators/numa_allocator.h>
+#include <minidl/numa.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// Memory bandwidth by placement. stream: one thread on the CPUs of node c summing a buffer
+// bound to node m, for every pair (labelled local or remote). add: a pinned pool adding two
+// tensors written serially by the calling thread, placed by first touch (system), interleaved,
+// or partitioned to match the pool.
+// Names are numa/stream/cpu<c>/mem<m> and numa/add/{system,interleave,partitioned}.
+namespace {
+
+constexpr std::size_t kStreamBytes = std::size_t{64} << 20;
+constexpr std::size_t kAddElems = std::size_t{16} << 20;
+
+void stream(bench::State& state, std::size_t cpu_node, std::size_t mem_node) {
+    const ScopedNodeAffinity pin(cpu_node);
+    NumaAllocator alloc(NumaPolicy::bind, mem_node);
+    const std::size_t n = kStreamBytes / sizeof(float);
+    auto* p = static_cast<float*>(alloc.allocate(kStreamBytes));
+    std::fill_n(p, n, 1.0f);
+    while (state.keep_running()) {
+        float acc[8] = {};
+        for (std::size_t i = 0; i < n; i += 8) {
+            for (std::size_t k = 0; k < 8; ++k) acc[k] += p[i + k];
+        }
+        bench::do_not_optimize(acc);
+    }
+    alloc.deallocate(p);
+    state.set_bytes_processed(kStreamBytes);
+    state.set_label(cpu_node == mem_node ? "local" : "remote");
+}
+
+Tensor serial_ones(std::size_t n, std::shared_ptr<Allocator> alloc) {
+    Tensor t = Tensor::empty({n}, DType::f32, std::move(alloc));
+    std::fill_n(static_cast<float*>(t.data()), n, 1.0f);  // every page first touched here
+    return t;
+}
+
+void add(bench::State& state, std::shared_ptr<Allocator> alloc) {
+    const bool was_pinned = get_thread_pinning();
+    set_thread_pinning(true);
+    {
+        const Tensor a = serial_ones(kAddElems, alloc), b = serial_ones(kAddElems, alloc);
+        Tensor out = serial_ones(kAddElems, alloc);
+        while (state.keep_running()) bench::do_not_optimize(ops::add_out(a, b, out).data());
+    }
+    set_thread_pinning(was_pinned);
+    state.set_bytes_processed(3 * kAddElems * sizeof(float));
+    state.set_label(std::to_string(numa_num_nodes()) + " nodes, " + std::to_string(get_num_threads()) + " threads");
+}
+
+const bool registered = [] {
+    for (std::size_t c : numa_cpu_nodes()) {
+        for (std::size_t m = 0; m < numa_num_nodes(); ++m) {
+            bench::register_benchmark("numa/stream/cpu" + std::to_string(c) + "/mem" + std::to_string(m),
+                                      [=](bench::State& state) { stream(state, c, m); });
+        }
+    }
+    bench::register_benchmark("numa/add/system", [](bench::State& state) { add(state, nullptr); });
+    bench::register_benchmark("numa/add/interleave", [](bench::State& state) {
+        add(state, std::make_shared<NumaAllocator>(NumaPolicy::interleave));
+    });
+    bench::register_benchmark("numa/add/partitioned", [](bench::State& state) {
+        add(state, std::make_shared<NumaAllocator>(NumaPolicy::partitioned));
+    });
+    return true;
+}();
+
+}  // namespace
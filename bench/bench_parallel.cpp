@@ -0,0 +1,83 @@
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+using namespace minidl;
+
+namespace {
+
+std::vector<std::size_t> thread_counts() {
+    const std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts;
+    for (std::size_t t = 1; t < hw; t *= 2) counts.push_back(t);
+    counts.push_back(hw);
+    return counts;
+}
+
+// seconds per iteration of the single-threaded run, keyed by benchmark family.
+std::map<std::string, double>& serial_time() {
+    static std::map<std::string, double> m;
+    return m;
+}
+
+void run_scaling(bench::State& state, const std::string& family, std::size_t threads, const Tensor& a,
+                 const Tensor& b) {
+    const std::size_t prev = get_num_threads();
+    set_num_threads(threads);
+    while (state.keep_running()) {
+        Tensor c = ops::add(a, b);
+        bench::do_not_optimize(c.data());
+    }
+    set_num_threads(prev);
+
+    const std::size_t n = a.numel() > b.numel() ? a.numel() : b.numel();
+    state.set_items_processed(n);
+    state.set_bytes_processed(3 * n * sizeof(float));
+
+    const double t = state.seconds_per_iteration();
+    if (threads == 1) serial_time()[family] = t;
+    const double base = serial_time().count(family) ? serial_time()[family] : t;
+    char label[64];
+    std::snprintf(label, sizeof(label), "threads=%zu speedup=%.2fx", threads, base / t);
+    state.set_label(label);
+}
+
+const bool registered = [] {
+    for (std::size_t n : {std::size_t{1} << 16, std::size_t{1} << 22, std::size_t{1} << 26}) {
+        for (std::size_t t : thread_counts()) {
+            const std::string contig = "parallel/add_contig/" + std::to_string(n);
+            bench::register_benchmark(contig + "/threads:" + std::to_string(t), [=](bench::State& state) {
+                Tensor a = Tensor::ones({n});
+                Tensor b = Tensor::ones({n});
+                run_scaling(state, contig, t, a, b);
+            });
+
+            const std::size_t cols = 1024;
+            const std::string bcast = "parallel/add_broadcast/" + std::to_string(n);
+            bench::register_benchmark(bcast + "/threads:" + std::to_string(t), [=](bench::State& state) {
+                Tensor a = Tensor::ones({n / cols, cols});
+                Tensor b = Tensor::ones({cols});
+                run_scaling(state, bcast, t, a, b);
+            });
+
+            const std::string strided = "parallel/add_transposed/" + std::to_string(n);
+            bench::register_benchmark(strided + "/threads:" + std::to_string(t), [=](bench::State& state) {
+                Tensor a = Tensor::ones({cols, n / cols}).transpose({1, 0});
+                Tensor b = Tensor::ones({n / cols, cols});
+                run_scaling(state, strided, t, a, b);
+            });
+        }
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,78 @@
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// Reductions over the three kernel shapes: the whole tensor, the innermost (unit stride)
+// axis, and the outer axis, where each output walks a column. Plus a sliced input so the
+// strided paths are covered. Names are reduce/<op>/<dtype>/<case>/<rows>x<cols>.
+namespace {
+
+using ReduceFn = Tensor (*)(const Tensor&, const std::vector<std::size_t>&, bool);
+
+struct Case {
+    const char* name;
+    std::vector<std::size_t> axes;
+};
+
+const bool registered = [] {
+    const std::pair<const char*, ReduceFn> op_list[] = {{"sum", ops::sum}, {"max", ops::max}};
+    const std::pair<std::size_t, std::size_t> shapes[] = {
+        {1, std::size_t{1} << 24}, {4096, 4096}, {std::size_t{1} << 20, 16}, {16, std::size_t{1} << 20}};
+    const Case cases[] = {{"all", {}}, {"inner", {1}}, {"outer", {0}}};
+
+    for (const auto& [op_name, op] : op_list) {
+        for (DType dt : {DType::f32, DType::i32}) {
+            for (const auto& [rows, cols] : shapes) {
+                for (const Case& c : cases) {
+                    const std::string name = std::string("reduce/") + op_name + "/" +
+                                             (dt == DType::f32 ? "f32" : "i32") + "/" + c.name + "/" +
+                                             std::to_string(rows) + "x" + std::to_string(cols);
+                    const auto axes = c.axes;
+                    bench::register_benchmark(name, [=](bench::State& state) {
+                        const Tensor x = Tensor::ones({rows, cols}, dt);
+                        while (state.keep_running()) {
+                            Tensor r = op(x, axes, false);
+                            bench::do_not_optimize(r.data());
+                        }
+                        state.set_items_processed(x.numel());
+                        state.set_bytes_processed(x.nbytes());
+                    });
+                }
+            }
+        }
+    }
+
+    // every other column of a 4096x8192 tensor: strided runs on the inner axis.
+    for (const Case& c : cases) {
+        const auto axes = c.axes;
+        const std::string name = std::string("reduce/sum/f32/") + c.name + "/strided/4096x4096";
+        bench::register_benchmark(name, [=](bench::State& state) {
+            const Tensor x = Tensor::ones({4096, 8192}).slice(1, 0, 8192, 2);
+            while (state.keep_running()) {
+                Tensor r = ops::sum(x, axes, false);
+                bench::do_not_optimize(r.data());
+            }
+            state.set_items_processed(x.numel());
+            state.set_bytes_processed(2 * x.numel() * sizeof(float));  // whole cache lines are read
+        });
+    }
+
+    bench::register_benchmark("reduce/argmax/f32/inner/4096x4096", [](bench::State& state) {
+        const Tensor x = Tensor::ones({4096, 4096});
+        while (state.keep_running()) {
+            Tensor r = ops::argmax(x, 1);
+            bench::do_not_optimize(r.data());
+        }
+        state.set_items_processed(x.numel());
+        state.set_bytes_processed(x.nbytes());
+    });
+    return true;
+}();
+
+}  // namespace
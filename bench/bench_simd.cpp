@@ -0,0 +1,84 @@
+#include <minidl/detail/binary_ops.h>
+#include <minidl/detail/cpu_features.h>
+#include <minidl/detail/kernels_simd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+using namespace minidl;
+
+namespace {
+
+// single-thread memcpy GB/s per size, the practical bandwidth ceiling for a streaming kernel.
+std::map<std::size_t, double>& memcpy_gbps() {
+    static std::map<std::size_t, double> m;
+    return m;
+}
+
+void label_against_memcpy(bench::State& state, std::size_t n) {
+    const double gbps = static_cast<double>(state.bytes_processed()) / state.seconds_per_iteration() * 1e-9;
+    const auto it = memcpy_gbps().find(n);
+    if (it == memcpy_gbps().end()) return;
+    char label[64];
+    std::snprintf(label, sizeof(label), "%.0f%% of memcpy", 100.0 * gbps / it->second);
+    state.set_label(label);
+}
+
+template <typename T, class Op>
+void register_kernel(const std::string& name, std::size_t n, kernels::BinaryContigFn<T, Op> fn) {
+    bench::register_benchmark(name + "/" + std::to_string(n), [=](bench::State& state) {
+        std::vector<T> x(n, T(1)), y(n, T(2)), z(n);
+        while (state.keep_running()) {
+            fn(z.data(), x.data(), y.data(), n);
+            bench::do_not_optimize(z.data());
+        }
+        state.set_items_processed(n);
+        state.set_bytes_processed(3 * n * sizeof(T));
+        label_against_memcpy(state, n);
+    });
+}
+
+template <typename T, class Op>
+void register_all(const std::string& op, std::size_t n) {
+    const std::string prefix = "simd/" + op + "/";
+    register_kernel<T, Op>(prefix + "scalar", n, &kernels::binary_contig<T, Op>);
+    const auto cap = detail::cpu_capability();
+    (void)cap;
+#if defined(MINIDL_HAVE_AVX2)
+    if (cap == detail::CpuCapability::avx2 || cap == detail::CpuCapability::avx512)
+        register_kernel<T, Op>(prefix + "avx2", n, &kernels::avx2::binary_contig<T, Op>);
+#endif
+#if defined(MINIDL_HAVE_AVX512)
+    if (cap == detail::CpuCapability::avx512)
+        register_kernel<T, Op>(prefix + "avx512", n, &kernels::avx512::binary_contig<T, Op>);
+#endif
+#if defined(MINIDL_HAVE_NEON)
+    register_kernel<T, Op>(prefix + "neon", n, &kernels::neon::binary_contig<T, Op>);
+#endif
+}
+
+const bool registered = [] {
+    // L1, L2, L3 and DRAM resident working sets (3 operands of 4 bytes).
+    for (std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 14, std::size_t{1} << 18, std::size_t{1} << 24}) {
+        bench::register_benchmark("simd/memcpy/" + std::to_string(n), [=](bench::State& state) {
+            std::vector<float> src(n, 1.0f), dst(n);
+            while (state.keep_running()) {
+                std::memcpy(dst.data(), src.data(), n * sizeof(float));
+                bench::do_not_optimize(dst.data());
+            }
+            state.set_items_processed(n);
+            state.set_bytes_processed(2 * n * sizeof(float));
+            memcpy_gbps()[n] = static_cast<double>(state.bytes_processed()) / state.seconds_per_iteration() * 1e-9;
+        });
+        register_all<float, detail::AddOp<float>>("add_f32", n);
+        register_all<std::int32_t, detail::MulOp<std::int32_t>>("mul_i32", n);
+    }
+    return true;
+}();
+
+}  // namespace
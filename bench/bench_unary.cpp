@@ -0,0 +1,65 @@
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <string>
+
+#include "bench.h"
+
+using namespace minidl;
+
+// Unary ops, fast (vectorized approximation) against exact (libm per element), on a
+// contiguous tensor and on every other column of a wider one, where the fast form gathers
+// blocks for the SIMD kernel.
+// Names are unary/<op>/<precision>/<layout>/<n>.
+namespace {
+
+using UnaryFn = Tensor (*)(const Tensor&, ops::Precision);
+
+// n values spread over [-4, 4], where the activations are not saturated.
+Tensor spread(std::size_t rows, std::size_t cols) {
+    Tensor t = Tensor::empty({rows, cols});
+    auto* p = static_cast<float*>(t.data());
+    for (std::size_t i = 0; i < t.numel(); ++i) p[i] = -4.0f + 8.0f * float(i % 4093) / 4093.0f;
+    return t;
+}
+
+const bool registered = [] {
+    const std::pair<const char*, UnaryFn> op_list[] = {
+        {"exp", ops::exp}, {"log", ops::log}, {"tanh", ops::tanh}, {"sigmoid", ops::sigmoid}, {"gelu", ops::gelu}};
+    constexpr std::size_t kRows = 1024, kCols = 4096;
+
+    for (const auto& [op_name, op] : op_list) {
+        for (auto precision : {ops::Precision::fast, ops::Precision::exact}) {
+            for (bool strided : {false, true}) {
+                const std::string name = std::string("unary/") + op_name + "/" +
+                                         (precision == ops::Precision::fast ? "fast" : "exact") + "/" +
+                                         (strided ? "strided" : "contig") + "/" + std::to_string(kRows * kCols);
+                bench::register_benchmark(name, [=](bench::State& state) {
+                    // log runs on exp(x), so its inputs are positive.
+                    Tensor x = spread(kRows, strided ? 2 * kCols : kCols);
+                    if (op == ops::log) x = ops::exp(x);
+                    if (strided) x = x.slice(1, 0, 2 * kCols, 2);
+                    while (state.keep_running()) {
+                        Tensor r = op(x, precision);
+                        bench::do_not_optimize(r.data());
+                    }
+                    state.set_items_processed(x.numel());
+                    state.set_bytes_processed(2 * x.nbytes());
+                });
+            }
+        }
+    }
+
+    bench::register_benchmark("unary/relu/f32/contig/" + std::to_string(kRows * kCols), [](bench::State& state) {
+        const Tensor x = spread(kRows, kCols);
+        while (state.keep_running()) {
+            Tensor r = ops::relu(x);
+            bench::do_not_optimize(r.data());
+        }
+        state.set_items_processed(x.numel());
+        state.set_bytes_processed(2 * x.nbytes());
+    });
+    return true;
+}();
+
+}  // namespace
@@ -4,12 +4,17 @@
 #include <cstddef>
 
 namespace minidl {
+
+// One cache line, and a full AVX-512 register.
+inline constexpr std::size_t kDefaultAlignment = 64;
+
 class Allocator {
    public:
     Allocator() = default;
     virtual ~Allocator() = default;
 
-    virtual void* allocate(std::size_t nbytes) = 0;
+    // `alignment` is a power of two; the returned pointer is a multiple of it.
+    virtual void* allocate(std::size_t nbytes, std::size_t alignment = kDefaultAlignment) = 0;
     virtual void deallocate(void* data) = 0;
 
     // delete copy
@@ -18,4 +23,12 @@ class Allocator {
     Allocator(Allocator&& other) = delete;
     Allocator& operator=(Allocator&& othre) = delete;
 };
+
+namespace detail {
+constexpr bool is_pow2(std::size_t v) noexcept { return v != 0 && (v & (v - 1)) == 0; }
+constexpr std::size_t round_up(std::size_t v, std::size_t multiple) noexcept {
+    return (v + multiple - 1) / multiple * multiple;
+}
+}  // namespace detail
+
 }  // namespace minidl
@@ -0,0 +1,108 @@
+#pragma once
+#include <minidl/allocator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace minidl {
+
+struct ArenaStats {
+    std::size_t bytes_in_use = 0;     // bump extent, padding included
+    std::size_t high_water_mark = 0;  // largest bytes_in_use so far
+    std::size_t bytes_reserved = 0;   // slab bytes held from upstream
+    std::size_t num_slabs = 0;
+    std::size_t live_allocations = 0;
+    std::size_t num_allocs = 0;
+    std::size_t num_upstream_allocs = 0;   // slabs requested from upstream
+    std::size_t num_deferred_rewinds = 0;  // scopes that ended with allocations still live
+};
+
+// Bump allocator for step workspaces such as the intermediates of one inference step.
+// allocate() carves blocks off large slabs taken from upstream; deallocate() only
+// bookkeeps, and the memory comes back all at once when a Scope ends or on reset(). Slabs
+// are kept, so once the first step has sized them the following steps make no upstream
+// calls at all:
+//     auto arena = std::make_shared<ArenaAllocator>();
+//     for (...) {
+//         ArenaAllocator::Scope step(*arena);
+//         ...tensors created with arena, dropped by the end of the step...
+//     }
+// A Scope whose allocations are still live when it ends does not rewind; they are handed
+// to the enclosing scope and counted in num_deferred_rewinds. Scopes nest and must end in
+// reverse order.
+//
+// Nothing is reused within a scope, so a step's footprint is the sum of its intermediates.
+// When those are far larger than the caches, CachingAllocator, which hands the block just
+// freed straight back out, keeps the working set warmer.
+class ArenaAllocator final : public Allocator {
+   public:
+    struct Options {
+        std::size_t slab_size = std::size_t{16} << 20;  // larger requests get a slab of their own
+        // false: a single slab of slab_size, reserved up front; running out of it throws
+        // std::bad_alloc instead of taking another slab.
+        bool grow = true;
+    };
+
+    class Scope {
+       public:
+        explicit Scope(ArenaAllocator& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+       private:
+        ArenaAllocator& arena_;
+    };
+
+    ArenaAllocator() : ArenaAllocator(Options{}) {}
+    explicit ArenaAllocator(Options options, std::shared_ptr<Allocator> upstream = nullptr);
+    ~ArenaAllocator() override;
+
+    void* allocate(std::size_t nbytes, std::size_t alignment = kDefaultAlignment) override;
+    void deallocate(void* data) override;
+
+    // rewinds the whole arena; throws if a Scope is open or an allocation is still live.
+    void reset();
+
+    ArenaStats stats() const;
+
+   private:
+    struct Slab {
+        char* data;
+        std::size_t size;
+    };
+    // a position to rewind to, and the allocations made since that are still live.
+    struct Mark {
+        std::size_t slab;
+        std::size_t offset;
+        std::size_t used;
+        std::uint64_t seq;
+        std::size_t live;
+    };
+
+    void push_mark();
+    void pop_mark() noexcept;
+    Slab new_slab(std::size_t size);
+
+    Options options_;
+    std::shared_ptr<Allocator> upstream_;
+
+    mutable std::mutex mutex_;
+    std::vector<Slab> slabs_;
+    std::vector<Mark> marks_;  // marks_[0] is the start of the arena
+    std::size_t slab_ = 0;     // slab being bumped
+    std::size_t offset_ = 0;   // bytes of slabs_[slab_] handed out
+    std::size_t used_ = 0;
+    std::uint64_t next_seq_ = 0;
+
+    std::size_t high_water_mark_ = 0;
+    std::size_t num_allocs_ = 0;
+    std::size_t num_upstream_allocs_ = 0;
+    std::size_t num_deferred_rewinds_ = 0;
+};
+
+}  // namespace minidl
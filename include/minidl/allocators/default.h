@@ -3,8 +3,13 @@
 
 #include "minidl/allocators/system_allocator.h"
 namespace minidl {
-inline std::shared_ptr<Allocator> get_default_allocator() {
-    static std::shared_ptr<Allocator> a = std::make_shared<SystemAllocator>();
-    return a;
-}
+
+// Allocator used by factories when none is passed. Starts as the one named by
+// $MINIDL_ALLOCATOR ("system" or "caching"), SystemAllocator when unset.
+std::shared_ptr<Allocator> get_default_allocator();
+
+// Replaces the process default; nullptr restores the environment choice.
+// Tensors already created keep the allocator they were created with.
+void set_default_allocator(std::shared_ptr<Allocator> alloc);
+
 }  // namespace minidl
@@ -0,0 +1,59 @@
+#pragma once
+#include <minidl/allocator.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace minidl {
+
+enum class HugePageMode {
+    transparent,  // 2 MiB-aligned anonymous mappings with madvise(MADV_HUGEPAGE)
+    hugetlb,      // MAP_HUGETLB from the reserved pool; transparent when the pool is empty
+};
+
+struct HugePageStats {
+    std::size_t hugetlb_blocks = 0;      // mapped from the hugetlbfs pool
+    std::size_t transparent_blocks = 0;  // mapped for transparent huge pages
+    std::size_t upstream_blocks = 0;     // below the threshold, or no huge page support
+};
+
+// Backs large blocks with 2 MiB pages, so one TLB entry covers 512 times the bytes of a 4 KiB
+// page and strided walks over big tensors (transposed copies, broadcasts) stop missing the
+// TLB on every row. Requests below the threshold go to upstream (the default allocator when
+// null), as do all of them where huge pages are not available (off Linux). Transparent huge
+// pages only take effect when /sys/kernel/mm/transparent_hugepage/enabled is [always] or
+// [madvise]; the mappings are still valid, with small pages, when it is [never].
+class HugePageAllocator final : public Allocator {
+   public:
+    static constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    struct Options {
+        std::size_t threshold = kHugePageSize;  // smaller requests go upstream
+        HugePageMode mode = HugePageMode::transparent;
+    };
+
+    HugePageAllocator() : HugePageAllocator(Options{}) {}
+    explicit HugePageAllocator(Options options, std::shared_ptr<Allocator> upstream = nullptr);
+    ~HugePageAllocator() override;
+
+    // alignment up to kHugePageSize for mapped blocks.
+    void* allocate(std::size_t nbytes, std::size_t alignment = kDefaultAlignment) override;
+    void deallocate(void* data) override;
+
+    HugePageStats stats() const noexcept;
+
+    // true if the kernel hands out transparent huge pages for madvise'd mappings.
+    static bool transparent_available();
+
+   private:
+    Options options_;
+    std::shared_ptr<Allocator> upstream_;
+    std::mutex mutex_;
+    std::unordered_map<void*, std::size_t> sizes_;  // mapped bytes of each live block
+    std::atomic<std::size_t> hugetlb_blocks_{0}, transparent_blocks_{0}, upstream_blocks_{0};
+};
+
+}  // namespace minidl
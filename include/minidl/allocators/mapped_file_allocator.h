@@ -0,0 +1,45 @@
+#pragma once
+#include <minidl/allocator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace minidl {
+
+enum class MapMode {
+    read_only,      // pages shared with every other mapping of the file; writes fault
+    copy_on_write,  // writes go to private copies of the touched pages; the file is unchanged
+};
+
+// A file mapped into memory. load() (serialize.h) makes it the Storage::owner of the tensors
+// that point into it, with upstream (the default allocator when null) as their allocator, so
+// the mapping goes away once the last of those tensors does, while the results of ops on them
+// are allocated upstream and do not keep it alive. As an allocator it ignores blocks inside
+// the mapping and forwards every other request to upstream.
+class MappedFileAllocator final : public Allocator {
+   public:
+    MappedFileAllocator(const std::string& path, MapMode mode, std::shared_ptr<Allocator> upstream = nullptr);
+    ~MappedFileAllocator() override;
+
+    void* allocate(std::size_t nbytes, std::size_t alignment = kDefaultAlignment) override;
+    void deallocate(void* data) override;
+
+    std::byte* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    MapMode mode() const noexcept { return mode_; }
+    const std::shared_ptr<Allocator>& upstream() const noexcept { return upstream_; }
+    bool contains(const void* p) const noexcept {
+        const auto addr = reinterpret_cast<std::uintptr_t>(p), base = reinterpret_cast<std::uintptr_t>(data_);
+        return addr >= base && addr - base < size_;
+    }
+
+   private:
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    MapMode mode_;
+    std::shared_ptr<Allocator> upstream_;
+};
+
+}  // namespace minidl
@@ -0,0 +1,49 @@
+#pragma once
+#include <minidl/allocator.h>
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace minidl {
+
+enum class NumaPolicy {
+    bind,         // every page on one node
+    interleave,   // pages round-robin over all nodes
+    partitioned,  // one contiguous slice per node with CPUs, sized as the pinned pool (see below)
+};
+
+// Places the pages of each block by policy rather than by first touch. Blocks are whole
+// pages mapped from the OS, so this is meant for large tensors; put a CachingAllocator in
+// front of it for many small ones.
+//
+// `partitioned` follows the pinned thread pool (set_thread_pinning) as sized when the block
+// is allocated: the pages of task t of a parallel_for that splits the block over every thread
+// go to the node worker t is pinned to. A contiguous elementwise op over a partitioned tensor
+// large enough to use every thread then reads and writes node-local pages in all tasks but
+// the first, which runs on the calling thread wherever that is. Ops that use fewer tasks
+// (fewer than get_num_threads() chunks of work), read the tensor strided or broadcast, or run
+// after the pool was resized may touch remote pages.
+//
+// Where the kernel has no NUMA support (or off Linux) the pages fall back to first touch.
+class NumaAllocator final : public Allocator {
+   public:
+    // node: the node of `bind`; ignored otherwise.
+    explicit NumaAllocator(NumaPolicy policy, std::size_t node = 0);
+    ~NumaAllocator() override;
+
+    // alignment up to the page size.
+    void* allocate(std::size_t nbytes, std::size_t alignment = kDefaultAlignment) override;
+    void deallocate(void* data) override;
+
+    NumaPolicy policy() const noexcept { return policy_; }
+    std::size_t node() const noexcept { return node_; }
+
+   private:
+    NumaPolicy policy_;
+    std::size_t node_;
+    std::mutex mutex_;
+    std::unordered_map<void*, std::size_t> sizes_;  // mapped bytes of each live block
+};
+
+}  // namespace minidl
@@ -1,16 +1,35 @@
 #pragma once
 #include <minidl/allocator.h>
 
+#include <cstdlib>
+#include <limits>
 #include <new>
+#include <stdexcept>
 
 namespace minidl {
 
 class SystemAllocator final : public Allocator {
-    void* allocate(std::size_t nbytes) override {
+    void* allocate(std::size_t nbytes, std::size_t alignment = kDefaultAlignment) override {
         if (nbytes == 0) return nullptr;
-        return ::operator new(nbytes);
+        if (!detail::is_pow2(alignment)) throw std::runtime_error("SystemAllocator: alignment must be a power of two.");
+        if (alignment < alignof(std::max_align_t)) alignment = alignof(std::max_align_t);
+#if defined(_WIN32)
+        void* p = _aligned_malloc(nbytes, alignment);
+#else
+        // aligned_alloc wants a size that is a multiple of the alignment; rounding must not wrap.
+        if (nbytes > std::numeric_limits<std::size_t>::max() - alignment) throw std::bad_alloc{};
+        void* p = std::aligned_alloc(alignment, detail::round_up(nbytes, alignment));
+#endif
+        if (!p) throw std::bad_alloc{};
+        return p;
+    }
+    void deallocate(void* data) override {
+#if defined(_WIN32)
+        _aligned_free(data);
+#else
+        std::free(data);
+#endif
     }
-    void deallocate(void* data) override { ::operator delete(data); }
 };
 
 }  // namespace minidl
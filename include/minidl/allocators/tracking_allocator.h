@@ -0,0 +1,41 @@
+#pragma once
+#include <minidl/allocator.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace minidl {
+
+// Debug wrapper that counts live allocations, e.g. to assert that an op pipeline
+// returned every buffer:
+//     auto alloc = std::make_shared<TrackingAllocator>();
+//     { ...tensors created with alloc... }
+//     EXPECT_EQ(alloc->live_allocations(), 0u);
+class TrackingAllocator final : public Allocator {
+   public:
+    explicit TrackingAllocator(std::shared_ptr<Allocator> inner = nullptr);
+
+    void* allocate(std::size_t nbytes, std::size_t alignment = kDefaultAlignment) override;
+    void deallocate(void* data) override;
+
+    std::size_t live_allocations() const;
+    std::size_t live_bytes() const;
+    std::size_t total_allocations() const;
+    std::size_t peak_bytes() const;
+    // deallocate calls for pointers that are not live (double frees).
+    std::size_t invalid_frees() const;
+
+   private:
+    std::shared_ptr<Allocator> inner_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<void*, std::size_t> live_;
+    std::size_t live_bytes_ = 0;
+    std::size_t total_allocations_ = 0;
+    std::size_t peak_bytes_ = 0;
+    std::size_t invalid_frees_ = 0;
+};
+
+}  // namespace minidl
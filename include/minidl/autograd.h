@@ -0,0 +1,48 @@
+#pragma once
+#include <minidl/detail/autograd.h>
+#include <minidl/tensor.h>
+
+namespace minidl::autograd {
+
+// Reverse-mode autodiff
+// Ops on tensors that require grad (Tensor::set_requires_grad) record their backward on a
+// tape: the result points at a node holding what the op saved and the inputs it came from.
+// Recorded are add, sub, mul, div (broadcasting), exp, log, tanh, sigmoid, relu, matmul,
+// sum, mean, the views (view, reshape, transpose, slice, select and what builds on them),
+// contiguous() and to(). pow, maximum, minimum, gelu, prod, max, min and expr::eval have no
+// backward and throw on an input that requires grad under grad mode: detach() it first. The
+// comparisons and argmax return untracked bool and index results, which carry no gradient.
+// The in-place and _out ops and copy_ are not recorded: they update a tensor outside the
+// graph, the way an optimizer step updates its parameters.
+//
+// Saved tensors share storage with the op's inputs and output; modifying one in place before
+// backward gives wrong gradients.
+
+// Grad mode for the current thread, on by default: ops in scope of a NoGradGuard record
+// nothing.
+class NoGradGuard {
+   public:
+    NoGradGuard() : prev_(detail::grad_enabled()) { detail::set_grad_enabled(false); }
+    ~NoGradGuard() { detail::set_grad_enabled(prev_); }
+
+    NoGradGuard(const NoGradGuard&) = delete;
+    NoGradGuard& operator=(const NoGradGuard&) = delete;
+
+   private:
+    bool prev_;
+};
+
+inline bool is_grad_enabled() noexcept { return detail::grad_enabled(); }
+
+// Accumulates d root / d leaf into the grad() of every leaf root depends on. Nodes run in
+// topological order, each once all the nodes that feed it have run, and a gradient buffer is
+// freed as soon as its node has run. Gradients reaching the same tensor from several uses
+// are added in place into a buffer backward owns, and a leaf keeps its grad() buffer across
+// calls (see Tensor::zero_grad). Unless retain_graph, the saved tensors are released on the
+// way and a second backward through the same graph throws.
+//
+// root must have one element; the overload takes d loss / d root of root's shape.
+void backward(const Tensor& root, bool retain_graph = false);
+void backward(const Tensor& root, const Tensor& grad, bool retain_graph = false);
+
+}  // namespace minidl::autograd
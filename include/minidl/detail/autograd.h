@@ -0,0 +1,83 @@
+#pragma once
+#include <minidl/dtype.h>
+#include <minidl/tensor.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace minidl::detail {
+
+struct Node;
+
+// What autograd knows about a tensor, shared by every copy of it (see Tensor::requires_grad).
+// A leaf has no grad_fn and collects its gradient in `grad`; any other tensor that requires
+// grad is the result of grad_fn.
+struct AutogradMeta {
+    bool requires_grad = false;
+    std::shared_ptr<Node> grad_fn;
+    std::optional<Tensor> grad;
+    bool grad_is_zero = false;  // set by zero_grad: the next gradient is copied, not added
+};
+
+// One input of a Node: its AutogradMeta (null when it does not require grad) and its dtype,
+// which the gradient flowing to it is converted to.
+struct Edge {
+    std::shared_ptr<AutogradMeta> meta;
+    DType dtype;
+};
+
+// The backward of one recorded op.
+struct Node {
+    virtual ~Node() = default;
+
+    // the gradients of the inputs, in order, given the gradient of the output. Entries of
+    // inputs without a meta in `next` may be left empty.
+    virtual std::vector<std::optional<Tensor>> apply(const Tensor& grad) = 0;
+    // drops what the op saved for apply, once backward is done with it.
+    virtual void release() {}
+
+    std::vector<Edge> next;
+    bool released = false;
+};
+
+// Grad mode is per thread; off inside autograd::NoGradGuard and during backward.
+bool grad_enabled() noexcept;
+void set_grad_enabled(bool enabled) noexcept;
+
+// true when an op on `inputs` has to be recorded.
+inline bool needs_grad(std::initializer_list<const Tensor*> inputs) noexcept {
+    if (!grad_enabled()) return false;
+    for (const Tensor* t : inputs) {
+        if (t->requires_grad()) return true;
+    }
+    return false;
+}
+
+// for ops without a backward: throws when an op on `inputs` would have to be recorded, so a
+// gradient is never silently dropped.
+void require_no_grad(const char* op, std::initializer_list<const Tensor*> inputs);
+
+// makes `out` the result of `node` applied to `inputs`; callers check needs_grad first.
+void record(Tensor& out, std::shared_ptr<Node> node, std::initializer_list<const Tensor*> inputs);
+
+// Views share their base's storage, and the meta when copied from it: gives `out`, a view of
+// `base`, a meta of its own, recorded when base requires grad.
+void record_view(Tensor& out, const Tensor& base);
+// out is a copy of `base` in the same or another dtype (contiguous(), to()).
+void record_copy(Tensor& out, const Tensor& base);
+
+// The differentiable ops, recorded by their entry points in minidl_ops (src/autograd/functions.cpp).
+enum class BinaryGrad { none, add, sub, mul, div };
+enum class UnaryGrad { exp, log, tanh, sigmoid, relu };
+enum class ReduceGrad { sum, mean };
+
+void record_binary(BinaryGrad kind, Tensor& out, const Tensor& a, const Tensor& b);
+void record_unary(UnaryGrad kind, Tensor& out, const Tensor& x);
+void record_matmul(Tensor& out, const Tensor& a, const Tensor& b);
+// `axes` as the reduction took them, empty for every dim.
+void record_reduce(ReduceGrad kind, Tensor& out, const Tensor& x, const std::vector<std::size_t>& axes);
+
+}  // namespace minidl::detail
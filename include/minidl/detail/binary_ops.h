@@ -1,49 +1,309 @@
 #pragma once
 #include "minidl/detail/broadcasting.h"
+#include "minidl/detail/dispatch.h"
 #include "minidl/detail/kernels_pointwise.h"
+#include "minidl/detail/kernels_simd.h"
+#include "minidl/detail/layout.h"
+#include "minidl/detail/overlap.h"
+#include "minidl/detail/parallel.h"
+#include "minidl/detail/simd/math_vec.h"
 #include "minidl/tensor.h"
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
 namespace minidl::detail {
 
 // Functors
+// `result_type` is the element type written (bool for comparisons); `vec` is the same
+// operation on an ISA vector type (see detail/simd/), declared by ops with
+// `vectorizable = true`.
 template <typename T>
 struct AddOp {
+    using result_type = T;
+    static constexpr bool vectorizable = true;
     static inline T apply(T a, T b) noexcept { return a + b; }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return a + b;
+    }
+};
+
+template <typename T>
+struct SubOp {
+    using result_type = T;
+    static constexpr bool vectorizable = true;
+    static inline T apply(T a, T b) noexcept { return a - b; }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return a - b;
+    }
 };
 
 template <typename T>
 struct MulOp {
+    using result_type = T;
+    static constexpr bool vectorizable = true;
     static inline T apply(T a, T b) noexcept { return a * b; }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return a * b;
+    }
 };
 
-// impl
+// Integer division truncates toward zero; x / 0 is 0 and MIN / -1 wraps, instead of trapping.
+template <typename T>
+struct DivOp {
+    using result_type = T;
+    static constexpr bool vectorizable = std::is_floating_point_v<T>;
+    static inline T apply(T a, T b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return a / b;
+        } else {
+            if (b == 0) return 0;
+            if constexpr (std::is_signed_v<T>) {
+                if (b == -1) return static_cast<T>(0u - static_cast<std::make_unsigned_t<T>>(a));
+            }
+            return static_cast<T>(a / b);
+        }
+    }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return a / b;
+    }
+};
+
+// NaN if either side is NaN, as in NumPy / PyTorch (the reductions skip NaN instead).
+template <typename T>
+struct MaximumOp {
+    using result_type = T;
+    static constexpr bool vectorizable = true;
+    static inline T apply(T a, T b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (b != b) return b;
+        }
+        return b > a ? b : a;
+    }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return simd::maximum_vec(a, b);
+        } else {
+            return max(a, b);
+        }
+    }
+};
+
+template <typename T>
+struct MinimumOp {
+    using result_type = T;
+    static constexpr bool vectorizable = true;
+    static inline T apply(T a, T b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            if (b != b) return b;
+        }
+        return b < a ? b : a;
+    }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return simd::minimum_vec(a, b);
+        } else {
+            return min(a, b);
+        }
+    }
+};
+
+// std::pow for floats. For integers, repeated squaring with wraparound; negative exponents
+// give the truncated 1 / a^-b, so 0 unless |a| == 1.
+template <typename T>
+struct PowOp {
+    using result_type = T;
+    static constexpr bool vectorizable = false;
+    static inline T apply(T a, T b) noexcept {
+        if constexpr (std::is_floating_point_v<T>) {
+            return std::pow(a, b);
+        } else {
+            using U = std::make_unsigned_t<T>;
+            if constexpr (std::is_signed_v<T>) {
+                if (b < 0) return a == 1 ? 1 : a == -1 ? (b % 2 ? -1 : 1) : 0;
+            }
+            U r = 1, base = static_cast<U>(a);
+            for (auto e = static_cast<U>(b); e; e >>= 1) {
+                if (e & 1) r *= base;
+                base *= base;
+            }
+            return static_cast<T>(r);
+        }
+    }
+};
+
+#define MINIDL_DEFINE_COMPARISON_OP(Name, op)                          \
+    template <typename T>                                              \
+    struct Name {                                                      \
+        using result_type = bool;                                      \
+        static constexpr bool vectorizable = false;                    \
+        static inline bool apply(T a, T b) noexcept { return a op b; } \
+    };
+
+MINIDL_DEFINE_COMPARISON_OP(EqOp, ==)
+MINIDL_DEFINE_COMPARISON_OP(NeOp, !=)
+MINIDL_DEFINE_COMPARISON_OP(LtOp, <)
+MINIDL_DEFINE_COMPARISON_OP(LeOp, <=)
+MINIDL_DEFINE_COMPARISON_OP(GtOp, >)
+MINIDL_DEFINE_COMPARISON_OP(GeOp, >=)
+#undef MINIDL_DEFINE_COMPARISON_OP
+
+// The op table. X(name, Functor) for every binary op: ops/pointwise.cpp generates the
+// ops:: entry points and dtype dispatch from it, and the kernel sources their explicit
+// instantiations, so a new op is one functor and one line here (plus its ops.h declaration).
+// Arithmetic ops also get an in-place `name_`; comparisons write bool.
+#define MINIDL_ARITHMETIC_BINARY_OPS(X) \
+    X(add, AddOp)                       \
+    X(sub, SubOp)                       \
+    X(mul, MulOp)                       \
+    X(div, DivOp)                       \
+    X(maximum, MaximumOp)               \
+    X(minimum, MinimumOp)               \
+    X(pow, PowOp)
+
+#define MINIDL_COMPARISON_BINARY_OPS(X) \
+    X(eq, EqOp)                         \
+    X(ne, NeOp)                         \
+    X(lt, LtOp)                         \
+    X(le, LeOp)                         \
+    X(gt, GtOp)                         \
+    X(ge, GeOp)
+
+#define MINIDL_BINARY_OPS(X)         \
+    MINIDL_ARITHMETIC_BINARY_OPS(X) \
+    MINIDL_COMPARISON_BINARY_OPS(X)
+
+// f16 and bf16 compute in f32: ops on them are instantiated as Op<compute_type_t<T>>, and
+// write T (or bool for comparisons).
+template <typename T>
+using compute_type_t = std::conditional_t<kernels::is_half_v<T>, float, T>;
 template <typename T, class Op>
-Tensor binary_impl(const Tensor& a, const Tensor& b) {
-    if (a.dtype() != b.dtype()) throw std::runtime_error("binary_impl: dtype mismatch.");
+using binary_result_t = std::conditional_t<kernels::is_half_v<T> && std::is_same_v<typename Op::result_type, float>,
+                                           T, typename Op::result_type>;
 
-    const auto out_shape = detail::compute_broadcast_shape(a.shape().dims(), b.shape().dims());
-    Tensor out = Tensor::zeros(Shape(out_shape), a.dtype(), a.storage()->alloc_);
+// binary_kernel for the types with kernels of their own.
+template <typename T, class Op>
+void binary_native_kernel(const Tensor& a, const Tensor& b, Tensor& out) {
+    const auto& out_shape = out.shape().dims();
     const std::size_t n = out.numel();
-    if (n == 0) return out;
+    if (n == 0) return;
 
-    auto xs = detail::expand_strides_for_broadcast(a.shape().dims(), a.strides(), out_shape);
-    auto ys = detail::expand_strides_for_broadcast(b.shape().dims(), b.strides(), out_shape);
+    const auto xs = detail::expand_strides_for_broadcast(a.shape().dims(), a.strides(), out_shape);
+    const auto ys = detail::expand_strides_for_broadcast(b.shape().dims(), b.strides(), out_shape);
 
     const bool same_shape = (a.shape().dims() == b.shape().dims());
     const bool same_strides = same_shape && (a.strides() == b.strides());
     const bool cont_all = a.is_contiguous() && b.is_contiguous() && out.is_contiguous();
     const bool no_bcast = same_shape && same_strides;
 
-    auto* z = static_cast<T*>(out.data());
+    auto* z = static_cast<typename Op::result_type*>(out.data());
     auto* x = static_cast<const T*>(a.data());
     auto* y = static_cast<const T*>(b.data());
 
     if (cont_all && no_bcast) {
-        kernels::binary_contig<T, Op>(z, x, y, out.numel());
+        detail::parallel_for(0, n, detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+            kernels::binary_contig_dispatch<T, Op>(z + begin, x + begin, y + begin, end - begin);
+        });
     } else if (no_bcast) {
-        kernels::binary_same_shape_strided<T, Op>(z, x, y, out_shape, a.strides(), b.strides());
+        const detail::TensorIterator iter(out_shape, {out.strides(), a.strides(), b.strides()});
+        detail::parallel_for(0, n, detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+            kernels::binary_same_shape_strided<T, Op>(z, x, y, iter, begin, end);
+        });
+    } else {
+        const detail::TensorIterator iter(out_shape, {out.strides(), xs, ys});
+        detail::parallel_for(0, n, detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+            kernels::binary_broadcast<T, Op>(z, x, y, iter, begin, end);
+        });
+    }
+}
+
+// binary_kernel when an operand is not of dtype T, or T is f16 / bf16: Op is the functor on
+// compute_type_t<T>, and each operand is converted block by block (kernels::binary_convert_1d)
+// instead of as a whole.
+template <typename T, class Op>
+void binary_convert_kernel(const Tensor& a, const Tensor& b, Tensor& out) {
+    const auto& out_shape = out.shape().dims();
+    const std::size_t n = out.numel();
+    if (n == 0) return;
+
+    const auto xs = detail::expand_strides_for_broadcast(a.shape().dims(), a.strides(), out_shape);
+    const auto ys = detail::expand_strides_for_broadcast(b.shape().dims(), b.strides(), out_shape);
+    const DType zt = out.dtype(), xt = a.dtype(), yt = b.dtype();
+    const std::size_t zi = size_of(zt), xi = size_of(xt), yi = size_of(yt);
+    auto* z = static_cast<std::byte*>(out.data());
+    auto* x = static_cast<const std::byte*>(a.data());
+    auto* y = static_cast<const std::byte*>(b.data());
+    const detail::TensorIterator iter(out_shape, {out.strides(), xs, ys});
+    detail::parallel_for(0, n, detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+        iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t m) {
+            kernels::binary_convert_1d<compute_type_t<T>, Op>(z + off[0] * zi, zt, x + off[1] * xi, xt,
+                                                              y + off[2] * yi, yt, m, st[0], st[1], st[2]);
+        });
+    });
+}
+
+// z = Op(a, b) into an existing out of the broadcast shape and dtype binary_result_t<T, Op>,
+// where T is the promoted dtype of a and b; inputs must not partially alias out.
+template <typename T, class Op>
+void binary_kernel(const Tensor& a, const Tensor& b, Tensor& out) {
+    if constexpr (kernels::is_half_v<T>) {
+        binary_convert_kernel<T, Op>(a, b, out);
+    } else {
+        if (a.dtype() == dtype_of_v<T> && b.dtype() == dtype_of_v<T>) {
+            binary_native_kernel<T, Op>(a, b, out);
+        } else {
+            binary_convert_kernel<T, Op>(a, b, out);
+        }
+    }
+}
+
+// impl
+// T is promote_types(a.dtype(), b.dtype()); the operands keep their own dtypes.
+template <typename T, class Op>
+Tensor binary_impl(const Tensor& a, const Tensor& b) {
+    const auto out_shape = detail::compute_broadcast_shape(a.shape().dims(), b.shape().dims());
+    Tensor out = Tensor::empty(Shape(out_shape), dtype_of_v<binary_result_t<T, Op>>, a.storage()->alloc_);
+    binary_kernel<T, Op>(a, b, out);
+    return out;
+}
+
+template <typename T, class Op>
+Tensor& binary_out_impl(const Tensor& a, const Tensor& b, Tensor& out) {
+    using R = binary_result_t<T, Op>;
+    if (out.dtype() != dtype_of_v<R>) {
+        throw std::runtime_error(std::string("binary_out: out dtype must be the result dtype ") +
+                                 to_string(dtype_of_v<R>) + ".");
+    }
+
+    const auto out_shape = detail::compute_broadcast_shape(a.shape().dims(), b.shape().dims());
+    if (out.shape().dims() != out_shape) {
+        throw std::runtime_error("binary_out: out shape must equal the broadcast shape.");
+    }
+    if (has_internal_overlap(out_shape, out.strides())) {
+        throw std::runtime_error("binary_out: out must not have overlapping elements.");
+    }
+
+    // in place needs equal element sizes; otherwise (bool results, narrower operands) any
+    // overlap goes through a temporary.
+    const auto alias_ok_for = [&](const Tensor& x) {
+        return size_of(x.dtype()) == sizeof(R) ? safe_to_alias(x, out) : !may_overlap(x, out);
+    };
+    const bool alias_ok = alias_ok_for(a) && alias_ok_for(b);
+    if (alias_ok) {
+        binary_kernel<T, Op>(a, b, out);
     } else {
-        kernels::binary_broadcast<T, Op>(z, x, y, out_shape, xs, ys);
+        // partial overlap: results would feed back into later inputs.
+        out.copy_(binary_impl<T, Op>(a, b));
     }
     return out;
 }
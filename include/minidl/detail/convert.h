@@ -0,0 +1,98 @@
+#pragma once
+#include "minidl/dtype.h"
+#include "minidl/half.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace minidl::kernels {
+
+template <typename T>
+inline constexpr bool is_half_v = std::is_same_v<T, Half> || std::is_same_v<T, BFloat16>;
+
+// One element of Tensor::to:
+//   to bool        x != 0 (NaN is true)
+//   float to int   truncates toward zero and saturates at the target's range; NaN gives 0
+//   int to int     wraps modulo 2^bits, as static_cast does
+//   to a float     rounds to nearest even (f64 to f16 / bf16 rounds through f32)
+template <typename D, typename S>
+inline D convert_value(S x) noexcept {
+    if constexpr (std::is_same_v<D, S>) {
+        return x;
+    } else if constexpr (std::is_same_v<D, bool>) {
+        if constexpr (is_half_v<S>) {
+            return static_cast<float>(x) != 0.0f;
+        } else {
+            return x != S(0);
+        }
+    } else if constexpr (is_half_v<D>) {
+        return D(static_cast<float>(x));
+    } else if constexpr (std::is_floating_point_v<D>) {
+        return static_cast<D>(x);
+    } else if constexpr (std::is_floating_point_v<S> || is_half_v<S>) {
+        // both bounds are powers of two, exact in F.
+        using F = std::conditional_t<std::is_same_v<S, double>, double, float>;
+        constexpr F lo = static_cast<F>(std::numeric_limits<D>::min());
+        constexpr F hi = static_cast<F>(std::numeric_limits<D>::max() / 2 + 1) * F(2);
+        const F v = static_cast<F>(x);
+        if (v != v) return D(0);
+        if (v <= lo) return std::numeric_limits<D>::min();
+        if (v >= hi) return std::numeric_limits<D>::max();
+        return static_cast<D>(v);
+    } else {
+        return static_cast<D>(x);
+    }
+}
+
+// n contiguous elements of src_dtype at src to dst_dtype at dst, with convert_value.
+// f32 <-> f16 / bf16 go through the widest kernel the host supports, below.
+void convert_contig(void* dst, DType dst_dtype, const void* src, DType src_dtype, std::size_t n);
+
+// n elements with the given element strides.
+void convert_strided(void* dst, DType dst_dtype, std::size_t dst_stride, const void* src, DType src_dtype,
+                     std::size_t src_stride, std::size_t n);
+
+// The f32 <-> f16 / bf16 kernels, for the ops that compute f16 / bf16 in f32.
+void to_f32(float* dst, const Half* src, std::size_t n) noexcept;
+void to_f32(float* dst, const BFloat16* src, std::size_t n) noexcept;
+void from_f32(Half* dst, const float* src, std::size_t n) noexcept;
+void from_f32(BFloat16* dst, const float* src, std::size_t n) noexcept;
+
+// Per-ISA kernels on the raw 16-bit patterns, bit for bit equal to the scalar conversions in
+// half.h except where noted. f16 uses F16C on AVX2 (part of the avx2 level) and AVX-512F's
+// own conversions; bf16 is integer rounding on the f32 bits.
+#if defined(MINIDL_HAVE_AVX2)
+namespace avx2 {
+void f32_to_f16(std::uint16_t* dst, const float* src, std::size_t n) noexcept;
+void f16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept;
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept;
+void bf16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept;
+}  // namespace avx2
+#endif
+#if defined(MINIDL_HAVE_AVX512)
+namespace avx512 {
+void f32_to_f16(std::uint16_t* dst, const float* src, std::size_t n) noexcept;
+void f16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept;
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept;
+void bf16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept;
+}  // namespace avx512
+#endif
+#if defined(MINIDL_HAVE_AVX512BF16)
+// VCVTNEPS2BF16, on CPUs with AVX512_BF16 (detail::cpu_has_avx512_bf16()). The instruction
+// flushes f32 denormals (|x| < 2^-126) to a zero of the same sign.
+namespace avx512bf16 {
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept;
+}  // namespace avx512bf16
+#endif
+#if defined(MINIDL_HAVE_NEON)
+namespace neon {
+void f32_to_f16(std::uint16_t* dst, const float* src, std::size_t n) noexcept;
+void f16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept;
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept;
+void bf16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept;
+}  // namespace neon
+#endif
+
+}  // namespace minidl::kernels
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace minidl::detail {
+
+// Instruction set levels with dedicated kernels. x86 levels are ordered.
+enum class CpuCapability {
+    scalar,
+    neon,
+    avx2,    // AVX2 + FMA + F16C
+    avx512,  // AVX-512F
+};
+
+// Widest level supported by both the CPU (cpuid/xgetbv) and the OS. $MINIDL_CPU_CAPABILITY
+// (scalar, neon, avx2, avx512) lowers it, e.g. to compare kernels on one host.
+// Detected once per process.
+CpuCapability cpu_capability() noexcept;
+
+const char* to_string(CpuCapability cap) noexcept;
+
+// AVX512_BF16 (the f32 -> bf16 conversion instructions), on top of the avx512 level; false
+// when cpu_capability() is lowered below avx512.
+bool cpu_has_avx512_bf16() noexcept;
+
+}  // namespace minidl::detail
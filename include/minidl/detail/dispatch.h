@@ -1,10 +1,57 @@
 #pragma once
 #include "minidl/dtype.h"
+#include "minidl/half.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 
 namespace minidl::detail {
 
+// DType of the elements a kernel of type T writes, e.g. for an op's result_type.
+template <typename T>
+struct DTypeOf;
+template <>
+struct DTypeOf<float> {
+    static constexpr DType value = DType::f32;
+};
+template <>
+struct DTypeOf<std::int32_t> {
+    static constexpr DType value = DType::i32;
+};
+template <>
+struct DTypeOf<bool> {
+    static constexpr DType value = DType::bool_;
+};
+template <>
+struct DTypeOf<double> {
+    static constexpr DType value = DType::f64;
+};
+template <>
+struct DTypeOf<Half> {
+    static constexpr DType value = DType::f16;
+};
+template <>
+struct DTypeOf<BFloat16> {
+    static constexpr DType value = DType::bf16;
+};
+template <>
+struct DTypeOf<std::int8_t> {
+    static constexpr DType value = DType::i8;
+};
+template <>
+struct DTypeOf<std::uint8_t> {
+    static constexpr DType value = DType::u8;
+};
+template <>
+struct DTypeOf<std::int64_t> {
+    static constexpr DType value = DType::i64;
+};
+template <typename T>
+inline constexpr DType dtype_of_v = DTypeOf<T>::value;
+
 template <typename F32Fn, typename I32Fn>
-auto dispatch(DType dt, F32Fn&& f32_fn, I32Fn&& i32_fn) {
+decltype(auto) dispatch(DType dt, F32Fn&& f32_fn, I32Fn&& i32_fn) {
     switch (dt) {
         case DType::f32:
             return f32_fn();
@@ -15,4 +62,36 @@ auto dispatch(DType dt, F32Fn&& f32_fn, I32Fn&& i32_fn) {
     }
 }
 
+template <typename T>
+struct TypeTag {
+    using type = T;
+};
+template <typename... Ts>
+struct TypeList {};
+
+using AllTypes = TypeList<float, double, Half, BFloat16, std::int8_t, std::uint8_t, std::int32_t, std::int64_t, bool>;
+// what the arithmetic and comparison ops accept; f16 and bf16 compute in f32.
+using NumericTypes = TypeList<float, double, Half, BFloat16, std::int8_t, std::uint8_t, std::int32_t, std::int64_t>;
+
+template <class Fn, typename T, typename... Rest>
+decltype(auto) dispatch_types_impl(TypeList<T, Rest...>, DType dt, const char* op, Fn& fn) {
+    if (dt == dtype_of_v<T>) return fn(TypeTag<T>{});
+    if constexpr (sizeof...(Rest) > 0) {
+        return dispatch_types_impl(TypeList<Rest...>{}, dt, op, fn);
+    } else {
+        throw std::runtime_error(std::string(op) + ": unsupported dtype " + to_string(dt) + ".");
+    }
+}
+
+// fn(TypeTag<T>{}) for the T of List whose dtype is dt, e.g.
+//   dispatch_types<NumericTypes>(x.dtype(), "neg", [&](auto tag) {
+//       using T = typename decltype(tag)::type;
+//       ...
+//   });
+// Every instantiation must return the same type. Throws, naming `op`, for dtypes not in List.
+template <class List, class Fn>
+decltype(auto) dispatch_types(DType dt, const char* op, Fn&& fn) {
+    return dispatch_types_impl(List{}, dt, op, fn);
+}
+
 }  // namespace minidl::detail
@@ -0,0 +1,140 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "minidl/detail/binary_ops.h"
+#include "minidl/detail/broadcasting.h"
+#include "minidl/detail/cpu_features.h"
+#include "minidl/detail/dispatch.h"
+#include "minidl/detail/parallel.h"
+#include "minidl/detail/tensor_iterator.h"
+#include "minidl/detail/trace.h"
+#include "minidl/tensor.h"
+
+namespace minidl::detail {
+
+template <class E>
+using ExprLeaves = std::array<const Tensor*, E::kLeaves>;
+
+template <class E>
+ExprLeaves<E> expr_leaves(const E& e) {
+    ExprLeaves<E> leaves{};
+    e.collect(leaves.data());
+    return leaves;
+}
+
+template <std::size_t N>
+std::vector<std::size_t> expr_broadcast_shape(const std::array<const Tensor*, N>& leaves) {
+    std::vector<std::size_t> shape = leaves[0]->shape().dims();
+    for (std::size_t k = 1; k < N; ++k) {
+        if (leaves[k]->dtype() != leaves[0]->dtype()) throw std::runtime_error("expr: dtype mismatch.");
+        shape = compute_broadcast_shape(shape, leaves[k]->shape().dims());
+    }
+    return shape;
+}
+
+template <typename T, class E>
+inline void expr_contig_run(const E& e, T* z, const T* const* p, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) z[i] = e.template at<0>(p, i);
+}
+
+#if defined(MINIDL_HAVE_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define MINIDL_EXPR_AVX2 1
+// Expressions are instantiated in user code, so they cannot go through the per-ISA translation
+// units; the unit-stride loop is compiled a second time for AVX2 instead. No FMA, so results
+// match the eager ops bit for bit.
+template <typename T, class E>
+__attribute__((target("avx2"))) void expr_contig_run_avx2(const E& e, T* z, const T* const* p,
+                                                          std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) z[i] = e.template at<0>(p, i);
+}
+#endif
+
+// One pass over out: each element is computed from the leaves with the whole tree inlined.
+template <typename T, class E>
+void expr_kernel(const E& e, const ExprLeaves<E>& leaves, Tensor& out) {
+    constexpr std::size_t N = E::kLeaves;
+    const auto& shape = out.shape().dims();
+    if (out.numel() == 0) return;
+
+    std::vector<std::vector<std::size_t>> strides;
+    strides.reserve(N + 1);
+    strides.push_back(out.strides());
+    for (const Tensor* t : leaves) {
+        strides.push_back(expand_strides_for_broadcast(t->shape().dims(), t->strides(), shape));
+    }
+
+    std::array<const T*, N> base{};
+    for (std::size_t k = 0; k < N; ++k) base[k] = static_cast<const T*>(leaves[k]->data());
+    T* z = static_cast<T*>(out.data());
+#ifdef MINIDL_EXPR_AVX2
+    const bool use_avx2 = cpu_capability() >= CpuCapability::avx2;
+#endif
+
+    const TensorIterator iter(shape, strides);
+    parallel_for(0, iter.numel(), kGrainSize, [&](std::size_t begin, std::size_t end) {
+        iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t n) {
+            T* zr = z + off[0];
+            std::array<const T*, N> p{};
+            bool unit = st[0] == 1;
+            for (std::size_t k = 0; k < N; ++k) {
+                p[k] = base[k] + off[k + 1];
+                unit = unit && st[k + 1] == 1;
+            }
+            const T* const* pp = p.data();
+            if (unit) {
+#ifdef MINIDL_EXPR_AVX2
+                if (use_avx2) return expr_contig_run_avx2(e, zr, pp, n);
+#endif
+                expr_contig_run(e, zr, pp, n);
+            } else {
+                const std::size_t zs = st[0];
+                for (std::size_t i = 0; i < n; ++i) zr[i * zs] = e.template at<0>(pp, st + 1, i);
+            }
+        });
+    });
+}
+
+template <class E>
+void expr_dispatch(const E& e, const ExprLeaves<E>& leaves, Tensor& out) {
+    dispatch(
+        out.dtype(), [&] { expr_kernel<float>(e, leaves, out); }, [&] { expr_kernel<std::int32_t>(e, leaves, out); });
+}
+
+template <class E>
+Tensor expr_eval(const E& e) {
+    const auto leaves = expr_leaves(e);
+    // a trace cannot replay the compiled-in tree; keep it from freezing the result as a constant.
+    for (const Tensor* t : leaves) trace_unsupported("expr::eval", {t});
+    const auto shape = expr_broadcast_shape(leaves);
+    Tensor out = Tensor::empty(Shape(shape), leaves[0]->dtype(), leaves[0]->storage()->alloc_);
+    expr_dispatch(e, leaves, out);
+    return out;
+}
+
+template <class E>
+Tensor& expr_eval_out(const E& e, Tensor& out) {
+    const auto leaves = expr_leaves(e);
+    trace_unsupported("expr::eval_out", {&out});
+    for (const Tensor* t : leaves) trace_unsupported("expr::eval_out", {t});
+    const auto shape = expr_broadcast_shape(leaves);
+    if (leaves[0]->dtype() != out.dtype()) throw std::runtime_error("expr: dtype mismatch.");
+    if (out.shape().dims() != shape) throw std::runtime_error("expr: out shape must equal the broadcast shape.");
+    if (has_internal_overlap(shape, out.strides())) {
+        throw std::runtime_error("expr: out must not have overlapping elements.");
+    }
+
+    for (const Tensor* t : leaves) {
+        if (!safe_to_alias(*t, out)) {
+            out.copy_(expr_eval(e));
+            return out;
+        }
+    }
+    expr_dispatch(e, leaves, out);
+    return out;
+}
+
+}  // namespace minidl::detail
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "minidl/detail/trace.h"
+#include "minidl/tensor.h"
+
+namespace minidl::detail {
+
+// A fused elementwise kernel as a small bytecode over registers that each hold one block of
+// f32. The program runs once per block of the output's iteration space: loads bring a block
+// of an operand into a register (or point the register at it), the ops run the SIMD kernel
+// of their Op on whole blocks, and the last instruction's register is the block of out.
+struct FusedInstr {
+    enum class Kind : std::uint8_t { load, unary, binary };
+    Kind kind;
+    PointwiseOp op = PointwiseOp::none;
+    bool fast = true;           // unary: Op::vec rather than the exact Op::apply
+    std::uint8_t dst = 0;       // register written
+    std::uint8_t a = 0, b = 0;  // registers read; load: a is the operand
+};
+
+struct FusedProgram {
+    std::vector<FusedInstr> code;
+    std::size_t num_operands = 0;
+    std::size_t num_regs = 0;
+};
+
+// bounds on one fused group; registers live on the stack of every worker.
+constexpr std::size_t kFusedMaxRegs = 8;
+constexpr std::size_t kFusedMaxOps = 32;
+
+// out = program(operands): every operand is f32 and broadcasts to out's shape. out must not
+// overlap an operand except element for element (an input it is written over).
+void run_fused(const FusedProgram& program, const Tensor* const* operands, Tensor& out);
+
+// Rewrites rec.steps so each tree of f32 pointwise steps, whose intermediates have the
+// output's shape and are read once, by the next op of the tree, is one step running a
+// FusedProgram over the tree's leaves. The intermediates are then produced by no step.
+// Returns the number of steps folded away.
+std::size_t fuse_pointwise(TraceRecorder& rec);
+
+}  // namespace minidl::detail
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace minidl::kernels {
+
+// Cache blocking of the packed GEMM (BLIS loop order). A kKC-deep slice of B, kNC columns
+// wide, is packed once per (jc, pc) step and stays in L3; each thread packs the kMC rows of
+// A of the block it computes against it (a kMC x kKC buffer per thread), which stay in L2;
+// the micro-kernel streams one MR x kKC sliver of A and one kKC x NR sliver of B out of L1
+// into an MR x NR register tile of C.
+constexpr std::size_t kGemmKC = 256;
+constexpr std::size_t kGemmMC = 144;
+constexpr std::size_t kGemmNC = 4096;
+
+// c[i * ldc + j] (= or +=) sum_p a[p * mr + i] * b[p * nr + j] for a full mr x nr tile, with
+// a and b packed by the driver. `accumulate` adds to c instead of overwriting it.
+template <typename T>
+using GemmMicroFn = void (*)(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc, bool accumulate) noexcept;
+
+template <typename T>
+struct GemmMicroKernel {
+    std::size_t mr;
+    std::size_t nr;
+    GemmMicroFn<T> fn;
+};
+
+// c = a * b for an m x k `a` and a k x n `b` read through element strides (row, column), so
+// transposed and sliced views are packed directly. c is row-major with leading dim ldc.
+// Runs on the thread pool unless called from inside a parallel region.
+template <typename T>
+void gemm(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t rsa, std::size_t csa, const T* b,
+          std::size_t rsb, std::size_t csb, T* c, std::size_t ldc);
+
+// Widest micro-kernel the host supports (see detail::cpu_capability()).
+template <typename T>
+GemmMicroKernel<T> select_gemm_micro() noexcept;
+
+// Register tiles: 6x16 on AVX2 (12 ymm accumulators), 8x32 on AVX-512 (16 zmm), 8x8 on NEON.
+#if defined(MINIDL_HAVE_AVX2)
+namespace avx2 {
+template <typename T>
+GemmMicroKernel<T> gemm_micro() noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_AVX512)
+namespace avx512 {
+template <typename T>
+GemmMicroKernel<T> gemm_micro() noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_NEON)
+namespace neon {
+template <typename T>
+GemmMicroKernel<T> gemm_micro() noexcept;
+}
+#endif
+
+}  // namespace minidl::kernels
@@ -19,6 +19,8 @@ struct NdCounter {
     }
     bool done() const { return finished; }
     void next();
+    // jump to the row-major linear index `linear`.
+    void seek(std::size_t linear);
 };
 
 inline std::size_t offset_elems(const std::vector<std::size_t>& idx, const std::vector<std::size_t>& stride) {
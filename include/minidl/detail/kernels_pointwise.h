@@ -1,42 +1,134 @@
 #pragma once
+#include <algorithm>
+#include <cstddef>
 #include <vector>
 
-#include "minidl/detail/iter.h"
+#include "minidl/detail/convert.h"
+#include "minidl/detail/dispatch.h"
+#include "minidl/detail/kernels_simd.h"
+#include "minidl/detail/simd/vec_scalar.h"
+#include "minidl/detail/tensor_iterator.h"
 
 namespace minidl::kernels {
 
 template <typename T, class Op>
-inline void binary_contig(T* __restrict z, const T* __restrict x, const T* __restrict y, std::size_t n) noexcept {
+inline void binary_contig(typename Op::result_type* __restrict z, const T* __restrict x, const T* __restrict y,
+                          std::size_t n) noexcept {
     for (std::size_t i = 0; i < n; ++i) {
         z[i] = Op::apply(x[i], y[i]);
     }
 }
 
+// One run of a TensorIterator. Unit-stride runs go to the SIMD kernel, broadcast-scalar runs
+// get loops the compiler can vectorize.
 template <typename T, class Op>
-inline void binary_same_shape_strided(T* __restrict z, const T* __restrict x, const T* __restrict y,
-                                      const std::vector<std::size_t>& shape, const std::vector<std::size_t>& xs,
-                                      const std::vector<std::size_t>& ys) noexcept {
-    minidl::detail::NdCounter it(shape);
-    std::size_t zi = 0;
-    while (!it.done()) {
-        const auto xo = minidl::detail::offset_elems(it.idx, xs);
-        const auto yo = minidl::detail::offset_elems(it.idx, ys);
-        z[zi++] = Op::apply(x[xo], y[yo]);
-        it.next();
+inline void binary_strided_1d(typename Op::result_type* __restrict z, const T* __restrict x, const T* __restrict y,
+                              std::size_t n, std::size_t zs, std::size_t xs, std::size_t ys) noexcept {
+    if (zs == 1 && xs == 1 && ys == 1) {
+        binary_contig_dispatch<T, Op>(z, x, y, n);
+    } else if (zs == 1 && xs == 1 && ys == 0) {
+        const T b = *y;
+        for (std::size_t i = 0; i < n; ++i) z[i] = Op::apply(x[i], b);
+    } else if (zs == 1 && xs == 0 && ys == 1) {
+        const T a = *x;
+        for (std::size_t i = 0; i < n; ++i) z[i] = Op::apply(a, y[i]);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) z[i * zs] = Op::apply(x[i * xs], y[i * ys]);
     }
 }
 
+// Strided kernels cover the iteration range [begin, end) of a 3-operand iterator (z, x, y).
 template <typename T, class Op>
-inline void binary_broadcast(T* __restrict z, const T* __restrict x, const T* __restrict y,
-                             const std::vector<std::size_t>& out_shape, const std::vector<std::size_t>& xs,
-                             const std::vector<std::size_t>& ys) noexcept {
-    minidl::detail::NdCounter it(out_shape);
-    std::size_t zi = 0;
-    while (!it.done()) {
-        const auto xo = minidl::detail::offset_elems(it.idx, xs);
-        const auto yo = minidl::detail::offset_elems(it.idx, ys);
-        z[zi++] = Op::apply(x[xo], y[yo]);
-        it.next();
+inline void binary_same_shape_strided(typename Op::result_type* __restrict z, const T* __restrict x,
+                                      const T* __restrict y, const minidl::detail::TensorIterator& iter,
+                                      std::size_t begin, std::size_t end) noexcept {
+    iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t n) {
+        binary_strided_1d<T, Op>(z + off[0], x + off[1], y + off[2], n, st[0], st[1], st[2]);
+    });
+}
+
+template <typename T, class Op>
+inline void binary_broadcast(typename Op::result_type* __restrict z, const T* __restrict x, const T* __restrict y,
+                             const minidl::detail::TensorIterator& iter, std::size_t begin, std::size_t end) noexcept {
+    iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t n) {
+        binary_strided_1d<T, Op>(z + off[0], x + off[1], y + off[2], n, st[0], st[1], st[2]);
+    });
+}
+
+// Runs whose operands are not all of the compute type (mixed dtypes, f16 / bf16) go through
+// the compute type's kernels in blocks this size on the stack.
+constexpr std::size_t kConvertBlock = 256;
+
+// m elements of dtype dt at p (stride st, in elements) as C: p itself when it already is a
+// contiguous run of C, otherwise converted into buf.
+template <typename C>
+inline const C* load_block(C* buf, const std::byte* p, DType dt, std::size_t st, std::size_t m) {
+    constexpr DType c = minidl::detail::dtype_of_v<C>;
+    if (dt == c && st == 1) return reinterpret_cast<const C*>(p);
+    if (st == 0) {
+        convert_contig(buf, c, p, dt, 1);
+        std::fill_n(buf + 1, m - 1, buf[0]);
+    } else {
+        convert_strided(buf, c, 1, p, dt, st, m);
+    }
+    return buf;
+}
+
+// One run of a 3-operand iterator whose operands each keep their own dtype (zt, xt, yt;
+// strides in elements): each block of x and y is converted to C, goes through C's kernel,
+// and is converted to zt on store, so every operand is read or written once.
+template <typename C, class Op>
+inline void binary_convert_1d(std::byte* z, DType zt, const std::byte* x, DType xt, const std::byte* y, DType yt,
+                              std::size_t n, std::size_t zs, std::size_t xs, std::size_t ys) {
+    using R = typename Op::result_type;
+    constexpr DType r = minidl::detail::dtype_of_v<R>;
+    const std::size_t zi = size_of(zt), xi = size_of(xt), yi = size_of(yt);
+    const bool direct = zt == r && zs == 1;
+    C xb[kConvertBlock], yb[kConvertBlock];
+    R zb[kConvertBlock];
+    for (std::size_t i0 = 0; i0 < n; i0 += kConvertBlock) {
+        const std::size_t m = std::min(kConvertBlock, n - i0);
+        const C* xp = load_block(xb, x + i0 * xs * xi, xt, xs, m);
+        const C* yp = load_block(yb, y + i0 * ys * yi, yt, ys, m);
+        R* zp = direct ? reinterpret_cast<R*>(z + i0 * zi) : zb;
+        binary_contig_dispatch<C, Op>(zp, xp, yp, m);
+        if (!direct) convert_strided(z + i0 * zs * zi, zt, zs, zb, r, 1, m);
+    }
+}
+
+// Op's fast form on one element, through the one-lane simd::scalar::Vec so it matches the
+// vector kernels bit for bit.
+template <typename T, class Op>
+inline T unary_fast(T x) noexcept {
+    return Op::template vec<simd::scalar::Vec<T>>(simd::scalar::Vec<T>{x}).v;
+}
+
+template <typename T, class Op>
+inline void unary_contig(T* __restrict z, const T* __restrict x, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) z[i] = unary_fast<T, Op>(x[i]);
+}
+
+// Strided runs of the fast form are gathered into blocks this size on the stack and go
+// through the SIMD kernel too.
+constexpr std::size_t kUnaryBlock = 256;
+
+// One run of a 2-operand iterator (z, x). `fast` picks Op::vec through the SIMD kernel;
+// otherwise every element goes through the exact Op::apply.
+template <typename T, class Op>
+inline void unary_strided_1d(T* __restrict z, const T* __restrict x, std::size_t n, std::size_t zs,
+                             std::size_t xs, bool fast) noexcept {
+    if (fast && zs == 1 && xs == 1) {
+        unary_contig_dispatch<T, Op>(z, x, n);
+    } else if (fast) {
+        T in[kUnaryBlock], out[kUnaryBlock];
+        for (std::size_t i0 = 0; i0 < n; i0 += kUnaryBlock) {
+            const std::size_t m = std::min(kUnaryBlock, n - i0);
+            for (std::size_t i = 0; i < m; ++i) in[i] = x[(i0 + i) * xs];
+            unary_contig_dispatch<T, Op>(out, in, m);
+            for (std::size_t i = 0; i < m; ++i) z[(i0 + i) * zs] = out[i];
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) z[i * zs] = Op::apply(x[i * xs]);
     }
 }
-}  // namespace minidl::kernels
\ No newline at end of file
+}  // namespace minidl::kernels
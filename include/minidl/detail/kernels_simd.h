@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace minidl::kernels {
+
+// scalar kernel, defined in kernels_pointwise.h.
+template <typename T, class Op>
+inline void binary_contig(typename Op::result_type* z, const T* x, const T* y, std::size_t n) noexcept;
+template <typename T, class Op>
+inline void unary_contig(T* z, const T* x, std::size_t n) noexcept;
+
+// Functors with a vector form declare `static constexpr bool vectorizable = true`
+// and `template <class V> static V vec(V, V)`.
+template <class Op, class = void>
+struct is_vectorizable : std::false_type {};
+template <class Op>
+struct is_vectorizable<Op, std::enable_if_t<Op::vectorizable>> : std::true_type {};
+
+template <typename T, class Op>
+inline constexpr bool has_simd_binary_v =
+    (std::is_same_v<T, float> || std::is_same_v<T, std::int32_t>) && is_vectorizable<Op>::value;
+
+template <typename T, class Op>
+using BinaryContigFn = void (*)(typename Op::result_type*, const T*, const T*, std::size_t) noexcept;
+
+// One instantiation per ISA, each built in its own translation unit with that ISA's flags.
+// The whole op table is instantiated; the bodies are empty for ops without a vector form,
+// which select_binary_contig never returns.
+#if defined(MINIDL_HAVE_AVX2)
+namespace avx2 {
+template <typename T, class Op>
+void binary_contig(typename Op::result_type* z, const T* x, const T* y, std::size_t n) noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_AVX512)
+namespace avx512 {
+template <typename T, class Op>
+void binary_contig(typename Op::result_type* z, const T* x, const T* y, std::size_t n) noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_NEON)
+namespace neon {
+template <typename T, class Op>
+void binary_contig(typename Op::result_type* z, const T* x, const T* y, std::size_t n) noexcept;
+}
+#endif
+
+// Widest binary_contig the host supports (see detail::cpu_capability()); the scalar one for
+// ops without a vector form.
+template <typename T, class Op>
+BinaryContigFn<T, Op> select_binary_contig() noexcept;
+
+// Contiguous reductions: R is a reducer from detail/reduce_ops.h with a vector form.
+template <typename T, class R>
+using ReduceContigFn = T (*)(const T*, std::size_t) noexcept;
+
+#if defined(MINIDL_HAVE_AVX2)
+namespace avx2 {
+template <typename T, class R>
+T reduce_contig(const T* x, std::size_t n) noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_AVX512)
+namespace avx512 {
+template <typename T, class R>
+T reduce_contig(const T* x, std::size_t n) noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_NEON)
+namespace neon {
+template <typename T, class R>
+T reduce_contig(const T* x, std::size_t n) noexcept;
+}
+#endif
+
+// Widest reduce_contig the host supports; the scalar detail::reduce_contig otherwise.
+template <typename T, class R>
+ReduceContigFn<T, R> select_reduce_contig() noexcept;
+
+// Contiguous unary ops: Op is a functor from detail/unary_ops.h; the kernels run its fast
+// (Op::vec) form.
+template <typename T, class Op>
+using UnaryContigFn = void (*)(T*, const T*, std::size_t) noexcept;
+
+#if defined(MINIDL_HAVE_AVX2)
+namespace avx2 {
+template <typename T, class Op>
+void unary_contig(T* z, const T* x, std::size_t n) noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_AVX512)
+namespace avx512 {
+template <typename T, class Op>
+void unary_contig(T* z, const T* x, std::size_t n) noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_NEON)
+namespace neon {
+template <typename T, class Op>
+void unary_contig(T* z, const T* x, std::size_t n) noexcept;
+}
+#endif
+
+// Widest unary_contig the host supports; the scalar kernels::unary_contig otherwise.
+template <typename T, class Op>
+UnaryContigFn<T, Op> select_unary_contig() noexcept;
+
+template <typename T, class Op>
+inline void unary_contig_dispatch(T* z, const T* x, std::size_t n) noexcept {
+    static const UnaryContigFn<T, Op> fn = select_unary_contig<T, Op>();
+    fn(z, x, n);
+}
+
+// binary_contig through the runtime-selected kernel; scalar for ops without a vector form.
+template <typename T, class Op>
+inline void binary_contig_dispatch(typename Op::result_type* z, const T* x, const T* y, std::size_t n) noexcept {
+    if constexpr (has_simd_binary_v<T, Op>) {
+        static const BinaryContigFn<T, Op> fn = select_binary_contig<T, Op>();
+        fn(z, x, y, n);
+    } else {
+        binary_contig<T, Op>(z, x, y, n);
+    }
+}
+
+}  // namespace minidl::kernels
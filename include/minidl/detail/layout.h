@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -6,4 +7,38 @@ namespace minidl::detail {
 
 std::vector<std::size_t> default_strides(const std::vector<std::size_t>& /*shape*/);
 bool is_contiguous(const std::vector<std::size_t>& /*shape*/, const std::vector<std::size_t>& /*strides*/);
+// elements between the first and one past the last addressed element (0 if numel is 0).
+std::size_t extent_elems(const std::vector<std::size_t>& /*shape*/, const std::vector<std::size_t>& /*strides*/);
+// true if the product of the dims does not fit in size_t (never when a dim is 0).
+bool numel_overflows(const std::vector<std::size_t>& /*shape*/);
+// true if two distinct indices map to the same element (a stride 0 dim of size > 1).
+bool has_internal_overlap(const std::vector<std::size_t>& /*shape*/, const std::vector<std::size_t>& /*strides*/);
+
+// element offset of the row-major linear index `linear` over (sizes, strides).
+inline std::size_t linear_offset(std::size_t linear, const std::vector<std::size_t>& sizes,
+                                 const std::vector<std::size_t>& strides) noexcept {
+    if (sizes.size() == 1) return linear * strides[0];
+    std::size_t off = 0;
+    for (std::size_t d = sizes.size(); d-- > 0;) {
+        off += (linear % sizes[d]) * strides[d];
+        linear /= sizes[d];
+    }
+    return off;
+}
+
+// Dims of a strided tensor split into the kept (outer) and reduced (inner) groups of a
+// reduction. Each group keeps logical order, drops size-1 dims and merges neighbours that
+// are contiguous with each other, so row-major linear indices within a group are preserved.
+// A group with no dims is {size 1, stride 0}.
+struct ReduceLayout {
+    std::vector<std::size_t> out_shape;  // with keepdim applied
+    std::vector<std::size_t> outer_sizes, outer_strides;
+    std::vector<std::size_t> inner_sizes, inner_strides;
+    std::size_t outer_numel = 1;
+    std::size_t inner_numel = 1;
+};
+
+// `axes` empty reduces every dim; duplicate or out-of-range axes throw.
+ReduceLayout reduce_layout(const std::vector<std::size_t>& /*shape*/, const std::vector<std::size_t>& /*strides*/,
+                           const std::vector<std::size_t>& /*axes*/, bool /*keepdim*/);
 }  // namespace minidl::detail
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "minidl/detail/broadcasting.h"
+#include "minidl/detail/gemm.h"
+#include "minidl/detail/layout.h"
+#include "minidl/detail/overlap.h"
+#include "minidl/detail/parallel.h"
+#include "minidl/tensor.h"
+
+namespace minidl::detail {
+
+// Shapes of a [..., M, K] x [..., K, N] product; the batch dims broadcast.
+struct MatmulShape {
+    std::vector<std::size_t> batch;  // broadcast batch dims
+    std::vector<std::size_t> out;    // batch + {M, N}
+    std::size_t m, n, k;
+};
+
+inline MatmulShape matmul_shape(const Tensor& a, const Tensor& b) {
+    const auto& sa = a.shape().dims();
+    const auto& sb = b.shape().dims();
+    if (a.dtype() != b.dtype()) throw std::runtime_error("matmul: dtype mismatch.");
+    if (sa.size() < 2 || sb.size() < 2) throw std::runtime_error("matmul: operands must have at least 2 dims.");
+    if (sa[sa.size() - 1] != sb[sb.size() - 2]) throw std::runtime_error("matmul: inner dimensions do not match.");
+
+    MatmulShape s;
+    s.m = sa[sa.size() - 2];
+    s.k = sa[sa.size() - 1];
+    s.n = sb[sb.size() - 1];
+    s.batch = compute_broadcast_shape({sa.begin(), sa.end() - 2}, {sb.begin(), sb.end() - 2});
+    s.out = s.batch;
+    s.out.push_back(s.m);
+    s.out.push_back(s.n);
+    return s;
+}
+
+// Batch strides of t (rank >= 2) broadcast to `batch`.
+inline std::vector<std::size_t> matmul_batch_strides(const Tensor& t, const std::vector<std::size_t>& batch) {
+    const auto& shape = t.shape().dims();
+    const auto& strides = t.strides();
+    return expand_strides_for_broadcast({shape.begin(), shape.end() - 2}, {strides.begin(), strides.end() - 2},
+                                        batch);
+}
+
+// out = a @ b per batch element. out's last dim must be unit stride and must not overlap a or b.
+// Many small matrices are spread across threads one matrix each; otherwise each product is
+// parallel inside gemm.
+template <typename T>
+void matmul_kernel(const Tensor& a, const Tensor& b, const MatmulShape& s, Tensor& out) {
+    const std::size_t r = s.out.size();
+    const std::size_t ra = a.shape().dims().size();
+    const std::size_t rb = b.shape().dims().size();
+    const auto a_bs = matmul_batch_strides(a, s.batch);
+    const auto b_bs = matmul_batch_strides(b, s.batch);
+    const std::vector<std::size_t> out_bs(out.strides().begin(), out.strides().end() - 2);
+
+    const std::size_t rsa = a.strides()[ra - 2], csa = a.strides()[ra - 1];
+    const std::size_t rsb = b.strides()[rb - 2], csb = b.strides()[rb - 1];
+    const std::size_t ldc = out.strides()[r - 2];
+
+    std::size_t batch = 1;
+    for (auto d : s.batch) batch *= d;
+    if (batch == 0 || out.numel() == 0) return;
+
+    const T* pa = static_cast<const T*>(a.data());
+    const T* pb = static_cast<const T*>(b.data());
+    T* pc = static_cast<T*>(out.data());
+
+    const auto one = [&](std::size_t i) {
+        const T* ai = s.batch.empty() ? pa : pa + linear_offset(i, s.batch, a_bs);
+        const T* bi = s.batch.empty() ? pb : pb + linear_offset(i, s.batch, b_bs);
+        T* ci = s.batch.empty() ? pc : pc + linear_offset(i, s.batch, out_bs);
+        kernels::gemm<T>(s.m, s.n, s.k, ai, rsa, csa, bi, rsb, csb, ci, ldc);
+    };
+
+    // one matrix per task once there are enough of them, or when each is too small to split.
+    const std::size_t flops = s.m * s.n * s.k;
+    if (batch >= get_num_threads() || flops < kGrainSize * 16) {
+        parallel_for(0, batch, std::max<std::size_t>(1, kGrainSize * 16 / std::max<std::size_t>(flops, 1)),
+                     [&](std::size_t begin, std::size_t end) {
+                         for (std::size_t i = begin; i < end; ++i) one(i);
+                     });
+    } else {
+        for (std::size_t i = 0; i < batch; ++i) one(i);
+    }
+}
+
+template <typename T>
+Tensor matmul_impl(const Tensor& a, const Tensor& b) {
+    const MatmulShape s = matmul_shape(a, b);
+    Tensor out = Tensor::empty(Shape(s.out), a.dtype(), a.storage()->alloc_);
+    matmul_kernel<T>(a, b, s, out);
+    return out;
+}
+
+template <typename T>
+Tensor& matmul_out_impl(const Tensor& a, const Tensor& b, Tensor& out) {
+    const MatmulShape s = matmul_shape(a, b);
+    if (out.dtype() != a.dtype()) throw std::runtime_error("matmul: out dtype mismatch.");
+    if (out.shape().dims() != s.out) throw std::runtime_error("matmul: out has the wrong shape.");
+    if (has_internal_overlap(s.out, out.strides())) {
+        throw std::runtime_error("matmul: out must not have overlapping elements.");
+    }
+
+    // gemm reads every input element many times and writes rows of out: any overlap with
+    // the inputs, or columns that are not unit stride, go through a temporary.
+    const bool unit_cols = s.n <= 1 || out.strides().back() == 1;
+    if (!unit_cols || may_overlap(a, out) || may_overlap(b, out)) {
+        out.copy_(matmul_impl<T>(a, b));
+        return out;
+    }
+    matmul_kernel<T>(a, b, s, out);
+    return out;
+}
+
+}  // namespace minidl::detail
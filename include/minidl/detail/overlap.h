@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+
+#include "minidl/detail/broadcasting.h"
+#include "minidl/detail/layout.h"
+#include "minidl/tensor.h"
+
+namespace minidl::detail {
+
+// true if the memory ranges spanned by a and b intersect.
+inline bool may_overlap(const Tensor& a, const Tensor& b) {
+    if (a.numel() == 0 || b.numel() == 0) return false;
+    const auto* pa = static_cast<const std::byte*>(a.data());
+    const auto* pb = static_cast<const std::byte*>(b.data());
+    const auto* ea = pa + extent_elems(a.shape().dims(), a.strides()) * a.itemsize();
+    const auto* eb = pb + extent_elems(b.shape().dims(), b.strides()) * b.itemsize();
+    return pa < eb && pb < ea;
+}
+
+// Reading `in` (broadcast to out's shape) while writing `out` is safe if they do not overlap,
+// or if every output element is computed from the input element at the same address.
+inline bool safe_to_alias(const Tensor& in, const Tensor& out) {
+    if (!may_overlap(in, out)) return true;
+    if (in.data() != out.data()) return false;
+
+    const auto& out_shape = out.shape().dims();
+    const auto in_strides = expand_strides_for_broadcast(in.shape().dims(), in.strides(), out_shape);
+    for (std::size_t d = 0; d < out_shape.size(); ++d) {
+        if (out_shape[d] > 1 && in_strides[d] != out.strides()[d]) return false;
+    }
+    return true;
+}
+
+}  // namespace minidl::detail
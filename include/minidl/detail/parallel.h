@@ -0,0 +1,52 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+
+#include "minidl/detail/thread_pool.h"
+#include "minidl/parallel.h"
+
+namespace minidl::detail {
+
+// Elements per chunk: ~128KB of f32 per operand, so the working set of a binary op stays in L2.
+// Ranges at or below one chunk run serially on the calling thread.
+constexpr std::size_t kGrainSize = 32768;
+
+// Calls fn(chunk_begin, chunk_end) over [begin, end) in chunks of `grain` elements.
+// Chunks are split statically into contiguous blocks, one per thread, so the same
+// range of a tensor is always processed by the same thread.
+template <class Fn>
+void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, const Fn& fn) {
+    if (begin >= end) return;
+    if (grain == 0) grain = 1;
+
+    const std::size_t n = end - begin;
+    const std::size_t num_threads = get_num_threads();
+    if (num_threads <= 1 || n <= grain || in_parallel_region()) {
+        fn(begin, end);
+        return;
+    }
+
+    const std::size_t num_chunks = (n + grain - 1) / grain;
+    const std::size_t num_tasks = std::min(num_threads, num_chunks);
+
+    struct Ctx {
+        const Fn* fn;
+        std::size_t begin, end, grain, num_chunks, num_tasks;
+    } ctx{&fn, begin, end, grain, num_chunks, num_tasks};
+
+    get_thread_pool().run(
+        num_tasks,
+        [](void* p, std::size_t t) {
+            const auto& c = *static_cast<const Ctx*>(p);
+            const std::size_t first = t * c.num_chunks / c.num_tasks;
+            const std::size_t last = (t + 1) * c.num_chunks / c.num_tasks;
+            for (std::size_t ch = first; ch < last; ++ch) {
+                const std::size_t b = c.begin + ch * c.grain;
+                const std::size_t e = std::min(c.end, b + c.grain);
+                (*c.fn)(b, e);
+            }
+        },
+        &ctx);
+}
+
+}  // namespace minidl::detail
@@ -0,0 +1,361 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "minidl/detail/kernels_simd.h"
+#include "minidl/detail/layout.h"
+#include "minidl/detail/parallel.h"
+#include "minidl/tensor.h"
+
+namespace minidl::detail {
+
+// Reduction functors: `identity()` and an associative `op`. Results are combined in a
+// pairwise tree, so f32 sums keep O(log n) rounding error instead of O(n). `vec` is `op`
+// on an ISA vector type (see detail/simd/).
+template <typename T>
+struct SumReduce {
+    static constexpr bool vectorizable = true;
+    static constexpr T identity() noexcept { return T(0); }
+    static inline T op(T a, T b) noexcept { return a + b; }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return a + b;
+    }
+};
+
+template <typename T>
+struct ProdReduce {
+    static constexpr bool vectorizable = true;
+    static constexpr T identity() noexcept { return T(1); }
+    static inline T op(T a, T b) noexcept { return a * b; }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return a * b;
+    }
+};
+
+// NaNs are not propagated: a comparison with NaN keeps the current value.
+template <typename T>
+struct MaxReduce {
+    static constexpr bool vectorizable = true;
+    static constexpr T identity() noexcept {
+        if constexpr (std::numeric_limits<T>::has_infinity) return -std::numeric_limits<T>::infinity();
+        return std::numeric_limits<T>::lowest();
+    }
+    static inline T op(T a, T b) noexcept { return b > a ? b : a; }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return max(a, b);
+    }
+};
+
+template <typename T>
+struct MinReduce {
+    static constexpr bool vectorizable = true;
+    static constexpr T identity() noexcept {
+        if constexpr (std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+        return std::numeric_limits<T>::max();
+    }
+    static inline T op(T a, T b) noexcept { return b < a ? b : a; }
+    template <class V>
+    static inline V vec(V a, V b) noexcept {
+        return min(a, b);
+    }
+};
+
+// Independent accumulator lanes per run: breaks the serial dependency so the compiler can
+// vectorize, and is the leaf level of the pairwise tree.
+constexpr std::size_t kReduceLanes = 16;
+// Runs up to this length are reduced with one set of lanes; longer runs are split in halves.
+constexpr std::size_t kReduceLeaf = 512;
+// Shorter unit-stride runs stay on the inlined scalar loop; the vector kernels are an
+// indirect call plus a lane tree, which does not pay off for a handful of elements.
+constexpr std::size_t kReduceMinVector = 64;
+// Outputs per block of the vertical (outer-dim) kernel.
+constexpr std::size_t kReduceBlock = 1024;
+
+template <typename T, class R>
+T reduce_run(const T* x, std::size_t n, std::size_t stride) noexcept {
+    if (n > kReduceLeaf) {
+        const std::size_t half = (n / 2 + kReduceLanes - 1) / kReduceLanes * kReduceLanes;
+        return R::op(reduce_run<T, R>(x, half, stride), reduce_run<T, R>(x + half * stride, n - half, stride));
+    }
+
+    T acc[kReduceLanes];
+    for (auto& a : acc) a = R::identity();
+    std::size_t i = 0;
+    if (stride == 1) {
+        for (; i + kReduceLanes <= n; i += kReduceLanes) {
+            for (std::size_t k = 0; k < kReduceLanes; ++k) acc[k] = R::op(acc[k], x[i + k]);
+        }
+    } else {
+        for (; i + kReduceLanes <= n; i += kReduceLanes) {
+            for (std::size_t k = 0; k < kReduceLanes; ++k) acc[k] = R::op(acc[k], x[(i + k) * stride]);
+        }
+    }
+    T tail = R::identity();
+    for (; i < n; ++i) tail = R::op(tail, x[i * stride]);
+
+    for (std::size_t w = kReduceLanes / 2; w > 0; w /= 2) {
+        for (std::size_t k = 0; k < w; ++k) acc[k] = R::op(acc[k], acc[k + w]);
+    }
+    return R::op(acc[0], tail);
+}
+
+// scalar contiguous kernel; the vector ones are picked by reduce_contig_dispatch.
+template <typename T, class R>
+T reduce_contig(const T* x, std::size_t n) noexcept {
+    return reduce_run<T, R>(x, n, 1);
+}
+
+template <typename T, class R>
+inline T reduce_contig_dispatch(const T* x, std::size_t n) noexcept {
+    if constexpr (kernels::is_vectorizable<R>::value) {
+        static const kernels::ReduceContigFn<T, R> fn = kernels::select_reduce_contig<T, R>();
+        return fn(x, n);
+    } else {
+        return reduce_contig<T, R>(x, n);
+    }
+}
+
+// Reduces the reduced-group elements [a, b) of one output, whose first element is x.
+// Ranges inside one innermost run are a single reduce_run; longer ones split in halves.
+template <typename T, class R>
+T reduce_linear(const T* x, const ReduceLayout& l, std::size_t a, std::size_t b) noexcept {
+    if (a >= b) return R::identity();
+    const std::size_t n_last = l.inner_sizes.back();
+    const std::size_t row = a / n_last;
+    if (row == (b - 1) / n_last) {
+        const std::size_t s_last = l.inner_strides.back();
+        const T* p = x + linear_offset(a, l.inner_sizes, l.inner_strides);
+        if (s_last == 1 && b - a >= kReduceMinVector) return reduce_contig_dispatch<T, R>(p, b - a);
+        return reduce_run<T, R>(p, b - a, s_last);
+    }
+    // split on a row boundary when one is close to the middle, to keep leaves whole runs.
+    std::size_t mid = a + (b - a) / 2;
+    if (b - a >= 2 * n_last) mid = mid / n_last * n_last;
+    return R::op(reduce_linear<T, R>(x, l, a, mid), reduce_linear<T, R>(x, l, mid, b));
+}
+
+// acc[j] = op(acc[j], rows [r0, r1) of column j) for w adjacent outputs `os` elements apart.
+// Used when the outputs are closer together in memory than the reduced elements, so each
+// row of the block is read as one short run instead of w long strided walks.
+template <typename T, class R>
+void reduce_vertical(T* acc, const T* x, std::size_t w, std::size_t os, const ReduceLayout& l, std::size_t r0,
+                     std::size_t r1) noexcept {
+    constexpr std::size_t kLeafRows = 8;
+    if (r1 - r0 > kLeafRows) {
+        const std::size_t mid = r0 + (r1 - r0) / 2;
+        T right[kReduceBlock];
+        for (std::size_t j = 0; j < w; ++j) right[j] = R::identity();
+        reduce_vertical<T, R>(acc, x, w, os, l, r0, mid);
+        reduce_vertical<T, R>(right, x, w, os, l, mid, r1);
+        for (std::size_t j = 0; j < w; ++j) acc[j] = R::op(acc[j], right[j]);
+        return;
+    }
+    std::size_t r = r0;
+    if (os == 1) {
+        // four rows per pass over acc: one load and store of acc per four input rows.
+        for (; r + 4 <= r1; r += 4) {
+            const T* p0 = x + linear_offset(r, l.inner_sizes, l.inner_strides);
+            const T* p1 = x + linear_offset(r + 1, l.inner_sizes, l.inner_strides);
+            const T* p2 = x + linear_offset(r + 2, l.inner_sizes, l.inner_strides);
+            const T* p3 = x + linear_offset(r + 3, l.inner_sizes, l.inner_strides);
+            for (std::size_t j = 0; j < w; ++j) acc[j] = R::op(acc[j], R::op(R::op(p0[j], p1[j]), R::op(p2[j], p3[j])));
+        }
+    }
+    for (; r < r1; ++r) {
+        const T* p = x + linear_offset(r, l.inner_sizes, l.inner_strides);
+        if (os == 1) {
+            for (std::size_t j = 0; j < w; ++j) acc[j] = R::op(acc[j], p[j]);
+        } else {
+            for (std::size_t j = 0; j < w; ++j) acc[j] = R::op(acc[j], p[j * os]);
+        }
+    }
+}
+
+// Splits [0, n) into `parts` near-equal ranges.
+inline std::size_t split_point(std::size_t n, std::size_t parts, std::size_t i) noexcept { return n * i / parts; }
+
+// Number of pieces to cut each output's reduced range into: 1 unless there are fewer
+// independent work units than threads and enough elements per unit to be worth a split.
+inline std::size_t reduce_chunks(std::size_t units, std::size_t elems_per_unit) {
+    const std::size_t threads = get_num_threads();
+    if (units >= threads || elems_per_unit < 2 * kGrainSize || in_parallel_region()) return 1;
+    return std::min(threads, elems_per_unit / kGrainSize);
+}
+
+// Reduces `x` with R into `out`, a contiguous tensor of shape l.out_shape.
+//  - vertical kernel: the innermost kept dim is closer in memory than the innermost reduced
+//    one (e.g. sum over axis 0 of a row-major matrix); blocks of kReduceBlock outputs
+//    accumulate row after row.
+//  - otherwise each output reduces its own runs along the innermost reduced dim.
+// Outputs are split across threads; when there are fewer outputs than threads the reduced
+// range itself is split, and the per-chunk partials are combined in a second pass.
+template <typename T, class R>
+void reduce_kernel(const Tensor& x, const ReduceLayout& l, Tensor& out) {
+    if (l.outer_numel == 0) return;
+    const T* in = static_cast<const T*>(x.data());
+    T* o = static_cast<T*>(out.data());
+    const std::size_t inner = l.inner_numel;
+
+    const std::size_t last = l.outer_sizes.back();
+    const std::size_t os = l.outer_strides.back();
+    const bool inner_contig = l.inner_sizes.back() > 1 && l.inner_strides.back() == 1;
+    const bool vertical = !inner_contig && last > 1 && (l.inner_sizes.back() == 1 || os < l.inner_strides.back());
+
+    if (vertical) {
+        // units: (kept prefix, block of the innermost kept dim) x row chunk
+        const std::size_t blocks = (last + kReduceBlock - 1) / kReduceBlock;
+        const std::size_t units = l.outer_numel / last * blocks;
+        const std::size_t chunks = reduce_chunks(units, inner * std::min(kReduceBlock, last));
+        std::vector<T> partial(chunks > 1 ? units * chunks * kReduceBlock : 0);
+
+        const std::size_t grain = std::max<std::size_t>(1, kGrainSize / std::max<std::size_t>(inner * kReduceBlock, 1));
+        parallel_for(0, units * chunks, grain, [&](std::size_t begin, std::size_t end) {
+            T acc[kReduceBlock];
+            for (std::size_t u = begin; u < end; ++u) {
+                const std::size_t unit = u / chunks;
+                const std::size_t c = u % chunks;
+                const std::size_t j0 = unit % blocks * kReduceBlock;
+                const std::size_t w = std::min(kReduceBlock, last - j0);
+                const std::size_t out_index = unit / blocks * last + j0;
+                const T* base = in + linear_offset(out_index, l.outer_sizes, l.outer_strides);
+                for (std::size_t j = 0; j < w; ++j) acc[j] = R::identity();
+                reduce_vertical<T, R>(acc, base, w, os, l, split_point(inner, chunks, c),
+                                      split_point(inner, chunks, c + 1));
+                T* dst = chunks > 1 ? partial.data() + u * kReduceBlock : o + out_index;
+                std::copy(acc, acc + w, dst);
+            }
+        });
+
+        if (chunks > 1) {
+            for (std::size_t unit = 0; unit < units; ++unit) {
+                const std::size_t j0 = unit % blocks * kReduceBlock;
+                const std::size_t w = std::min(kReduceBlock, last - j0);
+                T* dst = o + unit / blocks * last + j0;
+                for (std::size_t j = 0; j < w; ++j) {
+                    T v = R::identity();
+                    for (std::size_t c = 0; c < chunks; ++c) {
+                        v = R::op(v, partial[(unit * chunks + c) * kReduceBlock + j]);
+                    }
+                    dst[j] = v;
+                }
+            }
+        }
+        return;
+    }
+
+    const std::size_t chunks = reduce_chunks(l.outer_numel, inner);
+    if (chunks > 1) {
+        std::vector<T> partial(l.outer_numel * chunks);
+        parallel_for(0, l.outer_numel * chunks, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t u = begin; u < end; ++u) {
+                const std::size_t oi = u / chunks;
+                const std::size_t c = u % chunks;
+                const T* base = in + linear_offset(oi, l.outer_sizes, l.outer_strides);
+                partial[u] =
+                    reduce_linear<T, R>(base, l, split_point(inner, chunks, c), split_point(inner, chunks, c + 1));
+            }
+        });
+        for (std::size_t oi = 0; oi < l.outer_numel; ++oi) {
+            o[oi] = reduce_run<T, R>(partial.data() + oi * chunks, chunks, 1);
+        }
+        return;
+    }
+
+    parallel_for(0, l.outer_numel, std::max<std::size_t>(1, kGrainSize / std::max<std::size_t>(inner, 1)),
+                 [&](std::size_t begin, std::size_t end) {
+                     for (std::size_t oi = begin; oi < end; ++oi) {
+                         const T* base = in + linear_offset(oi, l.outer_sizes, l.outer_strides);
+                         o[oi] = reduce_linear<T, R>(base, l, 0, inner);
+                     }
+                 });
+}
+
+template <typename T, class R>
+Tensor reduce_impl(const Tensor& x, const std::vector<std::size_t>& axes, bool keepdim, const char* name) {
+    const ReduceLayout l = reduce_layout(x.shape().dims(), x.strides(), axes, keepdim);
+    if (l.inner_numel == 0 && l.outer_numel != 0 && !std::is_same_v<R, SumReduce<T>> &&
+        !std::is_same_v<R, ProdReduce<T>>) {
+        throw std::runtime_error(std::string(name) + ": reduction over an empty dimension.");
+    }
+    Tensor out = Tensor::empty(Shape(l.out_shape), x.dtype(), x.storage()->alloc_);
+    reduce_kernel<T, R>(x, l, out);
+    return out;
+}
+
+// First index of the largest value along the reduced dims, as a row-major index into them.
+template <typename T>
+struct ArgMax {
+    T value;
+    std::size_t index;
+};
+
+template <typename T>
+inline void argmax_merge(ArgMax<T>& a, const ArgMax<T>& b) noexcept {
+    // b covers later indices: it wins only on a strictly larger value.
+    if (b.value > a.value) a = b;
+}
+
+template <typename T>
+ArgMax<T> argmax_linear(const T* x, const ReduceLayout& l, std::size_t a, std::size_t b) noexcept {
+    ArgMax<T> best{MaxReduce<T>::identity(), a};
+    const std::size_t n_last = l.inner_sizes.back();
+    const std::size_t s_last = l.inner_strides.back();
+    while (a < b) {
+        const std::size_t col = a % n_last;
+        const std::size_t len = std::min(n_last - col, b - a);
+        const T* p = x + linear_offset(a, l.inner_sizes, l.inner_strides);
+        for (std::size_t i = 0; i < len; ++i) {
+            if (p[i * s_last] > best.value) best = {p[i * s_last], a + i};
+        }
+        a += len;
+    }
+    return best;
+}
+
+template <typename T>
+void argmax_kernel(const Tensor& x, const ReduceLayout& l, Tensor& out) {
+    if (l.outer_numel == 0) return;
+    const T* in = static_cast<const T*>(x.data());
+    auto* o = static_cast<std::int32_t*>(out.data());
+    const std::size_t inner = l.inner_numel;
+    const std::size_t chunks = reduce_chunks(l.outer_numel, inner);
+    std::vector<ArgMax<T>> partial(l.outer_numel * chunks);
+    parallel_for(0, l.outer_numel * chunks, std::max<std::size_t>(1, kGrainSize / std::max<std::size_t>(inner, 1)),
+                 [&](std::size_t begin, std::size_t end) {
+                     for (std::size_t u = begin; u < end; ++u) {
+                         const T* base = in + linear_offset(u / chunks, l.outer_sizes, l.outer_strides);
+                         partial[u] = argmax_linear(base, l, split_point(inner, chunks, u % chunks),
+                                                    split_point(inner, chunks, u % chunks + 1));
+                     }
+                 });
+    for (std::size_t oi = 0; oi < l.outer_numel; ++oi) {
+        ArgMax<T> best = partial[oi * chunks];
+        for (std::size_t c = 1; c < chunks; ++c) argmax_merge(best, partial[oi * chunks + c]);
+        o[oi] = static_cast<std::int32_t>(best.index);
+    }
+}
+
+template <typename T>
+Tensor argmax_impl(const Tensor& x, const std::vector<std::size_t>& axes, bool keepdim) {
+    const ReduceLayout l = reduce_layout(x.shape().dims(), x.strides(), axes, keepdim);
+    if (l.inner_numel == 0 && l.outer_numel != 0) {
+        throw std::runtime_error("argmax: reduction over an empty dimension.");
+    }
+    if (l.inner_numel > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+        throw std::runtime_error("argmax: index does not fit in i32.");
+    }
+    Tensor out = Tensor::empty(Shape(l.out_shape), DType::i32, x.storage()->alloc_);
+    argmax_kernel<T>(x, l, out);
+    return out;
+}
+
+}  // namespace minidl::detail
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace minidl::simd {
+
+// Every call in this file is either on V or on Op::vec<V>, both unique to one ISA, so no
+// inline function gets compiled with wider ISA flags and then picked by the linker for
+// baseline callers.
+
+// n < V::size elements, through padded buffers so they also run on vector code.
+template <class V, class Op>
+inline void binary_partial_vec(typename V::value_type* z, const typename V::value_type* x,
+                               const typename V::value_type* y, std::size_t n) noexcept {
+    using T = typename V::value_type;
+    T xb[V::size] = {}, yb[V::size] = {}, zb[V::size];
+    std::memcpy(xb, x, n * sizeof(T));
+    std::memcpy(yb, y, n * sizeof(T));
+    Op::template vec<V>(V::load(xb), V::load(yb)).store(zb);
+    std::memcpy(z, zb, n * sizeof(T));
+}
+
+// Full vectors with aligned stores; loads are aligned when AlignedLoads.
+template <class V, class Op, bool AlignedLoads>
+inline std::size_t binary_body_vec(typename V::value_type* __restrict z, const typename V::value_type* __restrict x,
+                                   const typename V::value_type* __restrict y, std::size_t n) noexcept {
+    constexpr std::size_t L = V::size;
+    const auto load = [](const typename V::value_type* p) { return AlignedLoads ? V::load_aligned(p) : V::load(p); };
+
+    std::size_t i = 0;
+    for (; i + 2 * L <= n; i += 2 * L) {
+        const V a0 = load(x + i), a1 = load(x + i + L);
+        const V b0 = load(y + i), b1 = load(y + i + L);
+        Op::template vec<V>(a0, b0).store_aligned(z + i);
+        Op::template vec<V>(a1, b1).store_aligned(z + i + L);
+    }
+    for (; i + L <= n; i += L) {
+        Op::template vec<V>(load(x + i), load(y + i)).store_aligned(z + i);
+    }
+    return i;
+}
+
+// Contiguous binary loop over an ISA vector type V. Peels up to one vector so that the
+// stores are aligned, and takes the all-aligned path when x and y line up with z too
+// (the common case for 64-byte aligned tensors).
+template <class V, class Op>
+inline void binary_contig_vec(typename V::value_type* __restrict z, const typename V::value_type* __restrict x,
+                              const typename V::value_type* __restrict y, std::size_t n) noexcept {
+    using T = typename V::value_type;
+    constexpr std::size_t kBytes = V::size * sizeof(T);
+
+    const auto misalign = [](const void* p) { return reinterpret_cast<std::uintptr_t>(p) % kBytes; };
+
+    std::size_t head = 0;
+    if (misalign(z) % sizeof(T) == 0 && misalign(z) != 0) head = (kBytes - misalign(z)) / sizeof(T);
+    if (misalign(z) % sizeof(T) != 0) {
+        // not even element aligned; plain unaligned loop.
+        std::size_t i = 0;
+        for (; i + V::size <= n; i += V::size) Op::template vec<V>(V::load(x + i), V::load(y + i)).store(z + i);
+        if (i < n) binary_partial_vec<V, Op>(z + i, x + i, y + i, n - i);
+        return;
+    }
+    if (head > n) head = n;
+    if (head) binary_partial_vec<V, Op>(z, x, y, head);
+
+    z += head;
+    x += head;
+    y += head;
+    n -= head;
+
+    std::size_t done;
+    if (misalign(x) == 0 && misalign(y) == 0) {
+        done = binary_body_vec<V, Op, true>(z, x, y, n);
+    } else {
+        done = binary_body_vec<V, Op, false>(z, x, y, n);
+    }
+    if (done < n) binary_partial_vec<V, Op>(z + done, x + done, y + done, n - done);
+}
+
+}  // namespace minidl::simd
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+
+namespace minidl::simd {
+
+// GEMM micro-kernel over an ISA vector type V: an MR x (NV * V::size) tile of C held in
+// MR * NV vector registers. Each step of k loads NV vectors of packed B, broadcasts MR
+// values of packed A and issues MR * NV multiply-adds. Like binary_contig_vec.h, only V
+// operations are called, so nothing here is emitted with one ISA's flags for another's callers.
+template <class V, std::size_t MR, std::size_t NV>
+inline void gemm_micro_vec(std::size_t kc, const typename V::value_type* a, const typename V::value_type* b,
+                           typename V::value_type* c, std::size_t ldc, bool accumulate) noexcept {
+    using T = typename V::value_type;
+    constexpr std::size_t L = V::size;
+    constexpr std::size_t NR = NV * L;
+
+    V acc[MR][NV];
+    for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t j = 0; j < NV; ++j) acc[i][j] = V::broadcast(T(0));
+    }
+
+    for (std::size_t p = 0; p < kc; ++p) {
+        V bv[NV];
+        for (std::size_t j = 0; j < NV; ++j) bv[j] = V::load(b + j * L);
+        for (std::size_t i = 0; i < MR; ++i) {
+            const V ai = V::broadcast(a[i]);
+            for (std::size_t j = 0; j < NV; ++j) acc[i][j] = fmadd(ai, bv[j], acc[i][j]);
+        }
+        a += MR;
+        b += NR;
+    }
+
+    for (std::size_t i = 0; i < MR; ++i) {
+        T* ci = c + i * ldc;
+        for (std::size_t j = 0; j < NV; ++j) {
+            V r = acc[i][j];
+            if (accumulate) r = r + V::load(ci + j * L);
+            r.store(ci + j * L);
+        }
+    }
+}
+
+}  // namespace minidl::simd
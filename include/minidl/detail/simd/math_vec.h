@@ -0,0 +1,174 @@
+#pragma once
+#include <limits>
+
+namespace minidl::simd {
+
+// f32 transcendental approximations over a vector type V: an ISA Vec, or simd::scalar::Vec
+// for single elements. Only V operations are called, as in binary_contig_vec.h.
+//
+// Max error against a double-precision reference, measured on every 257th float of the
+// range (tests/unary_test.cpp rechecks a sample):
+//   exp_vec      2 ulp   results below FLT_MIN (x < -87.34) flush to 0
+//   log_vec      1 ulp   every positive float, denormals included
+//   tanh_vec     6 ulp
+//   sigmoid_vec  4 ulp   for x >= -87; below that the result flushes to 0
+//   erf_vec      6 ulp
+//   gelu_vec     8 ulp   for x >= -1; below, 1 + erf cancels and the bound is 2e-6 absolute
+// NaN in gives NaN out; overflow and poles give the IEEE infinities.
+
+// Constants folded at compile time: calling numeric_limits from the templates would emit
+// its members out of line (at -O0) with the including TU's ISA flags.
+constexpr float kMathInf = std::numeric_limits<float>::infinity();
+constexpr float kMathNaN = std::numeric_limits<float>::quiet_NaN();
+constexpr float kMathMinNormal = std::numeric_limits<float>::min();
+constexpr float kMathMax = std::numeric_limits<float>::max();
+constexpr float kMathDenormMin = std::numeric_limits<float>::denorm_min();
+
+// Cephes expf: x = n ln2 + r with |r| <= ln2 / 2, exp(r) from a degree-6 polynomial, and
+// 2^n written straight into the exponent bits.
+template <class V>
+inline V exp_vec(V x) noexcept {
+    const V hi = V::broadcast(88.72283935546875f);   // just above ln(FLT_MAX)
+    const V lo = V::broadcast(-87.33654022216797f);  // ln(FLT_MIN)
+    const V one = V::broadcast(1.0f);
+    // the clamp also maps NaN to lo, so n below stays a finite integer.
+    const V c = min(max(lo, x), hi);
+
+    // ln2 = 0.693359375 - 2.12194440e-4, the first part short enough that n * it is exact.
+    const V n = round(c * V::broadcast(1.44269504088896341f));
+    V r = fmadd(n, V::broadcast(-0.693359375f), c);
+    r = fmadd(n, V::broadcast(2.12194440e-4f), r);
+
+    V p = V::broadcast(1.9875691500e-4f);
+    p = fmadd(p, r, V::broadcast(1.3981999507e-3f));
+    p = fmadd(p, r, V::broadcast(8.3334519073e-3f));
+    p = fmadd(p, r, V::broadcast(4.1665795894e-2f));
+    p = fmadd(p, r, V::broadcast(1.6666665459e-1f));
+    p = fmadd(p, r, V::broadcast(5.0000001201e-1f));
+    p = fmadd(p, r * r, r + one);
+
+    // n reaches 128 just below ln(FLT_MAX); 2^128 is applied as 2^127 * 2.
+    const V n_max = V::broadcast(127.0f);
+    V y = p * pow2i(min(n, n_max)) * select_lt(n_max, n, V::broadcast(2.0f), one);
+    y = y + (x - x);  // NaN for NaN and infinite x; the infinities are fixed up next.
+    y = select_lt(hi, x, V::broadcast(kMathInf), y);
+    y = select_lt(x, lo, V::broadcast(0.0f), y);
+    return y;
+}
+
+// Cephes logf: x = m 2^e with m in [sqrt(1/2), sqrt(2)), log(m) = f - f^2/2 + f^3 P(f) for
+// f = m - 1, plus e ln2 in two parts.
+template <class V>
+inline V log_vec(V x) noexcept {
+    const V zero = V::broadcast(0.0f);
+    const V one = V::broadcast(1.0f);
+    const V min_normal = V::broadcast(kMathMinNormal);
+
+    // denormals are scaled by 2^23 into the normal range.
+    const V xs = select_lt(x, min_normal, x * V::broadcast(8388608.0f), x);
+    V e = exponent(xs) + select_lt(x, min_normal, V::broadcast(-23.0f), zero);
+    V m = mantissa(xs);
+    const V sqrt2 = V::broadcast(1.41421356237f);
+    e = e + select_lt(sqrt2, m, one, zero);
+    m = select_lt(sqrt2, m, m * V::broadcast(0.5f), m);
+
+    const V f = m - one;
+    const V z = f * f;
+    V p = V::broadcast(7.0376836292e-2f);
+    p = fmadd(p, f, V::broadcast(-1.1514610310e-1f));
+    p = fmadd(p, f, V::broadcast(1.1676998740e-1f));
+    p = fmadd(p, f, V::broadcast(-1.2420140846e-1f));
+    p = fmadd(p, f, V::broadcast(1.4249322787e-1f));
+    p = fmadd(p, f, V::broadcast(-1.6668057665e-1f));
+    p = fmadd(p, f, V::broadcast(2.0000714765e-1f));
+    p = fmadd(p, f, V::broadcast(-2.4999993993e-1f));
+    p = fmadd(p, f, V::broadcast(3.3333331174e-1f));
+    p = p * f * z;
+    p = fmadd(e, V::broadcast(-2.12194440e-4f), p);
+    p = fmadd(z, V::broadcast(-0.5f), p);
+    V y = fmadd(e, V::broadcast(0.693359375f), f + p);
+
+    y = y + (x - x);  // NaN for NaN and infinite x; +inf is fixed up next.
+    y = select_lt(V::broadcast(kMathMax), x, V::broadcast(kMathInf), y);
+    y = select_lt(x, V::broadcast(kMathDenormMin), V::broadcast(-kMathInf), y);
+    y = select_lt(x, zero, V::broadcast(kMathNaN), y);
+    return y;
+}
+
+// Odd rational approximation x P(x^2) / Q(x^2) on [-7.9, 7.9], exactly +-1 outside.
+template <class V>
+inline V tanh_vec(V x) noexcept {
+    const V bound = V::broadcast(7.90531110763549805f);
+    const V c = min(max(x, V::broadcast(0.0f) - bound), bound);
+    const V x2 = c * c;
+
+    V p = V::broadcast(-2.76076847742355e-16f);
+    p = fmadd(p, x2, V::broadcast(2.00018790482477e-13f));
+    p = fmadd(p, x2, V::broadcast(-8.60467152213735e-11f));
+    p = fmadd(p, x2, V::broadcast(5.12229709037114e-08f));
+    p = fmadd(p, x2, V::broadcast(1.48572235717979e-05f));
+    p = fmadd(p, x2, V::broadcast(6.37261928875436e-04f));
+    p = fmadd(p, x2, V::broadcast(4.89352455891786e-03f));
+
+    V q = V::broadcast(1.19825839466702e-06f);
+    q = fmadd(q, x2, V::broadcast(1.18534705686654e-04f));
+    q = fmadd(q, x2, V::broadcast(2.26843463243900e-03f));
+    q = fmadd(q, x2, V::broadcast(4.89352518554385e-03f));
+    const V one = V::broadcast(1.0f);
+    const V y = select_lt(bound, x, one, c * (p / q));
+    return select_lt(x, V::broadcast(0.0f) - bound, V::broadcast(0.0f) - one, y);
+}
+
+// 1 / (1 + exp(-x)).
+template <class V>
+inline V sigmoid_vec(V x) noexcept {
+    const V one = V::broadcast(1.0f);
+    return one / (one + exp_vec(V::broadcast(0.0f) - x));
+}
+
+// Odd rational approximation x P(x^2) / Q(x^2) on [-4, 4]; erf rounds to +-1 outside.
+template <class V>
+inline V erf_vec(V x) noexcept {
+    const V c = min(max(x, V::broadcast(-4.0f)), V::broadcast(4.0f));
+    const V x2 = c * c;
+
+    V p = V::broadcast(-2.72614225801306e-10f);
+    p = fmadd(p, x2, V::broadcast(2.77068142495902e-08f));
+    p = fmadd(p, x2, V::broadcast(-2.10102402082508e-06f));
+    p = fmadd(p, x2, V::broadcast(-5.69250639462346e-05f));
+    p = fmadd(p, x2, V::broadcast(-7.34990630326855e-04f));
+    p = fmadd(p, x2, V::broadcast(-2.95459980854025e-03f));
+    p = fmadd(p, x2, V::broadcast(-1.60960333262415e-02f));
+
+    V q = V::broadcast(-1.45660718464996e-05f);
+    q = fmadd(q, x2, V::broadcast(-2.13374055278905e-04f));
+    q = fmadd(q, x2, V::broadcast(-1.68282697438203e-03f));
+    q = fmadd(q, x2, V::broadcast(-7.37332916720468e-03f));
+    q = fmadd(q, x2, V::broadcast(-1.42647390514189e-02f));
+    return c * (p / q);
+}
+
+// The erf form x/2 (1 + erf(x / sqrt(2))), not the tanh approximation of it.
+template <class V>
+inline V gelu_vec(V x) noexcept {
+    const V half_x = x * V::broadcast(0.5f);
+    return fmadd(half_x, erf_vec(x * V::broadcast(0.70710678118654752f)), half_x);
+}
+
+// r, or x where x is NaN: x is a number iff x < inf or -inf < x.
+template <class V>
+inline V propagate_nan(V x, V r) noexcept {
+    return select_lt(x, V::broadcast(kMathInf), r, select_lt(V::broadcast(-kMathInf), x, r, x));
+}
+
+// Elementwise max / min that return NaN when either side is NaN (max(a, b) alone keeps a).
+template <class V>
+inline V maximum_vec(V a, V b) noexcept {
+    return propagate_nan(b, max(a, b));
+}
+template <class V>
+inline V minimum_vec(V a, V b) noexcept {
+    return propagate_nan(b, min(a, b));
+}
+
+}  // namespace minidl::simd
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+
+namespace minidl::simd {
+
+// As in binary_contig_vec.h, only V and R::vec<V> are called here: the scalar R::op and
+// R::identity are folded to constants, never emitted with this TU's ISA flags.
+
+// Vectors per accumulator pass of a leaf; longer runs are split in halves (pairwise).
+constexpr std::size_t kReduceLeafVectors = 32;
+
+template <class V, class R>
+inline V reduce_pairwise_vec(const typename V::value_type* x, std::size_t n) noexcept {
+    using T = typename V::value_type;
+    constexpr std::size_t L = V::size;
+    constexpr T id = R::identity();
+
+    if (n > kReduceLeafVectors * L) {
+        const std::size_t half = (n / 2 + 4 * L - 1) / (4 * L) * (4 * L);
+        return R::template vec<V>(reduce_pairwise_vec<V, R>(x, half), reduce_pairwise_vec<V, R>(x + half, n - half));
+    }
+
+    V a0 = V::broadcast(id), a1 = a0, a2 = a0, a3 = a0;
+    std::size_t i = 0;
+    for (; i + 4 * L <= n; i += 4 * L) {
+        a0 = R::template vec<V>(a0, V::load(x + i));
+        a1 = R::template vec<V>(a1, V::load(x + i + L));
+        a2 = R::template vec<V>(a2, V::load(x + i + 2 * L));
+        a3 = R::template vec<V>(a3, V::load(x + i + 3 * L));
+    }
+    for (; i + L <= n; i += L) a0 = R::template vec<V>(a0, V::load(x + i));
+    if (i < n) {
+        T buf[L];
+        for (auto& b : buf) b = id;
+        std::memcpy(buf, x + i, (n - i) * sizeof(T));
+        a1 = R::template vec<V>(a1, V::load(buf));
+    }
+    return R::template vec<V>(R::template vec<V>(a0, a1), R::template vec<V>(a2, a3));
+}
+
+// Contiguous reduction of n elements over an ISA vector type V: pairwise over leaves of
+// kReduceLeafVectors vectors, four independent accumulators per leaf, then a lane tree.
+template <class V, class R>
+inline typename V::value_type reduce_contig_vec(const typename V::value_type* x, std::size_t n) noexcept {
+    using T = typename V::value_type;
+    constexpr std::size_t L = V::size;
+
+    // lane tree through a double-width buffer: each step folds the upper half onto the lower.
+    T buf[2 * L] = {};
+    reduce_pairwise_vec<V, R>(x, n).store(buf);
+    for (std::size_t w = L / 2; w > 0; w /= 2) {
+        R::template vec<V>(V::load(buf), V::load(buf + w)).store(buf);
+    }
+    return buf[0];
+}
+
+}  // namespace minidl::simd
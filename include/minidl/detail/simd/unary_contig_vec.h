@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+
+namespace minidl::simd {
+
+// Contiguous unary loop over an ISA vector type V, calling Op::vec<V>. Unary ops are
+// compute bound (a polynomial per element), so unlike binary_contig_vec.h there is no
+// alignment peeling; the tail goes through a padded buffer.
+template <class V, class Op>
+inline void unary_contig_vec(typename V::value_type* __restrict z, const typename V::value_type* __restrict x,
+                             std::size_t n) noexcept {
+    using T = typename V::value_type;
+    constexpr std::size_t L = V::size;
+
+    std::size_t i = 0;
+    for (; i + 2 * L <= n; i += 2 * L) {
+        const V a0 = V::load(x + i), a1 = V::load(x + i + L);
+        Op::template vec<V>(a0).store(z + i);
+        Op::template vec<V>(a1).store(z + i + L);
+    }
+    for (; i + L <= n; i += L) Op::template vec<V>(V::load(x + i)).store(z + i);
+    if (i < n) {
+        T xb[L] = {}, zb[L];
+        std::memcpy(xb, x + i, (n - i) * sizeof(T));
+        Op::template vec<V>(V::load(xb)).store(zb);
+        std::memcpy(z + i, zb, (n - i) * sizeof(T));
+    }
+}
+
+}  // namespace minidl::simd
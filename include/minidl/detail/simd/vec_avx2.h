@@ -0,0 +1,86 @@
+#pragma once
+// Only usable from translation units built with -mavx2 -mfma.
+#if defined(__AVX2__)
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minidl::simd::avx2 {
+
+template <typename T>
+struct Vec;
+
+template <>
+struct Vec<float> {
+    using value_type = float;
+    static constexpr std::size_t size = 8;
+
+    __m256 v;
+
+    static Vec load(const float* p) noexcept { return {_mm256_loadu_ps(p)}; }
+    static Vec load_aligned(const float* p) noexcept { return {_mm256_load_ps(p)}; }
+    static Vec broadcast(float s) noexcept { return {_mm256_set1_ps(s)}; }
+    void store(float* p) const noexcept { _mm256_storeu_ps(p, v); }
+    void store_aligned(float* p) const noexcept { _mm256_store_ps(p, v); }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {_mm256_add_ps(a.v, b.v)}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {_mm256_mul_ps(a.v, b.v)}; }
+    // a * b + c, fused.
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return {_mm256_fmadd_ps(a.v, b.v, c.v)}; }
+    // b if b > a, else a (so a NaN in b keeps a), matching the scalar reducers.
+    friend Vec max(Vec a, Vec b) noexcept { return {_mm256_max_ps(b.v, a.v)}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {_mm256_min_ps(b.v, a.v)}; }
+
+    // Building blocks of detail/simd/math_vec.h.
+    friend Vec operator-(Vec a, Vec b) noexcept { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend Vec operator/(Vec a, Vec b) noexcept { return {_mm256_div_ps(a.v, b.v)}; }
+    // nearest integer, ties to even.
+    friend Vec round(Vec a) noexcept { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    // 2^n for integral n in [-126, 127].
+    friend Vec pow2i(Vec n) noexcept {
+        const __m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n.v), _mm256_set1_epi32(127));
+        return {_mm256_castsi256_ps(_mm256_slli_epi32(e, 23))};
+    }
+    // x = mantissa(x) * 2^exponent(x) with the mantissa in [1, 2), for positive normal x.
+    friend Vec exponent(Vec x) noexcept {
+        const __m256i e = _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(x.v), 23), _mm256_set1_epi32(0xff));
+        return {_mm256_cvtepi32_ps(_mm256_sub_epi32(e, _mm256_set1_epi32(127)))};
+    }
+    friend Vec mantissa(Vec x) noexcept {
+        const __m256i m = _mm256_and_si256(_mm256_castps_si256(x.v), _mm256_set1_epi32(0x007fffff));
+        return {_mm256_castsi256_ps(_mm256_or_si256(m, _mm256_set1_epi32(0x3f800000)))};
+    }
+    // a < b ? t : f per lane; false when either side is NaN.
+    friend Vec select_lt(Vec a, Vec b, Vec t, Vec f) noexcept {
+        return {_mm256_blendv_ps(f.v, t.v, _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ))};
+    }
+};
+
+template <>
+struct Vec<std::int32_t> {
+    using value_type = std::int32_t;
+    static constexpr std::size_t size = 8;
+
+    __m256i v;
+
+    static Vec load(const std::int32_t* p) noexcept {
+        return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))};
+    }
+    static Vec load_aligned(const std::int32_t* p) noexcept {
+        return {_mm256_load_si256(reinterpret_cast<const __m256i*>(p))};
+    }
+    static Vec broadcast(std::int32_t s) noexcept { return {_mm256_set1_epi32(s)}; }
+    void store(std::int32_t* p) const noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    void store_aligned(std::int32_t* p) const noexcept { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {_mm256_add_epi32(a.v, b.v)}; }
+    friend Vec operator-(Vec a, Vec b) noexcept { return {_mm256_sub_epi32(a.v, b.v)}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {_mm256_mullo_epi32(a.v, b.v)}; }
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return a * b + c; }
+    friend Vec max(Vec a, Vec b) noexcept { return {_mm256_max_epi32(a.v, b.v)}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {_mm256_min_epi32(a.v, b.v)}; }
+};
+
+}  // namespace minidl::simd::avx2
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+// Only usable from translation units built with -mavx512f.
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minidl::simd::avx512 {
+
+template <typename T>
+struct Vec;
+
+template <>
+struct Vec<float> {
+    using value_type = float;
+    static constexpr std::size_t size = 16;
+
+    __m512 v;
+
+    static Vec load(const float* p) noexcept { return {_mm512_loadu_ps(p)}; }
+    static Vec load_aligned(const float* p) noexcept { return {_mm512_load_ps(p)}; }
+    static Vec broadcast(float s) noexcept { return {_mm512_set1_ps(s)}; }
+    void store(float* p) const noexcept { _mm512_storeu_ps(p, v); }
+    void store_aligned(float* p) const noexcept { _mm512_store_ps(p, v); }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {_mm512_add_ps(a.v, b.v)}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {_mm512_mul_ps(a.v, b.v)}; }
+    // a * b + c, fused.
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return {_mm512_fmadd_ps(a.v, b.v, c.v)}; }
+    // b if b > a, else a (so a NaN in b keeps a), matching the scalar reducers. Here and for
+    // i32, the masked form with a full mask avoids GCC 12's -Wmaybe-uninitialized on the
+    // unmasked intrinsics.
+    friend Vec max(Vec a, Vec b) noexcept { return {_mm512_mask_max_ps(a.v, 0xFFFF, b.v, a.v)}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {_mm512_mask_min_ps(a.v, 0xFFFF, b.v, a.v)}; }
+
+    // Building blocks of detail/simd/math_vec.h, masked for the same GCC 12 warning.
+    friend Vec operator-(Vec a, Vec b) noexcept { return {_mm512_sub_ps(a.v, b.v)}; }
+    friend Vec operator/(Vec a, Vec b) noexcept { return {_mm512_div_ps(a.v, b.v)}; }
+    // nearest integer, ties to even.
+    friend Vec round(Vec a) noexcept {
+        return {_mm512_mask_roundscale_ps(a.v, 0xFFFF, a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+    }
+    // 2^n for integral n in [-126, 127].
+    friend Vec pow2i(Vec n) noexcept {
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i e = _mm512_add_epi32(_mm512_mask_cvtps_epi32(zero, 0xFFFF, n.v), _mm512_set1_epi32(127));
+        return {_mm512_castsi512_ps(_mm512_mask_slli_epi32(zero, 0xFFFF, e, 23))};
+    }
+    // x = mantissa(x) * 2^exponent(x) with the mantissa in [1, 2), for positive normal x.
+    friend Vec exponent(Vec x) noexcept { return {_mm512_mask_getexp_ps(x.v, 0xFFFF, x.v)}; }
+    friend Vec mantissa(Vec x) noexcept {
+        return {_mm512_mask_getmant_ps(x.v, 0xFFFF, x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_zero)};
+    }
+    // a < b ? t : f per lane; false when either side is NaN.
+    friend Vec select_lt(Vec a, Vec b, Vec t, Vec f) noexcept {
+        return {_mm512_mask_blend_ps(_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ), f.v, t.v)};
+    }
+};
+
+template <>
+struct Vec<std::int32_t> {
+    using value_type = std::int32_t;
+    static constexpr std::size_t size = 16;
+
+    __m512i v;
+
+    static Vec load(const std::int32_t* p) noexcept { return {_mm512_loadu_si512(p)}; }
+    static Vec load_aligned(const std::int32_t* p) noexcept { return {_mm512_load_si512(p)}; }
+    static Vec broadcast(std::int32_t s) noexcept { return {_mm512_set1_epi32(s)}; }
+    void store(std::int32_t* p) const noexcept { _mm512_storeu_si512(p, v); }
+    void store_aligned(std::int32_t* p) const noexcept { _mm512_store_si512(p, v); }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {_mm512_add_epi32(a.v, b.v)}; }
+    friend Vec operator-(Vec a, Vec b) noexcept { return {_mm512_sub_epi32(a.v, b.v)}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {_mm512_mullo_epi32(a.v, b.v)}; }
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return a * b + c; }
+    friend Vec max(Vec a, Vec b) noexcept { return {_mm512_mask_max_epi32(a.v, 0xFFFF, a.v, b.v)}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {_mm512_mask_min_epi32(a.v, 0xFFFF, a.v, b.v)}; }
+};
+
+}  // namespace minidl::simd::avx512
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+// NEON is part of the AArch64 baseline, so no extra flags are needed.
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minidl::simd::neon {
+
+template <typename T>
+struct Vec;
+
+template <>
+struct Vec<float> {
+    using value_type = float;
+    static constexpr std::size_t size = 4;
+
+    float32x4_t v;
+
+    static Vec load(const float* p) noexcept { return {vld1q_f32(p)}; }
+    static Vec load_aligned(const float* p) noexcept { return {vld1q_f32(p)}; }
+    static Vec broadcast(float s) noexcept { return {vdupq_n_f32(s)}; }
+    void store(float* p) const noexcept { vst1q_f32(p, v); }
+    void store_aligned(float* p) const noexcept { vst1q_f32(p, v); }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {vaddq_f32(a.v, b.v)}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {vmulq_f32(a.v, b.v)}; }
+    // a * b + c, fused.
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return {vfmaq_f32(c.v, a.v, b.v)}; }
+    // b if b > a, else a: vmaxq_f32 would propagate NaN, the scalar reducers do not.
+    friend Vec max(Vec a, Vec b) noexcept { return {vbslq_f32(vcgtq_f32(b.v, a.v), b.v, a.v)}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {vbslq_f32(vcltq_f32(b.v, a.v), b.v, a.v)}; }
+
+    // Building blocks of detail/simd/math_vec.h.
+    friend Vec operator-(Vec a, Vec b) noexcept { return {vsubq_f32(a.v, b.v)}; }
+    friend Vec operator/(Vec a, Vec b) noexcept { return {vdivq_f32(a.v, b.v)}; }
+    // nearest integer, ties to even.
+    friend Vec round(Vec a) noexcept { return {vrndnq_f32(a.v)}; }
+    // 2^n for integral n in [-126, 127].
+    friend Vec pow2i(Vec n) noexcept {
+        const int32x4_t e = vaddq_s32(vcvtnq_s32_f32(n.v), vdupq_n_s32(127));
+        return {vreinterpretq_f32_s32(vshlq_n_s32(e, 23))};
+    }
+    // x = mantissa(x) * 2^exponent(x) with the mantissa in [1, 2), for positive normal x.
+    friend Vec exponent(Vec x) noexcept {
+        const int32x4_t e = vandq_s32(vshrq_n_s32(vreinterpretq_s32_f32(x.v), 23), vdupq_n_s32(0xff));
+        return {vcvtq_f32_s32(vsubq_s32(e, vdupq_n_s32(127)))};
+    }
+    friend Vec mantissa(Vec x) noexcept {
+        const int32x4_t m = vandq_s32(vreinterpretq_s32_f32(x.v), vdupq_n_s32(0x007fffff));
+        return {vreinterpretq_f32_s32(vorrq_s32(m, vdupq_n_s32(0x3f800000)))};
+    }
+    // a < b ? t : f per lane; false when either side is NaN.
+    friend Vec select_lt(Vec a, Vec b, Vec t, Vec f) noexcept { return {vbslq_f32(vcltq_f32(a.v, b.v), t.v, f.v)}; }
+};
+
+template <>
+struct Vec<std::int32_t> {
+    using value_type = std::int32_t;
+    static constexpr std::size_t size = 4;
+
+    int32x4_t v;
+
+    static Vec load(const std::int32_t* p) noexcept { return {vld1q_s32(p)}; }
+    static Vec load_aligned(const std::int32_t* p) noexcept { return {vld1q_s32(p)}; }
+    static Vec broadcast(std::int32_t s) noexcept { return {vdupq_n_s32(s)}; }
+    void store(std::int32_t* p) const noexcept { vst1q_s32(p, v); }
+    void store_aligned(std::int32_t* p) const noexcept { vst1q_s32(p, v); }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {vaddq_s32(a.v, b.v)}; }
+    friend Vec operator-(Vec a, Vec b) noexcept { return {vsubq_s32(a.v, b.v)}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {vmulq_s32(a.v, b.v)}; }
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return {vmlaq_s32(c.v, a.v, b.v)}; }
+    friend Vec max(Vec a, Vec b) noexcept { return {vmaxq_s32(a.v, b.v)}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {vminq_s32(a.v, b.v)}; }
+};
+
+}  // namespace minidl::simd::neon
+#endif
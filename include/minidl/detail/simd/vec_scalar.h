@@ -0,0 +1,81 @@
+#pragma once
+// One-lane stand-in for the ISA vector types, built with the baseline flags. Code written
+// against a Vec (e.g. detail/simd/math_vec.h) runs on single elements through it, so the
+// strided loops and hosts without SIMD compute the same results as the vector kernels.
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace minidl::simd::scalar {
+
+template <typename T>
+struct Vec;
+
+template <>
+struct Vec<float> {
+    using value_type = float;
+    static constexpr std::size_t size = 1;
+
+    float v;
+
+    static Vec load(const float* p) noexcept { return {*p}; }
+    static Vec load_aligned(const float* p) noexcept { return {*p}; }
+    static Vec broadcast(float s) noexcept { return {s}; }
+    void store(float* p) const noexcept { *p = v; }
+    void store_aligned(float* p) const noexcept { *p = v; }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {a.v + b.v}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {a.v * b.v}; }
+    // fused like the ISA kernels, so single elements round exactly as the vector lanes do.
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return {std::fma(a.v, b.v, c.v)}; }
+    friend Vec max(Vec a, Vec b) noexcept { return {b.v > a.v ? b.v : a.v}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {b.v < a.v ? b.v : a.v}; }
+
+    friend Vec operator-(Vec a, Vec b) noexcept { return {a.v - b.v}; }
+    friend Vec operator/(Vec a, Vec b) noexcept { return {a.v / b.v}; }
+    friend Vec round(Vec a) noexcept { return {std::nearbyint(a.v)}; }
+    friend Vec pow2i(Vec n) noexcept {
+        const std::uint32_t bits = static_cast<std::uint32_t>(static_cast<std::int32_t>(n.v) + 127) << 23;
+        float r;
+        std::memcpy(&r, &bits, sizeof(r));
+        return {r};
+    }
+    friend Vec exponent(Vec x) noexcept {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x.v, sizeof(bits));
+        return {static_cast<float>(static_cast<std::int32_t>((bits >> 23) & 0xff) - 127)};
+    }
+    friend Vec mantissa(Vec x) noexcept {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x.v, sizeof(bits));
+        bits = (bits & 0x007fffff) | 0x3f800000;
+        float r;
+        std::memcpy(&r, &bits, sizeof(r));
+        return {r};
+    }
+    friend Vec select_lt(Vec a, Vec b, Vec t, Vec f) noexcept { return {a.v < b.v ? t.v : f.v}; }
+};
+
+template <>
+struct Vec<std::int32_t> {
+    using value_type = std::int32_t;
+    static constexpr std::size_t size = 1;
+
+    std::int32_t v;
+
+    static Vec load(const std::int32_t* p) noexcept { return {*p}; }
+    static Vec load_aligned(const std::int32_t* p) noexcept { return {*p}; }
+    static Vec broadcast(std::int32_t s) noexcept { return {s}; }
+    void store(std::int32_t* p) const noexcept { *p = v; }
+    void store_aligned(std::int32_t* p) const noexcept { *p = v; }
+
+    friend Vec operator+(Vec a, Vec b) noexcept { return {a.v + b.v}; }
+    friend Vec operator-(Vec a, Vec b) noexcept { return {a.v - b.v}; }
+    friend Vec operator*(Vec a, Vec b) noexcept { return {a.v * b.v}; }
+    friend Vec fmadd(Vec a, Vec b, Vec c) noexcept { return {a.v * b.v + c.v}; }
+    friend Vec max(Vec a, Vec b) noexcept { return {b.v > a.v ? b.v : a.v}; }
+    friend Vec min(Vec a, Vec b) noexcept { return {b.v < a.v ? b.v : a.v}; }
+};
+
+}  // namespace minidl::simd::scalar
@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace minidl::detail {
+
+// Iterates several operands over one shape and hands the caller 1-D runs with constant
+// strides, so the per-element work is a plain strided (often unit-stride) loop.
+//
+// At construction, size-1 dims are dropped, dims are ordered by operand strides
+// (operand 0, usually the output, decides first; stride 0 dims defer to the next operand)
+// and adjacent dims that are mergeable for every operand are coalesced. A broadcast
+// operand keeps stride 0 along the dims it is broadcast over.
+class TensorIterator {
+   public:
+    // strides[k]: element strides of operand k, one per dim of `shape`.
+    TensorIterator(const std::vector<std::size_t>& shape, const std::vector<std::vector<std::size_t>>& strides);
+
+    std::size_t ntensors() const noexcept { return ntensors_; }
+    std::size_t ndim() const noexcept { return shape_.size(); }
+    std::size_t numel() const noexcept { return numel_; }
+
+    // coalesced dims, innermost first.
+    const std::vector<std::size_t>& shape() const noexcept { return shape_; }
+    std::size_t stride(std::size_t operand, std::size_t dim) const noexcept {
+        return strides_[dim * ntensors_ + operand];
+    }
+
+    // Calls loop(offsets, strides, n) for each run of the iteration range [begin, end),
+    // where offsets[k] is operand k's element offset at the start of the run and
+    // strides[k] its stride along the run.
+    template <class Loop>
+    void for_each(std::size_t begin, std::size_t end, Loop&& loop) const;
+
+   private:
+    // zero-filled indices, on the stack for the common small sizes.
+    class IndexBuffer {
+       public:
+        explicit IndexBuffer(std::size_t n) {
+            if (n > kInline) {
+                heap_.assign(n, 0);
+                ptr_ = heap_.data();
+            }
+        }
+        IndexBuffer(const IndexBuffer& other) = delete;
+        IndexBuffer& operator=(const IndexBuffer& other) = delete;
+
+        std::size_t* data() noexcept { return ptr_; }
+        std::size_t& operator[](std::size_t i) noexcept { return ptr_[i]; }
+
+       private:
+        static constexpr std::size_t kInline = 16;
+        std::size_t local_[kInline] = {};
+        std::vector<std::size_t> heap_;
+        std::size_t* ptr_ = local_;
+    };
+
+    std::size_t ntensors_ = 0;
+    std::size_t numel_ = 1;
+    std::vector<std::size_t> shape_;
+    std::vector<std::size_t> strides_;  // [dim * ntensors_ + operand]
+};
+
+template <class Loop>
+void TensorIterator::for_each(std::size_t begin, std::size_t end, Loop&& loop) const {
+    if (end > numel_) end = numel_;
+    if (begin >= end) return;
+
+    const std::size_t nt = ntensors_;
+    IndexBuffer offsets(nt);
+    if (shape_.empty()) {
+        // scalar (or all size-1 dims): a single element.
+        IndexBuffer zero(nt);
+        loop(offsets.data(), zero.data(), std::size_t{1});
+        return;
+    }
+
+    const std::size_t nd = shape_.size();
+    IndexBuffer idx(nd);
+    std::size_t rem = begin;
+    for (std::size_t d = 0; d < nd; ++d) {
+        idx[d] = rem % shape_[d];
+        rem /= shape_[d];
+        for (std::size_t k = 0; k < nt; ++k) offsets[k] += idx[d] * stride(k, d);
+    }
+
+    const std::size_t* inner = strides_.data();
+    const std::size_t inner_size = shape_[0];
+    std::size_t pos = begin;
+    while (true) {
+        const std::size_t n = std::min(inner_size - idx[0], end - pos);
+        loop(offsets.data(), inner, n);
+        pos += n;
+        if (pos >= end) return;
+
+        // the run always ends on a row boundary here; move to the next row.
+        for (std::size_t k = 0; k < nt; ++k) offsets[k] -= idx[0] * stride(k, 0);
+        idx[0] = 0;
+        for (std::size_t d = 1; d < nd; ++d) {
+            for (std::size_t k = 0; k < nt; ++k) offsets[k] += stride(k, d);
+            if (++idx[d] < shape_[d]) break;
+            for (std::size_t k = 0; k < nt; ++k) offsets[k] -= shape_[d] * stride(k, d);
+            idx[d] = 0;
+        }
+    }
+}
+
+}  // namespace minidl::detail
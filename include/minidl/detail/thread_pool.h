@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace minidl::detail {
+
+// Persistent workers. `run` hands task t to worker t (the caller is task 0), so a given
+// range of a parallel_for always lands on the same thread. With `pin`, worker t stays on the
+// CPUs of NUMA node detail::numa_task_node(t, num_threads).
+class ThreadPool {
+   public:
+    using TaskFn = void (*)(void* /*ctx*/, std::size_t /*task*/);
+
+    explicit ThreadPool(std::size_t num_threads, bool pin = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+    ThreadPool(ThreadPool&& other) = delete;
+    ThreadPool& operator=(ThreadPool&& other) = delete;
+
+    std::size_t num_threads() const noexcept { return workers_.size() + 1; }
+    bool pinned() const noexcept { return pin_; }
+
+    // runs fn(ctx, t) for t in [0, num_tasks) and blocks until all tasks finished.
+    // num_tasks must not exceed num_threads().
+    void run(std::size_t num_tasks, TaskFn fn, void* ctx);
+
+   private:
+    void worker_loop(std::size_t id);
+    void run_task(std::size_t task);
+
+    std::vector<std::thread> workers_;
+    bool pin_ = false;
+
+    std::mutex run_mutex_;  // one parallel region at a time
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+
+    std::size_t generation_ = 0;
+    bool stop_ = false;
+
+    TaskFn fn_ = nullptr;
+    void* ctx_ = nullptr;
+    std::size_t num_tasks_ = 0;
+    std::size_t pending_ = 0;
+    std::exception_ptr error_;
+};
+
+ThreadPool& get_thread_pool();
+
+// true inside a task of the pool; nested parallel regions run serially.
+bool in_parallel_region() noexcept;
+
+}  // namespace minidl::detail
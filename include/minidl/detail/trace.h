@@ -0,0 +1,74 @@
+#pragma once
+#include <minidl/dtype.h>
+#include <minidl/shape.h>
+#include <minidl/tensor.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+
+namespace minidl::detail {
+
+// replays one traced op: writes the op of inputs[0..] into out (through the op's _out form).
+using TraceKernel = std::function<void(const Tensor* const* inputs, Tensor& out)>;
+
+// A tensor the trace has seen. Inputs are graph::Trace placeholders, constants are tensors
+// from outside the trace (weights) that ops read, op values are op results and views share
+// the storage of an input or op value (`root`).
+struct TraceValue {
+    enum class Kind { input, constant, op, view };
+    Kind kind;
+    Tensor tensor;          // the tensor seen while tracing; constants are read from it on replay
+    std::size_t root = 0;   // view: the input or op value it views
+    std::size_t offset = 0; // view: elements past root's first element
+};
+
+// The elementwise ops graph::Plan can fuse, when all their operands are f32.
+enum class PointwiseOp : std::uint8_t { none, add, sub, mul, div, maximum, minimum, exp, log, tanh, sigmoid, gelu, relu };
+
+struct TraceStep {
+    const char* name;
+    TraceKernel kernel;
+    std::vector<std::size_t> inputs;  // value ids
+    std::size_t output;
+    bool in_place;  // out may be written over an input of its shape and dtype
+    PointwiseOp pointwise = PointwiseOp::none;
+    bool fast = true;  // pointwise unary ops: Precision::fast
+};
+
+// What graph::Trace records, filled in by the ops while it is active on the thread.
+struct TraceRecorder {
+    std::vector<TraceValue> values;
+    std::vector<TraceStep> steps;
+    std::vector<std::size_t> inputs, outputs;
+    // the values over each storage seen, to tell which value a tensor is.
+    std::unordered_map<const Storage*, std::vector<std::size_t>> by_storage;
+
+    std::size_t add(TraceValue::Kind kind, const Tensor& t);
+    // the value `t` is; a tensor from outside the trace becomes a constant. Throws for a
+    // layout over a traced storage that no traced op or view produced.
+    std::size_t value_of(const Tensor& t, const char* op);
+    // true if t's storage belongs to an input or op value.
+    bool is_traced(const Tensor& t) const;
+};
+
+// the recorder of the graph::Trace active on this thread, or null.
+TraceRecorder* active_trace() noexcept;
+void set_active_trace(TraceRecorder* trace) noexcept;
+inline bool tracing() noexcept { return active_trace() != nullptr; }
+
+// Hooks for the ops; all of them do nothing unless tracing.
+// out = name(inputs), replayed by `kernel`; `pointwise` names the op for fusion.
+void trace_op(const char* name, TraceKernel kernel, const Tensor& out, std::initializer_list<const Tensor*> inputs,
+              bool in_place, PointwiseOp pointwise = PointwiseOp::none, bool fast = true);
+// out views base (view, reshape, transpose, slice, select).
+void trace_view(const Tensor& out, const Tensor& base);
+// out = base.contiguous(), a copy; recorded for constants as well.
+void trace_copy(const Tensor& out, const Tensor& base);
+// throws if `name`, which a trace cannot replay, reads or writes a traced tensor.
+void trace_unsupported(const char* name, std::initializer_list<const Tensor*> tensors);
+
+}  // namespace minidl::detail
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace minidl::kernels {
+
+// Square tile, in elements, that the blocked transpose moves at a time: a 64x64 tile of
+// 4-byte items is 16KB per side, so both sides of a tile stay in L1/L2.
+constexpr std::size_t kTransposeTile = 64;
+
+// dst[r * dst_ld + c] = src[c * src_ld + r] for r < rows, c < cols, items of `item` bytes.
+// Both leading dimensions are in elements. Unblocked: callers tile (see transpose_tile).
+void transpose_2d(void* dst, const void* src, std::size_t rows, std::size_t cols, std::size_t dst_ld,
+                  std::size_t src_ld, std::size_t item) noexcept;
+
+// 4-byte items with in-register transposes: 8x8 blocks on AVX2, 16x16 blocks (one cache
+// line per row on both sides) on AVX-512.
+#if defined(MINIDL_HAVE_AVX2)
+namespace avx2 {
+void transpose_2d_32(std::uint32_t* dst, const std::uint32_t* src, std::size_t rows, std::size_t cols,
+                     std::size_t dst_ld, std::size_t src_ld) noexcept;
+}
+#endif
+#if defined(MINIDL_HAVE_AVX512)
+namespace avx512 {
+void transpose_2d_32(std::uint32_t* dst, const std::uint32_t* src, std::size_t rows, std::size_t cols,
+                     std::size_t dst_ld, std::size_t src_ld) noexcept;
+}
+#endif
+
+}  // namespace minidl::kernels
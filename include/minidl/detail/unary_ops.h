@@ -0,0 +1,124 @@
+#pragma once
+#include "minidl/detail/kernels_pointwise.h"
+#include "minidl/detail/kernels_simd.h"
+#include "minidl/detail/layout.h"
+#include "minidl/detail/overlap.h"
+#include "minidl/detail/parallel.h"
+#include "minidl/detail/simd/math_vec.h"
+#include "minidl/tensor.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
+namespace minidl::detail {
+
+// Functors
+// `apply` is the exact form (libm, or double precision where float would lose bits);
+// `vec` the fast approximation from detail/simd/math_vec.h on an ISA vector type, or on
+// simd::scalar::Vec for single elements. Error bounds are listed in math_vec.h.
+template <typename T>
+struct ExpOp {
+    static inline T apply(T x) noexcept { return std::exp(x); }
+    template <class V>
+    static inline V vec(V x) noexcept {
+        return simd::exp_vec(x);
+    }
+};
+
+template <typename T>
+struct LogOp {
+    static inline T apply(T x) noexcept { return std::log(x); }
+    template <class V>
+    static inline V vec(V x) noexcept {
+        return simd::log_vec(x);
+    }
+};
+
+template <typename T>
+struct TanhOp {
+    static inline T apply(T x) noexcept { return std::tanh(x); }
+    template <class V>
+    static inline V vec(V x) noexcept {
+        return simd::tanh_vec(x);
+    }
+};
+
+template <typename T>
+struct SigmoidOp {
+    static inline T apply(T x) noexcept { return static_cast<T>(1.0 / (1.0 + std::exp(-static_cast<double>(x)))); }
+    template <class V>
+    static inline V vec(V x) noexcept {
+        return simd::sigmoid_vec(x);
+    }
+};
+
+template <typename T>
+struct GeluOp {
+    static inline T apply(T x) noexcept {
+        const double d = x;
+        return static_cast<T>(0.5 * d * (1.0 + std::erf(d * 0.70710678118654752)));
+    }
+    template <class V>
+    static inline V vec(V x) noexcept {
+        return simd::gelu_vec(x);
+    }
+};
+
+// Exact in both forms; NaN passes through.
+template <typename T>
+struct ReluOp {
+    static inline T apply(T x) noexcept { return x < T(0) ? T(0) : x; }
+    template <class V>
+    static inline V vec(V x) noexcept {
+        return max(x, V::broadcast(T(0)));
+    }
+};
+
+// z = Op(x) into an existing out of x's shape; x must not partially alias out.
+template <typename T, class Op>
+void unary_kernel(const Tensor& x, Tensor& out, bool fast) {
+    const std::size_t n = out.numel();
+    if (n == 0) return;
+
+    auto* z = static_cast<T*>(out.data());
+    auto* px = static_cast<const T*>(x.data());
+
+    if (x.is_contiguous() && out.is_contiguous()) {
+        parallel_for(0, n, kGrainSize, [&](std::size_t begin, std::size_t end) {
+            kernels::unary_strided_1d<T, Op>(z + begin, px + begin, end - begin, 1, 1, fast);
+        });
+    } else {
+        const TensorIterator iter(out.shape().dims(), {out.strides(), x.strides()});
+        parallel_for(0, n, kGrainSize, [&](std::size_t begin, std::size_t end) {
+            iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t len) {
+                kernels::unary_strided_1d<T, Op>(z + off[0], px + off[1], len, st[0], st[1], fast);
+            });
+        });
+    }
+}
+
+template <typename T, class Op>
+Tensor unary_impl(const Tensor& x, bool fast) {
+    Tensor out = Tensor::empty(x.shape(), x.dtype(), x.storage()->alloc_);
+    unary_kernel<T, Op>(x, out, fast);
+    return out;
+}
+
+template <typename T, class Op>
+Tensor& unary_out_impl(const Tensor& x, Tensor& out, bool fast) {
+    if (x.dtype() != out.dtype()) throw std::runtime_error("unary_out: dtype mismatch.");
+    if (out.shape().dims() != x.shape().dims()) throw std::runtime_error("unary_out: out must have the input's shape.");
+    if (has_internal_overlap(out.shape().dims(), out.strides())) {
+        throw std::runtime_error("unary_out: out must not have overlapping elements.");
+    }
+
+    if (safe_to_alias(x, out)) {
+        unary_kernel<T, Op>(x, out, fast);
+    } else {
+        out.copy_(unary_impl<T, Op>(x, fast));
+    }
+    return out;
+}
+
+}  // namespace minidl::detail
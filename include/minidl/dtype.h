@@ -1,9 +1,18 @@
 #pragma once
 #include <cstddef>
 namespace minidl {
+// Element types. The C++ type of each is detail::DTypeOf's inverse (see detail/dispatch.h);
+// f16 and bf16 are minidl::Half and minidl::BFloat16 (see half.h).
 enum DType {
     f32,
     i32,
+    bool_,  // one byte per element, 0 or 1; the result of comparisons.
+    f64,
+    f16,
+    bf16,
+    i8,
+    u8,
+    i64,
 };
 
 constexpr std::size_t size_of(const DType& dtype) {
@@ -12,7 +21,63 @@ constexpr std::size_t size_of(const DType& dtype) {
             return 4;
         case DType::i32:
             return 4;
+        case DType::bool_:
+            return 1;
+        case DType::f64:
+            return 8;
+        case DType::f16:
+            return 2;
+        case DType::bf16:
+            return 2;
+        case DType::i8:
+            return 1;
+        case DType::u8:
+            return 1;
+        case DType::i64:
+            return 8;
     }
     return 0;
 }
+
+constexpr bool is_floating_point(DType dtype) {
+    return dtype == DType::f32 || dtype == DType::f64 || dtype == DType::f16 || dtype == DType::bf16;
+}
+
+constexpr const char* to_string(DType dtype) {
+    switch (dtype) {
+        case DType::f32:
+            return "f32";
+        case DType::i32:
+            return "i32";
+        case DType::bool_:
+            return "bool";
+        case DType::f64:
+            return "f64";
+        case DType::f16:
+            return "f16";
+        case DType::bf16:
+            return "bf16";
+        case DType::i8:
+            return "i8";
+        case DType::u8:
+            return "u8";
+        case DType::i64:
+            return "i64";
+    }
+    return "unknown";
+}
+
+// The dtype binary ops compute and return for operands of dtypes a and b, following NumPy /
+// PyTorch: bool < integers < floating point, and the wider type of a kind wins. The mixed
+// pairs with no exact common type of their own go one step up: i8 with u8 gives i32 (there
+// is no i16) and f16 with bf16 gives f32.
+constexpr DType promote_types(DType a, DType b) {
+    if (a == b || b == DType::bool_) return a;
+    if (a == DType::bool_) return b;
+    const bool a_float = is_floating_point(a);
+    if (a_float != is_floating_point(b)) return a_float ? a : b;
+    if (a_float) return (a == DType::f64 || b == DType::f64) ? DType::f64 : DType::f32;
+    if (a == DType::i64 || b == DType::i64) return DType::i64;
+    return DType::i32;
+}
 }  // namespace minidl
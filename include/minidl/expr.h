@@ -0,0 +1,138 @@
+#pragma once
+#include "minidl/detail/autograd.h"
+#include "minidl/detail/binary_ops.h"
+#include "minidl/detail/expr_eval.h"
+#include "minidl/tensor.h"
+
+#include <cstddef>
+
+// Lazy elementwise expressions. `expr::lazy(a) * b + c` builds a compile-time tree
+// over the AddOp/MulOp functors; nothing is computed until `eval` runs the whole tree
+// in one fused loop, so intermediates are never written to memory.
+//
+// Nodes hold pointers to their leaf tensors: evaluate an expression before the tensors
+// it was built from go out of scope.
+namespace minidl::expr {
+
+template <class E>
+struct Expr {
+    const E& self() const noexcept { return static_cast<const E&>(*this); }
+};
+
+class Leaf : public Expr<Leaf> {
+   public:
+    static constexpr std::size_t kLeaves = 1;
+
+    explicit Leaf(const Tensor& t) noexcept : t_(&t) {}
+
+    void collect(const Tensor** out) const noexcept { out[0] = t_; }
+
+    // element i of operand I, where p/s are the per-operand base pointers and run strides.
+    template <std::size_t I, typename T>
+    T at(const T* const* p, std::size_t i) const noexcept {
+        return p[I][i];
+    }
+    template <std::size_t I, typename T>
+    T at(const T* const* p, const std::size_t* s, std::size_t i) const noexcept {
+        return p[I][i * s[I]];
+    }
+
+   private:
+    const Tensor* t_;
+};
+
+template <template <class> class Op, class L, class R>
+class Binary : public Expr<Binary<Op, L, R>> {
+   public:
+    static constexpr std::size_t kLeaves = L::kLeaves + R::kLeaves;
+
+    Binary(const L& lhs, const R& rhs) noexcept : lhs_(lhs), rhs_(rhs) {}
+
+    void collect(const Tensor** out) const noexcept {
+        lhs_.collect(out);
+        rhs_.collect(out + L::kLeaves);
+    }
+
+    template <std::size_t I, typename T>
+    T at(const T* const* p, std::size_t i) const noexcept {
+        return Op<T>::apply(lhs_.template at<I>(p, i), rhs_.template at<I + L::kLeaves>(p, i));
+    }
+    template <std::size_t I, typename T>
+    T at(const T* const* p, const std::size_t* s, std::size_t i) const noexcept {
+        return Op<T>::apply(lhs_.template at<I>(p, s, i), rhs_.template at<I + L::kLeaves>(p, s, i));
+    }
+
+   private:
+    L lhs_;
+    R rhs_;
+};
+
+inline Leaf lazy(const Tensor& t) noexcept { return Leaf(t); }
+
+// builders: tensors on either side are wrapped as leaves.
+template <class L, class R>
+Binary<detail::AddOp, L, R> add(const Expr<L>& l, const Expr<R>& r) {
+    return {l.self(), r.self()};
+}
+template <class L>
+Binary<detail::AddOp, L, Leaf> add(const Expr<L>& l, const Tensor& r) {
+    return {l.self(), Leaf(r)};
+}
+template <class R>
+Binary<detail::AddOp, Leaf, R> add(const Tensor& l, const Expr<R>& r) {
+    return {Leaf(l), r.self()};
+}
+
+template <class L, class R>
+Binary<detail::MulOp, L, R> mul(const Expr<L>& l, const Expr<R>& r) {
+    return {l.self(), r.self()};
+}
+template <class L>
+Binary<detail::MulOp, L, Leaf> mul(const Expr<L>& l, const Tensor& r) {
+    return {l.self(), Leaf(r)};
+}
+template <class R>
+Binary<detail::MulOp, Leaf, R> mul(const Tensor& l, const Expr<R>& r) {
+    return {Leaf(l), r.self()};
+}
+
+template <class L, class R>
+auto operator+(const Expr<L>& l, const Expr<R>& r) {
+    return add(l, r);
+}
+template <class L>
+auto operator+(const Expr<L>& l, const Tensor& r) {
+    return add(l, r);
+}
+template <class R>
+auto operator+(const Tensor& l, const Expr<R>& r) {
+    return add(l, r);
+}
+template <class L, class R>
+auto operator*(const Expr<L>& l, const Expr<R>& r) {
+    return mul(l, r);
+}
+template <class L>
+auto operator*(const Expr<L>& l, const Tensor& r) {
+    return mul(l, r);
+}
+template <class R>
+auto operator*(const Tensor& l, const Expr<R>& r) {
+    return mul(l, r);
+}
+
+// materializes `e` into a new contiguous tensor of the broadcast shape of its leaves. Not
+// differentiable: throws under grad mode if a leaf requires grad.
+template <class E>
+Tensor eval(const Expr<E>& e) {
+    for (const Tensor* t : detail::expr_leaves(e.self())) detail::require_no_grad("expr::eval", {t});
+    return detail::expr_eval(e.self());
+}
+
+// writes `e` into `out`, which must have the broadcast shape and the leaves' dtype.
+template <class E>
+Tensor& eval_out(const Expr<E>& e, Tensor& out) {
+    return detail::expr_eval_out(e.self(), out);
+}
+
+}  // namespace minidl::expr
@@ -0,0 +1,104 @@
+#pragma once
+#include <minidl/allocator.h>
+#include <minidl/detail/trace.h>
+#include <minidl/tensor.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Static graphs for fixed-shape inference. A Trace records the ops run on its placeholder
+// tensors; compile() plans every intermediate into one preallocated buffer, and Plan::run
+// replays the ops into it with no allocator calls:
+//
+//     graph::Trace trace;
+//     const Tensor x = trace.input({batch, 256});
+//     trace.output(ops::relu(ops::add(ops::matmul(x, w), b)));
+//     graph::Plan plan = trace.compile();
+//     const Tensor& y = plan.run({batch_of_inputs})[0];
+//
+// Traced are the binary ops, the unary ops, matmul, the views and contiguous(); reductions,
+// expr::eval and the in-place and _out ops throw on traced tensors, and to() throws on any
+// tensor while a trace is active. Tensors from outside the trace (weights) are read by
+// reference on every run, so their current contents are used; that includes contiguous()
+// copies of them, which are replayed.
+//
+// compile() also fuses: a tree of f32 elementwise ops (add, sub, mul, div, maximum, minimum
+// and the unary ops) whose intermediates are read only by the next op of the tree becomes one
+// kernel, which reads each leaf (broadcast or not) once per block of the output and never
+// writes the intermediates.
+namespace minidl::graph {
+
+struct CompileOptions {
+    bool fuse = true;  // fuse elementwise chains into one kernel each
+};
+
+// A planned op sequence. Intermediates live at fixed offsets in one buffer: values whose
+// lifetimes (from the op writing them to the last op reading them, or any view of them) do
+// not overlap share bytes, and an elementwise op whose input dies with it writes its output
+// over that input.
+class Plan {
+   public:
+    // runs the ops on `inputs`, which must have the placeholders' shapes and dtypes and be
+    // contiguous. The outputs point into the plan's buffer: the next run overwrites them.
+    const std::vector<Tensor>& run(const std::vector<Tensor>& inputs);
+
+    // the planned buffer, against the bytes eager execution allocates for the same ops.
+    std::size_t arena_bytes() const noexcept { return arena_bytes_; }
+    std::size_t eager_bytes() const noexcept { return eager_bytes_; }
+    std::size_t num_steps() const noexcept { return steps_.size(); }
+    // ops that write over their input.
+    std::size_t num_in_place() const noexcept { return num_in_place_; }
+    // traced ops folded into a fused kernel.
+    std::size_t num_fused() const noexcept { return num_fused_; }
+
+   private:
+    friend class Trace;
+    Plan() = default;
+
+    struct Step {
+        detail::TraceKernel kernel;
+        std::vector<std::size_t> args;
+        std::size_t out = 0;
+    };
+    // a view of an input, rebuilt over the input given to each run.
+    struct InputView {
+        std::size_t slot, input;
+        Shape shape;
+        std::vector<std::size_t> strides;
+        std::size_t offset;
+    };
+
+    std::vector<Tensor> slots_;  // one per traced value
+    std::vector<Step> steps_;
+    std::vector<std::size_t> inputs_, outputs_;
+    std::vector<InputView> input_views_;
+    std::vector<Tensor> results_;
+    std::vector<const Tensor*> args_;  // the running step's arguments
+    std::shared_ptr<Storage> arena_;
+    std::size_t arena_bytes_ = 0, eager_bytes_ = 0, num_in_place_ = 0, num_fused_ = 0;
+};
+
+// Records the ops run on this thread from construction until compile(), or destruction;
+// one Trace at a time per thread. The ops really run, on the placeholders' zeros.
+class Trace {
+   public:
+    Trace();
+    ~Trace();
+
+    Trace(const Trace&) = delete;
+    Trace& operator=(const Trace&) = delete;
+
+    // a placeholder for the input of that position in Plan::run.
+    Tensor input(const Shape& shape, DType dtype = DType::f32);
+    // marks a traced tensor as an output, in the order Plan::run returns them.
+    void output(const Tensor& t);
+    // stops recording and plans the buffer, allocated from `alloc` (the default allocator
+    // when null).
+    Plan compile(std::shared_ptr<Allocator> alloc = nullptr, CompileOptions options = {});
+
+   private:
+    std::unique_ptr<detail::TraceRecorder> rec_;
+};
+
+}  // namespace minidl::graph
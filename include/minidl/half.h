@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+namespace minidl {
+
+// 16-bit floating point storage types. Arithmetic goes through float: both convert to float
+// implicitly and from float explicitly, rounding to nearest even.
+//   Half      IEEE binary16: 5 exponent bits, 10 mantissa bits, max 65504.
+//   BFloat16  the top half of a float: 8 exponent bits (the f32 range), 7 mantissa bits.
+
+namespace detail {
+
+inline std::uint32_t float_bits(float f) noexcept {
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+inline float bits_float(std::uint32_t u) noexcept {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+inline std::uint16_t f32_to_f16_bits(float f) noexcept {
+    std::uint32_t x = float_bits(f);
+    const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000);
+    x &= 0x7fffffff;
+    // NaN stays NaN (quiet, top payload bits kept); anything from 65520 up rounds to inf.
+    if (x > 0x7f800000) return static_cast<std::uint16_t>(sign | 0x7e00 | ((x >> 13) & 0x3ff));
+    if (x >= 0x477ff000) return static_cast<std::uint16_t>(sign | 0x7c00);
+    if (x < 0x38800000) {
+        // below 2^-14 the result is subnormal: adding 0.5 lines the half ulp (2^-24) up with
+        // the float ulp at 0.5, and the FPU does the rounding.
+        const std::uint32_t r = float_bits(bits_float(x) + 0.5f);
+        return static_cast<std::uint16_t>(sign | (r - 0x3f000000));
+    }
+    // rebias the exponent by 15 - 127 and round the 13 dropped bits to nearest even.
+    x += 0xc8000fffu + ((x >> 13) & 1);
+    return static_cast<std::uint16_t>(sign | (x >> 13));
+}
+
+inline float f16_bits_to_f32(std::uint16_t h) noexcept {
+    const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000) << 16;
+    const std::uint32_t em = h & 0x7fff;
+    if (em >= 0x7c00) return bits_float(sign | 0x7f800000 | ((em & 0x3ff) << 13));
+    if (em >= 0x0400) return bits_float(sign | ((em << 13) + 0x38000000));
+    // subnormal: em * 2^-24 is exact.
+    return bits_float(sign | float_bits(static_cast<float>(em) * 5.9604644775390625e-8f));
+}
+
+inline std::uint16_t f32_to_bf16_bits(float f) noexcept {
+    const std::uint32_t x = float_bits(f);
+    if ((x & 0x7fffffff) > 0x7f800000) return static_cast<std::uint16_t>((x >> 16) | 0x0040);
+    return static_cast<std::uint16_t>((x + 0x7fff + ((x >> 16) & 1)) >> 16);
+}
+
+inline float bf16_bits_to_f32(std::uint16_t b) noexcept { return bits_float(static_cast<std::uint32_t>(b) << 16); }
+
+}  // namespace detail
+
+struct Half {
+    std::uint16_t bits = 0;
+
+    Half() = default;
+    explicit Half(float f) noexcept : bits(detail::f32_to_f16_bits(f)) {}
+    operator float() const noexcept { return detail::f16_bits_to_f32(bits); }
+
+    static Half from_bits(std::uint16_t b) noexcept {
+        Half h;
+        h.bits = b;
+        return h;
+    }
+};
+
+struct BFloat16 {
+    std::uint16_t bits = 0;
+
+    BFloat16() = default;
+    explicit BFloat16(float f) noexcept : bits(detail::f32_to_bf16_bits(f)) {}
+    operator float() const noexcept { return detail::bf16_bits_to_f32(bits); }
+
+    static BFloat16 from_bits(std::uint16_t b) noexcept {
+        BFloat16 h;
+        h.bits = b;
+        return h;
+    }
+};
+
+static_assert(sizeof(Half) == 2 && sizeof(BFloat16) == 2);
+
+}  // namespace minidl
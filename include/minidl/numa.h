@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// NUMA topology, thread placement and page placement queries. On Linux the nodes come from
+// /sys/devices/system/node; elsewhere, or on a kernel without NUMA, the machine is one node
+// holding every CPU.
+namespace minidl {
+
+std::size_t numa_num_nodes();
+// the CPUs of `node`; empty for a node with memory only.
+const std::vector<std::size_t>& numa_node_cpus(std::size_t node);
+// the nodes with CPUs, in order: the nodes the thread pool is spread over.
+const std::vector<std::size_t>& numa_cpu_nodes();
+// the node holding the page at p (faulting it in if untouched), or -1 when unknown.
+int numa_node_of(const void* p);
+
+// Restricts the calling thread to the CPUs of `node` until destruction, then restores its
+// previous affinity. Does nothing where affinity cannot be set.
+class ScopedNodeAffinity {
+   public:
+    explicit ScopedNodeAffinity(std::size_t node);
+    ~ScopedNodeAffinity();
+
+    ScopedNodeAffinity(const ScopedNodeAffinity&) = delete;
+    ScopedNodeAffinity& operator=(const ScopedNodeAffinity&) = delete;
+
+    // false if the affinity could not be set.
+    bool active() const noexcept { return !saved_.empty(); }
+
+   private:
+    std::vector<unsigned long> saved_;  // the previous CPU mask
+};
+
+namespace detail {
+// the node parallel_for task `task` of `num_tasks` runs on when the pool is pinned: the
+// tasks are split into one contiguous block per node with CPUs, in node order.
+std::size_t numa_task_node(std::size_t task, std::size_t num_tasks);
+// restricts the calling thread to the CPUs of `node`; false if that is not possible.
+bool pin_current_thread(std::size_t node);
+}  // namespace detail
+
+}  // namespace minidl
@@ -1,9 +1,96 @@
 #pragma once
 #include "minidl/tensor.h"
 
+#include <cstddef>
+#include <vector>
+
 namespace minidl::ops {
 
+// Elementwise binary ops on any dtype but bool; operands broadcast, and compute in (and
+// return) promote_types(lhs.dtype(), rhs.dtype()). Each operand is read in its own dtype,
+// without converting it to a whole new tensor first.
 Tensor add(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+Tensor sub(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
 Tensor mul(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+// integer division truncates toward zero, and x / 0 gives 0.
+Tensor div(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+// elementwise max / min; NaN if either side is NaN.
+Tensor maximum(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+Tensor minimum(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+// integer powers wrap on overflow; negative exponents truncate (0 unless |lhs| == 1).
+Tensor pow(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+
+// comparisons, with a bool result.
+Tensor eq(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+Tensor ne(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+Tensor lt(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+Tensor le(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+Tensor gt(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+Tensor ge(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+
+// write into `out`, which must already have the broadcast shape and the result dtype.
+Tensor& add_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& sub_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& mul_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& div_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& maximum_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& minimum_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& pow_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& eq_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& ne_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& lt_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& le_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& gt_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+Tensor& ge_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+
+// in-place: `other` must broadcast to self's shape, and the promoted dtype must be self's.
+Tensor& add_(Tensor& /*self*/, const Tensor& /*other*/);
+Tensor& sub_(Tensor& /*self*/, const Tensor& /*other*/);
+Tensor& mul_(Tensor& /*self*/, const Tensor& /*other*/);
+Tensor& div_(Tensor& /*self*/, const Tensor& /*other*/);
+Tensor& maximum_(Tensor& /*self*/, const Tensor& /*other*/);
+Tensor& minimum_(Tensor& /*self*/, const Tensor& /*other*/);
+Tensor& pow_(Tensor& /*self*/, const Tensor& /*other*/);
+
+// Elementwise activations and transcendentals, f32 only except relu (f32 and i32).
+// Precision::fast evaluates vectorized polynomial approximations (error bounds in
+// detail/simd/math_vec.h, a few ulp); Precision::exact calls libm per element.
+enum class Precision { fast, exact };
+
+Tensor exp(const Tensor& /*x*/, Precision /*precision*/ = Precision::fast);
+Tensor log(const Tensor& /*x*/, Precision /*precision*/ = Precision::fast);
+Tensor tanh(const Tensor& /*x*/, Precision /*precision*/ = Precision::fast);
+Tensor sigmoid(const Tensor& /*x*/, Precision /*precision*/ = Precision::fast);
+// x/2 (1 + erf(x / sqrt(2))).
+Tensor gelu(const Tensor& /*x*/, Precision /*precision*/ = Precision::fast);
+Tensor relu(const Tensor& /*x*/);
+
+// write into `out`, which must already have x's shape and dtype; out may be x itself.
+Tensor& exp_out(const Tensor& /*x*/, Tensor& /*out*/, Precision /*precision*/ = Precision::fast);
+Tensor& log_out(const Tensor& /*x*/, Tensor& /*out*/, Precision /*precision*/ = Precision::fast);
+Tensor& tanh_out(const Tensor& /*x*/, Tensor& /*out*/, Precision /*precision*/ = Precision::fast);
+Tensor& sigmoid_out(const Tensor& /*x*/, Tensor& /*out*/, Precision /*precision*/ = Precision::fast);
+Tensor& gelu_out(const Tensor& /*x*/, Tensor& /*out*/, Precision /*precision*/ = Precision::fast);
+Tensor& relu_out(const Tensor& /*x*/, Tensor& /*out*/);
+
+// [..., M, K] @ [..., K, N] -> [..., M, N]; batch dims broadcast. Transposed and sliced
+// operands are read in place, without a contiguous() copy.
+Tensor matmul(const Tensor& /*lhs*/, const Tensor& /*rhs*/);
+// write into `out`, which must already have the result shape and the operands' dtype.
+Tensor& matmul_out(const Tensor& /*lhs*/, const Tensor& /*rhs*/, Tensor& /*out*/);
+
+// reductions over `axes` (every dim when empty); keepdim leaves the reduced dims as size 1.
+// f32 sums are pairwise, with an error bound that grows with log(n) rather than n.
+Tensor sum(const Tensor& /*x*/, const std::vector<std::size_t>& /*axes*/ = {}, bool /*keepdim*/ = false);
+Tensor prod(const Tensor& /*x*/, const std::vector<std::size_t>& /*axes*/ = {}, bool /*keepdim*/ = false);
+Tensor max(const Tensor& /*x*/, const std::vector<std::size_t>& /*axes*/ = {}, bool /*keepdim*/ = false);
+Tensor min(const Tensor& /*x*/, const std::vector<std::size_t>& /*axes*/ = {}, bool /*keepdim*/ = false);
+// f32 only.
+Tensor mean(const Tensor& /*x*/, const std::vector<std::size_t>& /*axes*/ = {}, bool /*keepdim*/ = false);
+
+// i32 index of the first maximum along `axis`; the overload without an axis indexes the
+// flattened tensor.
+Tensor argmax(const Tensor& /*x*/, std::size_t /*axis*/, bool /*keepdim*/ = false);
+Tensor argmax(const Tensor& /*x*/);
 
 }  // namespace minidl::ops
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+
+namespace minidl {
+
+// Number of threads used by ops, including the calling thread.
+// Defaults to $MINIDL_NUM_THREADS, or std::thread::hardware_concurrency() when unset.
+std::size_t get_num_threads() noexcept;
+
+// Resizes the library thread pool. Must not be called while ops are running.
+// 0 restores the default.
+void set_num_threads(std::size_t num_threads);
+
+// Pins the pool's workers to NUMA nodes (see numa.h): the threads are split into one
+// contiguous block per node with CPUs, so the contiguous ranges parallel_for hands out, and
+// the pages first touched in them, stay on one node. The calling thread, which runs the first
+// range, is left where it is. Defaults to $MINIDL_PIN_THREADS (off when unset). Must not be
+// called while ops are running.
+void set_thread_pinning(bool pin);
+bool get_thread_pinning() noexcept;
+
+}  // namespace minidl
@@ -0,0 +1,48 @@
+#pragma once
+#include <minidl/allocators/mapped_file_allocator.h>
+#include <minidl/tensor.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace minidl {
+
+using NamedTensors = std::vector<std::pair<std::string, Tensor>>;
+
+// Tensor files
+// A header followed by one payload per tensor. Integers are u32 / u64 in the byte order of
+// the host that saved the file, which byte_order records; other hosts refuse to load it.
+//
+//   magic       8 bytes "minidl\0\0"
+//   version     u32, 1
+//   byte_order  u32, 0x01020304
+//   count       u32
+//   per tensor:
+//     name_len  u32, then name_len bytes of name
+//     dtype     u32, the DType value
+//     rank      u32, then rank u64 dims and rank u64 strides (in elements)
+//     offset    u64, the first element's position in the payload, in elements
+//     payload   u64 byte offset from the start of the file, a multiple of alignment
+//     nbytes    u64 payload size
+//     alignment u64, a power of two
+//
+// Payloads are aligned to kTensorFileAlignment (a page), so a mapped file hands out
+// page-aligned, SIMD-aligned data with no copy.
+inline constexpr std::size_t kTensorFileAlignment = 4096;
+
+// Writes `tensors` to `path`. A tensor whose elements fill the span they cover (contiguous,
+// or e.g. transposed) is written as that span with its strides; any other is written
+// contiguous.
+void save(const std::string& path, const NamedTensors& tensors);
+
+// The tensors of a file written by save(), pointing straight into a mapping of it: nothing
+// is read until touched, and read_only pages are shared with every other process mapping the
+// file. The mapping lives as long as any of the tensors or their views (see
+// MappedFileAllocator); results of ops on them are allocated upstream and do not hold it.
+// Writing to a read_only tensor faults. Throws on a malformed file.
+NamedTensors load(const std::string& path, MapMode mode = MapMode::read_only);
+
+}  // namespace minidl
@@ -3,28 +3,38 @@
 #include <minidl/dtype.h>
 #include <minidl/shape.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 namespace minidl {
 
-// forward declaration.
+// forward declarations.
 class Allocator;
+namespace detail {
+struct AutogradMeta;
+}
 
+// Owns `data`: the buffer goes back to `alloc_` when the Storage is destroyed.
+// Tensors share a Storage through std::shared_ptr, so it is move-only.
 struct Storage {
     Storage() = default;
     explicit Storage(std::shared_ptr<Allocator> alloc) : alloc_(std::move(alloc)) {};
+    ~Storage();
 
-    Storage(const Storage& other) = default;
-    Storage& operator=(const Storage& other) = default;
+    Storage(const Storage& other) = delete;
+    Storage& operator=(const Storage& other) = delete;
 
-    Storage(Storage&& other) noexcept = default;
-    Storage& operator=(Storage&& other) noexcept = default;
+    Storage(Storage&& other) noexcept;
+    Storage& operator=(Storage&& other) noexcept;
 
     void* data = nullptr;
     std::size_t nbytes = 0;
     std::shared_ptr<Allocator> alloc_;
+    // set when `data` belongs to another object (a file mapping), which it keeps alive; such data
+    // is never handed to alloc_, which then only serves what ops on the tensor allocate.
+    std::shared_ptr<const void> owner;
 };
 
 class Tensor {
@@ -42,21 +52,48 @@ class Tensor {
 
     // factory methods
     // static Tensor randn(const Shape& s, DType d = DType::f32, std::shared_ptr<Allocator> alloc = nullptr);
+    // uninitialized contents.
+    static Tensor empty(const Shape& shape, DType dtype = DType::f32, std::shared_ptr<Allocator> alloc = nullptr);
     static Tensor zeros(const Shape& shape, DType dtype = DType::f32, std::shared_ptr<Allocator> alloc = nullptr);
     static Tensor ones(const Shape& shape, DType dtype = DType::f32, std::shared_ptr<Allocator> alloc = nullptr);
     static Tensor arange(std::size_t size, DType dtype = DType::f32, std::shared_ptr<Allocator> alloc = nullptr);
+    // a view of an existing Storage with the given layout (strides and offset in elements);
+    // throws if an element would fall outside storage->nbytes.
+    static Tensor from_storage(std::shared_ptr<Storage> storage, const Shape& shape, DType dtype,
+                               std::vector<std::size_t> strides, std::size_t storage_offset = 0);
 
     // view & reshape
     Tensor view(const Shape& new_shape) const;
     Tensor reshape(const Shape& new_shape) const;
     Tensor transpose(const std::initializer_list<std::size_t> axes_ilist) const;
 
+    // slicing: views over the same Storage, nothing is copied.
+    // elements start, start + step, ... below stop along `dim`; stop is clamped to the dim size.
+    Tensor slice(std::size_t dim, std::size_t start, std::size_t stop, std::size_t step = 1) const;
+    Tensor narrow(std::size_t dim, std::size_t start, std::size_t length) const;
+    // index `index` of `dim`, which is removed from the result.
+    Tensor select(std::size_t dim, std::size_t index) const;
+    // consecutive pieces of `split_size` along `dim`; the last one may be smaller.
+    std::vector<Tensor> split(std::size_t split_size, std::size_t dim = 0) const;
+    // `chunks` pieces of equal size along `dim` (the last may be smaller, there may be fewer).
+    std::vector<Tensor> chunk(std::size_t chunks, std::size_t dim = 0) const;
+
     // get methods
     const Shape& shape() const noexcept { return shape_; }
     DType dtype() const noexcept { return dtype_; }
     const std::shared_ptr<Storage>& storage() const noexcept { return storage_; }
     const std::vector<std::size_t>& strides() const noexcept { return strides_; }
-    void* data() const noexcept { return storage_->data; }
+    // first element, storage_offset() elements into the storage.
+    void* data() const noexcept {
+        if (storage_->data == nullptr) return nullptr;
+        return static_cast<std::byte*>(storage_->data) + storage_offset_ * itemsize();
+    }
+    std::size_t storage_offset() const noexcept { return storage_offset_; }
+    // largest power of two dividing the data address (0 for no data).
+    std::size_t data_alignment() const noexcept {
+        const auto addr = reinterpret_cast<std::uintptr_t>(data());
+        return static_cast<std::size_t>(addr & (~addr + 1));
+    }
 
     std::size_t numel() const noexcept { return shape_.numel(); }
     std::size_t itemsize() const noexcept { return size_of(dtype_); }
@@ -69,6 +106,25 @@ class Tensor {
     }
 
     Tensor contiguous() const;
+    // element-wise copy of `src` (same shape and dtype) into this tensor's memory.
+    Tensor& copy_(const Tensor& src);
+    // elements converted to `dtype` in a new contiguous tensor (rounding and saturation rules at
+    // kernels::convert_value in detail/convert.h); *this, sharing storage, if the dtype matches.
+    Tensor to(DType dtype) const;
+
+    // autograd (see minidl/autograd.h). Copies of a tensor share its autograd state, so
+    // set_requires_grad before handing a parameter out. Only floating-point leaves (tensors
+    // not computed by a recorded op) can be marked.
+    Tensor& set_requires_grad(bool requires_grad = true);
+    bool requires_grad() const noexcept;
+    // the gradient backward() accumulated into this leaf; nullptr before the first backward.
+    const Tensor* grad() const noexcept;
+    // zeroes grad() in place: the buffer is kept and the next backward writes into it.
+    void zero_grad();
+    // the same elements, cut from the graph: requires_grad() is false.
+    Tensor detach() const;
+    const std::shared_ptr<detail::AutogradMeta>& autograd_meta() const noexcept { return autograd_; }
+    void set_autograd_meta(std::shared_ptr<detail::AutogradMeta> meta) noexcept { autograd_ = std::move(meta); }
 
    private:
     static inline std::vector<std::size_t> default_strides(const Shape& shape) {
@@ -81,6 +137,8 @@ class Tensor {
     DType dtype_;
     std::shared_ptr<Storage> storage_;
     std::vector<std::size_t> strides_;
+    std::size_t storage_offset_ = 0;  // in elements.
+    std::shared_ptr<detail::AutogradMeta> autograd_;  // null until autograd needs it.
 };
 
 }  // namespace minidl
@@ -0,0 +1,147 @@
+#include "minidl/allocators/arena_allocator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "minidl/allocators/system_allocator.h"
+
+namespace minidl {
+
+namespace {
+// each block is preceded by its allocation sequence number, which tells deallocate which
+// scope the block belongs to.
+constexpr std::size_t kHeader = sizeof(std::uint64_t);
+
+// offset in a slab at `base` of a block of nbytes placed at or after `offset`, or
+// `limit` + 1 when it does not fit in `limit` bytes.
+std::size_t place(const char* base, std::size_t offset, std::size_t nbytes, std::size_t alignment,
+                  std::size_t limit) noexcept {
+    const auto start = reinterpret_cast<std::uintptr_t>(base) + offset + kHeader;
+    const std::size_t user = static_cast<std::size_t>(detail::round_up(start, alignment) -
+                                                      reinterpret_cast<std::uintptr_t>(base));
+    return user + nbytes <= limit ? user : limit + 1;
+}
+}  // namespace
+
+ArenaAllocator::Scope::Scope(ArenaAllocator& arena) : arena_(arena) { arena_.push_mark(); }
+
+ArenaAllocator::Scope::~Scope() { arena_.pop_mark(); }
+
+ArenaAllocator::ArenaAllocator(Options options, std::shared_ptr<Allocator> upstream)
+    : options_(options), upstream_(std::move(upstream)) {
+    if (!upstream_) upstream_ = std::make_shared<SystemAllocator>();
+    if (options_.slab_size == 0) throw std::runtime_error("ArenaAllocator: slab_size must be positive.");
+    marks_.push_back(Mark{0, 0, 0, 0, 0});
+    if (!options_.grow) slabs_.push_back(new_slab(options_.slab_size));
+}
+
+ArenaAllocator::~ArenaAllocator() {
+    for (const Slab& s : slabs_) upstream_->deallocate(s.data);
+}
+
+ArenaAllocator::Slab ArenaAllocator::new_slab(std::size_t size) {
+    void* p = upstream_->allocate(size, kDefaultAlignment);
+    if (!p) throw std::bad_alloc{};
+    num_upstream_allocs_++;
+    return Slab{static_cast<char*>(p), size};
+}
+
+void* ArenaAllocator::allocate(std::size_t nbytes, std::size_t alignment) {
+    if (nbytes == 0) return nullptr;
+    if (!detail::is_pow2(alignment)) throw std::runtime_error("ArenaAllocator: alignment must be a power of two.");
+    if (alignment < kHeader) alignment = kHeader;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the current slab, else the first later one with room (free since the last rewind),
+    // else a new slab right after the current one.
+    std::size_t slab = slab_, offset = offset_, user = 0;
+    for (; slab < slabs_.size(); ++slab, offset = 0) {
+        const Slab& s = slabs_[slab];
+        user = place(s.data, offset, nbytes, alignment, s.size);
+        if (user <= s.size) break;
+    }
+    if (slab == slabs_.size()) {
+        if (!options_.grow) throw std::bad_alloc{};
+        const std::size_t size = std::max(options_.slab_size, nbytes + alignment + kHeader);
+        slab = slabs_.empty() ? 0 : slab_ + 1;
+        slabs_.insert(slabs_.begin() + static_cast<std::ptrdiff_t>(slab), new_slab(size));
+        offset = 0;
+        user = place(slabs_[slab].data, 0, nbytes, alignment, size);
+    }
+
+    used_ += (slab == slab_ ? user - offset_ : user) + nbytes;
+    slab_ = slab;
+    offset_ = user + nbytes;
+    if (used_ > high_water_mark_) high_water_mark_ = used_;
+
+    char* p = slabs_[slab].data + user;
+    const std::uint64_t seq = next_seq_++;
+    std::memcpy(p - kHeader, &seq, kHeader);
+    marks_.back().live++;
+    num_allocs_++;
+    return p;
+}
+
+void ArenaAllocator::deallocate(void* data) {
+    if (!data) return;
+    std::uint64_t seq;
+    std::memcpy(&seq, static_cast<const char*>(data) - kHeader, kHeader);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::size_t m = marks_.size() - 1;
+    while (marks_[m].seq > seq) --m;
+    marks_[m].live--;
+}
+
+void ArenaAllocator::push_mark() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    marks_.push_back(Mark{slab_, offset_, used_, next_seq_, 0});
+}
+
+void ArenaAllocator::pop_mark() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Mark mark = marks_.back();
+    marks_.pop_back();
+    if (mark.live != 0) {
+        // still in use: leave the memory where it is until the enclosing scope rewinds.
+        marks_.back().live += mark.live;
+        num_deferred_rewinds_++;
+        return;
+    }
+    slab_ = mark.slab;
+    offset_ = mark.offset;
+    used_ = mark.used;
+}
+
+void ArenaAllocator::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (marks_.size() != 1) throw std::runtime_error("ArenaAllocator: reset inside a Scope.");
+    if (marks_[0].live != 0) {
+        throw std::runtime_error("ArenaAllocator: reset with " + std::to_string(marks_[0].live) +
+                                 " live allocations.");
+    }
+    slab_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+ArenaStats ArenaAllocator::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ArenaStats s;
+    s.bytes_in_use = used_;
+    s.high_water_mark = high_water_mark_;
+    for (const Slab& slab : slabs_) s.bytes_reserved += slab.size;
+    s.num_slabs = slabs_.size();
+    for (const Mark& m : marks_) s.live_allocations += m.live;
+    s.num_allocs = num_allocs_;
+    s.num_upstream_allocs = num_upstream_allocs_;
+    s.num_deferred_rewinds = num_deferred_rewinds_;
+    return s;
+}
+
+}  // namespace minidl
@@ -0,0 +1,205 @@
+#include "minidl/allocators/caching_allocator.h"
+
+#include <limits>
+#include <new>
+#include <thread>
+
+#include "minidl/allocators/system_allocator.h"
+
+namespace minidl {
+
+namespace {
+constexpr std::size_t kMinBlock = 64;
+constexpr std::size_t kMinBlockLog2 = 6;
+constexpr std::size_t kClassesPerPow2 = 4;
+constexpr std::size_t kHeader = 64;  // room for BlockHeader that keeps 64-byte alignment
+
+// stored right before the user pointer.
+struct BlockHeader {
+    std::size_t size;    // size-class bytes, excluding the header
+    std::size_t offset;  // user pointer - upstream pointer
+    bool cached;         // false for oversized or over-aligned blocks
+};
+
+BlockHeader& header_of(void* user) noexcept {
+    return *reinterpret_cast<BlockHeader*>(static_cast<char*>(user) - sizeof(BlockHeader));
+}
+
+void* raw_of(void* user) noexcept { return static_cast<char*>(user) - header_of(user).offset; }
+
+std::size_t this_thread_index() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+std::size_t floor_log2(std::size_t v) noexcept {
+    std::size_t r = 0;
+    while (v >>= 1) ++r;
+    return r;
+}
+}  // namespace
+
+CachingAllocator::CachingAllocator(Options options, std::shared_ptr<Allocator> upstream)
+    : options_(options), upstream_(std::move(upstream)) {
+    if (!upstream_) upstream_ = std::make_shared<SystemAllocator>();
+
+    std::size_t num_shards = 1;
+    if (options_.per_thread_cache) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        num_shards = hw == 0 ? 1 : hw;
+    }
+    const std::size_t num_bins = bin_index(round_size(options_.max_block_size)) + 1;
+    for (std::size_t i = 0; i < num_shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->bins.resize(num_bins);
+    }
+}
+
+CachingAllocator::~CachingAllocator() { empty_cache(); }
+
+std::size_t CachingAllocator::round_size(std::size_t nbytes) noexcept {
+    if (nbytes <= kMinBlock) return kMinBlock;
+    // four classes between consecutive powers of two.
+    const std::size_t step = std::size_t{1} << (floor_log2(nbytes - 1) - 2);
+    return (nbytes + step - 1) / step * step;
+}
+
+std::size_t CachingAllocator::bin_index(std::size_t rounded) noexcept {
+    if (rounded <= kMinBlock) return 0;
+    const std::size_t lg = floor_log2(rounded - 1);  // rounded in (2^lg, 2^(lg+1)]
+    const std::size_t step = std::size_t{1} << (lg - 2);
+    const std::size_t sub = (rounded - (std::size_t{1} << lg)) / step - 1;  // 0..3
+    return 1 + (lg - kMinBlockLog2) * kClassesPerPow2 + sub;
+}
+
+std::size_t CachingAllocator::bin_size(std::size_t bin) noexcept {
+    if (bin == 0) return kMinBlock;
+    const std::size_t lg = (bin - 1) / kClassesPerPow2 + kMinBlockLog2;
+    const std::size_t sub = (bin - 1) % kClassesPerPow2;
+    return (std::size_t{1} << lg) + (sub + 1) * (std::size_t{1} << (lg - 2));
+}
+
+CachingAllocator::Shard& CachingAllocator::shard_for_this_thread() noexcept {
+    if (shards_.size() == 1) return *shards_[0];
+    return *shards_[this_thread_index() % shards_.size()];
+}
+
+void* CachingAllocator::pop_cached(std::size_t bin) noexcept {
+    Shard& own = shard_for_this_thread();
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        auto& list = own.bins[bin];
+        if (!list.empty()) {
+            void* p = list.back();
+            list.pop_back();
+            return p;
+        }
+    }
+    for (auto& shard : shards_) {
+        if (shard.get() == &own) continue;
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        auto& list = shard->bins[bin];
+        if (!list.empty()) {
+            void* p = list.back();
+            list.pop_back();
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+void CachingAllocator::note_alloc(std::size_t bytes) noexcept {
+    num_allocs_.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t now = bytes_in_use_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    std::size_t peak = peak_bytes_in_use_.load(std::memory_order_relaxed);
+    while (now > peak && !peak_bytes_in_use_.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+    }
+}
+
+void* CachingAllocator::allocate(std::size_t nbytes, std::size_t alignment) {
+    if (nbytes == 0) return nullptr;
+
+    const bool cacheable = nbytes <= options_.max_block_size && alignment <= kHeader;
+    const std::size_t size = cacheable ? round_size(nbytes) : nbytes;
+
+    void* p = nullptr;
+    if (cacheable) {
+        p = pop_cached(bin_index(size));
+        if (p) {
+            bytes_cached_.fetch_sub(size, std::memory_order_relaxed);
+            num_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!p) {
+        // the header takes one alignment unit, so the user pointer keeps the alignment.
+        const std::size_t offset = alignment > kHeader ? alignment : kHeader;
+        if (size > std::numeric_limits<std::size_t>::max() - offset) throw std::bad_alloc{};
+        void* raw = upstream_->allocate(size + offset, offset);
+        if (!raw) throw std::bad_alloc{};
+        p = static_cast<char*>(raw) + offset;
+        header_of(p) = BlockHeader{size, offset, cacheable};
+    }
+
+    note_alloc(size);
+    return p;
+}
+
+void CachingAllocator::deallocate(void* data) {
+    if (!data) return;
+
+    const BlockHeader& header = header_of(data);
+    const std::size_t size = header.size;
+    bytes_in_use_.fetch_sub(size, std::memory_order_relaxed);
+
+    if (header.cached && reserve_cache(size)) {
+        Shard& shard = shard_for_this_thread();
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.bins[bin_index(size)].push_back(data);
+        return;
+    }
+    upstream_->deallocate(raw_of(data));
+}
+
+// counts `size` more cached bytes if that stays within max_cached_bytes; a CAS so concurrent
+// frees cannot together overshoot the cap.
+bool CachingAllocator::reserve_cache(std::size_t size) noexcept {
+    std::size_t cached = bytes_cached_.load(std::memory_order_relaxed);
+    do {
+        if (cached + size > options_.max_cached_bytes) return false;
+    } while (!bytes_cached_.compare_exchange_weak(cached, cached + size, std::memory_order_relaxed));
+    return true;
+}
+
+void CachingAllocator::empty_cache() {
+    for (auto& shard : shards_) {
+        std::vector<std::vector<void*>> bins;
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            bins.resize(shard->bins.size());
+            bins.swap(shard->bins);
+        }
+        std::size_t freed = 0;
+        for (std::size_t b = 0; b < bins.size(); ++b) {
+            for (void* p : bins[b]) upstream_->deallocate(raw_of(p));
+            freed += bins[b].size() * bin_size(b);
+        }
+        bytes_cached_.fetch_sub(freed, std::memory_order_relaxed);
+    }
+}
+
+AllocatorStats CachingAllocator::stats() const noexcept {
+    AllocatorStats s;
+    s.bytes_in_use = bytes_in_use_.load(std::memory_order_relaxed);
+    s.bytes_cached = bytes_cached_.load(std::memory_order_relaxed);
+    s.peak_bytes_in_use = peak_bytes_in_use_.load(std::memory_order_relaxed);
+    s.num_allocs = num_allocs_.load(std::memory_order_relaxed);
+    s.num_cache_hits = num_cache_hits_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void CachingAllocator::reset_peak_stats() noexcept {
+    peak_bytes_in_use_.store(bytes_in_use_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+}  // namespace minidl
@@ -0,0 +1,33 @@
+#include "minidl/allocators/default.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include "minidl/allocators/caching_allocator.h"
+
+namespace minidl {
+
+namespace {
+std::shared_ptr<Allocator> make_env_allocator() {
+    const char* env = std::getenv("MINIDL_ALLOCATOR");
+    if (env && std::strcmp(env, "caching") == 0) return std::make_shared<CachingAllocator>();
+    return std::make_shared<SystemAllocator>();
+}
+
+std::mutex g_default_mutex;
+std::shared_ptr<Allocator> g_default;
+}  // namespace
+
+std::shared_ptr<Allocator> get_default_allocator() {
+    std::lock_guard<std::mutex> lock(g_default_mutex);
+    if (!g_default) g_default = make_env_allocator();
+    return g_default;
+}
+
+void set_default_allocator(std::shared_ptr<Allocator> alloc) {
+    std::lock_guard<std::mutex> lock(g_default_mutex);
+    g_default = alloc ? std::move(alloc) : make_env_allocator();
+}
+
+}  // namespace minidl
@@ -0,0 +1,124 @@
+#include "minidl/allocators/huge_page_allocator.h"
+
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "minidl/allocators/default.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#if defined(__linux__) && !defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT 26
+#endif
+
+namespace minidl {
+
+namespace {
+
+#if defined(__linux__)
+constexpr std::size_t kHuge = HugePageAllocator::kHugePageSize;
+// MAP_HUGETLB takes the pool's default page size unless the size is named: log2(2 MiB) = 21.
+constexpr int kMapHuge2MB = 21 << MAP_HUGE_SHIFT;
+
+// len bytes starting on a huge page boundary: a mapping one huge page longer, trimmed.
+void* map_aligned(std::size_t len) {
+    void* raw = ::mmap(nullptr, len + kHuge, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+    const auto base = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t start = detail::round_up(base, kHuge);
+    if (start != base) ::munmap(raw, start - base);
+    const std::size_t tail = base + len + kHuge - (start + len);
+    if (tail != 0) ::munmap(reinterpret_cast<void*>(start + len), tail);
+    return reinterpret_cast<void*>(start);
+}
+#endif
+
+}  // namespace
+
+HugePageAllocator::HugePageAllocator(Options options, std::shared_ptr<Allocator> upstream)
+    : options_(options), upstream_(std::move(upstream)) {
+    if (!upstream_) upstream_ = get_default_allocator();
+}
+
+HugePageAllocator::~HugePageAllocator() {
+#if defined(__linux__)
+    for (const auto& [p, len] : sizes_) ::munmap(p, len);
+#endif
+}
+
+void* HugePageAllocator::allocate(std::size_t nbytes, std::size_t alignment) {
+    if (nbytes == 0) return nullptr;
+    if (!detail::is_pow2(alignment)) throw std::runtime_error("HugePageAllocator: alignment must be a power of two.");
+#if defined(__linux__)
+    if (nbytes >= options_.threshold && alignment <= kHuge) {
+        // neither the rounding nor map_aligned's extra huge page may wrap.
+        if (nbytes > std::numeric_limits<std::size_t>::max() - 2 * kHuge) throw std::bad_alloc{};
+        const std::size_t len = detail::round_up(nbytes, kHuge);
+        void* p = nullptr;
+        if (options_.mode == HugePageMode::hugetlb) {
+            p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | kMapHuge2MB,
+                       -1, 0);
+            if (p == MAP_FAILED) {
+                p = nullptr;  // no reserved pages: fall back to transparent ones
+            } else {
+                ++hugetlb_blocks_;
+            }
+        }
+        if (!p) {
+            p = map_aligned(len);
+            if (!p) throw std::bad_alloc{};
+            // advisory: with THP off this fails and the block keeps small pages.
+            ::madvise(p, len, MADV_HUGEPAGE);
+            ++transparent_blocks_;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        sizes_.emplace(p, len);
+        return p;
+    }
+#endif
+    ++upstream_blocks_;
+    return upstream_->allocate(nbytes, alignment);
+}
+
+void HugePageAllocator::deallocate(void* data) {
+    if (!data) return;
+#if defined(__linux__)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = sizes_.find(data);
+        if (it != sizes_.end()) {
+            ::munmap(it->first, it->second);
+            sizes_.erase(it);
+            return;
+        }
+    }
+#endif
+    upstream_->deallocate(data);
+}
+
+HugePageStats HugePageAllocator::stats() const noexcept {
+    HugePageStats s;
+    s.hugetlb_blocks = hugetlb_blocks_.load(std::memory_order_relaxed);
+    s.transparent_blocks = transparent_blocks_.load(std::memory_order_relaxed);
+    s.upstream_blocks = upstream_blocks_.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool HugePageAllocator::transparent_available() {
+#if defined(__linux__)
+    std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string line;
+    std::getline(in, line);
+    return line.find("[always]") != std::string::npos || line.find("[madvise]") != std::string::npos;
+#else
+    return false;
+#endif
+}
+
+}  // namespace minidl
@@ -0,0 +1,58 @@
+#include "minidl/allocators/mapped_file_allocator.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "minidl/allocators/default.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace minidl {
+
+MappedFileAllocator::MappedFileAllocator(const std::string& path, MapMode mode, std::shared_ptr<Allocator> upstream)
+    : mode_(mode), upstream_(std::move(upstream)) {
+    if (!upstream_) upstream_ = get_default_allocator();
+#if defined(_WIN32)
+    (void)path;
+    throw std::runtime_error("MappedFileAllocator: not supported on this platform.");
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw std::runtime_error("MappedFileAllocator: cannot open " + path + ": " + std::strerror(errno));
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("MappedFileAllocator: " + path + " is empty or unreadable.");
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    const int prot = mode == MapMode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int flags = mode == MapMode::read_only ? MAP_SHARED : MAP_PRIVATE;
+    void* p = ::mmap(nullptr, size_, prot, flags, fd, 0);
+    const int err = errno;
+    ::close(fd);  // the mapping keeps the file alive
+    if (p == MAP_FAILED) throw std::runtime_error("MappedFileAllocator: cannot map " + path + ": " + std::strerror(err));
+    data_ = static_cast<std::byte*>(p);
+#endif
+}
+
+MappedFileAllocator::~MappedFileAllocator() {
+#if !defined(_WIN32)
+    if (data_) ::munmap(data_, size_);
+#endif
+}
+
+void* MappedFileAllocator::allocate(std::size_t nbytes, std::size_t alignment) {
+    return upstream_->allocate(nbytes, alignment);
+}
+
+void MappedFileAllocator::deallocate(void* data) {
+    if (!data || contains(data)) return;
+    upstream_->deallocate(data);
+}
+
+}  // namespace minidl
@@ -0,0 +1,134 @@
+#include "minidl/allocators/numa_allocator.h"
+
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "minidl/numa.h"
+#include "minidl/parallel.h"
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+namespace minidl {
+
+namespace {
+
+#if !defined(_WIN32)
+std::size_t page_size() {
+    static const std::size_t size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+#endif
+
+#if defined(__linux__) && defined(SYS_mbind)
+constexpr int kMpolBind = 2, kMpolInterleave = 3;
+
+// applies `mode` over `nodes` to [p, p + len); failures leave the range to first touch.
+void mbind(void* p, std::size_t len, int mode, const std::vector<std::size_t>& nodes) {
+    constexpr std::size_t kBits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(numa_num_nodes() / kBits + 1, 0);
+    for (std::size_t node : nodes) mask[node / kBits] |= 1ul << (node % kBits);
+    // maxnode counts one past the last bit the kernel reads.
+    ::syscall(SYS_mbind, p, len, mode, mask.data(), mask.size() * kBits + 1, 0);
+}
+
+void place(void* p, std::size_t len, NumaPolicy policy, std::size_t node) {
+    switch (policy) {
+        case NumaPolicy::bind:
+            mbind(p, len, kMpolBind, {node});
+            break;
+        case NumaPolicy::interleave: {
+            std::vector<std::size_t> all(numa_num_nodes());
+            for (std::size_t k = 0; k < all.size(); ++k) all[k] = k;
+            mbind(p, len, kMpolInterleave, all);
+            break;
+        }
+        case NumaPolicy::partitioned: {
+            // task t of a parallel_for over the whole pool gets pages [t, t + 1) * pages / tasks;
+            // each run of tasks on one node is bound to it.
+            const std::size_t tasks = get_num_threads();
+            const std::size_t pages = len / page_size();
+            std::size_t first = 0;
+            for (std::size_t t = 0; t < tasks; ++t) {
+                const std::size_t node = detail::numa_task_node(t, tasks);
+                if (t + 1 < tasks && detail::numa_task_node(t + 1, tasks) == node) continue;
+                const std::size_t last = (t + 1) * pages / tasks;
+                if (last != first) {
+                    mbind(static_cast<std::byte*>(p) + first * page_size(), (last - first) * page_size(), kMpolBind,
+                          {node});
+                }
+                first = last;
+            }
+            break;
+        }
+    }
+}
+#else
+void place(void*, std::size_t, NumaPolicy, std::size_t) {}
+#endif
+
+}  // namespace
+
+NumaAllocator::NumaAllocator(NumaPolicy policy, std::size_t node) : policy_(policy), node_(node) {
+    if (node >= numa_num_nodes()) throw std::runtime_error("NumaAllocator: no node " + std::to_string(node) + ".");
+}
+
+NumaAllocator::~NumaAllocator() {
+    for (const auto& [p, len] : sizes_) {
+#if defined(_WIN32)
+        (void)len;
+        _aligned_free(p);
+#else
+        ::munmap(p, len);
+#endif
+    }
+}
+
+void* NumaAllocator::allocate(std::size_t nbytes, std::size_t alignment) {
+    if (nbytes == 0) return nullptr;
+    if (!detail::is_pow2(alignment)) throw std::runtime_error("NumaAllocator: alignment must be a power of two.");
+#if defined(_WIN32)
+    void* p = _aligned_malloc(nbytes, alignment);
+    if (!p) throw std::bad_alloc{};
+    const std::size_t len = nbytes;
+#else
+    if (alignment > page_size()) throw std::runtime_error("NumaAllocator: alignment exceeds the page size.");
+    const std::size_t len = detail::round_up(nbytes, page_size());
+    void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc{};
+    // before any page is touched, so the policy decides where every page goes.
+    place(p, len, policy_, node_);
+#endif
+    std::lock_guard<std::mutex> lock(mutex_);
+    sizes_.emplace(p, len);
+    return p;
+}
+
+void NumaAllocator::deallocate(void* data) {
+    if (!data) return;
+    std::size_t len = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = sizes_.find(data);
+        if (it == sizes_.end()) throw std::runtime_error("NumaAllocator: pointer was not allocated here.");
+        len = it->second;
+        sizes_.erase(it);
+    }
+#if defined(_WIN32)
+    (void)len;
+    _aligned_free(data);
+#else
+    ::munmap(data, len);
+#endif
+}
+
+}  // namespace minidl
@@ -0,0 +1,64 @@
+#include "minidl/allocators/tracking_allocator.h"
+
+#include "minidl/allocators/system_allocator.h"
+
+namespace minidl {
+
+TrackingAllocator::TrackingAllocator(std::shared_ptr<Allocator> inner) : inner_(std::move(inner)) {
+    if (!inner_) inner_ = std::make_shared<SystemAllocator>();
+}
+
+void* TrackingAllocator::allocate(std::size_t nbytes, std::size_t alignment) {
+    void* p = inner_->allocate(nbytes, alignment);
+    if (!p) return p;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    live_[p] = nbytes;
+    live_bytes_ += nbytes;
+    total_allocations_++;
+    if (live_bytes_ > peak_bytes_) peak_bytes_ = live_bytes_;
+    return p;
+}
+
+void TrackingAllocator::deallocate(void* data) {
+    if (!data) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = live_.find(data);
+        if (it == live_.end()) {
+            // double free or foreign pointer; called from destructors, so count instead of throwing.
+            invalid_frees_++;
+            return;
+        }
+        live_bytes_ -= it->second;
+        live_.erase(it);
+    }
+    inner_->deallocate(data);
+}
+
+std::size_t TrackingAllocator::live_allocations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_.size();
+}
+
+std::size_t TrackingAllocator::live_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_bytes_;
+}
+
+std::size_t TrackingAllocator::total_allocations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_allocations_;
+}
+
+std::size_t TrackingAllocator::invalid_frees() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return invalid_frees_;
+}
+
+std::size_t TrackingAllocator::peak_bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_bytes_;
+}
+
+}  // namespace minidl
@@ -0,0 +1,129 @@
+#include "minidl/detail/autograd.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace minidl {
+
+namespace detail {
+
+namespace {
+
+thread_local bool grad_mode = true;
+
+// out = a view of the input with another layout over the same storage. The input's gradient
+// is g scattered back to where out's elements sit in the input; elements the view skipped
+// get zero.
+class ViewBackward final : public Node {
+   public:
+    ViewBackward(const Tensor& in, const Tensor& out)
+        : in_shape_(in.shape()),
+          in_strides_(in.strides()),
+          out_strides_(out.strides()),
+          offset_(out.storage_offset() - in.storage_offset()),
+          dense_(in.is_contiguous() && out.is_contiguous()),
+          covers_(in.numel() == out.numel()) {}
+
+    std::vector<std::optional<Tensor>> apply(const Tensor& g) override {
+        const auto& dims = in_shape_.dims();
+        // view / reshape of a contiguous tensor: the same elements in the same order.
+        if (covers_ && dense_) return {g.reshape(in_shape_)};
+        if (in_shape_.numel() == 0) return {Tensor::zeros(in_shape_, g.dtype(), g.storage()->alloc_)};
+
+        // a buffer laid out as the input, so that out's strides and offset find the same
+        // elements in it. A view that covers every input element writes all of it.
+        const std::size_t extent = extent_elems(dims, in_strides_);
+        const Shape flat(std::vector<std::size_t>{extent});
+        Tensor buf = covers_ ? Tensor::empty(flat, g.dtype(), g.storage()->alloc_)
+                             : Tensor::zeros(flat, g.dtype(), g.storage()->alloc_);
+        Tensor::from_storage(buf.storage(), g.shape(), g.dtype(), out_strides_, offset_).copy_(g);
+        return {Tensor::from_storage(buf.storage(), in_shape_, g.dtype(), in_strides_)};
+    }
+
+   private:
+    Shape in_shape_;
+    std::vector<std::size_t> in_strides_;
+    std::vector<std::size_t> out_strides_;
+    std::size_t offset_;
+    bool dense_;
+    bool covers_;
+};
+
+// contiguous() and to(): the gradient passes through, and the engine converts it to the
+// input's dtype.
+class CopyBackward final : public Node {
+   public:
+    std::vector<std::optional<Tensor>> apply(const Tensor& g) override { return {g}; }
+};
+
+}  // namespace
+
+bool grad_enabled() noexcept { return grad_mode; }
+
+void set_grad_enabled(bool enabled) noexcept { grad_mode = enabled; }
+
+void require_no_grad(const char* op, std::initializer_list<const Tensor*> inputs) {
+    if (needs_grad(inputs)) throw std::runtime_error(std::string(op) + " is not differentiable; detach() the input.");
+}
+
+void record(Tensor& out, std::shared_ptr<Node> node, std::initializer_list<const Tensor*> inputs) {
+    node->next.reserve(inputs.size());
+    for (const Tensor* t : inputs) {
+        node->next.push_back({t->requires_grad() ? t->autograd_meta() : nullptr, t->dtype()});
+    }
+    auto meta = std::make_shared<AutogradMeta>();
+    meta->requires_grad = true;
+    meta->grad_fn = std::move(node);
+    out.set_autograd_meta(std::move(meta));
+}
+
+void record_view(Tensor& out, const Tensor& base) {
+    out.set_autograd_meta(nullptr);
+    if (needs_grad({&base})) record(out, std::make_shared<ViewBackward>(base, out), {&base});
+}
+
+void record_copy(Tensor& out, const Tensor& base) {
+    out.set_autograd_meta(nullptr);
+    if (needs_grad({&base})) record(out, std::make_shared<CopyBackward>(), {&base});
+}
+
+}  // namespace detail
+
+Tensor& Tensor::set_requires_grad(bool requires_grad) {
+    if (autograd_ && autograd_->grad_fn) {
+        throw std::runtime_error("set_requires_grad: only leaf tensors can be marked (use detach()).");
+    }
+    if (requires_grad && !is_floating_point(dtype_)) {
+        throw std::runtime_error("set_requires_grad: only floating-point tensors can require grad.");
+    }
+    if (!autograd_) {
+        if (!requires_grad) return *this;
+        autograd_ = std::make_shared<detail::AutogradMeta>();
+    }
+    autograd_->requires_grad = requires_grad;
+    return *this;
+}
+
+bool Tensor::requires_grad() const noexcept { return autograd_ && autograd_->requires_grad; }
+
+const Tensor* Tensor::grad() const noexcept {
+    if (!autograd_ || !autograd_->grad) return nullptr;
+    return &*autograd_->grad;
+}
+
+void Tensor::zero_grad() {
+    if (!autograd_ || !autograd_->grad) return;
+    Tensor& g = *autograd_->grad;
+    if (g.numel() != 0) std::memset(g.data(), 0, g.nbytes());
+    autograd_->grad_is_zero = true;
+}
+
+Tensor Tensor::detach() const {
+    Tensor out = *this;
+    out.autograd_ = nullptr;
+    return out;
+}
+
+}  // namespace minidl
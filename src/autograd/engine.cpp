@@ -0,0 +1,138 @@
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minidl/autograd.h"
+#include "minidl/ops.h"
+
+namespace minidl::autograd {
+
+namespace {
+
+using detail::AutogradMeta;
+using detail::Node;
+
+// nothing else holds t's buffer, and every element has a place of its own in it: gradients
+// can be added into it in place.
+bool owns_buffer(const Tensor& t) {
+    return t.numel() != 0 && t.is_contiguous() && t.storage().use_count() == 1;
+}
+
+// slot += g, in place when one of the two is a buffer backward owns.
+void accumulate(std::optional<Tensor>& slot, Tensor g) {
+    if (!slot) {
+        slot = std::move(g);
+    } else if (owns_buffer(*slot)) {
+        ops::add_(*slot, g);
+    } else if (owns_buffer(g)) {
+        ops::add_(g, *slot);
+        slot = std::move(g);
+    } else {
+        slot = ops::add(*slot, g);
+    }
+}
+
+// a leaf keeps its grad buffer: the first gradient is adopted (or copied when shared),
+// later ones are copied or added into it.
+void accumulate_leaf(AutogradMeta& meta, Tensor g) {
+    if (!meta.grad) {
+        if (!owns_buffer(g)) {
+            Tensor own = Tensor::empty(g.shape(), g.dtype(), g.storage()->alloc_);
+            own.copy_(g);
+            g = std::move(own);
+        }
+        meta.grad = std::move(g);
+    } else if (meta.grad_is_zero) {
+        meta.grad->copy_(g);
+    } else {
+        ops::add_(*meta.grad, g);
+    }
+    meta.grad_is_zero = false;
+}
+
+struct Pending {
+    std::optional<Tensor> grad;
+    std::size_t deps = 0;  // edges from nodes that have not run yet
+};
+
+void run(const Tensor& root, Tensor seed, bool retain_graph) {
+    if (!root.requires_grad()) throw std::runtime_error("backward: tensor does not require grad.");
+    if (seed.dtype() != root.dtype()) seed = seed.to(root.dtype());
+    NoGradGuard no_grad;
+
+    const auto& meta = root.autograd_meta();
+    if (!meta->grad_fn) {
+        accumulate_leaf(*meta, std::move(seed));
+        return;
+    }
+
+    // every node root depends on, with the number of edges into it.
+    std::unordered_map<Node*, Pending> graph;
+    std::vector<Node*> stack{meta->grad_fn.get()};
+    graph[stack.back()];
+    while (!stack.empty()) {
+        Node* node = stack.back();
+        stack.pop_back();
+        if (node->released) {
+            throw std::runtime_error("backward: the graph was already freed; pass retain_graph to run it again.");
+        }
+        for (const detail::Edge& edge : node->next) {
+            if (!edge.meta || !edge.meta->grad_fn) continue;
+            Node* input = edge.meta->grad_fn.get();
+            const auto [it, inserted] = graph.try_emplace(input);
+            ++it->second.deps;
+            if (inserted) stack.push_back(input);
+        }
+    }
+
+    graph[meta->grad_fn.get()].grad = std::move(seed);
+    std::vector<Node*> ready{meta->grad_fn.get()};
+    while (!ready.empty()) {
+        Node* node = ready.back();
+        ready.pop_back();
+        std::vector<std::optional<Tensor>> grads;
+        {
+            const auto it = graph.find(node);
+            const Tensor g = std::move(*it->second.grad);
+            graph.erase(it);
+            grads = node->apply(g);
+        }
+        if (!retain_graph) {
+            node->release();
+            node->released = true;
+        }
+
+        for (std::size_t i = 0; i < node->next.size(); ++i) {
+            const detail::Edge& edge = node->next[i];
+            if (!edge.meta || !grads[i]) continue;
+            Tensor g = std::move(*grads[i]);
+            grads[i].reset();
+            if (g.dtype() != edge.dtype) g = g.to(edge.dtype);
+            if (!edge.meta->grad_fn) {
+                if (edge.meta->requires_grad) accumulate_leaf(*edge.meta, std::move(g));
+                continue;
+            }
+            Node* input = edge.meta->grad_fn.get();
+            Pending& pending = graph[input];
+            accumulate(pending.grad, std::move(g));
+            if (--pending.deps == 0) ready.push_back(input);
+        }
+    }
+}
+
+}  // namespace
+
+void backward(const Tensor& root, bool retain_graph) {
+    if (root.numel() != 1) {
+        throw std::runtime_error("backward: root must have one element (pass its gradient otherwise).");
+    }
+    run(root, Tensor::ones(root.shape(), root.dtype(), root.storage()->alloc_), retain_graph);
+}
+
+void backward(const Tensor& root, const Tensor& grad, bool retain_graph) {
+    if (grad.shape().dims() != root.shape().dims()) throw std::runtime_error("backward: grad must have root's shape.");
+    run(root, grad, retain_graph);
+}
+
+}  // namespace minidl::autograd
@@ -0,0 +1,209 @@
+#include <stdexcept>
+#include <utility>
+
+#include "minidl/detail/autograd.h"
+#include "minidl/ops.h"
+
+namespace minidl::detail {
+
+namespace {
+
+Tensor scalar(float value, DType dtype) {
+    Tensor t = Tensor::empty(Shape(std::vector<std::size_t>{}), DType::f32);
+    *static_cast<float*>(t.data()) = value;
+    return t.to(dtype);
+}
+
+Tensor neg(const Tensor& g) { return ops::sub(scalar(0.0f, g.dtype()), g); }
+
+// g summed down to `shape`, undoing the broadcast that took an operand of that shape to g's.
+Tensor sum_to(const Tensor& g, const Shape& shape) {
+    const auto& from = g.shape().dims();
+    const auto& to = shape.dims();
+    if (from == to) return g;
+    const std::size_t lead = from.size() - to.size();
+    std::vector<std::size_t> axes;
+    for (std::size_t d = 0; d < from.size(); ++d) {
+        if (d < lead || (to[d - lead] == 1 && from[d] != 1)) axes.push_back(d);
+    }
+    if (axes.empty()) return g.reshape(shape);
+    return ops::sum(g, axes).reshape(shape);
+}
+
+// the last two dims swapped, in place.
+Tensor transpose_last2(const Tensor& t) {
+    std::vector<std::size_t> dims = t.shape().dims();
+    std::vector<std::size_t> strides = t.strides();
+    const std::size_t r = dims.size();
+    std::swap(dims[r - 1], dims[r - 2]);
+    std::swap(strides[r - 1], strides[r - 2]);
+    return Tensor::from_storage(t.storage(), Shape(dims), t.dtype(), std::move(strides), t.storage_offset());
+}
+
+// Saved operands are detach()ed: an output saved by its own node would otherwise keep the
+// node alive through its meta.
+class BinaryBackward final : public Node {
+   public:
+    BinaryBackward(BinaryGrad kind, const Tensor& a, const Tensor& b, const Tensor& out)
+        : kind_(kind), a_shape_(a.shape()), b_shape_(b.shape()) {
+        const bool ga = a.requires_grad(), gb = b.requires_grad();
+        if (kind == BinaryGrad::mul) {
+            if (gb) a_ = a.detach();
+            if (ga) b_ = b.detach();
+        } else if (kind == BinaryGrad::div) {
+            b_ = b.detach();
+            if (gb) out_ = out.detach();
+        }
+    }
+
+    std::vector<std::optional<Tensor>> apply(const Tensor& g) override {
+        std::vector<std::optional<Tensor>> grads(2);
+        const bool ga = next[0].meta != nullptr, gb = next[1].meta != nullptr;
+        switch (kind_) {
+            case BinaryGrad::add:
+                if (ga) grads[0] = sum_to(g, a_shape_);
+                if (gb) grads[1] = sum_to(g, b_shape_);
+                break;
+            case BinaryGrad::sub:
+                if (ga) grads[0] = sum_to(g, a_shape_);
+                if (gb) grads[1] = sum_to(neg(g), b_shape_);
+                break;
+            case BinaryGrad::mul:
+                if (ga) grads[0] = sum_to(ops::mul(g, *b_), a_shape_);
+                if (gb) grads[1] = sum_to(ops::mul(g, *a_), b_shape_);
+                break;
+            case BinaryGrad::div:
+                // d(a/b)/db = -(a/b)/b
+                if (ga) grads[0] = sum_to(ops::div(g, *b_), a_shape_);
+                if (gb) grads[1] = sum_to(neg(ops::div(ops::mul(g, *out_), *b_)), b_shape_);
+                break;
+            case BinaryGrad::none:
+                break;
+        }
+        return grads;
+    }
+
+    void release() override {
+        a_.reset();
+        b_.reset();
+        out_.reset();
+    }
+
+   private:
+    BinaryGrad kind_;
+    Shape a_shape_, b_shape_;
+    std::optional<Tensor> a_, b_, out_;
+};
+
+class UnaryBackward final : public Node {
+   public:
+    // exp, tanh and sigmoid differentiate through their output, log and relu through x.
+    UnaryBackward(UnaryGrad kind, const Tensor& x, const Tensor& out)
+        : kind_(kind), saved_(kind == UnaryGrad::log || kind == UnaryGrad::relu ? x.detach() : out.detach()) {}
+
+    std::vector<std::optional<Tensor>> apply(const Tensor& g) override {
+        const Tensor& s = *saved_;
+        switch (kind_) {
+            case UnaryGrad::exp:
+                return {ops::mul(g, s)};
+            case UnaryGrad::log:
+                return {ops::div(g, s)};
+            case UnaryGrad::tanh:
+                return {ops::mul(g, ops::sub(scalar(1.0f, s.dtype()), ops::mul(s, s)))};
+            case UnaryGrad::sigmoid:
+                return {ops::mul(ops::mul(g, s), ops::sub(scalar(1.0f, s.dtype()), s))};
+            case UnaryGrad::relu:
+                // the bool mask promotes to g's dtype.
+                return {ops::mul(g, ops::gt(s, scalar(0.0f, s.dtype())))};
+        }
+        return {std::nullopt};
+    }
+
+    void release() override { saved_.reset(); }
+
+   private:
+    UnaryGrad kind_;
+    std::optional<Tensor> saved_;
+};
+
+class MatmulBackward final : public Node {
+   public:
+    MatmulBackward(const Tensor& a, const Tensor& b) : a_shape_(a.shape()), b_shape_(b.shape()) {
+        if (b.requires_grad()) a_ = a.detach();
+        if (a.requires_grad()) b_ = b.detach();
+    }
+
+    std::vector<std::optional<Tensor>> apply(const Tensor& g) override {
+        std::vector<std::optional<Tensor>> grads(2);
+        if (next[0].meta) grads[0] = sum_to(ops::matmul(g, transpose_last2(*b_)), a_shape_);
+        if (next[1].meta) grads[1] = sum_to(ops::matmul(transpose_last2(*a_), g), b_shape_);
+        return grads;
+    }
+
+    void release() override {
+        a_.reset();
+        b_.reset();
+    }
+
+   private:
+    Shape a_shape_, b_shape_;
+    std::optional<Tensor> a_, b_;
+};
+
+// g spread back over the reduced dims as a zero-stride view, scaled by 1/count for mean.
+class ReduceBackward final : public Node {
+   public:
+    ReduceBackward(ReduceGrad kind, const Tensor& x, const Tensor& out, const std::vector<std::size_t>& axes)
+        : kind_(kind), x_shape_(x.shape()), reduced_(x.rank(), axes.empty()) {
+        for (std::size_t a : axes) reduced_[a] = true;
+        count_ = out.numel() == 0 ? 0 : x.numel() / out.numel();
+    }
+
+    std::vector<std::optional<Tensor>> apply(const Tensor& g) override {
+        if (x_shape_.numel() == 0) return {Tensor::zeros(x_shape_, g.dtype(), g.storage()->alloc_)};
+        const Tensor src = kind_ == ReduceGrad::mean
+                               ? ops::mul(g, scalar(1.0f / static_cast<float>(count_), g.dtype()))
+                               : g.contiguous();
+        // g holds one element per kept index, in order, whether or not keepdim kept the
+        // reduced dims; the expanded view steps over them with stride 0.
+        const auto& dims = x_shape_.dims();
+        std::vector<std::size_t> strides(dims.size(), 0);
+        std::size_t stride = 1;
+        for (std::size_t d = dims.size(); d-- > 0;) {
+            if (reduced_[d]) continue;
+            strides[d] = stride;
+            stride *= dims[d];
+        }
+        return {Tensor::from_storage(src.storage(), x_shape_, src.dtype(), std::move(strides), src.storage_offset())};
+    }
+
+   private:
+    ReduceGrad kind_;
+    Shape x_shape_;
+    std::vector<bool> reduced_;
+    std::size_t count_ = 0;
+};
+
+}  // namespace
+
+void record_binary(BinaryGrad kind, Tensor& out, const Tensor& a, const Tensor& b) {
+    if (kind == BinaryGrad::none || !needs_grad({&a, &b})) return;
+    record(out, std::make_shared<BinaryBackward>(kind, a, b, out), {&a, &b});
+}
+
+void record_unary(UnaryGrad kind, Tensor& out, const Tensor& x) {
+    if (!needs_grad({&x})) return;
+    record(out, std::make_shared<UnaryBackward>(kind, x, out), {&x});
+}
+
+void record_matmul(Tensor& out, const Tensor& a, const Tensor& b) {
+    if (!needs_grad({&a, &b})) return;
+    record(out, std::make_shared<MatmulBackward>(a, b), {&a, &b});
+}
+
+void record_reduce(ReduceGrad kind, Tensor& out, const Tensor& x, const std::vector<std::size_t>& axes) {
+    if (!needs_grad({&x})) return;
+    record(out, std::make_shared<ReduceBackward>(kind, x, out, axes), {&x});
+}
+
+}  // namespace minidl::detail
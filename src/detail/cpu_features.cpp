@@ -0,0 +1,124 @@
+#include "minidl/detail/cpu_features.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MINIDL_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace minidl::detail {
+
+namespace {
+
+#if defined(MINIDL_X86)
+void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i) regs[i] = static_cast<unsigned>(r[i]);
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+std::uint64_t xgetbv0() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    return _xgetbv(0);
+#else
+    std::uint32_t lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<std::uint64_t>(hi) << 32) | lo;
+#endif
+}
+#endif
+
+CpuCapability detect() noexcept {
+#if defined(MINIDL_X86)
+    unsigned r[4];
+    cpuid(0, 0, r);
+    const unsigned max_leaf = r[0];
+    if (max_leaf < 7) return CpuCapability::scalar;
+
+    cpuid(1, 0, r);
+    const bool fma = (r[2] >> 12) & 1;
+    const bool f16c = (r[2] >> 29) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx = (r[2] >> 28) & 1;
+    if (!osxsave || !avx) return CpuCapability::scalar;
+
+    // the OS must save the ymm (bits 1,2) and opmask/zmm (bits 5,6,7) state.
+    const std::uint64_t xcr0 = xgetbv0();
+    const bool os_ymm = (xcr0 & 0x6) == 0x6;
+    const bool os_zmm = (xcr0 & 0xE6) == 0xE6;
+
+    cpuid(7, 0, r);
+    const bool avx2 = (r[1] >> 5) & 1;
+    const bool avx512f = (r[1] >> 16) & 1;
+
+    if (avx512f && avx2 && fma && f16c && os_zmm) return CpuCapability::avx512;
+    if (avx2 && fma && f16c && os_ymm) return CpuCapability::avx2;
+    return CpuCapability::scalar;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return CpuCapability::neon;
+#else
+    return CpuCapability::scalar;
+#endif
+}
+
+bool detect_avx512_bf16() noexcept {
+#if defined(MINIDL_X86)
+    unsigned r[4];
+    cpuid(7, 0, r);
+    if (r[0] < 1) return false;  // no subleaf 1
+    cpuid(7, 1, r);
+    return (r[0] >> 5) & 1;
+#else
+    return false;
+#endif
+}
+
+CpuCapability apply_env_override(CpuCapability detected) noexcept {
+    const char* env = std::getenv("MINIDL_CPU_CAPABILITY");
+    if (!env) return detected;
+
+    if (std::strcmp(env, "scalar") == 0) return CpuCapability::scalar;
+    if (detected == CpuCapability::neon) return detected;
+    if (std::strcmp(env, "avx2") == 0 && detected == CpuCapability::avx512) return CpuCapability::avx2;
+    return detected;
+}
+
+}  // namespace
+
+CpuCapability cpu_capability() noexcept {
+    static const CpuCapability cap = apply_env_override(detect());
+    return cap;
+}
+
+bool cpu_has_avx512_bf16() noexcept {
+    static const bool has = cpu_capability() == CpuCapability::avx512 && detect_avx512_bf16();
+    return has;
+}
+
+const char* to_string(CpuCapability cap) noexcept {
+    switch (cap) {
+        case CpuCapability::scalar:
+            return "scalar";
+        case CpuCapability::neon:
+            return "neon";
+        case CpuCapability::avx2:
+            return "avx2";
+        case CpuCapability::avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+}  // namespace minidl::detail
@@ -1,5 +1,7 @@
 #include "minidl/detail/iter.h"
 
+#include <cstdint>
+
 namespace minidl::detail {
 
 void NdCounter::next() {
@@ -21,4 +23,19 @@ void NdCounter::next() {
     finished = true;
 }
 
+void NdCounter::seek(std::size_t linear) {
+    std::size_t numel = 1;
+    for (auto d : shape) numel *= d;
+    if (linear >= numel) {
+        finished = true;
+        return;
+    }
+
+    finished = false;
+    for (std::size_t d = shape.size(); d-- > 0;) {
+        idx[d] = linear % shape[d];
+        linear /= shape[d];
+    }
+}
+
 }  // namespace minidl::detail
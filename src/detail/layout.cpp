@@ -1,10 +1,14 @@
 #include "minidl/detail/layout.h"
 
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
 namespace minidl::detail {
 
 std::vector<std::size_t> default_strides(const std::vector<std::size_t>& shape) {
     // stride in element
-    const std::int64_t r = static_cast<const std::int64_t>(shape.size());
+    const std::int64_t r = static_cast<std::int64_t>(shape.size());
     std::vector<std::size_t> strides;
 
     // empty strides
@@ -20,7 +24,7 @@ std::vector<std::size_t> default_strides(const std::vector<std::size_t>& shape)
 }
 
 bool is_contiguous(const std::vector<std::size_t>& shape, const std::vector<std::size_t>& strides) {
-    const std::int64_t r = static_cast<const std::int64_t>(shape.size());
+    const std::int64_t r = static_cast<std::int64_t>(shape.size());
     std::size_t expected = 1;
     for (std::int64_t d = r - 1; d >= 0; d--) {
         const std::size_t dim = shape[static_cast<std::size_t>(d)];
@@ -35,4 +39,80 @@ bool is_contiguous(const std::vector<std::size_t>& shape, const std::vector<std:
     return true;
 }
 
+std::size_t extent_elems(const std::vector<std::size_t>& shape, const std::vector<std::size_t>& strides) {
+    std::size_t last = 0;
+    for (std::size_t d = 0; d < shape.size(); d++) {
+        if (shape[d] == 0) return 0;
+        last += (shape[d] - 1) * strides[d];
+    }
+    return last + 1;
+}
+
+bool numel_overflows(const std::vector<std::size_t>& shape) {
+    if (std::find(shape.begin(), shape.end(), std::size_t{0}) != shape.end()) return false;
+    std::size_t numel = 1;
+    for (std::size_t d : shape) {
+        if (numel > std::numeric_limits<std::size_t>::max() / d) return true;
+        numel *= d;
+    }
+    return false;
+}
+
+bool has_internal_overlap(const std::vector<std::size_t>& shape, const std::vector<std::size_t>& strides) {
+    for (std::size_t d = 0; d < shape.size(); d++) {
+        if (shape[d] > 1 && strides[d] == 0) return true;
+    }
+    return false;
+}
+
+namespace {
+
+// appends (size, stride), merging it into the previous dim when the two are contiguous.
+void push_coalesced(std::vector<std::size_t>& sizes, std::vector<std::size_t>& strides, std::size_t size,
+                    std::size_t stride) {
+    if (size == 1) return;
+    if (!sizes.empty() && strides.back() == stride * size) {
+        sizes.back() *= size;
+        strides.back() = stride;
+        return;
+    }
+    sizes.push_back(size);
+    strides.push_back(stride);
+}
+
+}  // namespace
+
+ReduceLayout reduce_layout(const std::vector<std::size_t>& shape, const std::vector<std::size_t>& strides,
+                           const std::vector<std::size_t>& axes, bool keepdim) {
+    const std::size_t r = shape.size();
+    std::vector<bool> reduced(r, axes.empty());
+    for (auto a : axes) {
+        if (a >= r) throw std::runtime_error("reduce: axis out of range.");
+        if (reduced[a]) throw std::runtime_error("reduce: duplicate axis.");
+        reduced[a] = true;
+    }
+
+    ReduceLayout l;
+    for (std::size_t d = 0; d < r; d++) {
+        if (reduced[d]) {
+            if (keepdim) l.out_shape.push_back(1);
+            push_coalesced(l.inner_sizes, l.inner_strides, shape[d], strides[d]);
+            l.inner_numel *= shape[d];
+        } else {
+            l.out_shape.push_back(shape[d]);
+            push_coalesced(l.outer_sizes, l.outer_strides, shape[d], strides[d]);
+            l.outer_numel *= shape[d];
+        }
+    }
+    if (l.outer_sizes.empty()) {
+        l.outer_sizes.push_back(1);
+        l.outer_strides.push_back(0);
+    }
+    if (l.inner_sizes.empty()) {
+        l.inner_sizes.push_back(1);
+        l.inner_strides.push_back(0);
+    }
+    return l;
+}
+
 }  // namespace minidl::detail
@@ -0,0 +1,167 @@
+#include "minidl/numa.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace minidl {
+
+namespace {
+
+struct Topology {
+    std::vector<std::vector<std::size_t>> cpus;  // per node
+    std::vector<std::size_t> cpu_nodes;
+};
+
+// "0-3,8,10-11" as the listed numbers; empty if the string is malformed.
+std::vector<std::size_t> parse_list(const std::string& text) {
+    std::vector<std::size_t> out;
+    std::size_t pos = 0;
+    while (pos < text.size() && text[pos] != '\n') {
+        std::size_t len = 0;
+        std::size_t lo = 0, hi = 0;
+        try {
+            lo = std::stoul(text.substr(pos), &len);
+        } catch (const std::exception&) {
+            return {};
+        }
+        pos += len;
+        hi = lo;
+        if (pos < text.size() && text[pos] == '-') {
+            try {
+                hi = std::stoul(text.substr(pos + 1), &len);
+            } catch (const std::exception&) {
+                return {};
+            }
+            pos += len + 1;
+        }
+        for (std::size_t v = lo; v <= hi; ++v) out.push_back(v);
+        if (pos < text.size() && text[pos] == ',') ++pos;
+    }
+    return out;
+}
+
+std::string read_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+Topology load_topology() {
+    Topology t;
+#if defined(__linux__)
+    const std::vector<std::size_t> online = parse_list(read_line("/sys/devices/system/node/online"));
+    if (!online.empty()) {
+        t.cpus.resize(online.back() + 1);
+        for (std::size_t node : online) {
+            t.cpus[node] = parse_list(read_line("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+        }
+    }
+#endif
+    if (t.cpus.empty()) {
+        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        t.cpus.emplace_back();
+        for (std::size_t c = 0; c < hw; ++c) t.cpus[0].push_back(c);
+    }
+    for (std::size_t node = 0; node < t.cpus.size(); ++node) {
+        if (!t.cpus[node].empty()) t.cpu_nodes.push_back(node);
+    }
+    if (t.cpu_nodes.empty()) t.cpu_nodes.push_back(0);
+    return t;
+}
+
+const Topology& topology() {
+    static const Topology t = load_topology();
+    return t;
+}
+
+#if defined(__linux__)
+constexpr std::size_t kMaskBits = 8 * sizeof(unsigned long);
+
+// the thread's CPU mask, large enough for every CPU of the topology.
+std::vector<unsigned long> mask_for(std::size_t node) {
+    std::size_t max_cpu = 0;
+    for (const auto& cpus : topology().cpus) {
+        for (std::size_t c : cpus) max_cpu = std::max(max_cpu, c);
+    }
+    std::vector<unsigned long> mask(std::max<std::size_t>(max_cpu / kMaskBits + 1, CPU_SETSIZE / kMaskBits), 0);
+    for (std::size_t c : topology().cpus[node]) mask[c / kMaskBits] |= 1ul << (c % kMaskBits);
+    return mask;
+}
+
+bool set_affinity(const std::vector<unsigned long>& mask) {
+    return ::sched_setaffinity(0, mask.size() * sizeof(unsigned long),
+                               reinterpret_cast<const cpu_set_t*>(mask.data())) == 0;
+}
+#endif
+
+}  // namespace
+
+std::size_t numa_num_nodes() { return topology().cpus.size(); }
+
+const std::vector<std::size_t>& numa_node_cpus(std::size_t node) {
+    if (node >= numa_num_nodes()) throw std::runtime_error("numa_node_cpus: no node " + std::to_string(node) + ".");
+    return topology().cpus[node];
+}
+
+const std::vector<std::size_t>& numa_cpu_nodes() { return topology().cpu_nodes; }
+
+int numa_node_of(const void* p) {
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+    constexpr int kNodeOfAddr = 1 | 2;  // MPOL_F_NODE | MPOL_F_ADDR
+    int node = -1;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, p, kNodeOfAddr) != 0) return -1;
+    return node;
+#else
+    (void)p;
+    return -1;
+#endif
+}
+
+ScopedNodeAffinity::ScopedNodeAffinity(std::size_t node) {
+    if (node >= numa_num_nodes()) throw std::runtime_error("ScopedNodeAffinity: no node " + std::to_string(node) + ".");
+#if defined(__linux__)
+    std::vector<unsigned long> saved = mask_for(node);
+    if (::sched_getaffinity(0, saved.size() * sizeof(unsigned long), reinterpret_cast<cpu_set_t*>(saved.data())) != 0) {
+        return;
+    }
+    if (detail::pin_current_thread(node)) saved_ = std::move(saved);
+#endif
+}
+
+ScopedNodeAffinity::~ScopedNodeAffinity() {
+#if defined(__linux__)
+    if (active()) set_affinity(saved_);
+#endif
+}
+
+namespace detail {
+
+std::size_t numa_task_node(std::size_t task, std::size_t num_tasks) {
+    const auto& nodes = numa_cpu_nodes();
+    if (num_tasks == 0) return nodes.front();
+    return nodes[std::min(task, num_tasks - 1) * nodes.size() / num_tasks];
+}
+
+bool pin_current_thread(std::size_t node) {
+#if defined(__linux__)
+    if (node >= numa_num_nodes() || topology().cpus[node].empty()) return false;
+    return set_affinity(mask_for(node));
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+}  // namespace detail
+
+}  // namespace minidl
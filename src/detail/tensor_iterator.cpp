@@ -0,0 +1,80 @@
+#include "minidl/detail/tensor_iterator.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace minidl::detail {
+
+namespace {
+
+// >0 if dim a should sit outside dim b, <0 if inside, 0 if no operand decides.
+int should_swap(const std::vector<std::vector<std::size_t>>& strides, const std::vector<std::size_t>& shape,
+                std::size_t a, std::size_t b) {
+    for (const auto& s : strides) {
+        // a broadcast (stride 0) dim says nothing about memory order.
+        if (s[a] == 0 || s[b] == 0) continue;
+        if (s[a] < s[b]) return -1;
+        if (s[a] > s[b]) return 1;
+        if (shape[a] > shape[b]) return 1;
+    }
+    return 0;
+}
+
+}  // namespace
+
+TensorIterator::TensorIterator(const std::vector<std::size_t>& shape,
+                               const std::vector<std::vector<std::size_t>>& strides)
+    : ntensors_(strides.size()) {
+    const std::size_t rank = shape.size();
+    for (const auto& s : strides) {
+        if (s.size() != rank) throw std::runtime_error("TensorIterator: strides rank mismatch.");
+    }
+    for (auto d : shape) numel_ *= d;
+    if (numel_ == 0) {
+        shape_.assign(1, 0);
+        strides_.assign(ntensors_, 0);
+        return;
+    }
+
+    // candidate dims, innermost first; size-1 dims never move any pointer.
+    std::vector<std::size_t> perm;
+    for (std::size_t d = rank; d-- > 0;) {
+        if (shape[d] != 1) perm.push_back(d);
+    }
+
+    // insertion sort, inner dims first, keeping the original order where ambiguous.
+    for (std::size_t i = 1; i < perm.size(); ++i) {
+        std::size_t cur = i;
+        for (std::size_t j = i; j-- > 0;) {
+            const int c = should_swap(strides, shape, perm[j], perm[cur]);
+            if (c > 0) {
+                std::swap(perm[j], perm[cur]);
+                cur = j;
+            } else if (c < 0) {
+                break;
+            }
+        }
+    }
+
+    // coalesce neighbours that are mergeable for every operand.
+    for (std::size_t d : perm) {
+        if (!shape_.empty()) {
+            const std::size_t last = shape_.size() - 1;
+            bool mergeable = true;
+            for (std::size_t k = 0; k < ntensors_; ++k) {
+                if (stride(k, last) * shape_[last] != strides[k][d]) {
+                    mergeable = false;
+                    break;
+                }
+            }
+            if (mergeable) {
+                shape_[last] *= shape[d];
+                continue;
+            }
+        }
+        shape_.push_back(shape[d]);
+        for (std::size_t k = 0; k < ntensors_; ++k) strides_.push_back(strides[k][d]);
+    }
+}
+
+}  // namespace minidl::detail
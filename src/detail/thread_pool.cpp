@@ -0,0 +1,172 @@
+#include "minidl/detail/thread_pool.h"
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "minidl/numa.h"
+#include "minidl/parallel.h"
+
+namespace minidl::detail {
+
+namespace {
+thread_local bool tls_in_parallel_region = false;
+
+std::size_t default_num_threads() {
+    if (const char* env = std::getenv("MINIDL_NUM_THREADS")) {
+        try {
+            const long v = std::stol(env);
+            if (v > 0) return static_cast<std::size_t>(v);
+        } catch (const std::exception&) {
+            // ignore malformed values
+        }
+    }
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+}
+
+bool default_pinning() {
+    const char* env = std::getenv("MINIDL_PIN_THREADS");
+    return env && env[0] != '\0' && std::string(env) != "0";
+}
+
+std::mutex g_pool_mutex;
+std::unique_ptr<ThreadPool> g_pool;
+std::atomic<std::size_t> g_num_threads{0};
+std::atomic<int> g_pinning{-1};  // -1 until read from the environment
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t num_threads, bool pin) : pin_(pin) {
+    if (num_threads == 0) num_threads = 1;
+    workers_.reserve(num_threads - 1);
+    for (std::size_t i = 1; i < num_threads; ++i) {
+        workers_.emplace_back([this, i, num_threads] {
+            // task i of a run over every thread; runs with fewer tasks keep the same workers,
+            // so their ranges may sit on another node.
+            if (pin_) pin_current_thread(numa_task_node(i, num_threads));
+            worker_loop(i);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& w : workers_) w.join();
+}
+
+void ThreadPool::run_task(std::size_t task) {
+    try {
+        fn_(ctx_, task);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) error_ = std::current_exception();
+    }
+}
+
+void ThreadPool::run(std::size_t num_tasks, TaskFn fn, void* ctx) {
+    if (num_tasks == 0) return;
+    if (num_tasks > num_threads()) num_tasks = num_threads();
+
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fn_ = fn;
+        ctx_ = ctx;
+        num_tasks_ = num_tasks;
+        pending_ = num_tasks - 1;
+        error_ = nullptr;
+        ++generation_;
+    }
+    if (num_tasks > 1) start_cv_.notify_all();
+
+    tls_in_parallel_region = true;
+    run_task(0);
+    tls_in_parallel_region = false;
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return pending_ == 0; });
+        error = error_;
+        error_ = nullptr;
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void ThreadPool::worker_loop(std::size_t id) {
+    tls_in_parallel_region = true;
+    std::size_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            if (id >= num_tasks_) continue;
+        }
+
+        run_task(id);
+
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last = (--pending_ == 0);
+        }
+        if (last) done_cv_.notify_one();
+    }
+}
+
+ThreadPool& get_thread_pool() {
+    std::lock_guard<std::mutex> lock(g_pool_mutex);
+    if (!g_pool) {
+        g_pool = std::make_unique<ThreadPool>(get_num_threads(), get_thread_pinning());
+    }
+    return *g_pool;
+}
+
+bool in_parallel_region() noexcept { return tls_in_parallel_region; }
+
+}  // namespace minidl::detail
+
+namespace minidl {
+
+std::size_t get_num_threads() noexcept {
+    std::size_t n = detail::g_num_threads.load(std::memory_order_relaxed);
+    if (n == 0) {
+        n = detail::default_num_threads();
+        detail::g_num_threads.store(n, std::memory_order_relaxed);
+    }
+    return n;
+}
+
+void set_num_threads(std::size_t num_threads) {
+    if (num_threads == 0) num_threads = detail::default_num_threads();
+
+    std::lock_guard<std::mutex> lock(detail::g_pool_mutex);
+    detail::g_num_threads.store(num_threads, std::memory_order_relaxed);
+    if (detail::g_pool && detail::g_pool->num_threads() != num_threads) {
+        detail::g_pool.reset();
+    }
+}
+
+bool get_thread_pinning() noexcept {
+    int pin = detail::g_pinning.load(std::memory_order_relaxed);
+    if (pin < 0) {
+        pin = detail::default_pinning() ? 1 : 0;
+        detail::g_pinning.store(pin, std::memory_order_relaxed);
+    }
+    return pin != 0;
+}
+
+void set_thread_pinning(bool pin) {
+    std::lock_guard<std::mutex> lock(detail::g_pool_mutex);
+    detail::g_pinning.store(pin ? 1 : 0, std::memory_order_relaxed);
+    // workers pin themselves at startup, so a change takes a new pool.
+    if (detail::g_pool && detail::g_pool->pinned() != pin) detail::g_pool.reset();
+}
+
+}  // namespace minidl
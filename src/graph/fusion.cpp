@@ -0,0 +1,311 @@
+#include "minidl/detail/fusion.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "minidl/detail/binary_ops.h"
+#include "minidl/detail/broadcasting.h"
+#include "minidl/detail/kernels_pointwise.h"
+#include "minidl/detail/parallel.h"
+#include "minidl/detail/tensor_iterator.h"
+#include "minidl/detail/unary_ops.h"
+
+namespace minidl::detail {
+
+namespace {
+
+constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+constexpr std::size_t kBlock = kernels::kConvertBlock;
+
+bool is_unary(PointwiseOp op) { return op >= PointwiseOp::exp; }
+
+void binary_block(PointwiseOp op, float* z, const float* x, const float* y, std::size_t m) {
+    switch (op) {
+        case PointwiseOp::add:
+            return kernels::binary_contig_dispatch<float, AddOp<float>>(z, x, y, m);
+        case PointwiseOp::sub:
+            return kernels::binary_contig_dispatch<float, SubOp<float>>(z, x, y, m);
+        case PointwiseOp::mul:
+            return kernels::binary_contig_dispatch<float, MulOp<float>>(z, x, y, m);
+        case PointwiseOp::div:
+            return kernels::binary_contig_dispatch<float, DivOp<float>>(z, x, y, m);
+        case PointwiseOp::maximum:
+            return kernels::binary_contig_dispatch<float, MaximumOp<float>>(z, x, y, m);
+        case PointwiseOp::minimum:
+            return kernels::binary_contig_dispatch<float, MinimumOp<float>>(z, x, y, m);
+        default:
+            return;
+    }
+}
+
+template <class Op>
+void unary_block(float* z, const float* x, std::size_t m, bool fast) {
+    if (fast) {
+        kernels::unary_contig_dispatch<float, Op>(z, x, m);
+    } else {
+        for (std::size_t i = 0; i < m; ++i) z[i] = Op::apply(x[i]);
+    }
+}
+
+void unary_block(PointwiseOp op, float* z, const float* x, std::size_t m, bool fast) {
+    switch (op) {
+        case PointwiseOp::exp:
+            return unary_block<ExpOp<float>>(z, x, m, fast);
+        case PointwiseOp::log:
+            return unary_block<LogOp<float>>(z, x, m, fast);
+        case PointwiseOp::tanh:
+            return unary_block<TanhOp<float>>(z, x, m, fast);
+        case PointwiseOp::sigmoid:
+            return unary_block<SigmoidOp<float>>(z, x, m, fast);
+        case PointwiseOp::gelu:
+            return unary_block<GeluOp<float>>(z, x, m, fast);
+        case PointwiseOp::relu:
+            return unary_block<ReluOp<float>>(z, x, m, fast);
+        default:
+            return;
+    }
+}
+
+// The rewrite: which steps fold into the step reading their output, and the registers each
+// subtree needs.
+class Fuser {
+   public:
+    explicit Fuser(TraceRecorder& rec) : rec_(rec), steps_(rec.steps) {}
+
+    std::size_t run() {
+        const auto& values = rec_.values;
+        const std::size_t n = values.size();
+        // readers of each value; a view or an output counts as one.
+        std::vector<std::size_t> uses(n, 0);
+        producer_.assign(n, kNone);
+        for (std::size_t v = 0; v < n; ++v) {
+            if (values[v].kind == TraceValue::Kind::view) ++uses[values[v].root];
+        }
+        for (std::size_t i = 0; i < steps_.size(); ++i) {
+            for (std::size_t in : steps_[i].inputs) ++uses[in];
+            producer_[steps_[i].output] = i;
+        }
+        for (std::size_t out : rec_.outputs) ++uses[out];
+
+        absorbed_.assign(steps_.size(), false);
+        need_.assign(steps_.size(), 0);
+        size_.assign(steps_.size(), 0);
+        for (std::size_t i = 0; i < steps_.size(); ++i) {
+            const TraceStep& s = steps_[i];
+            if (!fusable(s)) continue;
+            const auto& shape = values[s.output].tensor.shape().dims();
+            // candidates: fusable producers whose output only this step reads, in out's shape.
+            std::vector<std::size_t> cand;
+            for (std::size_t in : s.inputs) {
+                const std::size_t p = producer_[in];
+                if (p != kNone && fusable(steps_[p]) && uses[in] == 1 && values[in].tensor.shape().dims() == shape) {
+                    cand.push_back(p);
+                }
+            }
+            // all of them if the group stays in bounds, else the first that does.
+            if (!absorb(i, cand)) {
+                bool done = false;
+                for (std::size_t p : cand) {
+                    if (!done && absorb(i, {p})) done = true;
+                }
+                if (!done) absorb(i, {});
+            }
+        }
+
+        std::size_t folded = 0;
+        std::vector<TraceStep> fused;
+        fused.reserve(steps_.size());
+        for (std::size_t i = 0; i < steps_.size(); ++i) {
+            if (absorbed_[i]) {
+                ++folded;
+                continue;
+            }
+            if (size_[i] > 1) {
+                fused.push_back(build(i));
+            } else {
+                fused.push_back(std::move(steps_[i]));
+            }
+        }
+        steps_ = std::move(fused);
+        return folded;
+    }
+
+   private:
+    bool fusable(const TraceStep& s) const {
+        if (s.pointwise == PointwiseOp::none || rec_.values[s.output].tensor.dtype() != DType::f32) return false;
+        for (std::size_t in : s.inputs) {
+            if (rec_.values[in].tensor.dtype() != DType::f32) return false;
+        }
+        return true;
+    }
+
+    // the registers and ops of value v's subtree: a folded step's, or one load.
+    std::size_t need_of(std::size_t v) const {
+        const std::size_t p = producer_[v];
+        return p != kNone && absorbed_[p] ? need_[p] : 1;
+    }
+    std::size_t size_of(std::size_t v) const {
+        const std::size_t p = producer_[v];
+        return p != kNone && absorbed_[p] ? size_[p] : 0;
+    }
+
+    // folds `children` into step i if the tree stays within the bounds. A result register is
+    // taken while the operands are held, and the operand needing more registers is computed
+    // first (Sethi-Ullman), so a chain needs 2 or 3 registers and a balanced tree log2 of its
+    // leaves more.
+    bool absorb(std::size_t i, const std::vector<std::size_t>& children) {
+        for (std::size_t p : children) absorbed_[p] = true;
+        const TraceStep& s = steps_[i];
+        std::size_t need = 0, size = 1;
+        if (s.inputs.size() == 1) {
+            need = std::max<std::size_t>(need_of(s.inputs[0]), 2);
+            size += size_of(s.inputs[0]);
+        } else {
+            const std::size_t a = need_of(s.inputs[0]), b = need_of(s.inputs[1]);
+            need = std::max({std::max(a, b), std::min(a, b) + 1, std::size_t{3}});
+            size += size_of(s.inputs[0]) + size_of(s.inputs[1]);
+        }
+        if (need > kFusedMaxRegs || size > kFusedMaxOps) {
+            for (std::size_t p : children) absorbed_[p] = false;
+            return false;
+        }
+        need_[i] = need;
+        size_[i] = size;
+        return true;
+    }
+
+    std::uint8_t take() {
+        const auto r = static_cast<std::uint8_t>(std::find(busy_.begin(), busy_.end(), false) - busy_.begin());
+        busy_[r] = true;
+        program_.num_regs = std::max<std::size_t>(program_.num_regs, r + std::size_t{1});
+        return r;
+    }
+
+    std::uint8_t emit_value(std::size_t v) {
+        const std::size_t p = producer_[v];
+        if (p != kNone && absorbed_[p]) return emit_step(p);
+        const auto it = std::find(operands_.begin(), operands_.end(), v);
+        const auto operand = static_cast<std::uint8_t>(it - operands_.begin());
+        if (it == operands_.end()) operands_.push_back(v);
+        const std::uint8_t r = take();
+        program_.code.push_back({FusedInstr::Kind::load, PointwiseOp::none, true, r, operand, 0});
+        return r;
+    }
+
+    std::uint8_t emit_step(std::size_t i) {
+        const TraceStep& s = steps_[i];
+        if (is_unary(s.pointwise)) {
+            const std::uint8_t a = emit_value(s.inputs[0]);
+            const std::uint8_t r = take();
+            busy_[a] = false;
+            program_.code.push_back({FusedInstr::Kind::unary, s.pointwise, s.fast, r, a, 0});
+            return r;
+        }
+        std::uint8_t a = 0, b = 0;
+        if (need_of(s.inputs[1]) > need_of(s.inputs[0])) {
+            b = emit_value(s.inputs[1]);
+            a = emit_value(s.inputs[0]);
+        } else {
+            a = emit_value(s.inputs[0]);
+            b = emit_value(s.inputs[1]);
+        }
+        const std::uint8_t r = take();
+        busy_[a] = busy_[b] = false;
+        program_.code.push_back({FusedInstr::Kind::binary, s.pointwise, true, r, a, b});
+        return r;
+    }
+
+    // the step running the tree rooted at step i.
+    TraceStep build(std::size_t i) {
+        program_ = {};
+        operands_.clear();
+        busy_.assign(kFusedMaxRegs, false);
+        emit_step(i);
+        program_.num_operands = operands_.size();
+        TraceKernel kernel = [program = std::move(program_)](const Tensor* const* in, Tensor& out) {
+            run_fused(program, in, out);
+        };
+        return {"fused", std::move(kernel), operands_, steps_[i].output, true};
+    }
+
+    TraceRecorder& rec_;
+    std::vector<TraceStep>& steps_;
+    std::vector<std::size_t> producer_;  // the step writing each value
+    std::vector<bool> absorbed_;         // the step is folded into the one reading it
+    std::vector<std::size_t> need_, size_;
+    FusedProgram program_;
+    std::vector<std::size_t> operands_;
+    std::vector<bool> busy_;
+};
+
+}  // namespace
+
+void run_fused(const FusedProgram& program, const Tensor* const* operands, Tensor& out) {
+    const auto& shape = out.shape().dims();
+    if (out.numel() == 0) return;
+    const std::size_t n = program.num_operands;
+
+    std::vector<std::vector<std::size_t>> strides;
+    strides.reserve(n + 1);
+    strides.push_back(out.strides());
+    std::vector<const float*> base(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        strides.push_back(expand_strides_for_broadcast(operands[k]->shape().dims(), operands[k]->strides(), shape));
+        base[k] = static_cast<const float*>(operands[k]->data());
+    }
+    float* z = static_cast<float*>(out.data());
+    const FusedInstr* code = program.code.data();
+    const std::size_t len = program.code.size();
+
+    const TensorIterator iter(shape, strides);
+    parallel_for(0, iter.numel(), kGrainSize, [&](std::size_t begin, std::size_t end) {
+        alignas(64) float buf[kFusedMaxRegs][kBlock];
+        const float* reg[kFusedMaxRegs] = {};
+        iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t count) {
+            const std::size_t zs = st[0];
+            for (std::size_t i0 = 0; i0 < count; i0 += kBlock) {
+                const std::size_t m = std::min(kBlock, count - i0);
+                for (std::size_t pc = 0; pc < len; ++pc) {
+                    const FusedInstr& in = code[pc];
+                    float* d = buf[in.dst];
+                    switch (in.kind) {
+                        case FusedInstr::Kind::load: {
+                            // unit stride is read in place, broadcast filled, anything else gathered.
+                            const std::size_t s = st[in.a + 1];
+                            const float* p = base[in.a] + off[in.a + 1] + i0 * s;
+                            if (s == 1) {
+                                reg[in.dst] = p;
+                                continue;
+                            }
+                            if (s == 0) {
+                                std::fill_n(d, m, *p);
+                            } else {
+                                for (std::size_t i = 0; i < m; ++i) d[i] = p[i * s];
+                            }
+                            break;
+                        }
+                        case FusedInstr::Kind::unary:
+                            if (pc + 1 == len && zs == 1) d = z + off[0] + i0;
+                            unary_block(in.op, d, reg[in.a], m, in.fast);
+                            break;
+                        case FusedInstr::Kind::binary:
+                            if (pc + 1 == len && zs == 1) d = z + off[0] + i0;
+                            binary_block(in.op, d, reg[in.a], reg[in.b], m);
+                            break;
+                    }
+                    reg[in.dst] = d;
+                }
+                if (zs != 1) {
+                    const float* r = reg[code[len - 1].dst];
+                    float* zp = z + off[0] + i0 * zs;
+                    for (std::size_t i = 0; i < m; ++i) zp[i * zs] = r[i];
+                }
+            }
+        });
+    });
+}
+
+std::size_t fuse_pointwise(TraceRecorder& rec) { return Fuser(rec).run(); }
+
+}  // namespace minidl::detail
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "minidl/allocators/default.h"
+#include "minidl/detail/fusion.h"
+#include "minidl/graph.h"
+
+namespace minidl::graph {
+
+namespace {
+
+using detail::TraceValue;
+
+constexpr std::size_t kNone = std::numeric_limits<std::size_t>::max();
+
+// A stretch of the plan's buffer, live from the step writing it to the last step reading it.
+struct Buffer {
+    std::size_t bytes, first, last;
+    std::size_t offset = 0;
+};
+
+// out can be written over `in`: same elements, dtype and (contiguous) layout.
+bool reusable(const Tensor& in, const Tensor& out) {
+    return in.dtype() == out.dtype() && in.shape().dims() == out.shape().dims() && in.is_contiguous() &&
+           out.is_contiguous();
+}
+
+// Offsets for the buffers, largest first, each at the lowest offset clear of the buffers
+// already placed that are live at the same time. Returns the total size.
+std::size_t place(std::vector<Buffer>& buffers) {
+    std::vector<std::size_t> order(buffers.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(),
+                     [&](std::size_t a, std::size_t b) { return buffers[a].bytes > buffers[b].bytes; });
+
+    std::size_t total = 0;
+    std::vector<std::size_t> placed;
+    std::vector<std::pair<std::size_t, std::size_t>> busy;
+    for (std::size_t b : order) {
+        Buffer& buf = buffers[b];
+        busy.clear();
+        for (std::size_t p : placed) {
+            const Buffer& other = buffers[p];
+            if (other.first <= buf.last && buf.first <= other.last) {
+                busy.emplace_back(other.offset, other.offset + other.bytes);
+            }
+        }
+        std::sort(busy.begin(), busy.end());
+        std::size_t offset = 0;
+        for (const auto& [lo, hi] : busy) {
+            if (offset + buf.bytes <= lo) break;
+            offset = std::max(offset, hi);
+        }
+        buf.offset = offset;
+        total = std::max(total, offset + buf.bytes);
+        placed.push_back(b);
+    }
+    return total;
+}
+
+}  // namespace
+
+Plan Trace::compile(std::shared_ptr<Allocator> alloc, CompileOptions options) {
+    if (!rec_) throw std::runtime_error("Trace: already compiled.");
+    if (detail::active_trace() == rec_.get()) detail::set_active_trace(nullptr);
+    const std::unique_ptr<detail::TraceRecorder> rec = std::move(rec_);
+    const auto& values = rec->values;
+    auto& steps = rec->steps;
+
+    Plan plan;
+    for (const auto& step : steps) plan.eager_bytes_ += values[step.output].tensor.nbytes();
+    // fused intermediates are written by no step, and get no buffer.
+    if (options.fuse) plan.num_fused_ = detail::fuse_pointwise(*rec);
+
+    const std::size_t n = values.size();
+    const std::size_t end = steps.size();
+    const auto root_of = [&](std::size_t v) { return values[v].kind == TraceValue::Kind::view ? values[v].root : v; };
+
+    // liveness: op values live from their step to the last step reading them or a view of
+    // them; outputs to the end.
+    std::vector<std::size_t> last(n, 0);
+    std::vector<bool> viewed(n, false), is_output(n, false);
+    for (std::size_t v = 0; v < n; ++v) {
+        if (values[v].kind == TraceValue::Kind::view) viewed[values[v].root] = true;
+    }
+    for (std::size_t i = 0; i < end; ++i) {
+        last[steps[i].output] = std::max(last[steps[i].output], i);
+        for (std::size_t in : steps[i].inputs) last[root_of(in)] = std::max(last[root_of(in)], i);
+    }
+    for (std::size_t out : rec->outputs) {
+        is_output[root_of(out)] = true;
+        last[root_of(out)] = end;
+    }
+
+    // one buffer per op value, except where an elementwise op writes over an input that
+    // dies with it.
+    std::vector<std::size_t> buffer(n, kNone);
+    std::vector<Buffer> buffers;
+    for (std::size_t i = 0; i < end; ++i) {
+        const std::size_t out = steps[i].output;
+        std::size_t b = kNone;
+        if (steps[i].in_place) {
+            for (std::size_t in : steps[i].inputs) {
+                if (values[in].kind == TraceValue::Kind::op && !viewed[in] && !is_output[in] && last[in] == i &&
+                    reusable(values[in].tensor, values[out].tensor)) {
+                    b = buffer[in];
+                    break;
+                }
+            }
+        }
+        if (b == kNone) {
+            b = buffers.size();
+            buffers.push_back({detail::round_up(values[out].tensor.nbytes(), kDefaultAlignment), i, last[out]});
+        } else {
+            buffers[b].last = std::max(buffers[b].last, last[out]);
+            ++plan.num_in_place_;
+        }
+        buffer[out] = b;
+    }
+    plan.arena_bytes_ = place(buffers);
+
+    if (!alloc) alloc = get_default_allocator();
+    plan.arena_ = std::make_shared<Storage>(alloc);
+    plan.arena_->nbytes = plan.arena_bytes_;
+    if (plan.arena_bytes_ != 0) plan.arena_->data = alloc->allocate(plan.arena_bytes_);
+
+    // a tensor per value: op values and their views over the arena, inputs and constants as
+    // traced; views of inputs are rebuilt by run().
+    std::vector<std::size_t> input_index(n, kNone);
+    for (std::size_t i = 0; i < rec->inputs.size(); ++i) input_index[rec->inputs[i]] = i;
+    plan.slots_.reserve(n);
+    for (std::size_t v = 0; v < n; ++v) {
+        const Tensor& t = values[v].tensor;
+        switch (values[v].kind) {
+            case TraceValue::Kind::input:
+            case TraceValue::Kind::constant:
+                plan.slots_.push_back(t);
+                break;
+            case TraceValue::Kind::op:
+                if (buffer[v] == kNone) {
+                    plan.slots_.push_back(Tensor::from_storage(plan.arena_, Shape{0}, t.dtype(), {1}, 0));
+                } else {
+                    plan.slots_.push_back(Tensor::from_storage(plan.arena_, t.shape(), t.dtype(), t.strides(),
+                                                               buffers[buffer[v]].offset / t.itemsize()));
+                }
+                break;
+            case TraceValue::Kind::view: {
+                const std::size_t root = values[v].root;
+                if (values[root].kind == TraceValue::Kind::input) {
+                    plan.input_views_.push_back({v, input_index[root], t.shape(), t.strides(), values[v].offset});
+                    plan.slots_.push_back(t);
+                } else {
+                    plan.slots_.push_back(Tensor::from_storage(plan.arena_, t.shape(), t.dtype(), t.strides(),
+                                                               plan.slots_[root].storage_offset() + values[v].offset));
+                }
+                break;
+            }
+        }
+    }
+
+    plan.steps_.reserve(end);
+    for (auto& step : steps) {
+        plan.args_.resize(std::max(plan.args_.size(), step.inputs.size()));
+        plan.steps_.push_back({std::move(step.kernel), std::move(step.inputs), step.output});
+    }
+    plan.inputs_ = rec->inputs;
+    plan.outputs_ = rec->outputs;
+    for (std::size_t out : plan.outputs_) plan.results_.push_back(plan.slots_[out]);
+    return plan;
+}
+
+const std::vector<Tensor>& Plan::run(const std::vector<Tensor>& inputs) {
+    if (inputs.size() != inputs_.size()) {
+        throw std::runtime_error("Plan::run: expected " + std::to_string(inputs_.size()) + " inputs.");
+    }
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        Tensor& slot = slots_[inputs_[i]];
+        if (inputs[i].dtype() != slot.dtype() || inputs[i].shape().dims() != slot.shape().dims()) {
+            throw std::runtime_error("Plan::run: input " + std::to_string(i) + " does not match its placeholder.");
+        }
+        if (!inputs[i].is_contiguous()) throw std::runtime_error("Plan::run: inputs must be contiguous.");
+        slot = inputs[i];
+    }
+    for (const InputView& v : input_views_) {
+        const Tensor& in = slots_[inputs_[v.input]];
+        slots_[v.slot] =
+            Tensor::from_storage(in.storage(), v.shape, in.dtype(), v.strides, in.storage_offset() + v.offset);
+    }
+
+    for (Step& s : steps_) {
+        for (std::size_t k = 0; k < s.args.size(); ++k) args_[k] = &slots_[s.args[k]];
+        s.kernel(args_.data(), slots_[s.out]);
+    }
+    for (std::size_t i = 0; i < outputs_.size(); ++i) results_[i] = slots_[outputs_[i]];
+    return results_;
+}
+
+}  // namespace minidl::graph
@@ -0,0 +1,115 @@
+#include "minidl/detail/trace.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "minidl/graph.h"
+
+namespace minidl {
+
+namespace detail {
+
+namespace {
+
+thread_local TraceRecorder* active = nullptr;
+
+bool same_layout(const Tensor& a, const Tensor& b) {
+    return a.dtype() == b.dtype() && a.storage_offset() == b.storage_offset() &&
+           a.shape().dims() == b.shape().dims() && a.strides() == b.strides();
+}
+
+}  // namespace
+
+std::size_t TraceRecorder::add(TraceValue::Kind kind, const Tensor& t) {
+    const std::size_t id = values.size();
+    values.push_back({kind, t.detach()});
+    by_storage[t.storage().get()].push_back(id);
+    return id;
+}
+
+std::size_t TraceRecorder::value_of(const Tensor& t, const char* op) {
+    const auto it = by_storage.find(t.storage().get());
+    if (it != by_storage.end()) {
+        for (std::size_t id : it->second) {
+            if (same_layout(values[id].tensor, t)) return id;
+        }
+        if (values[it->second.front()].kind != TraceValue::Kind::constant) {
+            throw std::runtime_error(std::string(op) + ": reads a view of a traced tensor that was not traced.");
+        }
+    }
+    return add(TraceValue::Kind::constant, t);
+}
+
+bool TraceRecorder::is_traced(const Tensor& t) const {
+    const auto it = by_storage.find(t.storage().get());
+    return it != by_storage.end() && values[it->second.front()].kind != TraceValue::Kind::constant;
+}
+
+TraceRecorder* active_trace() noexcept { return active; }
+
+void set_active_trace(TraceRecorder* trace) noexcept { active = trace; }
+
+void trace_op(const char* name, TraceKernel kernel, const Tensor& out, std::initializer_list<const Tensor*> inputs,
+              bool in_place, PointwiseOp pointwise, bool fast) {
+    TraceRecorder* rec = active;
+    if (!rec) return;
+    TraceStep step{name, std::move(kernel), {}, 0, in_place, pointwise, fast};
+    for (const Tensor* t : inputs) step.inputs.push_back(rec->value_of(*t, name));
+    step.output = rec->add(TraceValue::Kind::op, out);
+    rec->steps.push_back(std::move(step));
+}
+
+void trace_view(const Tensor& out, const Tensor& base) {
+    TraceRecorder* rec = active;
+    if (!rec || !rec->is_traced(base)) return;
+    const std::size_t b = rec->value_of(base, "view");
+    const std::size_t root = rec->values[b].kind == TraceValue::Kind::view ? rec->values[b].root : b;
+    const std::size_t offset = out.storage_offset() - rec->values[root].tensor.storage_offset();
+    const std::size_t id = rec->add(TraceValue::Kind::view, out);
+    rec->values[id].root = root;
+    rec->values[id].offset = offset;
+}
+
+void trace_copy(const Tensor& out, const Tensor& base) {
+    // copies of constants too: replayed, they see later updates of the weight.
+    if (!active) return;
+    trace_op(
+        "contiguous", [](const Tensor* const* in, Tensor& o) { o.copy_(*in[0]); }, out, {&base}, false);
+}
+
+void trace_unsupported(const char* name, std::initializer_list<const Tensor*> tensors) {
+    if (!active) return;
+    for (const Tensor* t : tensors) {
+        if (active->is_traced(*t)) throw std::runtime_error(std::string(name) + ": cannot be traced (graph::Trace).");
+    }
+}
+
+}  // namespace detail
+
+namespace graph {
+
+Trace::Trace() : rec_(std::make_unique<detail::TraceRecorder>()) {
+    if (detail::active_trace()) throw std::runtime_error("Trace: another trace is active on this thread.");
+    detail::set_active_trace(rec_.get());
+}
+
+Trace::~Trace() {
+    if (rec_ && detail::active_trace() == rec_.get()) detail::set_active_trace(nullptr);
+}
+
+Tensor Trace::input(const Shape& shape, DType dtype) {
+    if (!rec_) throw std::runtime_error("Trace: already compiled.");
+    Tensor t = Tensor::zeros(shape, dtype);
+    rec_->inputs.push_back(rec_->add(detail::TraceValue::Kind::input, t));
+    return t;
+}
+
+void Trace::output(const Tensor& t) {
+    if (!rec_) throw std::runtime_error("Trace: already compiled.");
+    rec_->outputs.push_back(rec_->value_of(t, "output"));
+}
+
+}  // namespace graph
+
+}  // namespace minidl
@@ -0,0 +1,109 @@
+#include "minidl/detail/convert.h"
+
+#include "minidl/detail/cpu_features.h"
+#include "minidl/detail/dispatch.h"
+
+namespace minidl::kernels {
+
+namespace {
+
+using ToF32Fn = void (*)(float*, const std::uint16_t*, std::size_t) noexcept;
+using FromF32Fn = void (*)(std::uint16_t*, const float*, std::size_t) noexcept;
+
+void f32_to_f16_scalar(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) dst[i] = detail::f32_to_f16_bits(src[i]);
+}
+void f16_to_f32_scalar(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) dst[i] = detail::f16_bits_to_f32(src[i]);
+}
+void f32_to_bf16_scalar(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) dst[i] = detail::f32_to_bf16_bits(src[i]);
+}
+void bf16_to_f32_scalar(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    for (std::size_t i = 0; i < n; ++i) dst[i] = detail::bf16_bits_to_f32(src[i]);
+}
+
+struct HalfKernels {
+    FromF32Fn f32_to_f16 = &f32_to_f16_scalar;
+    ToF32Fn f16_to_f32 = &f16_to_f32_scalar;
+    FromF32Fn f32_to_bf16 = &f32_to_bf16_scalar;
+    ToF32Fn bf16_to_f32 = &bf16_to_f32_scalar;
+};
+
+HalfKernels select_half_kernels() noexcept {
+    HalfKernels k;
+    const auto cap = detail::cpu_capability();
+    (void)cap;
+#if defined(MINIDL_HAVE_AVX512)
+    if (cap == detail::CpuCapability::avx512) {
+        k = {&avx512::f32_to_f16, &avx512::f16_to_f32, &avx512::f32_to_bf16, &avx512::bf16_to_f32};
+#if defined(MINIDL_HAVE_AVX512BF16)
+        if (detail::cpu_has_avx512_bf16()) k.f32_to_bf16 = &avx512bf16::f32_to_bf16;
+#endif
+        return k;
+    }
+#endif
+#if defined(MINIDL_HAVE_AVX2)
+    if (cap == detail::CpuCapability::avx512 || cap == detail::CpuCapability::avx2) {
+        return {&avx2::f32_to_f16, &avx2::f16_to_f32, &avx2::f32_to_bf16, &avx2::bf16_to_f32};
+    }
+#endif
+#if defined(MINIDL_HAVE_NEON)
+    if (cap == detail::CpuCapability::neon) {
+        return {&neon::f32_to_f16, &neon::f16_to_f32, &neon::f32_to_bf16, &neon::bf16_to_f32};
+    }
+#endif
+    return k;
+}
+
+const HalfKernels& half_kernels() noexcept {
+    static const HalfKernels k = select_half_kernels();
+    return k;
+}
+
+template <typename D, typename S>
+void convert_typed(D* __restrict dst, std::size_t ds, const S* __restrict src, std::size_t ss,
+                   std::size_t n) noexcept {
+    if constexpr (std::is_same_v<S, float> && is_half_v<D>) {
+        if (ds == 1 && ss == 1) return from_f32(dst, src, n);
+    } else if constexpr (is_half_v<S> && std::is_same_v<D, float>) {
+        if (ds == 1 && ss == 1) return to_f32(dst, src, n);
+    }
+    if (ds == 1 && ss == 1) {
+        for (std::size_t i = 0; i < n; ++i) dst[i] = convert_value<D>(src[i]);
+    } else {
+        for (std::size_t i = 0; i < n; ++i) dst[i * ds] = convert_value<D>(src[i * ss]);
+    }
+}
+
+}  // namespace
+
+void to_f32(float* dst, const Half* src, std::size_t n) noexcept {
+    half_kernels().f16_to_f32(dst, reinterpret_cast<const std::uint16_t*>(src), n);
+}
+void to_f32(float* dst, const BFloat16* src, std::size_t n) noexcept {
+    half_kernels().bf16_to_f32(dst, reinterpret_cast<const std::uint16_t*>(src), n);
+}
+void from_f32(Half* dst, const float* src, std::size_t n) noexcept {
+    half_kernels().f32_to_f16(reinterpret_cast<std::uint16_t*>(dst), src, n);
+}
+void from_f32(BFloat16* dst, const float* src, std::size_t n) noexcept {
+    half_kernels().f32_to_bf16(reinterpret_cast<std::uint16_t*>(dst), src, n);
+}
+
+void convert_strided(void* dst, DType dst_dtype, std::size_t dst_stride, const void* src, DType src_dtype,
+                     std::size_t src_stride, std::size_t n) {
+    detail::dispatch_types<detail::AllTypes>(dst_dtype, "to", [&](auto dst_tag) {
+        using D = typename decltype(dst_tag)::type;
+        detail::dispatch_types<detail::AllTypes>(src_dtype, "to", [&](auto src_tag) {
+            using S = typename decltype(src_tag)::type;
+            convert_typed(static_cast<D*>(dst), dst_stride, static_cast<const S*>(src), src_stride, n);
+        });
+    });
+}
+
+void convert_contig(void* dst, DType dst_dtype, const void* src, DType src_dtype, std::size_t n) {
+    convert_strided(dst, dst_dtype, 1, src, src_dtype, 1, n);
+}
+
+}  // namespace minidl::kernels
@@ -0,0 +1,208 @@
+#include "minidl/detail/gemm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "minidl/detail/cpu_features.h"
+#include "minidl/detail/parallel.h"
+
+namespace minidl::kernels {
+
+namespace {
+
+// Largest mr * nr of any micro-kernel, for the edge-tile scratch.
+constexpr std::size_t kMaxTile = 8 * 32;
+
+template <typename T, std::size_t MR, std::size_t NR>
+void gemm_micro_scalar(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc, bool accumulate) noexcept {
+    T acc[MR][NR] = {};
+    for (std::size_t p = 0; p < kc; ++p) {
+        for (std::size_t i = 0; i < MR; ++i) {
+            for (std::size_t j = 0; j < NR; ++j) acc[i][j] += a[i] * b[j];
+        }
+        a += MR;
+        b += NR;
+    }
+    for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t j = 0; j < NR; ++j) c[i * ldc + j] = accumulate ? c[i * ldc + j] + acc[i][j] : acc[i][j];
+    }
+}
+
+// 64-byte aligned packing scratch, per thread and slot. It grows on demand and is kept for
+// the thread's lifetime, so repeated (e.g. batched) calls do not allocate.
+template <typename T>
+T* pack_buffer(std::size_t slot, std::size_t n) {
+    struct Buffer {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t bytes = 0;
+    };
+    thread_local Buffer buffers[2];
+    Buffer& buf = buffers[slot];
+    const std::size_t bytes = n * sizeof(T) + 64;
+    if (buf.bytes < bytes) {
+        buf.data.reset(new std::byte[bytes]);
+        buf.bytes = bytes;
+    }
+    const auto addr = reinterpret_cast<std::uintptr_t>(buf.data.get());
+    return reinterpret_cast<T*>((addr + 63) & ~std::uintptr_t{63});
+}
+
+// rows [0, mc) x depth [0, kc) of a into mr-row panels: dst[panel][p][i], zero padded to mr.
+template <typename T>
+void pack_a(T* dst, const T* a, std::size_t mc, std::size_t kc, std::size_t rsa, std::size_t csa,
+            std::size_t mr) noexcept {
+    for (std::size_t i0 = 0; i0 < mc; i0 += mr) {
+        const std::size_t rows = std::min(mr, mc - i0);
+        const T* src = a + i0 * rsa;
+        if (rsa == 1) {
+            // column-major (e.g. a transposed view): each step of k is a contiguous run.
+            for (std::size_t p = 0; p < kc; ++p) {
+                std::memcpy(dst + p * mr, src + p * csa, rows * sizeof(T));
+                std::fill(dst + p * mr + rows, dst + (p + 1) * mr, T(0));
+            }
+        } else {
+            // walk each source row contiguously (when csa == 1), scattering into the panel in L1.
+            for (std::size_t i = 0; i < rows; ++i) {
+                const T* row = src + i * rsa;
+                for (std::size_t p = 0; p < kc; ++p) dst[p * mr + i] = row[p * csa];
+            }
+            for (std::size_t i = rows; i < mr; ++i) {
+                for (std::size_t p = 0; p < kc; ++p) dst[p * mr + i] = T(0);
+            }
+        }
+        dst += mr * kc;
+    }
+}
+
+// depth [0, kc) x columns [0, nc) of b into nr-column panels: dst[panel][p][j], zero padded to nr.
+template <typename T>
+void pack_b(T* dst, const T* b, std::size_t nc, std::size_t kc, std::size_t rsb, std::size_t csb,
+            std::size_t nr) noexcept {
+    for (std::size_t j0 = 0; j0 < nc; j0 += nr) {
+        const std::size_t cols = std::min(nr, nc - j0);
+        const T* src = b + j0 * csb;
+        if (csb == 1) {
+            for (std::size_t p = 0; p < kc; ++p) {
+                std::memcpy(dst + p * nr, src + p * rsb, cols * sizeof(T));
+                std::fill(dst + p * nr + cols, dst + (p + 1) * nr, T(0));
+            }
+        } else {
+            // column-major (e.g. a transposed view) or general strides: walk each source column.
+            for (std::size_t j = 0; j < cols; ++j) {
+                const T* col = src + j * csb;
+                for (std::size_t p = 0; p < kc; ++p) dst[p * nr + j] = col[p * rsb];
+            }
+            for (std::size_t j = cols; j < nr; ++j) {
+                for (std::size_t p = 0; p < kc; ++p) dst[p * nr + j] = T(0);
+            }
+        }
+        dst += nr * kc;
+    }
+}
+
+}  // namespace
+
+template <typename T>
+GemmMicroKernel<T> select_gemm_micro() noexcept {
+    const auto cap = detail::cpu_capability();
+    (void)cap;
+#if defined(MINIDL_HAVE_AVX512)
+    if (cap == detail::CpuCapability::avx512) return avx512::gemm_micro<T>();
+#endif
+#if defined(MINIDL_HAVE_AVX2)
+    if (cap == detail::CpuCapability::avx512 || cap == detail::CpuCapability::avx2) return avx2::gemm_micro<T>();
+#endif
+#if defined(MINIDL_HAVE_NEON)
+    if (cap == detail::CpuCapability::neon) return neon::gemm_micro<T>();
+#endif
+    return {4, 8, &gemm_micro_scalar<T, 4, 8>};
+}
+
+template <typename T>
+void gemm(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t rsa, std::size_t csa, const T* b,
+          std::size_t rsb, std::size_t csb, T* c, std::size_t ldc) {
+    if (m == 0 || n == 0) return;
+    if (k == 0) {
+        for (std::size_t i = 0; i < m; ++i) std::fill(c + i * ldc, c + i * ldc + n, T(0));
+        return;
+    }
+
+    static const GemmMicroKernel<T> uk = select_gemm_micro<T>();
+    const std::size_t mr = uk.mr;
+    const std::size_t nr = uk.nr;
+    const std::size_t mc = kGemmMC / mr * mr;
+    const std::size_t m_blocks = (m + mc - 1) / mc;
+    const std::size_t threads = detail::in_parallel_region() ? 1 : get_num_threads();
+
+    for (std::size_t jc = 0; jc < n; jc += kGemmNC) {
+        const std::size_t nc = std::min(kGemmNC, n - jc);
+        const std::size_t n_panels = (nc + nr - 1) / nr;
+        // with few row blocks, the columns are split too so every thread gets a tile range.
+        const std::size_t n_parts = std::min(n_panels, (threads + m_blocks - 1) / m_blocks);
+
+        for (std::size_t pc = 0; pc < k; pc += kGemmKC) {
+            const std::size_t kc = std::min(kGemmKC, k - pc);
+            const bool accumulate = pc > 0;
+
+            T* bp = pack_buffer<T>(0, n_panels * nr * kc);
+            const T* b_blk = b + pc * rsb + jc * csb;
+            detail::parallel_for(0, n_panels, std::max<std::size_t>(1, detail::kGrainSize / (kc * nr)),
+                                 [&](std::size_t p0, std::size_t p1) {
+                                     pack_b(bp + p0 * nr * kc, b_blk + p0 * nr * csb,
+                                            std::min(nc, p1 * nr) - p0 * nr, kc, rsb, csb, nr);
+                                 });
+
+            const T* a_blk = a + pc * csa;
+            detail::parallel_for(0, m_blocks * n_parts, 1, [&](std::size_t u0, std::size_t u1) {
+                alignas(64) T tile[kMaxTile];
+                // the mc x kc block of A this thread packed last; the units of one row block
+                // are adjacent, so a thread packs each of its blocks once.
+                T* ap = pack_buffer<T>(1, mc * kc);
+                std::size_t packed = m_blocks;
+                for (std::size_t u = u0; u < u1; ++u) {
+                    const std::size_t ib = u / n_parts;
+                    const std::size_t i0 = ib * mc;
+                    const std::size_t i1 = std::min(m, i0 + mc);
+                    const std::size_t jp0 = u % n_parts * n_panels / n_parts;
+                    const std::size_t jp1 = (u % n_parts + 1) * n_panels / n_parts;
+                    if (packed != ib) {
+                        pack_a(ap, a_blk + i0 * rsa, i1 - i0, kc, rsa, csa, mr);
+                        packed = ib;
+                    }
+
+                    // one kc x nr sliver of B stays in L1 while the mc rows of A stream from L2.
+                    for (std::size_t jp = jp0; jp < jp1; ++jp) {
+                        const T* bs = bp + jp * nr * kc;
+                        const std::size_t cols = std::min(nr, nc - jp * nr);
+                        for (std::size_t ir = i0; ir < i1; ir += mr) {
+                            const T* as = ap + (ir - i0) * kc;
+                            const std::size_t rows = std::min(mr, m - ir);
+                            T* cs = c + ir * ldc + jc + jp * nr;
+                            if (rows == mr && cols == nr) {
+                                uk.fn(kc, as, bs, cs, ldc, accumulate);
+                                continue;
+                            }
+                            uk.fn(kc, as, bs, tile, nr, false);
+                            for (std::size_t i = 0; i < rows; ++i) {
+                                for (std::size_t j = 0; j < cols; ++j) {
+                                    const T v = tile[i * nr + j];
+                                    cs[i * ldc + j] = accumulate ? cs[i * ldc + j] + v : v;
+                                }
+                            }
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+template GemmMicroKernel<float> select_gemm_micro<float>() noexcept;
+template GemmMicroKernel<std::int32_t> select_gemm_micro<std::int32_t>() noexcept;
+template void gemm<float>(std::size_t, std::size_t, std::size_t, const float*, std::size_t, std::size_t, const float*,
+                          std::size_t, std::size_t, float*, std::size_t);
+template void gemm<std::int32_t>(std::size_t, std::size_t, std::size_t, const std::int32_t*, std::size_t, std::size_t,
+                                 const std::int32_t*, std::size_t, std::size_t, std::int32_t*, std::size_t);
+
+}  // namespace minidl::kernels
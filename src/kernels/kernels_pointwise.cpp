@@ -4,44 +4,29 @@
 
 namespace minidl::kernels {
 
-// Add instances
-template void binary_contig<float, detail::AddOp<float>>(float*, const float*, const float*, std::size_t) noexcept;
-template void binary_contig<std::int32_t, detail::AddOp<std::int32_t>>(std::int32_t*, const std::int32_t*,
-                                                                       const std::int32_t*, std::size_t) noexcept;
-template void binary_same_shape_strided<float, detail::AddOp<float>>(float*, const float*, const float*,
-                                                                     const std::vector<std::size_t>&,
-                                                                     const std::vector<std::size_t>&,
-                                                                     const std::vector<std::size_t>&) noexcept;
-template void binary_same_shape_strided<std::int32_t, detail::AddOp<std::int32_t>>(
-    std::int32_t*, const std::int32_t*, const std::int32_t*, const std::vector<std::size_t>&,
-    const std::vector<std::size_t>&, const std::vector<std::size_t>&) noexcept;
-template void binary_broadcast<float, detail::AddOp<float>>(float*, const float*, const float*,
-                                                            const std::vector<std::size_t>&,
-                                                            const std::vector<std::size_t>&,
-                                                            const std::vector<std::size_t>&) noexcept;
-template void binary_broadcast<std::int32_t, detail::AddOp<float>>(std::int32_t*, const std::int32_t*,
-                                                                   const std::int32_t*, const std::vector<std::size_t>&,
-                                                                   const std::vector<std::size_t>&,
-                                                                   const std::vector<std::size_t>&) noexcept;
+using detail::TensorIterator;
 
-// Mul instances
-template void binary_contig<float, detail::MulOp<float>>(float*, const float*, const float*, std::size_t) noexcept;
-template void binary_contig<std::int32_t, detail::MulOp<std::int32_t>>(std::int32_t*, const std::int32_t*,
-                                                                       const std::int32_t*, std::size_t) noexcept;
-template void binary_same_shape_strided<float, detail::MulOp<float>>(float*, const float*, const float*,
-                                                                     const std::vector<std::size_t>&,
-                                                                     const std::vector<std::size_t>&,
-                                                                     const std::vector<std::size_t>&) noexcept;
-template void binary_same_shape_strided<std::int32_t, detail::MulOp<std::int32_t>>(
-    std::int32_t*, const std::int32_t*, const std::int32_t*, const std::vector<std::size_t>&,
-    const std::vector<std::size_t>&, const std::vector<std::size_t>&) noexcept;
-template void binary_broadcast<float, detail::MulOp<float>>(float*, const float*, const float*,
-                                                            const std::vector<std::size_t>&,
-                                                            const std::vector<std::size_t>&,
-                                                            const std::vector<std::size_t>&) noexcept;
-template void binary_broadcast<std::int32_t, detail::MulOp<float>>(std::int32_t*, const std::int32_t*,
-                                                                   const std::int32_t*, const std::vector<std::size_t>&,
-                                                                   const std::vector<std::size_t>&,
-                                                                   const std::vector<std::size_t>&) noexcept;
+// The contiguous, same-shape strided and broadcast kernels of every op in the table, for
+// every dtype with kernels of its own (f16 and bf16 run the f32 ones).
+#define MINIDL_INSTANTIATE_BINARY_T(T, Op)                                                                       \
+    template void binary_contig<T, detail::Op<T>>(typename detail::Op<T>::result_type*, const T*, const T*,     \
+                                                  std::size_t) noexcept;                                       \
+    template void binary_same_shape_strided<T, detail::Op<T>>(typename detail::Op<T>::result_type*, const T*,   \
+                                                              const T*, const TensorIterator&, std::size_t,     \
+                                                              std::size_t) noexcept;                           \
+    template void binary_broadcast<T, detail::Op<T>>(typename detail::Op<T>::result_type*, const T*, const T*,  \
+                                                     const TensorIterator&, std::size_t, std::size_t) noexcept;
+
+#define MINIDL_INSTANTIATE_BINARY(name, Op)      \
+    MINIDL_INSTANTIATE_BINARY_T(float, Op)        \
+    MINIDL_INSTANTIATE_BINARY_T(double, Op)       \
+    MINIDL_INSTANTIATE_BINARY_T(std::int8_t, Op)  \
+    MINIDL_INSTANTIATE_BINARY_T(std::uint8_t, Op) \
+    MINIDL_INSTANTIATE_BINARY_T(std::int32_t, Op) \
+    MINIDL_INSTANTIATE_BINARY_T(std::int64_t, Op)
+
+MINIDL_BINARY_OPS(MINIDL_INSTANTIATE_BINARY)
+#undef MINIDL_INSTANTIATE_BINARY
+#undef MINIDL_INSTANTIATE_BINARY_T
 
 }  // namespace minidl::kernels
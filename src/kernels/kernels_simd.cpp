@@ -0,0 +1,97 @@
+#include "minidl/detail/kernels_simd.h"
+
+#include "minidl/detail/binary_ops.h"
+#include "minidl/detail/cpu_features.h"
+#include "minidl/detail/reduce_ops.h"
+#include "minidl/detail/unary_ops.h"
+
+namespace minidl::kernels {
+
+template <typename T, class Op>
+BinaryContigFn<T, Op> select_binary_contig() noexcept {
+    if constexpr (has_simd_binary_v<T, Op>) {
+        const auto cap = detail::cpu_capability();
+        (void)cap;
+#if defined(MINIDL_HAVE_AVX512)
+        if (cap == detail::CpuCapability::avx512) return &avx512::binary_contig<T, Op>;
+#endif
+#if defined(MINIDL_HAVE_AVX2)
+        if (cap == detail::CpuCapability::avx512 || cap == detail::CpuCapability::avx2) {
+            return &avx2::binary_contig<T, Op>;
+        }
+#endif
+#if defined(MINIDL_HAVE_NEON)
+        if (cap == detail::CpuCapability::neon) return &neon::binary_contig<T, Op>;
+#endif
+    }
+    return &binary_contig<T, Op>;
+}
+
+#define MINIDL_INSTANTIATE_SELECT_BINARY(name, Op)                                                 \
+    template BinaryContigFn<float, detail::Op<float>> select_binary_contig<float, detail::Op<float>>() noexcept; \
+    template BinaryContigFn<std::int32_t, detail::Op<std::int32_t>>                               \
+    select_binary_contig<std::int32_t, detail::Op<std::int32_t>>() noexcept;
+
+MINIDL_BINARY_OPS(MINIDL_INSTANTIATE_SELECT_BINARY)
+#undef MINIDL_INSTANTIATE_SELECT_BINARY
+
+template <typename T, class R>
+ReduceContigFn<T, R> select_reduce_contig() noexcept {
+    const auto cap = detail::cpu_capability();
+    (void)cap;
+#if defined(MINIDL_HAVE_AVX512)
+    if (cap == detail::CpuCapability::avx512) return &avx512::reduce_contig<T, R>;
+#endif
+#if defined(MINIDL_HAVE_AVX2)
+    if (cap == detail::CpuCapability::avx512 || cap == detail::CpuCapability::avx2) {
+        return &avx2::reduce_contig<T, R>;
+    }
+#endif
+#if defined(MINIDL_HAVE_NEON)
+    if (cap == detail::CpuCapability::neon) return &neon::reduce_contig<T, R>;
+#endif
+    return &detail::reduce_contig<T, R>;
+}
+
+#define MINIDL_INSTANTIATE_SELECT_REDUCE(R)                                                     \
+    template ReduceContigFn<float, detail::R<float>> select_reduce_contig<float, detail::R<float>>() noexcept; \
+    template ReduceContigFn<std::int32_t, detail::R<std::int32_t>>                              \
+    select_reduce_contig<std::int32_t, detail::R<std::int32_t>>() noexcept;
+
+MINIDL_INSTANTIATE_SELECT_REDUCE(SumReduce)
+MINIDL_INSTANTIATE_SELECT_REDUCE(ProdReduce)
+MINIDL_INSTANTIATE_SELECT_REDUCE(MaxReduce)
+MINIDL_INSTANTIATE_SELECT_REDUCE(MinReduce)
+#undef MINIDL_INSTANTIATE_SELECT_REDUCE
+
+template <typename T, class Op>
+UnaryContigFn<T, Op> select_unary_contig() noexcept {
+    const auto cap = detail::cpu_capability();
+    (void)cap;
+#if defined(MINIDL_HAVE_AVX512)
+    if (cap == detail::CpuCapability::avx512) return &avx512::unary_contig<T, Op>;
+#endif
+#if defined(MINIDL_HAVE_AVX2)
+    if (cap == detail::CpuCapability::avx512 || cap == detail::CpuCapability::avx2) {
+        return &avx2::unary_contig<T, Op>;
+    }
+#endif
+#if defined(MINIDL_HAVE_NEON)
+    if (cap == detail::CpuCapability::neon) return &neon::unary_contig<T, Op>;
+#endif
+    return &unary_contig<T, Op>;
+}
+
+#define MINIDL_INSTANTIATE_SELECT_UNARY(T, Op) \
+    template UnaryContigFn<T, detail::Op<T>> select_unary_contig<T, detail::Op<T>>() noexcept;
+
+MINIDL_INSTANTIATE_SELECT_UNARY(float, ExpOp)
+MINIDL_INSTANTIATE_SELECT_UNARY(float, LogOp)
+MINIDL_INSTANTIATE_SELECT_UNARY(float, TanhOp)
+MINIDL_INSTANTIATE_SELECT_UNARY(float, SigmoidOp)
+MINIDL_INSTANTIATE_SELECT_UNARY(float, GeluOp)
+MINIDL_INSTANTIATE_SELECT_UNARY(float, ReluOp)
+MINIDL_INSTANTIATE_SELECT_UNARY(std::int32_t, ReluOp)
+#undef MINIDL_INSTANTIATE_SELECT_UNARY
+
+}  // namespace minidl::kernels
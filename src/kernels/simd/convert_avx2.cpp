@@ -0,0 +1,89 @@
+// Built with avx2 code generation flags, which include F16C (see src/CMakeLists.txt).
+#include <immintrin.h>
+
+#include <cstring>
+
+#include "minidl/detail/convert.h"
+
+namespace minidl::kernels::avx2 {
+
+namespace {
+
+// 8 f32 bit patterns rounded to nearest even bf16; NaN stays NaN, made quiet.
+inline __m256i bf16_round(__m256i x) noexcept {
+    const __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+    const __m256i rounded = _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff))), 16);
+    const __m256i abs = _mm256_and_si256(x, _mm256_set1_epi32(0x7fffffff));
+    const __m256i nan = _mm256_cmpgt_epi32(abs, _mm256_set1_epi32(0x7f800000));
+    const __m256i quiet = _mm256_or_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(0x0040));
+    return _mm256_blendv_epi8(rounded, quiet, nan);
+}
+
+inline void f32_to_bf16_16(std::uint16_t* dst, const float* src) noexcept {
+    const __m256i lo = bf16_round(_mm256_castps_si256(_mm256_loadu_ps(src)));
+    const __m256i hi = bf16_round(_mm256_castps_si256(_mm256_loadu_ps(src + 8)));
+    // packus interleaves the 128-bit lanes of lo and hi; the permute puts them back in order.
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), packed);
+}
+
+}  // namespace
+
+void f32_to_f16(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), h);
+    }
+    if (i < n) {
+        float in[8] = {};
+        std::uint16_t out[8];
+        std::memcpy(in, src + i, (n - i) * sizeof(float));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_cvtps_ph(_mm256_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT));
+        std::memcpy(dst + i, out, (n - i) * sizeof(std::uint16_t));
+    }
+}
+
+void f16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    }
+    if (i < n) {
+        std::uint16_t in[8] = {};
+        float out[8];
+        std::memcpy(in, src + i, (n - i) * sizeof(std::uint16_t));
+        _mm256_storeu_ps(out, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))));
+        std::memcpy(dst + i, out, (n - i) * sizeof(float));
+    }
+}
+
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) f32_to_bf16_16(dst + i, src + i);
+    if (i < n) {
+        float in[16] = {};
+        std::uint16_t out[16];
+        std::memcpy(in, src + i, (n - i) * sizeof(float));
+        f32_to_bf16_16(out, in);
+        std::memcpy(dst + i, out, (n - i) * sizeof(std::uint16_t));
+    }
+}
+
+void bf16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i w = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_slli_epi32(w, 16));
+    }
+    if (i < n) {
+        std::uint16_t in[8] = {};
+        float out[8];
+        std::memcpy(in, src + i, (n - i) * sizeof(std::uint16_t));
+        const __m256i w = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_slli_epi32(w, 16));
+        std::memcpy(dst + i, out, (n - i) * sizeof(float));
+    }
+}
+
+}  // namespace minidl::kernels::avx2
@@ -0,0 +1,95 @@
+// Built with avx512 code generation flags (see src/CMakeLists.txt).
+#include <immintrin.h>
+
+#include <cstring>
+
+#include "minidl/detail/convert.h"
+
+namespace minidl::kernels::avx512 {
+
+namespace {
+
+// masked forms: GCC 12 warns about the unmasked ones' undefined pass-through operand.
+inline __m512i srli16(__m512i x) noexcept { return _mm512_mask_srli_epi32(x, 0xFFFF, x, 16); }
+
+// 16 f32 bit patterns rounded to nearest even bf16; NaN stays NaN, made quiet.
+inline __m256i bf16_round(__m512i x) noexcept {
+    const __m512i lsb = _mm512_and_si512(srli16(x), _mm512_set1_epi32(1));
+    const __m512i rounded = srli16(_mm512_add_epi32(x, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7fff))));
+    const __m512i abs = _mm512_and_si512(x, _mm512_set1_epi32(0x7fffffff));
+    const __mmask16 nan = _mm512_cmpgt_epi32_mask(abs, _mm512_set1_epi32(0x7f800000));
+    const __m512i quiet = _mm512_or_si512(srli16(x), _mm512_set1_epi32(0x0040));
+    return _mm512_mask_cvtepi32_epi16(_mm256_setzero_si256(), 0xFFFF, _mm512_mask_blend_epi32(nan, rounded, quiet));
+}
+
+inline __m256i f32_to_f16_16(__m512 x) noexcept {
+    return _mm512_mask_cvtps_ph(_mm256_setzero_si256(), 0xFFFF, x, _MM_FROUND_TO_NEAREST_INT);
+}
+
+inline __m512 f16_to_f32_16(__m256i h) noexcept { return _mm512_mask_cvtph_ps(_mm512_setzero_ps(), 0xFFFF, h); }
+
+inline __m512i bf16_to_f32_16(__m256i b) noexcept {
+    const __m512i w = _mm512_maskz_cvtepu16_epi32(0xFFFF, b);
+    return _mm512_mask_slli_epi32(w, 0xFFFF, w, 16);
+}
+
+}  // namespace
+
+void f32_to_f16(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), f32_to_f16_16(_mm512_loadu_ps(src + i)));
+    }
+    if (i < n) {
+        float in[16] = {};
+        std::uint16_t out[16];
+        std::memcpy(in, src + i, (n - i) * sizeof(float));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), f32_to_f16_16(_mm512_loadu_ps(in)));
+        std::memcpy(dst + i, out, (n - i) * sizeof(std::uint16_t));
+    }
+}
+
+void f16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(dst + i, f16_to_f32_16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+    }
+    if (i < n) {
+        std::uint16_t in[16] = {};
+        float out[16];
+        std::memcpy(in, src + i, (n - i) * sizeof(std::uint16_t));
+        _mm512_storeu_ps(out, f16_to_f32_16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))));
+        std::memcpy(dst + i, out, (n - i) * sizeof(float));
+    }
+}
+
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            bf16_round(_mm512_castps_si512(_mm512_loadu_ps(src + i))));
+    }
+    if (i < n) {
+        float in[16] = {};
+        std::uint16_t out[16];
+        std::memcpy(in, src + i, (n - i) * sizeof(float));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bf16_round(_mm512_castps_si512(_mm512_loadu_ps(in))));
+        std::memcpy(dst + i, out, (n - i) * sizeof(std::uint16_t));
+    }
+}
+
+void bf16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_si512(dst + i, bf16_to_f32_16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+    }
+    if (i < n) {
+        std::uint16_t in[16] = {};
+        float out[16];
+        std::memcpy(in, src + i, (n - i) * sizeof(std::uint16_t));
+        _mm512_storeu_si512(out, bf16_to_f32_16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in))));
+        std::memcpy(dst + i, out, (n - i) * sizeof(float));
+    }
+}
+
+}  // namespace minidl::kernels::avx512
@@ -0,0 +1,25 @@
+// Built with avx512 + AVX512_BF16 code generation flags (see src/CMakeLists.txt); only
+// called when detail::cpu_has_avx512_bf16().
+#include <immintrin.h>
+
+#include <cstring>
+
+#include "minidl/detail/convert.h"
+
+namespace minidl::kernels::avx512bf16 {
+
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256bh b = _mm512_cvtneps_pbh(_mm512_loadu_ps(src + i));
+        std::memcpy(dst + i, &b, sizeof(b));
+    }
+    if (i < n) {
+        float in[16] = {};
+        std::memcpy(in, src + i, (n - i) * sizeof(float));
+        const __m256bh b = _mm512_cvtneps_pbh(_mm512_loadu_ps(in));
+        std::memcpy(dst + i, &b, (n - i) * sizeof(std::uint16_t));
+    }
+}
+
+}  // namespace minidl::kernels::avx512bf16
@@ -0,0 +1,75 @@
+// AArch64: NEON and the f16 conversions are part of the baseline.
+#include <arm_neon.h>
+
+#include <cstring>
+
+#include "minidl/detail/convert.h"
+
+namespace minidl::kernels::neon {
+
+namespace {
+
+// 4 f32 bit patterns rounded to nearest even bf16; NaN stays NaN, made quiet.
+inline uint16x4_t bf16_round(uint32x4_t x) noexcept {
+    const uint32x4_t lsb = vandq_u32(vshrq_n_u32(x, 16), vdupq_n_u32(1));
+    const uint32x4_t rounded = vshrq_n_u32(vaddq_u32(x, vaddq_u32(lsb, vdupq_n_u32(0x7fff))), 16);
+    const uint32x4_t nan = vcgtq_u32(vandq_u32(x, vdupq_n_u32(0x7fffffff)), vdupq_n_u32(0x7f800000));
+    const uint32x4_t quiet = vorrq_u32(vshrq_n_u32(x, 16), vdupq_n_u32(0x0040));
+    return vmovn_u32(vbslq_u32(nan, quiet, rounded));
+}
+
+inline uint16x4_t f32_to_f16_4(float32x4_t x) noexcept { return vreinterpret_u16_f16(vcvt_f16_f32(x)); }
+inline float32x4_t f16_to_f32_4(uint16x4_t h) noexcept { return vcvt_f32_f16(vreinterpret_f16_u16(h)); }
+inline float32x4_t bf16_to_f32_4(uint16x4_t b) noexcept { return vreinterpretq_f32_u32(vshll_n_u16(b, 16)); }
+
+}  // namespace
+
+void f32_to_f16(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) vst1_u16(dst + i, f32_to_f16_4(vld1q_f32(src + i)));
+    if (i < n) {
+        float in[4] = {};
+        std::uint16_t out[4];
+        std::memcpy(in, src + i, (n - i) * sizeof(float));
+        vst1_u16(out, f32_to_f16_4(vld1q_f32(in)));
+        std::memcpy(dst + i, out, (n - i) * sizeof(std::uint16_t));
+    }
+}
+
+void f16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) vst1q_f32(dst + i, f16_to_f32_4(vld1_u16(src + i)));
+    if (i < n) {
+        std::uint16_t in[4] = {};
+        float out[4];
+        std::memcpy(in, src + i, (n - i) * sizeof(std::uint16_t));
+        vst1q_f32(out, f16_to_f32_4(vld1_u16(in)));
+        std::memcpy(dst + i, out, (n - i) * sizeof(float));
+    }
+}
+
+void f32_to_bf16(std::uint16_t* dst, const float* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) vst1_u16(dst + i, bf16_round(vreinterpretq_u32_f32(vld1q_f32(src + i))));
+    if (i < n) {
+        float in[4] = {};
+        std::uint16_t out[4];
+        std::memcpy(in, src + i, (n - i) * sizeof(float));
+        vst1_u16(out, bf16_round(vreinterpretq_u32_f32(vld1q_f32(in))));
+        std::memcpy(dst + i, out, (n - i) * sizeof(std::uint16_t));
+    }
+}
+
+void bf16_to_f32(float* dst, const std::uint16_t* src, std::size_t n) noexcept {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) vst1q_f32(dst + i, bf16_to_f32_4(vld1_u16(src + i)));
+    if (i < n) {
+        std::uint16_t in[4] = {};
+        float out[4];
+        std::memcpy(in, src + i, (n - i) * sizeof(std::uint16_t));
+        vst1q_f32(out, bf16_to_f32_4(vld1_u16(in)));
+        std::memcpy(dst + i, out, (n - i) * sizeof(float));
+    }
+}
+
+}  // namespace minidl::kernels::neon
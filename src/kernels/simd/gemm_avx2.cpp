@@ -0,0 +1,25 @@
+// Built with avx2 code generation flags (see src/CMakeLists.txt).
+#include "minidl/detail/gemm.h"
+#include "minidl/detail/simd/gemm_micro_vec.h"
+#include "minidl/detail/simd/vec_avx2.h"
+
+namespace minidl::kernels::avx2 {
+
+namespace {
+
+template <typename T>
+void gemm_6x16(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc, bool accumulate) noexcept {
+    simd::gemm_micro_vec<simd::avx2::Vec<T>, 6, 2>(kc, a, b, c, ldc, accumulate);
+}
+
+}  // namespace
+
+template <typename T>
+GemmMicroKernel<T> gemm_micro() noexcept {
+    return {6, 16, &gemm_6x16<T>};
+}
+
+template GemmMicroKernel<float> gemm_micro<float>() noexcept;
+template GemmMicroKernel<std::int32_t> gemm_micro<std::int32_t>() noexcept;
+
+}  // namespace minidl::kernels::avx2
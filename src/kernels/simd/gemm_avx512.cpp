@@ -0,0 +1,25 @@
+// Built with avx512 code generation flags (see src/CMakeLists.txt).
+#include "minidl/detail/gemm.h"
+#include "minidl/detail/simd/gemm_micro_vec.h"
+#include "minidl/detail/simd/vec_avx512.h"
+
+namespace minidl::kernels::avx512 {
+
+namespace {
+
+template <typename T>
+void gemm_8x32(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc, bool accumulate) noexcept {
+    simd::gemm_micro_vec<simd::avx512::Vec<T>, 8, 2>(kc, a, b, c, ldc, accumulate);
+}
+
+}  // namespace
+
+template <typename T>
+GemmMicroKernel<T> gemm_micro() noexcept {
+    return {8, 32, &gemm_8x32<T>};
+}
+
+template GemmMicroKernel<float> gemm_micro<float>() noexcept;
+template GemmMicroKernel<std::int32_t> gemm_micro<std::int32_t>() noexcept;
+
+}  // namespace minidl::kernels::avx512
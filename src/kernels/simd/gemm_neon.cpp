@@ -0,0 +1,25 @@
+// Built with neon code generation flags (see src/CMakeLists.txt).
+#include "minidl/detail/gemm.h"
+#include "minidl/detail/simd/gemm_micro_vec.h"
+#include "minidl/detail/simd/vec_neon.h"
+
+namespace minidl::kernels::neon {
+
+namespace {
+
+template <typename T>
+void gemm_8x8(std::size_t kc, const T* a, const T* b, T* c, std::size_t ldc, bool accumulate) noexcept {
+    simd::gemm_micro_vec<simd::neon::Vec<T>, 8, 2>(kc, a, b, c, ldc, accumulate);
+}
+
+}  // namespace
+
+template <typename T>
+GemmMicroKernel<T> gemm_micro() noexcept {
+    return {8, 8, &gemm_8x8<T>};
+}
+
+template GemmMicroKernel<float> gemm_micro<float>() noexcept;
+template GemmMicroKernel<std::int32_t> gemm_micro<std::int32_t>() noexcept;
+
+}  // namespace minidl::kernels::neon
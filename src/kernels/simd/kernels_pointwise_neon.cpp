@@ -0,0 +1,23 @@
+// Built with neon code generation flags (see src/CMakeLists.txt).
+#include "minidl/detail/binary_ops.h"
+#include "minidl/detail/kernels_simd.h"
+#include "minidl/detail/simd/binary_contig_vec.h"
+#include "minidl/detail/simd/vec_neon.h"
+
+namespace minidl::kernels::neon {
+
+template <typename T, class Op>
+void binary_contig(typename Op::result_type* z, const T* x, const T* y, std::size_t n) noexcept {
+    if constexpr (has_simd_binary_v<T, Op>) simd::binary_contig_vec<simd::neon::Vec<T>, Op>(z, x, y, n);
+}
+
+#define MINIDL_INSTANTIATE_BINARY(name, Op)                                                         \
+    template void binary_contig<float, detail::Op<float>>(typename detail::Op<float>::result_type*, const float*, \
+                                                          const float*, std::size_t) noexcept;       \
+    template void binary_contig<std::int32_t, detail::Op<std::int32_t>>(                             \
+        typename detail::Op<std::int32_t>::result_type*, const std::int32_t*, const std::int32_t*, std::size_t) noexcept;
+
+MINIDL_BINARY_OPS(MINIDL_INSTANTIATE_BINARY)
+#undef MINIDL_INSTANTIATE_BINARY
+
+}  // namespace minidl::kernels::neon
@@ -0,0 +1,25 @@
+// Built with avx512 code generation flags (see src/CMakeLists.txt).
+#include "minidl/detail/kernels_simd.h"
+#include "minidl/detail/reduce_ops.h"
+#include "minidl/detail/simd/reduce_contig_vec.h"
+#include "minidl/detail/simd/vec_avx512.h"
+
+namespace minidl::kernels::avx512 {
+
+template <typename T, class R>
+T reduce_contig(const T* x, std::size_t n) noexcept {
+    return simd::reduce_contig_vec<simd::avx512::Vec<T>, R>(x, n);
+}
+
+#define MINIDL_INSTANTIATE_REDUCE(R)                                                        \
+    template float reduce_contig<float, detail::R<float>>(const float*, std::size_t) noexcept; \
+    template std::int32_t reduce_contig<std::int32_t, detail::R<std::int32_t>>(const std::int32_t*,  \
+                                                                               std::size_t) noexcept;
+
+MINIDL_INSTANTIATE_REDUCE(SumReduce)
+MINIDL_INSTANTIATE_REDUCE(ProdReduce)
+MINIDL_INSTANTIATE_REDUCE(MaxReduce)
+MINIDL_INSTANTIATE_REDUCE(MinReduce)
+#undef MINIDL_INSTANTIATE_REDUCE
+
+}  // namespace minidl::kernels::avx512
@@ -0,0 +1,26 @@
+// Built with avx2 code generation flags (see src/CMakeLists.txt).
+#include "minidl/detail/kernels_simd.h"
+#include "minidl/detail/simd/unary_contig_vec.h"
+#include "minidl/detail/simd/vec_avx2.h"
+#include "minidl/detail/unary_ops.h"
+
+namespace minidl::kernels::avx2 {
+
+template <typename T, class Op>
+void unary_contig(T* z, const T* x, std::size_t n) noexcept {
+    simd::unary_contig_vec<simd::avx2::Vec<T>, Op>(z, x, n);
+}
+
+#define MINIDL_INSTANTIATE_UNARY(T, Op) \
+    template void unary_contig<T, detail::Op<T>>(T*, const T*, std::size_t) noexcept;
+
+MINIDL_INSTANTIATE_UNARY(float, ExpOp)
+MINIDL_INSTANTIATE_UNARY(float, LogOp)
+MINIDL_INSTANTIATE_UNARY(float, TanhOp)
+MINIDL_INSTANTIATE_UNARY(float, SigmoidOp)
+MINIDL_INSTANTIATE_UNARY(float, GeluOp)
+MINIDL_INSTANTIATE_UNARY(float, ReluOp)
+MINIDL_INSTANTIATE_UNARY(std::int32_t, ReluOp)
+#undef MINIDL_INSTANTIATE_UNARY
+
+}  // namespace minidl::kernels::avx2
@@ -0,0 +1,74 @@
+// Built with avx2 code generation flags (see src/CMakeLists.txt).
+#include <immintrin.h>
+
+#include "minidl/detail/transpose.h"
+
+namespace minidl::kernels::avx2 {
+
+namespace {
+
+// rows 0..7 of src (stride src_ld) become columns 0..7 of dst (stride dst_ld).
+inline void transpose_8x8(std::uint32_t* dst, const std::uint32_t* src, std::size_t dst_ld,
+                          std::size_t src_ld) noexcept {
+    const auto* s = reinterpret_cast<const float*>(src);
+    auto* d = reinterpret_cast<float*>(dst);
+
+    const __m256 r0 = _mm256_loadu_ps(s + 0 * src_ld);
+    const __m256 r1 = _mm256_loadu_ps(s + 1 * src_ld);
+    const __m256 r2 = _mm256_loadu_ps(s + 2 * src_ld);
+    const __m256 r3 = _mm256_loadu_ps(s + 3 * src_ld);
+    const __m256 r4 = _mm256_loadu_ps(s + 4 * src_ld);
+    const __m256 r5 = _mm256_loadu_ps(s + 5 * src_ld);
+    const __m256 r6 = _mm256_loadu_ps(s + 6 * src_ld);
+    const __m256 r7 = _mm256_loadu_ps(s + 7 * src_ld);
+
+    // 2x2 blocks of pairs, then 4x4 within each 128-bit lane, then swap lanes.
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    const __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    const __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    const __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    const __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    const __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(d + 0 * dst_ld, _mm256_permute2f128_ps(u0, u4, 0x20));
+    _mm256_storeu_ps(d + 1 * dst_ld, _mm256_permute2f128_ps(u1, u5, 0x20));
+    _mm256_storeu_ps(d + 2 * dst_ld, _mm256_permute2f128_ps(u2, u6, 0x20));
+    _mm256_storeu_ps(d + 3 * dst_ld, _mm256_permute2f128_ps(u3, u7, 0x20));
+    _mm256_storeu_ps(d + 4 * dst_ld, _mm256_permute2f128_ps(u0, u4, 0x31));
+    _mm256_storeu_ps(d + 5 * dst_ld, _mm256_permute2f128_ps(u1, u5, 0x31));
+    _mm256_storeu_ps(d + 6 * dst_ld, _mm256_permute2f128_ps(u2, u6, 0x31));
+    _mm256_storeu_ps(d + 7 * dst_ld, _mm256_permute2f128_ps(u3, u7, 0x31));
+}
+
+}  // namespace
+
+void transpose_2d_32(std::uint32_t* dst, const std::uint32_t* src, std::size_t rows, std::size_t cols,
+                     std::size_t dst_ld, std::size_t src_ld) noexcept {
+    const std::size_t rows8 = rows & ~std::size_t{7};
+    const std::size_t cols8 = cols & ~std::size_t{7};
+
+    for (std::size_t r = 0; r < rows8; r += 8) {
+        for (std::size_t c = 0; c < cols8; c += 8) {
+            transpose_8x8(dst + r * dst_ld + c, src + c * src_ld + r, dst_ld, src_ld);
+        }
+        for (std::size_t rr = r; rr < r + 8; ++rr) {
+            for (std::size_t c = cols8; c < cols; ++c) dst[rr * dst_ld + c] = src[c * src_ld + rr];
+        }
+    }
+    for (std::size_t r = rows8; r < rows; ++r) {
+        for (std::size_t c = 0; c < cols; ++c) dst[r * dst_ld + c] = src[c * src_ld + r];
+    }
+}
+
+}  // namespace minidl::kernels::avx2
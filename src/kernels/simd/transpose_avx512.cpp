@@ -0,0 +1,78 @@
+// Built with avx512 code generation flags (see src/CMakeLists.txt).
+#include <immintrin.h>
+
+#include "minidl/detail/transpose.h"
+
+namespace minidl::kernels::avx512 {
+
+namespace {
+
+// GCC 12's avx512fintrin.h passes _mm512_undefined_ps() as the merge source of the unpack
+// and shuffle intrinsics, which -Wuninitialized flags wherever they are inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+// rows 0..15 of src (stride src_ld) become columns 0..15 of dst (stride dst_ld). Each source
+// and destination row is one full cache line, so no line is touched twice.
+inline void transpose_16x16(std::uint32_t* dst, const std::uint32_t* src, std::size_t dst_ld,
+                            std::size_t src_ld) noexcept {
+    const auto* s = reinterpret_cast<const float*>(src);
+    auto* d = reinterpret_cast<float*>(dst);
+
+    __m512 r[16];
+    for (int i = 0; i < 16; ++i) r[i] = _mm512_loadu_ps(s + i * src_ld);
+
+    // pairs, then quads within each 128-bit lane.
+    __m512 t[16];
+    for (int i = 0; i < 16; i += 2) {
+        t[i] = _mm512_unpacklo_ps(r[i], r[i + 1]);
+        t[i + 1] = _mm512_unpackhi_ps(r[i], r[i + 1]);
+    }
+    __m512 u[16];
+    for (int i = 0; i < 16; i += 4) {
+        u[i + 0] = _mm512_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        u[i + 1] = _mm512_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        u[i + 2] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        u[i + 3] = _mm512_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    // 128-bit lanes: even/odd lanes of 4-row groups, then of 8-row groups.
+    __m512 v[16];
+    for (int g = 0; g < 16; g += 8) {
+        for (int i = 0; i < 4; ++i) {
+            v[g + i] = _mm512_shuffle_f32x4(u[g + i], u[g + 4 + i], 0x88);
+            v[g + 4 + i] = _mm512_shuffle_f32x4(u[g + i], u[g + 4 + i], 0xdd);
+        }
+    }
+    for (int i = 0; i < 8; ++i) {
+        _mm512_storeu_ps(d + i * dst_ld, _mm512_shuffle_f32x4(v[i], v[8 + i], 0x88));
+        _mm512_storeu_ps(d + (8 + i) * dst_ld, _mm512_shuffle_f32x4(v[i], v[8 + i], 0xdd));
+    }
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+}  // namespace
+
+void transpose_2d_32(std::uint32_t* dst, const std::uint32_t* src, std::size_t rows, std::size_t cols,
+                     std::size_t dst_ld, std::size_t src_ld) noexcept {
+    const std::size_t rows16 = rows & ~std::size_t{15};
+    const std::size_t cols16 = cols & ~std::size_t{15};
+
+    for (std::size_t r = 0; r < rows16; r += 16) {
+        for (std::size_t c = 0; c < cols16; c += 16) {
+            transpose_16x16(dst + r * dst_ld + c, src + c * src_ld + r, dst_ld, src_ld);
+        }
+        for (std::size_t rr = r; rr < r + 16; ++rr) {
+            for (std::size_t c = cols16; c < cols; ++c) dst[rr * dst_ld + c] = src[c * src_ld + rr];
+        }
+    }
+    for (std::size_t r = rows16; r < rows; ++r) {
+        for (std::size_t c = 0; c < cols; ++c) dst[r * dst_ld + c] = src[c * src_ld + r];
+    }
+}
+
+}  // namespace minidl::kernels::avx512
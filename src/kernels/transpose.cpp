@@ -0,0 +1,73 @@
+#include "minidl/detail/transpose.h"
+
+#include "minidl/detail/cpu_features.h"
+
+#include <cstring>
+
+namespace minidl::kernels {
+
+namespace {
+
+template <typename U>
+void transpose_2d_typed(U* dst, const U* src, std::size_t rows, std::size_t cols, std::size_t dst_ld,
+                        std::size_t src_ld) noexcept {
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < cols; ++c) dst[r * dst_ld + c] = src[c * src_ld + r];
+    }
+}
+
+using Transpose32Fn = void (*)(std::uint32_t*, const std::uint32_t*, std::size_t, std::size_t, std::size_t,
+                               std::size_t) noexcept;
+
+void transpose_2d_32_scalar(std::uint32_t* dst, const std::uint32_t* src, std::size_t rows, std::size_t cols,
+                            std::size_t dst_ld, std::size_t src_ld) noexcept {
+    transpose_2d_typed(dst, src, rows, cols, dst_ld, src_ld);
+}
+
+Transpose32Fn select_transpose_2d_32() noexcept {
+    const auto cap = detail::cpu_capability();
+    (void)cap;
+#if defined(MINIDL_HAVE_AVX512)
+    if (cap == detail::CpuCapability::avx512) return &avx512::transpose_2d_32;
+#endif
+#if defined(MINIDL_HAVE_AVX2)
+    if (cap == detail::CpuCapability::avx512 || cap == detail::CpuCapability::avx2) return &avx2::transpose_2d_32;
+#endif
+    return &transpose_2d_32_scalar;
+}
+
+}  // namespace
+
+void transpose_2d(void* dst, const void* src, std::size_t rows, std::size_t cols, std::size_t dst_ld,
+                  std::size_t src_ld, std::size_t item) noexcept {
+    switch (item) {
+        case 1:
+            transpose_2d_typed(static_cast<std::uint8_t*>(dst), static_cast<const std::uint8_t*>(src), rows, cols,
+                               dst_ld, src_ld);
+            return;
+        case 2:
+            transpose_2d_typed(static_cast<std::uint16_t*>(dst), static_cast<const std::uint16_t*>(src), rows, cols,
+                               dst_ld, src_ld);
+            return;
+        case 4: {
+            static const Transpose32Fn fn = select_transpose_2d_32();
+            fn(static_cast<std::uint32_t*>(dst), static_cast<const std::uint32_t*>(src), rows, cols, dst_ld, src_ld);
+            return;
+        }
+        case 8:
+            transpose_2d_typed(static_cast<std::uint64_t*>(dst), static_cast<const std::uint64_t*>(src), rows, cols,
+                               dst_ld, src_ld);
+            return;
+        default: {
+            auto* d = static_cast<std::byte*>(dst);
+            const auto* s = static_cast<const std::byte*>(src);
+            for (std::size_t r = 0; r < rows; ++r) {
+                for (std::size_t c = 0; c < cols; ++c) {
+                    std::memcpy(d + (r * dst_ld + c) * item, s + (c * src_ld + r) * item, item);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace minidl::kernels
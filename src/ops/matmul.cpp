@@ -0,0 +1,31 @@
+#include <cstdint>
+
+#include "minidl/detail/autograd.h"
+#include "minidl/detail/dispatch.h"
+#include "minidl/detail/matmul_ops.h"
+#include "minidl/detail/trace.h"
+#include "minidl/ops.h"
+
+namespace minidl::ops {
+
+Tensor matmul(const Tensor& a, const Tensor& b) {
+    Tensor out = detail::dispatch(
+        a.dtype(), [&] { return detail::matmul_impl<float>(a, b); },
+        [&] { return detail::matmul_impl<int32_t>(a, b); });
+    detail::record_matmul(out, a, b);
+    if (detail::tracing()) {
+        detail::trace_op(
+            "matmul", [](const Tensor* const* in, Tensor& o) { matmul_out(*in[0], *in[1], o); }, out, {&a, &b},
+            false);
+    }
+    return out;
+}
+
+Tensor& matmul_out(const Tensor& a, const Tensor& b, Tensor& out) {
+    detail::trace_unsupported("matmul_out", {&a, &b, &out});
+    return detail::dispatch(
+        out.dtype(), [&]() -> Tensor& { return detail::matmul_out_impl<float>(a, b, out); },
+        [&]() -> Tensor& { return detail::matmul_out_impl<int32_t>(a, b, out); });
+}
+
+}  // namespace minidl::ops
@@ -1,21 +1,84 @@
-#include <iostream>
+#include <type_traits>
 
+#include "minidl/detail/autograd.h"
 #include "minidl/detail/binary_ops.h"
 #include "minidl/detail/dispatch.h"
+#include "minidl/detail/trace.h"
 #include "minidl/ops.h"
 
 namespace minidl::ops {
 
-Tensor add(const Tensor& a, const Tensor& b) {
-    return detail::dispatch(
-        a.dtype(), [&] { return detail::binary_impl<float, detail::AddOp<float>>(a, b); },
-        [&] { return detail::binary_impl<int32_t, detail::AddOp<int32_t>>(a, b); });
-}
-
-Tensor mul(const Tensor& a, const Tensor& b) {
-    return detail::dispatch(
-        a.dtype(), [&] { return detail::binary_impl<float, detail::MulOp<float>>(a, b); },
-        [&] { return detail::binary_impl<int32_t, detail::MulOp<int32_t>>(a, b); });
-}
+namespace {
+
+// the ops autograd differentiates.
+template <template <typename> class Op>
+constexpr detail::BinaryGrad kGrad = detail::BinaryGrad::none;
+template <>
+constexpr detail::BinaryGrad kGrad<detail::AddOp> = detail::BinaryGrad::add;
+template <>
+constexpr detail::BinaryGrad kGrad<detail::SubOp> = detail::BinaryGrad::sub;
+template <>
+constexpr detail::BinaryGrad kGrad<detail::MulOp> = detail::BinaryGrad::mul;
+template <>
+constexpr detail::BinaryGrad kGrad<detail::DivOp> = detail::BinaryGrad::div;
+
+// the ops a graph::Plan can fuse.
+template <template <typename> class Op>
+constexpr detail::PointwiseOp kPointwise = detail::PointwiseOp::none;
+template <>
+constexpr detail::PointwiseOp kPointwise<detail::AddOp> = detail::PointwiseOp::add;
+template <>
+constexpr detail::PointwiseOp kPointwise<detail::SubOp> = detail::PointwiseOp::sub;
+template <>
+constexpr detail::PointwiseOp kPointwise<detail::MulOp> = detail::PointwiseOp::mul;
+template <>
+constexpr detail::PointwiseOp kPointwise<detail::DivOp> = detail::PointwiseOp::div;
+template <>
+constexpr detail::PointwiseOp kPointwise<detail::MaximumOp> = detail::PointwiseOp::maximum;
+template <>
+constexpr detail::PointwiseOp kPointwise<detail::MinimumOp> = detail::PointwiseOp::minimum;
+
+}  // namespace
+
+// name(a, b) and name_out(a, b, out) for every op in the table, dispatched on the inputs' dtype.
+// Ops without a backward reject grad inputs, except the comparisons: a bool result carries no
+// gradient, so nothing is dropped.
+#define MINIDL_DEFINE_BINARY(name, Op)                                                                   \
+    Tensor name(const Tensor& a, const Tensor& b) {                                                      \
+        if constexpr (kGrad<detail::Op> == detail::BinaryGrad::none &&                                   \
+                      !std::is_same_v<typename detail::Op<float>::result_type, bool>) {                  \
+            detail::require_no_grad(#name, {&a, &b});                                                    \
+        }                                                                                                \
+        const DType dt = promote_types(a.dtype(), b.dtype());                                            \
+        Tensor out = detail::dispatch_types<detail::NumericTypes>(dt, #name, [&](auto tag) {             \
+            using T = typename decltype(tag)::type;                                                      \
+            return detail::binary_impl<T, detail::Op<detail::compute_type_t<T>>>(a, b);                  \
+        });                                                                                              \
+        if constexpr (kGrad<detail::Op> != detail::BinaryGrad::none) {                                   \
+            detail::record_binary(kGrad<detail::Op>, out, a, b);                                         \
+        }                                                                                                \
+        if (detail::tracing()) {                                                                         \
+            detail::trace_op(                                                                            \
+                #name, [](const Tensor* const* in, Tensor& o) { name##_out(*in[0], *in[1], o); }, out,   \
+                {&a, &b}, true, kPointwise<detail::Op>);                                                 \
+        }                                                                                                \
+        return out;                                                                                      \
+    }                                                                                                    \
+    Tensor& name##_out(const Tensor& a, const Tensor& b, Tensor& out) {                                  \
+        detail::trace_unsupported(#name "_out", {&a, &b, &out});                                         \
+        const DType dt = promote_types(a.dtype(), b.dtype());                                            \
+        return detail::dispatch_types<detail::NumericTypes>(dt, #name, [&](auto tag) -> Tensor& {        \
+            using T = typename decltype(tag)::type;                                                      \
+            return detail::binary_out_impl<T, detail::Op<detail::compute_type_t<T>>>(a, b, out);         \
+        });                                                                                              \
+    }
+
+#define MINIDL_DEFINE_BINARY_INPLACE(name, Op) \
+    Tensor& name##_(Tensor& self, const Tensor& other) { return name##_out(self, other, self); }
+
+MINIDL_BINARY_OPS(MINIDL_DEFINE_BINARY)
+MINIDL_ARITHMETIC_BINARY_OPS(MINIDL_DEFINE_BINARY_INPLACE)
+#undef MINIDL_DEFINE_BINARY
+#undef MINIDL_DEFINE_BINARY_INPLACE
 
 }  // namespace minidl::ops
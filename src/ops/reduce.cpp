@@ -0,0 +1,70 @@
+#include <cstdint>
+
+#include "minidl/detail/autograd.h"
+#include "minidl/detail/dispatch.h"
+#include "minidl/detail/reduce_ops.h"
+#include "minidl/detail/trace.h"
+#include "minidl/ops.h"
+
+namespace minidl::ops {
+
+Tensor sum(const Tensor& x, const std::vector<std::size_t>& axes, bool keepdim) {
+    detail::trace_unsupported("sum", {&x});
+    Tensor out = detail::dispatch(
+        x.dtype(), [&] { return detail::reduce_impl<float, detail::SumReduce<float>>(x, axes, keepdim, "sum"); },
+        [&] { return detail::reduce_impl<int32_t, detail::SumReduce<int32_t>>(x, axes, keepdim, "sum"); });
+    detail::record_reduce(detail::ReduceGrad::sum, out, x, axes);
+    return out;
+}
+
+Tensor prod(const Tensor& x, const std::vector<std::size_t>& axes, bool keepdim) {
+    detail::trace_unsupported("prod", {&x});
+    detail::require_no_grad("prod", {&x});
+    return detail::dispatch(
+        x.dtype(), [&] { return detail::reduce_impl<float, detail::ProdReduce<float>>(x, axes, keepdim, "prod"); },
+        [&] { return detail::reduce_impl<int32_t, detail::ProdReduce<int32_t>>(x, axes, keepdim, "prod"); });
+}
+
+Tensor max(const Tensor& x, const std::vector<std::size_t>& axes, bool keepdim) {
+    detail::trace_unsupported("max", {&x});
+    detail::require_no_grad("max", {&x});
+    return detail::dispatch(
+        x.dtype(), [&] { return detail::reduce_impl<float, detail::MaxReduce<float>>(x, axes, keepdim, "max"); },
+        [&] { return detail::reduce_impl<int32_t, detail::MaxReduce<int32_t>>(x, axes, keepdim, "max"); });
+}
+
+Tensor min(const Tensor& x, const std::vector<std::size_t>& axes, bool keepdim) {
+    detail::trace_unsupported("min", {&x});
+    detail::require_no_grad("min", {&x});
+    return detail::dispatch(
+        x.dtype(), [&] { return detail::reduce_impl<float, detail::MinReduce<float>>(x, axes, keepdim, "min"); },
+        [&] { return detail::reduce_impl<int32_t, detail::MinReduce<int32_t>>(x, axes, keepdim, "min"); });
+}
+
+Tensor mean(const Tensor& x, const std::vector<std::size_t>& axes, bool keepdim) {
+    detail::trace_unsupported("mean", {&x});
+    if (x.dtype() != DType::f32) throw std::runtime_error("mean: only f32 is supported.");
+    Tensor out = sum(x.detach(), axes, keepdim);
+    const std::size_t count = out.numel() == 0 ? 0 : x.numel() / out.numel();
+    const float scale = count == 0 ? std::numeric_limits<float>::quiet_NaN() : 1.0f / static_cast<float>(count);
+    auto* p = static_cast<float*>(out.data());
+    for (std::size_t i = 0; i < out.numel(); ++i) p[i] = count == 0 ? scale : p[i] * scale;
+    detail::record_reduce(detail::ReduceGrad::mean, out, x, axes);
+    return out;
+}
+
+Tensor argmax(const Tensor& x, std::size_t axis, bool keepdim) {
+    detail::trace_unsupported("argmax", {&x});
+    return detail::dispatch(
+        x.dtype(), [&] { return detail::argmax_impl<float>(x, {axis}, keepdim); },
+        [&] { return detail::argmax_impl<int32_t>(x, {axis}, keepdim); });
+}
+
+Tensor argmax(const Tensor& x) {
+    detail::trace_unsupported("argmax", {&x});
+    return detail::dispatch(
+        x.dtype(), [&] { return detail::argmax_impl<float>(x, {}, false); },
+        [&] { return detail::argmax_impl<int32_t>(x, {}, false); });
+}
+
+}  // namespace minidl::ops
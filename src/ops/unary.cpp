@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <string>
+
+#include "minidl/detail/autograd.h"
+#include "minidl/detail/dispatch.h"
+#include "minidl/detail/trace.h"
+#include "minidl/detail/unary_ops.h"
+#include "minidl/ops.h"
+
+namespace minidl::ops {
+
+namespace {
+
+template <template <typename> class Op>
+Tensor float_unary(const Tensor& x, Precision precision, const char* name) {
+    return detail::dispatch(
+        x.dtype(), [&] { return detail::unary_impl<float, Op<float>>(x, precision == Precision::fast); },
+        [&]() -> Tensor { throw std::runtime_error(std::string(name) + ": only f32 is supported."); });
+}
+
+template <template <typename> class Op>
+Tensor& float_unary_out(const Tensor& x, Tensor& out, Precision precision, const char* name) {
+    if (detail::tracing()) detail::trace_unsupported((std::string(name) + "_out").c_str(), {&x, &out});
+    return detail::dispatch(
+        x.dtype(),
+        [&]() -> Tensor& { return detail::unary_out_impl<float, Op<float>>(x, out, precision == Precision::fast); },
+        [&]() -> Tensor& { throw std::runtime_error(std::string(name) + ": only f32 is supported."); });
+}
+
+// records out = name(x) into the active graph::Trace, replayed through the _out form; out
+// may be written over x.
+template <class OutFn>
+void trace_unary(const char* name, detail::PointwiseOp op, Precision precision, const Tensor& out, const Tensor& x,
+                 OutFn out_fn) {
+    if (!detail::tracing()) return;
+    detail::trace_op(
+        name, [out_fn](const Tensor* const* in, Tensor& o) { out_fn(*in[0], o); }, out, {&x}, true, op,
+        precision == Precision::fast);
+}
+
+}  // namespace
+
+Tensor exp(const Tensor& x, Precision precision) {
+    Tensor out = float_unary<detail::ExpOp>(x, precision, "exp");
+    detail::record_unary(detail::UnaryGrad::exp, out, x);
+    trace_unary("exp", detail::PointwiseOp::exp, precision, out, x,
+                [precision](const Tensor& in, Tensor& o) { exp_out(in, o, precision); });
+    return out;
+}
+
+Tensor log(const Tensor& x, Precision precision) {
+    Tensor out = float_unary<detail::LogOp>(x, precision, "log");
+    detail::record_unary(detail::UnaryGrad::log, out, x);
+    trace_unary("log", detail::PointwiseOp::log, precision, out, x,
+                [precision](const Tensor& in, Tensor& o) { log_out(in, o, precision); });
+    return out;
+}
+
+Tensor tanh(const Tensor& x, Precision precision) {
+    Tensor out = float_unary<detail::TanhOp>(x, precision, "tanh");
+    detail::record_unary(detail::UnaryGrad::tanh, out, x);
+    trace_unary("tanh", detail::PointwiseOp::tanh, precision, out, x,
+                [precision](const Tensor& in, Tensor& o) { tanh_out(in, o, precision); });
+    return out;
+}
+
+Tensor sigmoid(const Tensor& x, Precision precision) {
+    Tensor out = float_unary<detail::SigmoidOp>(x, precision, "sigmoid");
+    detail::record_unary(detail::UnaryGrad::sigmoid, out, x);
+    trace_unary("sigmoid", detail::PointwiseOp::sigmoid, precision, out, x,
+                [precision](const Tensor& in, Tensor& o) { sigmoid_out(in, o, precision); });
+    return out;
+}
+
+Tensor gelu(const Tensor& x, Precision precision) {
+    detail::require_no_grad("gelu", {&x});
+    Tensor out = float_unary<detail::GeluOp>(x, precision, "gelu");
+    trace_unary("gelu", detail::PointwiseOp::gelu, precision, out, x,
+                [precision](const Tensor& in, Tensor& o) { gelu_out(in, o, precision); });
+    return out;
+}
+
+Tensor relu(const Tensor& x) {
+    Tensor out = detail::dispatch(
+        x.dtype(), [&] { return detail::unary_impl<float, detail::ReluOp<float>>(x, true); },
+        [&] { return detail::unary_impl<int32_t, detail::ReluOp<int32_t>>(x, true); });
+    detail::record_unary(detail::UnaryGrad::relu, out, x);
+    trace_unary("relu", detail::PointwiseOp::relu, Precision::fast, out, x,
+                [](const Tensor& in, Tensor& o) { relu_out(in, o); });
+    return out;
+}
+
+Tensor& exp_out(const Tensor& x, Tensor& out, Precision precision) {
+    return float_unary_out<detail::ExpOp>(x, out, precision, "exp");
+}
+
+Tensor& log_out(const Tensor& x, Tensor& out, Precision precision) {
+    return float_unary_out<detail::LogOp>(x, out, precision, "log");
+}
+
+Tensor& tanh_out(const Tensor& x, Tensor& out, Precision precision) {
+    return float_unary_out<detail::TanhOp>(x, out, precision, "tanh");
+}
+
+Tensor& sigmoid_out(const Tensor& x, Tensor& out, Precision precision) {
+    return float_unary_out<detail::SigmoidOp>(x, out, precision, "sigmoid");
+}
+
+Tensor& gelu_out(const Tensor& x, Tensor& out, Precision precision) {
+    return float_unary_out<detail::GeluOp>(x, out, precision, "gelu");
+}
+
+Tensor& relu_out(const Tensor& x, Tensor& out) {
+    detail::trace_unsupported("relu_out", {&x, &out});
+    return detail::dispatch(
+        x.dtype(), [&]() -> Tensor& { return detail::unary_out_impl<float, detail::ReluOp<float>>(x, out, true); },
+        [&]() -> Tensor& { return detail::unary_out_impl<int32_t, detail::ReluOp<int32_t>>(x, out, true); });
+}
+
+}  // namespace minidl::ops
@@ -0,0 +1,165 @@
+#include "minidl/serialize.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+#include "minidl/detail/layout.h"
+
+namespace minidl {
+
+namespace {
+
+constexpr char kMagic[8] = {'m', 'i', 'n', 'i', 'd', 'l', '\0', '\0'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::uint32_t kByteOrder = 0x01020304;
+constexpr std::uint32_t kMaxRank = 64;
+
+template <typename T>
+void put(std::string& out, T v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+// bounds-checked reads from the mapped header.
+class Reader {
+   public:
+    Reader(const std::byte* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    T get() {
+        T v;
+        std::memcpy(&v, take(sizeof(T)), sizeof(T));
+        return v;
+    }
+    std::string get_string(std::size_t n) {
+        const std::byte* p = take(n);
+        return std::string(reinterpret_cast<const char*>(p), n);
+    }
+
+   private:
+    const std::byte* take(std::size_t n) {
+        if (n > size_ - pos_) throw std::runtime_error("load: truncated header.");
+        const std::byte* p = data_ + pos_;
+        pos_ += n;
+        return p;
+    }
+
+    const std::byte* data_;
+    std::size_t size_;
+    std::size_t pos_ = 0;
+};
+
+// what save() writes for one tensor: `src` is `bytes` bytes laid out as `strides`.
+struct Record {
+    const std::string* name;
+    Tensor tensor;
+    std::vector<std::size_t> strides;
+    const void* src = nullptr;
+    std::size_t bytes = 0;
+    std::size_t payload = 0;
+};
+
+}  // namespace
+
+void save(const std::string& path, const NamedTensors& tensors) {
+    std::vector<Record> records;
+    records.reserve(tensors.size());
+    for (const auto& [name, t] : tensors) {
+        const auto& dims = t.shape().dims();
+        const bool dense = detail::extent_elems(dims, t.strides()) == t.numel() &&
+                           !detail::has_internal_overlap(dims, t.strides());
+        Record r{&name, dense ? t : t.contiguous(), {}};
+        r.strides = r.tensor.strides();
+        r.src = r.tensor.data();
+        r.bytes = r.tensor.nbytes();
+        records.push_back(std::move(r));
+    }
+
+    std::string header(kMagic, sizeof(kMagic));
+    put(header, kVersion);
+    put(header, kByteOrder);
+    put(header, static_cast<std::uint32_t>(records.size()));
+    // the payload fields are patched in once the header size is known.
+    std::vector<std::size_t> payload_field(records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        const Record& r = records[i];
+        put(header, static_cast<std::uint32_t>(r.name->size()));
+        header += *r.name;
+        put(header, static_cast<std::uint32_t>(r.tensor.dtype()));
+        put(header, static_cast<std::uint32_t>(r.tensor.rank()));
+        for (std::size_t d : r.tensor.shape().dims()) put(header, static_cast<std::uint64_t>(d));
+        for (std::size_t s : r.strides) put(header, static_cast<std::uint64_t>(s));
+        put(header, std::uint64_t{0});
+        payload_field[i] = header.size();
+        put(header, std::uint64_t{0});
+        put(header, static_cast<std::uint64_t>(r.bytes));
+        put(header, static_cast<std::uint64_t>(kTensorFileAlignment));
+    }
+    std::size_t end = detail::round_up(header.size(), kTensorFileAlignment);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        records[i].payload = end;
+        const auto payload = static_cast<std::uint64_t>(end);
+        std::memcpy(&header[payload_field[i]], &payload, sizeof(payload));
+        end = detail::round_up(end + records[i].bytes, kTensorFileAlignment);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("save: cannot open " + path + ".");
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    static const std::array<char, kTensorFileAlignment> zeros{};
+    std::size_t pos = header.size();
+    for (const Record& r : records) {
+        out.write(zeros.data(), static_cast<std::streamsize>(r.payload - pos));
+        out.write(static_cast<const char*>(r.src), static_cast<std::streamsize>(r.bytes));
+        pos = r.payload + r.bytes;
+    }
+    // pad the last payload so every payload is whole pages, as its alignment promises.
+    out.write(zeros.data(), static_cast<std::streamsize>(end - pos));
+    if (!out.flush()) throw std::runtime_error("save: cannot write " + path + ".");
+}
+
+NamedTensors load(const std::string& path, MapMode mode) {
+    auto file = std::make_shared<MappedFileAllocator>(path, mode);
+    Reader in(file->data(), file->size());
+
+    if (in.get_string(sizeof(kMagic)) != std::string(kMagic, sizeof(kMagic))) {
+        throw std::runtime_error("load: " + path + " is not a tensor file.");
+    }
+    if (in.get<std::uint32_t>() != kVersion) throw std::runtime_error("load: unsupported version.");
+    if (in.get<std::uint32_t>() != kByteOrder) throw std::runtime_error("load: file has the other byte order.");
+
+    const auto count = in.get<std::uint32_t>();
+    NamedTensors tensors;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string name = in.get_string(in.get<std::uint32_t>());
+        const auto dtype = in.get<std::uint32_t>();
+        if (dtype > static_cast<std::uint32_t>(DType::i64)) throw std::runtime_error("load: bad dtype.");
+        const auto rank = in.get<std::uint32_t>();
+        if (rank > kMaxRank) throw std::runtime_error("load: bad rank.");
+        std::vector<std::size_t> dims(rank), strides(rank);
+        for (auto& d : dims) d = static_cast<std::size_t>(in.get<std::uint64_t>());
+        for (auto& s : strides) s = static_cast<std::size_t>(in.get<std::uint64_t>());
+        if (detail::numel_overflows(dims)) throw std::runtime_error("load: bad shape for " + name + ".");
+        const auto offset = static_cast<std::size_t>(in.get<std::uint64_t>());
+        const auto payload = static_cast<std::size_t>(in.get<std::uint64_t>());
+        const auto nbytes = static_cast<std::size_t>(in.get<std::uint64_t>());
+        const auto alignment = static_cast<std::size_t>(in.get<std::uint64_t>());
+        if (!detail::is_pow2(alignment) || payload % alignment != 0 || payload > file->size() ||
+            nbytes > file->size() - payload) {
+            throw std::runtime_error("load: bad payload for " + name + ".");
+        }
+
+        auto storage = std::make_shared<Storage>(file->upstream());
+        storage->owner = file;
+        storage->data = nbytes == 0 ? nullptr : file->data() + payload;
+        storage->nbytes = nbytes;
+        tensors.emplace_back(std::move(name), Tensor::from_storage(std::move(storage), Shape(dims),
+                                                                   static_cast<DType>(dtype), std::move(strides),
+                                                                   offset));
+    }
+    return tensors;
+}
+
+}  // namespace minidl
@@ -1,7 +1,32 @@
 #include "minidl/tensor.h"
 
+#include <utility>
+
+#include "minidl/allocator.h"
+
 namespace minidl {
 
+Storage::~Storage() {
+    if (data && alloc_ && !owner) alloc_->deallocate(data);
+}
+
+Storage::Storage(Storage&& other) noexcept
+    : data(std::exchange(other.data, nullptr)),
+      nbytes(std::exchange(other.nbytes, 0)),
+      alloc_(std::move(other.alloc_)),
+      owner(std::move(other.owner)) {}
+
+Storage& Storage::operator=(Storage&& other) noexcept {
+    if (this != &other) {
+        if (data && alloc_ && !owner) alloc_->deallocate(data);
+        data = std::exchange(other.data, nullptr);
+        nbytes = std::exchange(other.nbytes, 0);
+        alloc_ = std::move(other.alloc_);
+        owner = std::move(other.owner);
+    }
+    return *this;
+}
+
 // constructor and deleter
 Tensor::Tensor(const Shape& shape, DType dtype, std::shared_ptr<Storage> storage)
     : shape_(shape), dtype_(dtype), storage_(std::move(storage)) {}
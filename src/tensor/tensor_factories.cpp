@@ -1,27 +1,26 @@
 #include "minidl/allocators/default.h"
+#include "minidl/detail/convert.h"
+#include "minidl/detail/dispatch.h"
+#include "minidl/detail/layout.h"
+#include "minidl/detail/parallel.h"
 #include "minidl/tensor.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
 namespace minidl {
 
 void Tensor::fill_ones_(void* data, size_t numel, DType dtype) {
     if (!data) return;
-    switch (dtype) {
-        case DType::f32: {
-            auto* x = static_cast<float*>(data);
-            std::fill_n(x, numel, 1.0f);
-            break;
-        }
-        case DType::i32: {
-            auto* x = static_cast<std::int32_t*>(data);
-            std::fill_n(x, numel, 1);
-            break;
-        }
-        default:
-            throw std::runtime_error("Unsupported DType in fill_ones");
-    }
+    detail::dispatch_types<detail::AllTypes>(dtype, "ones", [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        std::fill_n(static_cast<T*>(data), numel, T(1));
+    });
 }
 
-Tensor Tensor::zeros(const Shape& shape, DType dtype, std::shared_ptr<Allocator> alloc) {
+Tensor Tensor::empty(const Shape& shape, DType dtype, std::shared_ptr<Allocator> alloc) {
     if (alloc == nullptr) alloc = get_default_allocator();
     auto storage = std::make_shared<Storage>(alloc);
 
@@ -35,68 +34,77 @@ Tensor Tensor::zeros(const Shape& shape, DType dtype, std::shared_ptr<Allocator>
         return t;
     }
     t.storage_->data = t.storage_->alloc_->allocate(t.nbytes());
-
     if (!t.data()) throw std::bad_alloc{};
-    std::memset(t.data(), 0, t.nbytes());
     return t;
 }
 
-Tensor Tensor::ones(const Shape& shape, DType dtype, std::shared_ptr<Allocator> alloc) {
-    if (alloc == nullptr) alloc = get_default_allocator();
-    auto storage = std::make_shared<Storage>(alloc);
-
-    Tensor t(shape, dtype, storage);
-    t.strides_ = t.default_strides(shape);
-
-    t.storage_->nbytes = t.numel() * t.itemsize();
-
-    if (t.nbytes() == 0) {
-        t.storage_->data = nullptr;
-        return t;
+Tensor Tensor::from_storage(std::shared_ptr<Storage> storage, const Shape& shape, DType dtype,
+                            std::vector<std::size_t> strides, std::size_t storage_offset) {
+    if (!storage) throw std::runtime_error("from_storage: null storage.");
+    if (strides.size() != shape.rank()) throw std::runtime_error("from_storage: strides must match the rank.");
+
+    // one past the last element, in elements; checked against overflow since layouts may come from files
+    // (an overflowing numel could wrap to 0 and pass for an empty tensor).
+    if (detail::numel_overflows(shape.dims())) throw std::runtime_error("from_storage: shape overflows.");
+    if (shape.numel() != 0) {
+        constexpr std::size_t kMax = std::numeric_limits<std::size_t>::max();
+        std::size_t end = storage_offset;
+        for (std::size_t i = 0; i < shape.rank(); ++i) {
+            const std::size_t last = shape[i] - 1;
+            if (strides[i] != 0 && last > (kMax - end) / strides[i]) {
+                throw std::runtime_error("from_storage: layout overflows.");
+            }
+            end += last * strides[i];
+        }
+        if (end >= storage->nbytes / size_of(dtype)) {
+            throw std::runtime_error("from_storage: layout exceeds the storage.");
+        }
     }
-    t.storage_->data = t.storage_->alloc_->allocate(t.nbytes());
-    if (!t.data()) throw std::bad_alloc{};
 
-    t.fill_ones_(t.data(), t.numel(), dtype);
+    Tensor t(shape, dtype, std::move(storage));
+    t.strides_ = std::move(strides);
+    t.storage_offset_ = storage_offset;
     return t;
 }
 
-Tensor Tensor::arange(std::size_t size, DType dtype, std::shared_ptr<Allocator> alloc) {
-    if (alloc == nullptr) alloc = get_default_allocator();
-    auto storage = std::make_shared<Storage>(alloc);
+// The fills below are split with the same parallel_for partition the ops use, so each page
+// is first touched (and placed) by the thread that will later process it.
 
-    Shape s({size});
-    Tensor t(s, dtype, storage);
-    t.strides_ = t.default_strides(s);
+Tensor Tensor::zeros(const Shape& shape, DType dtype, std::shared_ptr<Allocator> alloc) {
+    Tensor t = empty(shape, dtype, std::move(alloc));
+    auto* data = static_cast<std::byte*>(t.data());
+    const std::size_t item = t.itemsize();
 
-    t.storage_->nbytes = t.numel() * t.itemsize();
+    detail::parallel_for(0, t.numel(), detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+        std::memset(data + begin * item, 0, (end - begin) * item);
+    });
+    return t;
+}
 
-    if (t.nbytes() == 0) {
-        t.storage_->data = nullptr;
-        return t;
-    }
+Tensor Tensor::ones(const Shape& shape, DType dtype, std::shared_ptr<Allocator> alloc) {
+    Tensor t = empty(shape, dtype, std::move(alloc));
+    auto* data = static_cast<std::byte*>(t.data());
+    const std::size_t item = t.itemsize();
 
-    t.storage_->data = t.storage_->alloc_->allocate(t.nbytes());
-    if (!t.storage_->data) throw std::bad_alloc();
-
-    const std::size_t n = t.numel();
-    if (dtype == DType::f32) {
-        auto* x = static_cast<float*>(t.data());
-        float v = 0.0f;
-        for (std::size_t i = 0; i < n; i++) {
-            x[i] = v;
-            v += 1.0f;
-        }
-    } else if (dtype == DType::i32) {
-        auto* x = static_cast<std::int32_t*>(t.data());
-        std::int32_t v = 0;
-        for (std::size_t i = 0; i < n; i++) {
-            x[i] = v;
-            v += 1;
-        }
-    } else {
-        throw std::runtime_error("Unsupported DType in arange");
-    }
+    detail::parallel_for(0, t.numel(), detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+        fill_ones_(data + begin * item, end - begin, dtype);
+    });
+    return t;
+}
+
+Tensor Tensor::arange(std::size_t size, DType dtype, std::shared_ptr<Allocator> alloc) {
+    if (dtype == DType::bool_) throw std::runtime_error("arange: unsupported dtype bool.");
+    Tensor t = empty(Shape({size}), dtype, std::move(alloc));
+    void* data = t.data();
+
+    // values past a narrow type's range wrap (integers) or round (f16, bf16), as in to().
+    detail::dispatch_types<detail::NumericTypes>(dtype, "arange", [&](auto tag) {
+        using T = typename decltype(tag)::type;
+        detail::parallel_for(0, t.numel(), detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+            auto* x = static_cast<T*>(data);
+            for (std::size_t i = begin; i < end; i++) x[i] = kernels::convert_value<T>(static_cast<std::int64_t>(i));
+        });
+    });
     return t;
 }
 
@@ -1,9 +1,127 @@
 #include "minidl/allocators/default.h"
-#include "minidl/detail/iter.h"
+#include "minidl/detail/autograd.h"
+#include "minidl/detail/convert.h"
+#include "minidl/detail/overlap.h"
+#include "minidl/detail/parallel.h"
+#include "minidl/detail/tensor_iterator.h"
+#include "minidl/detail/trace.h"
+#include "minidl/detail/transpose.h"
 #include "minidl/tensor.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
 namespace minidl {
 
+namespace {
+
+template <typename U>
+void copy_run_typed(std::byte* dst, const std::byte* src, std::size_t n, std::size_t ds, std::size_t ss) {
+    auto* d = reinterpret_cast<U*>(dst);
+    const auto* s = reinterpret_cast<const U*>(src);
+    for (std::size_t i = 0; i < n; ++i) d[i * ds] = s[i * ss];
+}
+
+// copies one iterator run; strides in elements of `item` bytes.
+void copy_run(std::byte* dst, const std::byte* src, std::size_t n, std::size_t ds, std::size_t ss, std::size_t item) {
+    if (ds == 1 && ss == 1) {
+        std::memcpy(dst, src, n * item);
+        return;
+    }
+    switch (item) {
+        case 1:
+            copy_run_typed<std::uint8_t>(dst, src, n, ds, ss);
+            break;
+        case 2:
+            copy_run_typed<std::uint16_t>(dst, src, n, ds, ss);
+            break;
+        case 4:
+            copy_run_typed<std::uint32_t>(dst, src, n, ds, ss);
+            break;
+        case 8:
+            copy_run_typed<std::uint64_t>(dst, src, n, ds, ss);
+            break;
+        default:
+            for (std::size_t i = 0; i < n; ++i) std::memcpy(dst + i * ds * item, src + i * ss * item, item);
+    }
+}
+
+// Copies where the destination's unit-stride dim is strided in the source while the source has
+// a unit-stride dim of its own are (batched) 2-D transposes. Those are copied tile by tile so
+// both sides of a tile stay in cache. Returns false for any other layout.
+bool copy_transposed(std::byte* dst, const std::byte* src, const detail::TensorIterator& iter, std::size_t item) {
+    const std::size_t ndim = iter.ndim();
+    if (ndim < 2 || iter.stride(0, 0) != 1 || iter.stride(1, 0) == 1) return false;
+    std::size_t k = 1;
+    while (k < ndim && iter.stride(1, k) != 1) ++k;
+    if (k == ndim) return false;
+
+    const auto& shape = iter.shape();
+    const std::size_t cols = shape[0];
+    const std::size_t rows = shape[k];
+    constexpr std::size_t T = kernels::kTransposeTile;
+    if (rows < 8 || cols < 8) return false;  // the row-wise runs are as good for thin slabs.
+
+    const std::size_t dst_ld = iter.stride(0, k);
+    const std::size_t src_ld = iter.stride(1, 0);
+
+    // the remaining dims are batch dims, innermost first.
+    struct BatchDim {
+        std::size_t size, dst_stride, src_stride;
+    };
+    std::vector<BatchDim> batch_dims;
+    std::size_t batch = 1;
+    for (std::size_t d = 1; d < ndim; ++d) {
+        if (d == k) continue;
+        batch_dims.push_back({shape[d], iter.stride(0, d), iter.stride(1, d)});
+        batch *= shape[d];
+    }
+
+    const std::size_t row_tiles = (rows + T - 1) / T;
+    const std::size_t col_tiles = (cols + T - 1) / T;
+    const std::size_t tiles = row_tiles * col_tiles;
+    detail::parallel_for(0, batch * tiles, std::max<std::size_t>(1, detail::kGrainSize / (T * T)),
+                         [&](std::size_t begin, std::size_t end) {
+                             for (std::size_t u = begin; u < end; ++u) {
+                                 std::size_t rem = u / tiles;
+                                 std::size_t doff = 0, soff = 0;
+                                 for (const auto& bd : batch_dims) {
+                                     const std::size_t idx = rem % bd.size;
+                                     rem /= bd.size;
+                                     doff += idx * bd.dst_stride;
+                                     soff += idx * bd.src_stride;
+                                 }
+                                 const std::size_t r0 = (u % tiles) / col_tiles * T;
+                                 const std::size_t c0 = (u % tiles) % col_tiles * T;
+                                 kernels::transpose_2d(dst + (doff + r0 * dst_ld + c0) * item,
+                                                       src + (soff + c0 * src_ld + r0) * item, std::min(T, rows - r0),
+                                                       std::min(T, cols - c0), dst_ld, src_ld, item);
+                             }
+                         });
+    return true;
+}
+
+// dst[i] = src[i] over `shape`; operands must not overlap.
+void copy_strided(void* dst_data, const std::vector<std::size_t>& dst_strides, const void* src_data,
+                  const std::vector<std::size_t>& src_strides, const std::vector<std::size_t>& shape,
+                  std::size_t item) {
+    const auto* src = static_cast<const std::byte*>(src_data);
+    auto* dst = static_cast<std::byte*>(dst_data);
+
+    // coalescing already merges contiguous inner runs, which copy_run moves with one memcpy.
+    const detail::TensorIterator iter(shape, {dst_strides, src_strides});
+    if (copy_transposed(dst, src, iter, item)) return;
+    detail::parallel_for(0, iter.numel(), detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+        iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t n) {
+            copy_run(dst + off[0] * item, src + off[1] * item, n, st[0], st[1], item);
+        });
+    });
+}
+
+}  // namespace
+
 Tensor Tensor::view(const Shape& new_shape) const {
     if (new_shape.numel() != numel()) {
         throw std::runtime_error("view: new_shape.numel() must equal the current numel().");
@@ -15,6 +133,8 @@ Tensor Tensor::view(const Shape& new_shape) const {
     Tensor out = *this;
     out.shape_ = new_shape;
     out.strides_ = default_strides(new_shape);
+    detail::record_view(out, *this);
+    detail::trace_view(out, *this);
     return out;
 }
 
@@ -22,17 +142,8 @@ Tensor Tensor::reshape(const Shape& new_shape) const {
     if (new_shape.numel() != numel()) {
         throw std::runtime_error("reshape: new_shape.numel() must equal the current numel().");
     }
-    if (numel() == 0 || is_contiguous()) {
-        Tensor new_tensor = *this;
-        new_tensor.shape_ = new_shape;
-        new_tensor.strides_ = default_strides(new_shape);
-        return new_tensor;
-    }
-
-    Tensor new_tensor = this->contiguous();
-    new_tensor.shape_ = new_shape;
-    new_tensor.strides_ = default_strides(new_shape);
-    return new_tensor;
+    if (numel() == 0 || is_contiguous()) return view(new_shape);
+    return contiguous().view(new_shape);
 }
 
 Tensor Tensor::transpose(const std::initializer_list<std::size_t> axes_ilist) const {
@@ -69,44 +180,143 @@ Tensor Tensor::transpose(const std::initializer_list<std::size_t> axes_ilist) co
 
     new_tensor.shape_ = Shape(new_shape);
     new_tensor.strides_ = std::move(new_strides);
-
+    detail::record_view(new_tensor, *this);
+    detail::trace_view(new_tensor, *this);
     return new_tensor;
 }
 
+Tensor Tensor::slice(std::size_t dim, std::size_t start, std::size_t stop, std::size_t step) const {
+    if (dim >= rank()) throw std::runtime_error("slice: dim out of range.");
+    if (step == 0) throw std::runtime_error("slice: step must be positive.");
+    const std::size_t size = shape_[dim];
+    stop = std::min(stop, size);
+    start = std::min(start, stop);
+
+    std::vector<std::size_t> new_shape = shape_.dims();
+    new_shape[dim] = (stop - start + step - 1) / step;
+
+    Tensor out = *this;
+    out.shape_ = Shape(new_shape);
+    if (out.numel() != 0) out.storage_offset_ += start * strides_[dim];
+    out.strides_[dim] *= step;
+    detail::record_view(out, *this);
+    detail::trace_view(out, *this);
+    return out;
+}
+
+Tensor Tensor::narrow(std::size_t dim, std::size_t start, std::size_t length) const {
+    if (dim >= rank()) throw std::runtime_error("narrow: dim out of range.");
+    if (start > shape_[dim] || length > shape_[dim] - start) throw std::runtime_error("narrow: range out of bounds.");
+    return slice(dim, start, start + length);
+}
+
+Tensor Tensor::select(std::size_t dim, std::size_t index) const {
+    if (dim >= rank()) throw std::runtime_error("select: dim out of range.");
+    if (index >= shape_[dim]) throw std::runtime_error("select: index out of range.");
+
+    std::vector<std::size_t> new_shape = shape_.dims();
+    new_shape.erase(new_shape.begin() + static_cast<std::ptrdiff_t>(dim));
+
+    Tensor out = *this;
+    out.storage_offset_ += index * strides_[dim];
+    out.shape_ = Shape(new_shape);
+    out.strides_.erase(out.strides_.begin() + static_cast<std::ptrdiff_t>(dim));
+    detail::record_view(out, *this);
+    detail::trace_view(out, *this);
+    return out;
+}
+
+std::vector<Tensor> Tensor::split(std::size_t split_size, std::size_t dim) const {
+    if (dim >= rank()) throw std::runtime_error("split: dim out of range.");
+    if (split_size == 0) throw std::runtime_error("split: split_size must be positive.");
+
+    std::vector<Tensor> pieces;
+    const std::size_t size = shape_[dim];
+    pieces.reserve((size + split_size - 1) / split_size);
+    for (std::size_t start = 0; start < size; start += split_size) {
+        pieces.push_back(slice(dim, start, start + split_size));
+    }
+    return pieces;
+}
+
+std::vector<Tensor> Tensor::chunk(std::size_t chunks, std::size_t dim) const {
+    if (dim >= rank()) throw std::runtime_error("chunk: dim out of range.");
+    if (chunks == 0) throw std::runtime_error("chunk: chunks must be positive.");
+    const std::size_t size = shape_[dim];
+    if (size == 0) return {*this};
+    return split((size + chunks - 1) / chunks, dim);
+}
+
 Tensor Tensor::contiguous() const {
     if (is_contiguous()) return *this;
     if (numel() == 0) {
         Tensor t(shape_, dtype_, std::make_shared<Storage>(storage_->alloc_));
         t.storage_->nbytes = 0;
         t.storage_->data = nullptr;
+        detail::record_copy(t, *this);
+        detail::trace_copy(t, *this);
         return t;
     }
 
-    auto item = itemsize();
-    auto alloc = storage_->alloc_;
-    auto new_storage = std::make_shared<Storage>(alloc);
-    new_storage->nbytes = nbytes();
-    new_storage->data = alloc->allocate(new_storage->nbytes);
+    Tensor new_tensor = empty(shape_, dtype_, storage_->alloc_);
+    copy_strided(new_tensor.data(), new_tensor.strides_, data(), strides_, shape_.dims(), itemsize());
+    detail::record_copy(new_tensor, *this);
+    detail::trace_copy(new_tensor, *this);
+    return new_tensor;
+}
+
+Tensor& Tensor::copy_(const Tensor& src) {
+    if (src.dtype_ != dtype_) throw std::runtime_error("copy_: dtype mismatch.");
+    if (src.shape_.dims() != shape_.dims()) throw std::runtime_error("copy_: shape mismatch.");
+    if (numel() == 0) return *this;
+    detail::trace_unsupported("copy_", {this, &src});
+    if (detail::has_internal_overlap(shape_.dims(), strides_)) {
+        throw std::runtime_error("copy_: destination must not have overlapping elements.");
+    }
+
+    if (detail::may_overlap(src, *this)) {
+        if (src.data() == data() && src.strides_ == strides_) return *this;
+        // overlapping, different layout: stage the source through a scratch buffer.
+        const auto alloc = storage_->alloc_;
+        Storage scratch(alloc);
+        scratch.nbytes = nbytes();
+        scratch.data = alloc->allocate(scratch.nbytes);
+        const auto scratch_strides = default_strides(shape_);
+        copy_strided(scratch.data, scratch_strides, src.data(), src.strides_, shape_.dims(), itemsize());
+        copy_strided(data(), strides_, scratch.data, scratch_strides, shape_.dims(), itemsize());
+        return *this;
+    }
+    copy_strided(data(), strides_, src.data(), src.strides_, shape_.dims(), itemsize());
+    return *this;
+}
 
-    Tensor new_tensor(shape_, dtype_, new_storage);
-    new_tensor.strides_ = default_strides(shape_);
+Tensor Tensor::to(DType dtype) const {
+    if (dtype == dtype_) return *this;
+    // not replayable, and a conversion of a constant would freeze the weight at trace time.
+    if (detail::tracing()) throw std::runtime_error("to: cannot be traced (graph::Trace).");
+    Tensor out = empty(shape_, dtype, storage_->alloc_);
+    detail::record_copy(out, *this);
+    const std::size_t n = numel();
+    if (n == 0) return out;
 
-    // data iter
+    auto* dst = static_cast<std::byte*>(out.data());
     const auto* src = static_cast<const std::byte*>(data());
-    auto* dst = static_cast<std::byte*>(new_tensor.data());
-
-    const auto& dims = shape_.dims();
-    const auto& st = strides_;
-
-    detail::NdCounter counter(dims);
-    std::size_t dst_offset = 0;
-    while (!counter.done()) {
-        auto src_offset = detail::offset_elems(counter.idx, st) * item;
-        std::memcpy(dst + dst_offset, src + src_offset, item);
-        dst_offset += item;
-        counter.next();
+    const std::size_t dst_item = out.itemsize();
+    const std::size_t src_item = itemsize();
+    if (is_contiguous()) {
+        detail::parallel_for(0, n, detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+            kernels::convert_contig(dst + begin * dst_item, dtype, src + begin * src_item, dtype_, end - begin);
+        });
+        return out;
     }
-    return new_tensor;
+
+    const detail::TensorIterator iter(shape_.dims(), {out.strides_, strides_});
+    detail::parallel_for(0, n, detail::kGrainSize, [&](std::size_t begin, std::size_t end) {
+        iter.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t m) {
+            kernels::convert_strided(dst + off[0] * dst_item, dtype, st[0], src + off[1] * src_item, dtype_, st[1], m);
+        });
+    });
+    return out;
 }
 
 }  // namespace minidl
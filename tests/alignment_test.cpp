@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/caching_allocator.h>
+#include <minidl/allocators/system_allocator.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/tensor.h>
+
+#include <cstdint>
+#include <limits>
+#include <new>
+
+using namespace minidl;
+
+static bool aligned_to(const void* p, std::size_t a) { return reinterpret_cast<std::uintptr_t>(p) % a == 0; }
+
+TEST(Alignment, SystemAllocatorHonorsAlignment) {
+    SystemAllocator sys;
+    Allocator& alloc = sys;
+    for (std::size_t a : {16, 64, 128, 4096}) {
+        for (std::size_t n : {1, 63, 100, 5000}) {
+            void* p = alloc.allocate(n, a);
+            EXPECT_TRUE(aligned_to(p, a)) << "n=" << n << " a=" << a;
+            alloc.deallocate(p);
+        }
+    }
+    void* p = alloc.allocate(10);
+    EXPECT_TRUE(aligned_to(p, kDefaultAlignment));
+    alloc.deallocate(p);
+
+    EXPECT_THROW(alloc.allocate(10, 48), std::runtime_error);
+    // rounding up to the alignment must not wrap to a tiny block.
+    EXPECT_THROW(alloc.allocate(std::numeric_limits<std::size_t>::max() - 10), std::bad_alloc);
+}
+
+TEST(Alignment, CachingAllocatorHonorsAlignment) {
+    CachingAllocator alloc;
+    void* a = alloc.allocate(100);
+    EXPECT_TRUE(aligned_to(a, 64));
+
+    void* b = alloc.allocate(100, 4096);  // over-aligned, not cached
+    EXPECT_TRUE(aligned_to(b, 4096));
+    alloc.deallocate(b);
+    EXPECT_EQ(alloc.stats().bytes_cached, 0u);
+
+    alloc.deallocate(a);
+    EXPECT_EQ(alloc.stats().bytes_in_use, 0u);
+}
+
+TEST(Alignment, TensorDataAlignment) {
+    auto t = Tensor::zeros({3, 5}, DType::f32);
+    EXPECT_GE(t.data_alignment(), kDefaultAlignment);
+    EXPECT_TRUE(aligned_to(t.data(), t.data_alignment()));
+
+    auto alloc = std::make_shared<TrackingAllocator>(std::make_shared<CachingAllocator>());
+    auto c = Tensor::ones({7}, DType::i32, alloc);
+    EXPECT_GE(c.data_alignment(), kDefaultAlignment);
+
+    auto e = Tensor::zeros({0}, DType::f32);
+    EXPECT_EQ(e.data_alignment(), 0u);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/arena_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+using namespace minidl;
+
+namespace {
+std::uintptr_t addr(const void* p) { return reinterpret_cast<std::uintptr_t>(p); }
+}  // namespace
+
+TEST(ArenaAllocator, BumpsWithinASlab) {
+    ArenaAllocator arena;
+    void* a = arena.allocate(100);
+    void* b = arena.allocate(10, 16);
+    void* c = arena.allocate(1000, 256);
+    EXPECT_EQ(addr(a) % kDefaultAlignment, 0u);
+    EXPECT_EQ(addr(b) % 16, 0u);
+    EXPECT_EQ(addr(c) % 256, 0u);
+    EXPECT_GT(addr(b), addr(a) + 100);
+    EXPECT_GT(addr(c), addr(b) + 10);
+    EXPECT_EQ(arena.allocate(0), nullptr);
+    EXPECT_THROW(arena.allocate(8, 24), std::runtime_error);
+
+    const auto s = arena.stats();
+    EXPECT_EQ(s.num_allocs, 3u);
+    EXPECT_EQ(s.num_upstream_allocs, 1u);
+    EXPECT_EQ(s.live_allocations, 3u);
+    EXPECT_GE(s.bytes_in_use, 1110u);
+    EXPECT_EQ(s.high_water_mark, s.bytes_in_use);
+
+    arena.deallocate(a);
+    arena.deallocate(b);
+    arena.deallocate(c);
+    EXPECT_EQ(arena.stats().live_allocations, 0u);
+    arena.reset();
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+    EXPECT_EQ(arena.allocate(100), a);  // rewound to the start
+}
+
+TEST(ArenaAllocator, ScopeRewindsAndReusesSlabs) {
+    ArenaAllocator::Options opt;
+    opt.slab_size = 4096;
+    ArenaAllocator arena(opt);
+
+    void* first[3];
+    std::size_t high_water = 0;
+    for (int step = 0; step < 4; ++step) {
+        ArenaAllocator::Scope scope(arena);
+        void* p[3] = {arena.allocate(3000), arena.allocate(3000), arena.allocate(20000)};
+        if (step == 0) {
+            std::copy(p, p + 3, first);
+            high_water = arena.stats().high_water_mark;
+        } else {
+            EXPECT_EQ(p[0], first[0]);
+            EXPECT_EQ(p[1], first[1]);
+            EXPECT_EQ(p[2], first[2]);
+        }
+        for (void* q : p) arena.deallocate(q);
+    }
+    const auto s = arena.stats();
+    EXPECT_EQ(s.bytes_in_use, 0u);
+    EXPECT_EQ(s.high_water_mark, high_water);
+    EXPECT_EQ(s.num_slabs, 3u);  // two of slab_size, one for the oversized block
+    EXPECT_EQ(s.num_upstream_allocs, 3u);
+    EXPECT_EQ(s.num_deferred_rewinds, 0u);
+}
+
+TEST(ArenaAllocator, LiveAllocationsDeferTheRewind) {
+    ArenaAllocator arena;
+    void* kept = nullptr;
+    {
+        ArenaAllocator::Scope outer(arena);
+        {
+            ArenaAllocator::Scope inner(arena);
+            kept = arena.allocate(64);
+            arena.deallocate(arena.allocate(64));
+        }
+        EXPECT_EQ(arena.stats().num_deferred_rewinds, 1u);
+        // the kept block is not handed out again.
+        void* next = arena.allocate(64);
+        EXPECT_GT(addr(next), addr(kept));
+        arena.deallocate(next);
+        arena.deallocate(kept);
+    }
+    // its owner, the outer scope, rewinds once it is freed.
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+    EXPECT_EQ(arena.stats().num_deferred_rewinds, 1u);
+}
+
+TEST(ArenaAllocator, ResetChecksLiveAllocations) {
+    ArenaAllocator arena;
+    void* p = arena.allocate(32);
+    EXPECT_THROW(arena.reset(), std::runtime_error);
+    std::thread([&] { arena.deallocate(p); }).join();
+    {
+        ArenaAllocator::Scope scope(arena);
+        EXPECT_THROW(arena.reset(), std::runtime_error);
+    }
+    arena.reset();
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+}
+
+TEST(ArenaAllocator, FixedCapacityFailsHard) {
+    ArenaAllocator::Options opt;
+    opt.slab_size = 1 << 12;
+    opt.grow = false;
+    ArenaAllocator arena(opt);
+    EXPECT_EQ(arena.stats().num_upstream_allocs, 1u);  // reserved up front
+
+    ArenaAllocator::Scope scope(arena);
+    void* a = arena.allocate(2048);
+    EXPECT_THROW(arena.allocate(4096), std::bad_alloc);
+    EXPECT_THROW(arena.allocate(2048), std::bad_alloc);  // 2048 + header no longer fits
+    void* b = arena.allocate(1024);
+    EXPECT_NE(b, nullptr);
+    arena.deallocate(a);
+    arena.deallocate(b);
+    EXPECT_EQ(arena.stats().num_slabs, 1u);
+}
+
+// a step of ops whose intermediates all come from the arena: after the first step, no
+// upstream calls.
+TEST(ArenaAllocator, InferenceStepsStopAllocatingUpstream) {
+    auto arena = std::make_shared<ArenaAllocator>();
+    const Tensor x = Tensor::arange(1000).view({10, 100});
+    const Tensor w = Tensor::ones({100}, DType::f32);
+
+    std::size_t upstream_after_warmup = 0;
+    for (int step = 0; step < 5; ++step) {
+        ArenaAllocator::Scope scope(*arena);
+        Tensor a = Tensor::empty({10, 100}, DType::f32, arena);
+        ops::mul_out(x, w, a);
+        Tensor b = ops::add(a, w);
+        Tensor c = ops::mul(b, b);
+        Tensor r = ops::sum(c, {1});
+        EXPECT_FLOAT_EQ(static_cast<const float*>(r.data())[0], 338350.0f);  // sum of (i + 1)^2, i < 100
+        EXPECT_EQ(b.storage()->alloc_, arena);
+        if (step == 0) upstream_after_warmup = arena->stats().num_upstream_allocs;
+    }
+    const auto s = arena->stats();
+    EXPECT_EQ(s.num_upstream_allocs, upstream_after_warmup);
+    EXPECT_EQ(s.live_allocations, 0u);
+    EXPECT_EQ(s.bytes_in_use, 0u);
+    EXPECT_EQ(s.num_deferred_rewinds, 0u);
+}
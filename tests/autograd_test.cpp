@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <minidl/autograd.h>
+#include <minidl/expr.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace minidl;
+using namespace minidl::test_util;
+
+namespace {
+
+const float* as_f32(const Tensor& t) { return static_cast<const float*>(t.data()); }
+
+Tensor scalar(float v) {
+    Tensor t = Tensor::empty(Shape());
+    *static_cast<float*>(t.data()) = v;
+    return t;
+}
+
+using Fn = std::function<Tensor(const std::vector<Tensor>&)>;
+
+// backward of sum(f(inputs) * w) against central differences, for every input element.
+void expect_gradients(const Fn& f, std::vector<Tensor> inputs) {
+    for (Tensor& x : inputs) x.set_requires_grad();
+    const Tensor out = f(inputs);
+    ASSERT_TRUE(out.requires_grad());
+    const Tensor w = away_from_zero(out.shape(), 99, 0.5f);
+    autograd::backward(ops::sum(ops::mul(out, w)));
+
+    autograd::NoGradGuard no_grad;
+    const auto loss = [&] { return as_f32(ops::sum(ops::mul(f(inputs), w)))[0]; };
+    constexpr float eps = 1e-2f;
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        const Tensor* grad = inputs[i].grad();
+        ASSERT_NE(grad, nullptr) << "input " << i;
+        ASSERT_EQ(grad->shape().dims(), inputs[i].shape().dims());
+        const Tensor g = grad->contiguous();
+        auto* p = static_cast<float*>(inputs[i].data());
+        for (std::size_t j = 0; j < inputs[i].numel(); ++j) {
+            const float orig = p[j];
+            p[j] = orig + eps;
+            const float up = loss();
+            p[j] = orig - eps;
+            const float down = loss();
+            p[j] = orig;
+            const float numeric = (up - down) / (2 * eps);
+            EXPECT_NEAR(as_f32(g)[j], numeric, 2e-2f * std::max(1.0f, std::fabs(numeric)))
+                << "input " << i << " element " << j;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(Autograd, BinaryOpsReduceBroadcastGradients) {
+    const Shape a{2, 3, 4}, b{3, 1};
+    expect_gradients([](const auto& x) { return ops::add(x[0], x[1]); }, {away_from_zero(a, 1), away_from_zero(b, 2)});
+    expect_gradients([](const auto& x) { return ops::sub(x[0], x[1]); }, {away_from_zero(b, 1), away_from_zero(a, 2)});
+    expect_gradients([](const auto& x) { return ops::mul(x[0], x[1]); }, {away_from_zero(a, 1), away_from_zero(b, 2)});
+    expect_gradients([](const auto& x) { return ops::div(x[0], x[1]); }, {away_from_zero(a, 1), away_from_zero(b, 2, 1.0f)});
+    expect_gradients([](const auto& x) { return ops::div(x[0], x[1]); }, {away_from_zero({4}, 1), away_from_zero(a, 2, 1.0f)});
+}
+
+TEST(Autograd, UnaryOps) {
+    const Shape s{3, 5};
+    expect_gradients([](const auto& x) { return ops::exp(x[0]); }, {away_from_zero(s, 1)});
+    expect_gradients([](const auto& x) { return ops::log(x[0]); }, {away_from_zero(s, 2, 0.5f, false)});
+    expect_gradients([](const auto& x) { return ops::tanh(x[0]); }, {away_from_zero(s, 3)});
+    expect_gradients([](const auto& x) { return ops::sigmoid(x[0]); }, {away_from_zero(s, 4)});
+    expect_gradients([](const auto& x) { return ops::relu(x[0]); }, {away_from_zero(s, 5)});
+}
+
+TEST(Autograd, MatmulWithBroadcastBatch) {
+    expect_gradients([](const auto& x) { return ops::matmul(x[0], x[1]); }, {away_from_zero({3, 4}, 1), away_from_zero({4, 5}, 2)});
+    expect_gradients([](const auto& x) { return ops::matmul(x[0], x[1]); },
+                     {away_from_zero({2, 1, 3, 4}, 1), away_from_zero({3, 4, 2}, 2)});
+    // a transposed operand is differentiated through the view.
+    expect_gradients([](const auto& x) { return ops::matmul(x[0].transpose({1, 0}), x[1]); },
+                     {away_from_zero({4, 3}, 1), away_from_zero({4, 2}, 2)});
+}
+
+TEST(Autograd, Reductions) {
+    const Shape s{2, 3, 4};
+    expect_gradients([](const auto& x) { return ops::sum(x[0]); }, {away_from_zero(s, 1)});
+    expect_gradients([](const auto& x) { return ops::sum(x[0], {0, 2}); }, {away_from_zero(s, 2)});
+    expect_gradients([](const auto& x) { return ops::sum(x[0], {1}, true); }, {away_from_zero(s, 3)});
+    expect_gradients([](const auto& x) { return ops::mean(x[0], {2}); }, {away_from_zero(s, 4)});
+    expect_gradients([](const auto& x) { return ops::mean(x[0]); }, {away_from_zero(s, 5)});
+}
+
+TEST(Autograd, Views) {
+    const Shape s{4, 6};
+    expect_gradients([](const auto& x) { return ops::exp(x[0].transpose({1, 0})); }, {away_from_zero(s, 1)});
+    expect_gradients([](const auto& x) { return ops::exp(x[0].slice(1, 1, 6, 2)); }, {away_from_zero(s, 2)});
+    expect_gradients([](const auto& x) { return ops::exp(x[0].select(0, 2)); }, {away_from_zero(s, 3)});
+    expect_gradients([](const auto& x) { return ops::exp(x[0].view({2, 12})); }, {away_from_zero(s, 4)});
+    // reshape of a non-contiguous view copies; the copy is differentiated as well.
+    expect_gradients([](const auto& x) { return ops::exp(x[0].transpose({1, 0}).reshape({24})); }, {away_from_zero(s, 5)});
+    // overlapping uses of the same input add up.
+    expect_gradients(
+        [](const auto& x) {
+            const auto parts = x[0].chunk(2, 1);
+            return ops::mul(ops::add(parts[0], parts[1]), x[0].slice(1, 0, 3));
+        },
+        {away_from_zero(s, 6)});
+}
+
+TEST(Autograd, DiamondAccumulatesEveryPath) {
+    Tensor x = away_from_zero({5}, 1).set_requires_grad();
+    const Tensor y = ops::exp(x);
+    // y feeds three paths into z: dz/dx = 2 y^2 + y + y.
+    const Tensor z = ops::add(ops::mul(y, y), ops::add(y, y));
+    autograd::backward(ops::sum(z));
+    for (std::size_t i = 0; i < 5; ++i) {
+        const float yi = std::exp(as_f32(x)[i]);
+        EXPECT_NEAR(as_f32(*x.grad())[i], 2 * yi * yi + 2 * yi, 1e-4f * (1 + yi * yi));
+    }
+}
+
+TEST(Autograd, LeafGradsAccumulateIntoTheirBuffer) {
+    Tensor w = away_from_zero({3, 4}, 1).set_requires_grad();
+    EXPECT_EQ(w.grad(), nullptr);
+    autograd::backward(ops::sum(ops::mul(w, scalar(2.0f))));
+    ASSERT_NE(w.grad(), nullptr);
+    const void* buffer = w.grad()->data();
+    for (std::size_t i = 0; i < 12; ++i) EXPECT_FLOAT_EQ(as_f32(*w.grad())[i], 2.0f);
+
+    // a copy of the parameter shares its gradient.
+    const Tensor alias = w;
+    autograd::backward(ops::sum(ops::mul(alias, scalar(3.0f))));
+    EXPECT_EQ(w.grad()->data(), buffer);
+    for (std::size_t i = 0; i < 12; ++i) EXPECT_FLOAT_EQ(as_f32(*w.grad())[i], 5.0f);
+
+    w.zero_grad();
+    EXPECT_EQ(w.grad()->data(), buffer);
+    for (std::size_t i = 0; i < 12; ++i) EXPECT_FLOAT_EQ(as_f32(*w.grad())[i], 0.0f);
+    autograd::backward(ops::sum(w));
+    EXPECT_EQ(w.grad()->data(), buffer);
+    for (std::size_t i = 0; i < 12; ++i) EXPECT_FLOAT_EQ(as_f32(*w.grad())[i], 1.0f);
+}
+
+TEST(Autograd, GradsReachLeavesInTheirDType) {
+    Tensor x = Tensor::arange(6).to(DType::f16).set_requires_grad();
+    autograd::backward(ops::sum(ops::mul(x.to(DType::f32), scalar(3.0f))));
+    ASSERT_NE(x.grad(), nullptr);
+    ASSERT_EQ(x.grad()->dtype(), DType::f16);
+    const Tensor g = x.grad()->to(DType::f32);
+    for (std::size_t i = 0; i < 6; ++i) EXPECT_EQ(as_f32(g)[i], 3.0f);
+
+    // an integer operand gets no gradient.
+    Tensor w = away_from_zero({4}, 1).set_requires_grad();
+    autograd::backward(ops::sum(ops::mul(w, Tensor::arange(4, DType::i32))));
+    for (std::size_t i = 0; i < 4; ++i) EXPECT_FLOAT_EQ(as_f32(*w.grad())[i], static_cast<float>(i));
+}
+
+TEST(Autograd, NoGradAndDetachRecordNothing) {
+    Tensor x = away_from_zero({4}, 1).set_requires_grad();
+    EXPECT_TRUE(autograd::is_grad_enabled());
+    {
+        autograd::NoGradGuard no_grad;
+        EXPECT_FALSE(autograd::is_grad_enabled());
+        EXPECT_FALSE(ops::exp(x).requires_grad());
+        EXPECT_FALSE(x.transpose({0}).slice(0, 1, 3).requires_grad());
+    }
+    EXPECT_TRUE(autograd::is_grad_enabled());
+    EXPECT_TRUE(ops::exp(x).requires_grad());
+    EXPECT_FALSE(ops::exp(x.detach()).requires_grad());
+    EXPECT_EQ(x.detach().data(), x.data());
+}
+
+TEST(Autograd, OpsWithoutBackwardRejectGradInputs) {
+    Tensor x = away_from_zero({4}, 1, 0.2f, false).set_requires_grad();
+    const Tensor c = away_from_zero({4}, 2);
+    // pow would drop its share of the gradient: d/dx (x^1 + x) is 2, not 1.
+    EXPECT_THROW(ops::add(ops::pow(x, scalar(1.0f)), x), std::runtime_error);
+    EXPECT_THROW(ops::maximum(c, x), std::runtime_error);
+    EXPECT_THROW(ops::gelu(x), std::runtime_error);
+    EXPECT_THROW(ops::max(x), std::runtime_error);
+    EXPECT_THROW(expr::eval(expr::lazy(c) * x), std::runtime_error);
+    EXPECT_NO_THROW(ops::maximum(c, c));
+    // bool and index results carry no gradient: untracked, not rejected.
+    EXPECT_FALSE(ops::gt(x, c).requires_grad());
+    EXPECT_FALSE(ops::argmax(x).requires_grad());
+    {
+        autograd::NoGradGuard no_grad;
+        EXPECT_NO_THROW(ops::pow(x, scalar(1.0f)));
+    }
+
+    autograd::backward(ops::sum(ops::add(ops::pow(x.detach(), scalar(1.0f)), x)));
+    for (std::size_t i = 0; i < 4; ++i) EXPECT_FLOAT_EQ(as_f32(*x.grad())[i], 1.0f);
+}
+
+TEST(Autograd, GraphIsFreedUnlessRetained) {
+    Tensor x = away_from_zero({3}, 1).set_requires_grad();
+    const Tensor loss = ops::sum(ops::mul(x, x));
+    autograd::backward(loss, /*retain_graph=*/true);
+    autograd::backward(loss);
+    for (std::size_t i = 0; i < 3; ++i) EXPECT_FLOAT_EQ(as_f32(*x.grad())[i], 4 * as_f32(x)[i]);
+    EXPECT_THROW(autograd::backward(loss), std::runtime_error);
+}
+
+TEST(Autograd, RejectsBadUse) {
+    EXPECT_THROW(Tensor::arange(3, DType::i32).set_requires_grad(), std::runtime_error);
+    Tensor x = away_from_zero({3}, 1).set_requires_grad();
+    Tensor y = ops::exp(x);
+    EXPECT_THROW(y.set_requires_grad(), std::runtime_error);
+    EXPECT_THROW(autograd::backward(y), std::runtime_error);                   // not one element
+    EXPECT_THROW(autograd::backward(y, Tensor::ones({2})), std::runtime_error);  // wrong grad shape
+    EXPECT_THROW(autograd::backward(ops::sum(away_from_zero({3}, 2))), std::runtime_error);
+    autograd::backward(y, Tensor::ones({3}));
+    for (std::size_t i = 0; i < 3; ++i) EXPECT_NEAR(as_f32(*x.grad())[i], std::exp(as_f32(x)[i]), 1e-4f);
+}
+
+TEST(Autograd, TrainsALinearModel) {
+    // y = x @ [2, -1, 0.5] + 1, recovered by gradient descent on the squared error.
+    const Tensor x = away_from_zero({32, 3}, 1);
+    Tensor truth = Tensor::empty({3, 1});
+    static_cast<float*>(truth.data())[0] = 2.0f;
+    static_cast<float*>(truth.data())[1] = -1.0f;
+    static_cast<float*>(truth.data())[2] = 0.5f;
+    const Tensor y = ops::add(ops::matmul(x, truth), scalar(1.0f));
+
+    Tensor w = Tensor::zeros({3, 1}).set_requires_grad();
+    Tensor b = Tensor::zeros({1}).set_requires_grad();
+    const Tensor lr = scalar(0.3f);
+    float first = 0, last = 0;
+    for (int step = 0; step < 2000; ++step) {
+        const Tensor err = ops::sub(ops::add(ops::matmul(x, w), b), y);
+        const Tensor loss = ops::mean(ops::mul(err, err));
+        if (step == 0) first = as_f32(loss)[0];
+        last = as_f32(loss)[0];
+        w.zero_grad();
+        b.zero_grad();
+        autograd::backward(loss);
+        autograd::NoGradGuard no_grad;
+        ops::sub_(w, ops::mul(*w.grad(), lr));
+        ops::sub_(b, ops::mul(*b.grad(), lr));
+    }
+    EXPECT_LT(last, first * 1e-4f);
+    EXPECT_NEAR(as_f32(w)[0], 2.0f, 1e-2f);
+    EXPECT_NEAR(as_f32(w)[1], -1.0f, 1e-2f);
+    EXPECT_NEAR(as_f32(w)[2], 0.5f, 1e-2f);
+    EXPECT_NEAR(as_f32(b)[0], 1.0f, 1e-2f);
+}
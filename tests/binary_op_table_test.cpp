@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace minidl;
+using namespace minidl::test_util;
+
+static Tensor make_f32(const std::vector<std::size_t>& dims, const std::vector<float>& v) {
+    return from(dims, v, DType::f32);
+}
+static Tensor make_i32(const std::vector<std::size_t>& dims, const std::vector<std::int32_t>& v) {
+    return from(dims, v, DType::i32);
+}
+
+TEST(BinaryOpTable, ArithmeticF32) {
+    const Tensor a = make_f32({4}, {1.0f, -2.0f, 6.0f, 0.5f});
+    const Tensor b = make_f32({4}, {4.0f, 2.0f, -3.0f, 2.0f});
+    EXPECT_EQ(to_vector<float>(ops::sub(a, b)), (std::vector<float>{-3.0f, -4.0f, 9.0f, -1.5f}));
+    EXPECT_EQ(to_vector<float>(ops::div(a, b)), (std::vector<float>{0.25f, -1.0f, -2.0f, 0.25f}));
+    EXPECT_EQ(to_vector<float>(ops::maximum(a, b)), (std::vector<float>{4.0f, 2.0f, 6.0f, 2.0f}));
+    EXPECT_EQ(to_vector<float>(ops::minimum(a, b)), (std::vector<float>{1.0f, -2.0f, -3.0f, 0.5f}));
+    const std::vector<float> p = to_vector<float>(ops::pow(a, b));
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(p[i], std::pow(to_vector<float>(a)[i], to_vector<float>(b)[i])) << i;
+    }
+}
+
+TEST(BinaryOpTable, ArithmeticI32) {
+    const Tensor a = make_i32({6}, {7, -7, 5, INT_MIN, 3, -2});
+    const Tensor b = make_i32({6}, {2, 2, 0, -1, -1, 3});
+    EXPECT_EQ(to_vector<std::int32_t>(ops::sub(a, b)), (std::vector<std::int32_t>{5, -9, 5, INT_MIN + 1, 4, -5}));
+    // truncating division; x / 0 gives 0 and INT_MIN / -1 wraps instead of trapping.
+    EXPECT_EQ(to_vector<std::int32_t>(ops::div(a, b)), (std::vector<std::int32_t>{3, -3, 0, INT_MIN, -3, 0}));
+    EXPECT_EQ(to_vector<std::int32_t>(ops::maximum(a, b)), (std::vector<std::int32_t>{7, 2, 5, -1, 3, 3}));
+    EXPECT_EQ(to_vector<std::int32_t>(ops::minimum(a, b)), (std::vector<std::int32_t>{2, -7, 0, INT_MIN, -1, -2}));
+
+    const Tensor base = make_i32({7}, {3, -2, 1, -1, -1, 2, 0});
+    const Tensor exp = make_i32({7}, {4, 3, -5, -4, -3, -1, 0});
+    EXPECT_EQ(to_vector<std::int32_t>(ops::pow(base, exp)), (std::vector<std::int32_t>{81, -8, 1, 1, -1, 0, 1}));
+}
+
+TEST(BinaryOpTable, MaximumMinimumPropagateNaN) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    // long enough for the vector body and the tail, with NaN on either side.
+    const std::size_t n = 67;
+    std::vector<float> av(n), bv(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        av[i] = i % 3 == 0 ? nan : float(i);
+        bv[i] = i % 5 == 0 ? nan : (i % 2 ? -inf : inf);
+    }
+    const Tensor a = make_f32({n}, av);
+    const Tensor b = make_f32({n}, bv);
+    // every other element of a doubled buffer takes the strided path.
+    std::vector<float> a2(2 * n), b2(2 * n);
+    for (std::size_t i = 0; i < 2 * n; ++i) a2[i] = av[i / 2], b2[i] = bv[i / 2];
+    const Tensor as = make_f32({2 * n}, a2).slice(0, 0, 2 * n, 2);
+    const Tensor bs = make_f32({2 * n}, b2).slice(0, 1, 2 * n, 2);
+
+    const auto check = [&](const std::vector<float>& r, bool is_max) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const float x = r[i];
+            if (std::isnan(av[i]) || std::isnan(bv[i])) {
+                EXPECT_TRUE(std::isnan(x)) << i;
+            } else {
+                EXPECT_EQ(x, is_max ? std::max(av[i], bv[i]) : std::min(av[i], bv[i])) << i;
+            }
+        }
+    };
+    check(to_vector<float>(ops::maximum(a, b)), true);
+    check(to_vector<float>(ops::minimum(a, b)), false);
+    check(to_vector<float>(ops::maximum(as, bs)), true);
+    check(to_vector<float>(ops::minimum(as, bs)), false);
+}
+
+TEST(BinaryOpTable, ComparisonsProduceBool) {
+    const Tensor a = make_f32({2, 1}, {1.0f, 3.0f});
+    const Tensor b = make_f32({3}, {1.0f, 2.0f, 3.0f});
+    struct Case {
+        Tensor (*op)(const Tensor&, const Tensor&);
+        std::vector<bool> expected;
+    };
+    const Case cases[] = {
+        {ops::eq, {1, 0, 0, 0, 0, 1}}, {ops::ne, {0, 1, 1, 1, 1, 0}}, {ops::lt, {0, 1, 1, 0, 0, 0}},
+        {ops::le, {1, 1, 1, 0, 0, 1}}, {ops::gt, {0, 0, 0, 1, 1, 0}}, {ops::ge, {1, 0, 0, 1, 1, 1}},
+    };
+    for (const Case& c : cases) {
+        const Tensor r = c.op(a, b);
+        EXPECT_EQ(r.dtype(), DType::bool_);
+        ASSERT_EQ(r.shape().dims(), (std::vector<std::size_t>{2, 3}));
+        const std::vector<bool> got = to_vector<bool>(r);
+        EXPECT_EQ(got, c.expected);
+    }
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const Tensor n = make_f32({1}, {nan});
+    EXPECT_FALSE(to_vector<bool>(ops::eq(n, n))[0]);
+    EXPECT_TRUE(to_vector<bool>(ops::ne(n, n))[0]);
+
+    const Tensor x = make_i32({4}, {-1, 0, 1, 2});
+    EXPECT_EQ(to_vector<bool>(ops::ge(x, make_i32({1}, {1}))), (std::vector<bool>{0, 0, 1, 1}));
+}
+
+TEST(BinaryOpTable, OutAndInPlace) {
+    const Tensor a = make_f32({2, 3}, {1, 2, 3, 4, 5, 6});
+    const Tensor b = make_f32({3}, {2, 2, 2});
+
+    Tensor mask = Tensor::empty({2, 3}, DType::bool_);
+    ops::gt_out(a, b, mask);
+    EXPECT_EQ(to_vector<bool>(mask), (std::vector<bool>{0, 0, 1, 1, 1, 1}));
+    Tensor wrong = Tensor::empty({2, 3});
+    EXPECT_THROW(ops::gt_out(a, b, wrong), std::runtime_error);
+    EXPECT_THROW(ops::sub_out(a, b, mask), std::runtime_error);
+    Tensor ints = make_i32({3}, {1, 2, 3});
+    EXPECT_THROW(ops::sub_(ints, b), std::runtime_error);  // f32 result into i32
+
+    Tensor y = Tensor::empty({2, 3});
+    y.copy_(a);
+    ops::sub_(y, b);
+    EXPECT_EQ(to_vector<float>(y), (std::vector<float>{-1, 0, 1, 2, 3, 4}));
+    ops::div_(y, b);
+    EXPECT_EQ(to_vector<float>(y), (std::vector<float>{-0.5f, 0, 0.5f, 1, 1.5f, 2}));
+    ops::maximum_(y, Tensor::zeros({1}));
+    EXPECT_EQ(to_vector<float>(y), (std::vector<float>{0, 0, 0.5f, 1, 1.5f, 2}));
+    ops::pow_(y, b);
+    EXPECT_EQ(to_vector<float>(y), (std::vector<float>{0, 0, 0.25f, 1, 2.25f, 4}));
+}
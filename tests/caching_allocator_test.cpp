@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/caching_allocator.h>
+#include <minidl/allocators/default.h>
+#include <minidl/tensor.h>
+
+#include <limits>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace minidl;
+
+TEST(CachingAllocator, RoundSize) {
+    EXPECT_EQ(CachingAllocator::round_size(1), 64u);
+    EXPECT_EQ(CachingAllocator::round_size(64), 64u);
+    EXPECT_EQ(CachingAllocator::round_size(65), 80u);
+    EXPECT_EQ(CachingAllocator::round_size(1000), 1024u);
+    EXPECT_EQ(CachingAllocator::round_size(1025), 1280u);
+    for (std::size_t n = 1; n < 100000; n = n * 3 + 1) {
+        const std::size_t r = CachingAllocator::round_size(n);
+        EXPECT_GE(r, n);
+        EXPECT_LE(r, n + n / 4 + 64);
+    }
+}
+
+TEST(CachingAllocator, ReusesFreedBlock) {
+    CachingAllocator alloc;
+    void* p = alloc.allocate(1000);
+    ASSERT_NE(p, nullptr);
+    alloc.deallocate(p);
+
+    void* q = alloc.allocate(1020);  // same size class
+    EXPECT_EQ(q, p);
+    alloc.deallocate(q);
+
+    const auto s = alloc.stats();
+    EXPECT_EQ(s.num_allocs, 2u);
+    EXPECT_EQ(s.num_cache_hits, 1u);
+    EXPECT_DOUBLE_EQ(s.hit_rate(), 0.5);
+    EXPECT_EQ(s.bytes_in_use, 0u);
+    EXPECT_EQ(s.bytes_cached, 1024u);
+    EXPECT_EQ(s.peak_bytes_in_use, 1024u);
+}
+
+TEST(CachingAllocator, EmptyCacheReleasesBlocks) {
+    CachingAllocator alloc;
+    void* a = alloc.allocate(4096);
+    void* b = alloc.allocate(100);
+    alloc.deallocate(a);
+    alloc.deallocate(b);
+    EXPECT_EQ(alloc.stats().bytes_cached, 4096u + 112u);
+
+    alloc.empty_cache();
+    EXPECT_EQ(alloc.stats().bytes_cached, 0u);
+
+    void* c = alloc.allocate(4096);
+    EXPECT_EQ(alloc.stats().num_cache_hits, 0u);
+    alloc.deallocate(c);
+}
+
+TEST(CachingAllocator, LargeBlocksBypassCache) {
+    CachingAllocator::Options opt;
+    opt.max_block_size = 1 << 16;
+    CachingAllocator alloc(opt);
+
+    void* p = alloc.allocate(1 << 20);
+    EXPECT_EQ(alloc.stats().bytes_in_use, std::size_t{1} << 20);
+    alloc.deallocate(p);
+    EXPECT_EQ(alloc.stats().bytes_cached, 0u);
+    EXPECT_EQ(alloc.stats().bytes_in_use, 0u);
+
+    // the header on top of the request must not wrap to a tiny block.
+    EXPECT_THROW(alloc.allocate(std::numeric_limits<std::size_t>::max() - 10), std::bad_alloc);
+    EXPECT_EQ(alloc.stats().bytes_in_use, 0u);
+}
+
+TEST(CachingAllocator, RespectsMaxCachedBytes) {
+    CachingAllocator::Options opt;
+    opt.max_cached_bytes = 1024;
+    CachingAllocator alloc(opt);
+
+    void* a = alloc.allocate(1024);
+    void* b = alloc.allocate(1024);
+    alloc.deallocate(a);
+    alloc.deallocate(b);
+    EXPECT_EQ(alloc.stats().bytes_cached, 1024u);
+}
+
+TEST(CachingAllocator, ConcurrentFreesStayUnderTheCap) {
+    CachingAllocator::Options opt;
+    opt.max_cached_bytes = 16 * 1024;
+    CachingAllocator alloc(opt);
+
+    constexpr int kThreads = 8, kBlocks = 64;
+    std::vector<std::vector<void*>> blocks(kThreads);
+    for (auto& b : blocks) {
+        for (int i = 0; i < kBlocks; ++i) b.push_back(alloc.allocate(1024));
+    }
+    std::vector<std::thread> threads;
+    for (auto& b : blocks) {
+        threads.emplace_back([&alloc, &b] {
+            for (void* p : b) alloc.deallocate(p);
+        });
+    }
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(alloc.stats().bytes_cached, opt.max_cached_bytes);
+}
+
+TEST(CachingAllocator, CrossThreadFree) {
+    CachingAllocator alloc;
+    void* p = alloc.allocate(256);
+    std::thread([&] { alloc.deallocate(p); }).join();
+
+    // freed into another thread's shard, still found.
+    void* q = alloc.allocate(256);
+    EXPECT_EQ(q, p);
+    alloc.deallocate(q);
+}
+
+TEST(CachingAllocator, SelectableAsDefault) {
+    auto caching = std::make_shared<CachingAllocator>();
+    set_default_allocator(caching);
+    EXPECT_EQ(get_default_allocator(), caching);
+
+    auto t = Tensor::zeros({16, 16});
+    EXPECT_EQ(t.storage()->alloc_, caching);
+    EXPECT_EQ(caching->stats().num_allocs, 1u);
+
+    set_default_allocator(nullptr);
+    EXPECT_NE(get_default_allocator(), caching);
+}
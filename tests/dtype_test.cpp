@@ -0,0 +1,310 @@
+#include <gtest/gtest.h>
+#include <minidl/detail/convert.h>
+#include <minidl/detail/cpu_features.h>
+#include <minidl/detail/dispatch.h>
+#include <minidl/half.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace minidl;
+using namespace minidl::test_util;
+
+namespace {
+
+std::uint32_t bits(float f) {
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float from_bits(std::uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// f32 inputs covering every exponent: every 4099th bit pattern, both signs.
+std::vector<float> f32_sweep() {
+    std::vector<float> v;
+    for (std::uint64_t u = 0; u <= 0xffffffffu; u += 4099) v.push_back(from_bits(static_cast<std::uint32_t>(u)));
+    for (float f : {0.0f, -0.0f, 65504.0f, 65519.99f, 65520.0f, 5.9604645e-8f, 2.9802322e-8f, 2.9802326e-8f,
+                    std::numeric_limits<float>::infinity(), std::numeric_limits<float>::max()}) {
+        v.push_back(f);
+    }
+    return v;
+}
+
+bool same_or_both_nan(float a, float b) { return (a != a && b != b) || bits(a) == bits(b); }
+
+}  // namespace
+
+TEST(DType, SizesAndNames) {
+    EXPECT_EQ(size_of(DType::f64), 8u);
+    EXPECT_EQ(size_of(DType::f16), 2u);
+    EXPECT_EQ(size_of(DType::bf16), 2u);
+    EXPECT_EQ(size_of(DType::i8), 1u);
+    EXPECT_EQ(size_of(DType::u8), 1u);
+    EXPECT_EQ(size_of(DType::i64), 8u);
+    EXPECT_STREQ(to_string(DType::bf16), "bf16");
+    EXPECT_TRUE(is_floating_point(DType::f16));
+    EXPECT_FALSE(is_floating_point(DType::i64));
+}
+
+TEST(DType, DispatchTypesPicksTheListedType) {
+    for (DType dt : {DType::f32, DType::f64, DType::f16, DType::bf16, DType::i8, DType::u8, DType::i32, DType::i64,
+                     DType::bool_}) {
+        const std::size_t size = detail::dispatch_types<detail::AllTypes>(dt, "test", [&](auto tag) {
+            using T = typename decltype(tag)::type;
+            EXPECT_EQ(detail::dtype_of_v<T>, dt);
+            return sizeof(T);
+        });
+        EXPECT_EQ(size, size_of(dt)) << to_string(dt);
+    }
+    try {
+        detail::dispatch_types<detail::NumericTypes>(DType::bool_, "neg", [](auto) {});
+        FAIL() << "bool is not numeric";
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(std::string(e.what()), "neg: unsupported dtype bool.");
+    }
+}
+
+TEST(DType, HalfRoundTripsEveryPattern) {
+    for (std::uint32_t b = 0; b <= 0xffff; ++b) {
+        const Half h = Half::from_bits(static_cast<std::uint16_t>(b));
+        const float f = h;
+        if (f != f) {
+            EXPECT_TRUE((b & 0x7c00) == 0x7c00 && (b & 0x3ff)) << b;
+            continue;
+        }
+        EXPECT_EQ(Half(f).bits, b) << b;
+        const BFloat16 bf = BFloat16::from_bits(static_cast<std::uint16_t>(b));
+        if (static_cast<float>(bf) == static_cast<float>(bf)) EXPECT_EQ(BFloat16(static_cast<float>(bf)).bits, b) << b;
+    }
+}
+
+TEST(DType, ScalarConversionsRoundToNearestEven) {
+    // halfway cases go to the even neighbour, in both formats.
+    EXPECT_EQ(Half(1.0f + 1.0f / 2048).bits, Half(1.0f).bits);
+    EXPECT_EQ(Half(1.0f + 3.0f / 2048).bits, Half(1.0f + 4.0f / 2048).bits);
+    EXPECT_EQ(Half(65519.0f).bits, 0x7bff);
+    EXPECT_EQ(Half(65520.0f).bits, 0x7c00);
+    EXPECT_EQ(Half(2.9802322e-8f).bits, 0x0000);  // 2^-25: halfway to the smallest subnormal
+    EXPECT_EQ(Half(2.9802326e-8f).bits, 0x0001);
+    EXPECT_EQ(BFloat16(1.0f + 1.0f / 256).bits, 0x3f80);
+    EXPECT_EQ(BFloat16(1.0f + 3.0f / 256).bits, 0x3f82);
+    EXPECT_EQ(BFloat16(std::numeric_limits<float>::max()).bits, 0x7f80);
+    EXPECT_TRUE(std::isnan(static_cast<float>(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+    // against double rounding, for the normal f16 range.
+    for (float f : f32_sweep()) {
+        if (!(std::fabs(f) >= 6.103515625e-05f && std::fabs(f) < 65504.0f)) continue;
+        const float h = Half(f);
+        const double err = std::fabs(double(h) - double(f));
+        const double ulp = std::ldexp(1.0, std::ilogb(h) - 10);
+        EXPECT_LE(err, ulp / 2) << f;
+    }
+}
+
+TEST(DType, ConversionKernelsMatchScalar) {
+    const std::vector<float> x = f32_sweep();
+    const std::size_t n = x.size();
+    std::vector<Half> h(n);
+    std::vector<BFloat16> b(n);
+    std::vector<float> back(n);
+
+    // the kernels selected for this host, at lengths around the vector widths.
+    for (std::size_t m : {std::size_t{1}, std::size_t{7}, std::size_t{17}, std::size_t{33}, n}) {
+        kernels::from_f32(h.data(), x.data(), m);
+        kernels::from_f32(b.data(), x.data(), m);
+        for (std::size_t i = 0; i < m; ++i) {
+            ASSERT_TRUE(same_or_both_nan(Half::from_bits(h[i].bits), Half(x[i]))) << i;
+            const float ref = BFloat16(x[i]);
+            const bool flushed = detail::cpu_has_avx512_bf16() && std::fabs(x[i]) < FLT_MIN;
+            if (flushed) {
+                ASSERT_EQ(static_cast<float>(b[i]), 0.0f) << i;
+            } else {
+                ASSERT_TRUE(same_or_both_nan(b[i], ref)) << i << " " << x[i];
+            }
+        }
+        kernels::to_f32(back.data(), h.data(), m);
+        for (std::size_t i = 0; i < m; ++i) ASSERT_TRUE(same_or_both_nan(back[i], h[i])) << i;
+        kernels::to_f32(back.data(), b.data(), m);
+        for (std::size_t i = 0; i < m; ++i) ASSERT_TRUE(same_or_both_nan(back[i], b[i])) << i;
+    }
+}
+
+#if defined(MINIDL_HAVE_AVX2)
+TEST(DType, Avx2ConversionsMatchScalar) {
+    const auto cap = detail::cpu_capability();
+    if (cap != detail::CpuCapability::avx2 && cap != detail::CpuCapability::avx512) GTEST_SKIP() << "no AVX2";
+    const std::vector<float> x = f32_sweep();
+    const std::size_t n = x.size() - 5;  // a partial vector at the end
+    std::vector<std::uint16_t> h(n), b(n);
+    std::vector<float> back(n);
+    kernels::avx2::f32_to_f16(h.data(), x.data(), n);
+    kernels::avx2::f32_to_bf16(b.data(), x.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_TRUE(same_or_both_nan(Half::from_bits(h[i]), Half(x[i]))) << i;
+        ASSERT_TRUE(same_or_both_nan(BFloat16::from_bits(b[i]), BFloat16(x[i]))) << i;
+    }
+    kernels::avx2::bf16_to_f32(back.data(), b.data(), n);
+    for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(same_or_both_nan(back[i], BFloat16::from_bits(b[i]))) << i;
+    kernels::avx2::f16_to_f32(back.data(), h.data(), n);
+    for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(same_or_both_nan(back[i], Half::from_bits(h[i]))) << i;
+}
+#endif
+
+#if defined(MINIDL_HAVE_AVX512)
+TEST(DType, Avx512ConversionsMatchScalar) {
+    if (detail::cpu_capability() != detail::CpuCapability::avx512) GTEST_SKIP() << "no AVX-512";
+    const std::vector<float> x = f32_sweep();
+    const std::size_t n = x.size() - 5;
+    std::vector<std::uint16_t> h(n), b(n);
+    std::vector<float> back(n);
+    kernels::avx512::f32_to_f16(h.data(), x.data(), n);
+    kernels::avx512::f32_to_bf16(b.data(), x.data(), n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ASSERT_TRUE(same_or_both_nan(Half::from_bits(h[i]), Half(x[i]))) << i;
+        ASSERT_TRUE(same_or_both_nan(BFloat16::from_bits(b[i]), BFloat16(x[i]))) << i;
+    }
+    kernels::avx512::bf16_to_f32(back.data(), b.data(), n);
+    for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(same_or_both_nan(back[i], BFloat16::from_bits(b[i]))) << i;
+    kernels::avx512::f16_to_f32(back.data(), h.data(), n);
+    for (std::size_t i = 0; i < n; ++i) ASSERT_TRUE(same_or_both_nan(back[i], Half::from_bits(h[i]))) << i;
+
+#if defined(MINIDL_HAVE_AVX512BF16)
+    if (detail::cpu_has_avx512_bf16()) {
+        kernels::avx512bf16::f32_to_bf16(b.data(), x.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const float ref = std::fabs(x[i]) < FLT_MIN ? std::copysign(0.0f, x[i]) : float(BFloat16(x[i]));
+            ASSERT_TRUE(same_or_both_nan(BFloat16::from_bits(b[i]), ref)) << i;
+        }
+    }
+#endif
+}
+#endif
+
+TEST(DType, ToConvertsWithSaturation) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const Tensor f = from<float>({7}, {nan, 1e10f, -1e10f, 3.7f, -3.7f, 200.0f, 0.0f}, DType::f32);
+
+    EXPECT_EQ(to_vector<std::int32_t>(f.to(DType::i32)),
+              (std::vector<std::int32_t>{0, INT_MAX, INT_MIN, 3, -3, 200, 0}));
+    EXPECT_EQ(to_vector<std::int8_t>(f.to(DType::i8)), (std::vector<std::int8_t>{0, 127, -128, 3, -3, 127, 0}));
+    EXPECT_EQ(to_vector<std::uint8_t>(f.to(DType::u8)), (std::vector<std::uint8_t>{0, 255, 0, 3, 0, 200, 0}));
+    EXPECT_EQ(to_vector<std::int64_t>(f.to(DType::i64)),
+              (std::vector<std::int64_t>{0, 10000000000, -10000000000, 3, -3, 200, 0}));
+    EXPECT_EQ(to_vector<bool>(f.to(DType::bool_)), (std::vector<bool>{true, true, true, true, true, true, false}));
+
+    // integers wrap; bool is 0 / 1.
+    const Tensor i = from<std::int32_t>({3}, {300, -129, 7}, DType::i32);
+    EXPECT_EQ(to_vector<std::int8_t>(i.to(DType::i8)), (std::vector<std::int8_t>{44, 127, 7}));
+    EXPECT_EQ(to_vector<std::int32_t>(i.to(DType::bool_).to(DType::i32)), (std::vector<std::int32_t>{1, 1, 1}));
+
+    const Tensor d = f.to(DType::f64);
+    EXPECT_EQ(to_vector<double>(d)[3], double(3.7f));
+    EXPECT_EQ(to_vector<std::uint16_t>(f.to(DType::f16))[5], Half(200.0f).bits);
+    EXPECT_EQ(to_vector<std::uint16_t>(d.to(DType::bf16))[3], BFloat16(3.7f).bits);
+
+    // same dtype: no copy.
+    EXPECT_EQ(f.to(DType::f32).data(), f.data());
+}
+
+TEST(DType, ToFollowsStridedLayouts) {
+    const Tensor x = Tensor::arange(6 * 37).view({6, 37});
+    for (DType dt : {DType::f16, DType::bf16, DType::f64, DType::i64}) {
+        const Tensor t = x.transpose({1, 0}).to(dt);
+        EXPECT_TRUE(t.is_contiguous());
+        const Tensor back = t.to(DType::f32);
+        const auto v = to_vector<float>(back);
+        for (std::size_t r = 0; r < 37; ++r) {
+            for (std::size_t c = 0; c < 6; ++c) {
+                const float expect = dt == DType::bf16 ? float(BFloat16(float(c * 37 + r))) : float(c * 37 + r);
+                ASSERT_EQ(v[r * 6 + c], expect) << to_string(dt);
+            }
+        }
+    }
+}
+
+TEST(DType, FactoriesFillEveryDType) {
+    for (DType dt : {DType::f64, DType::f16, DType::bf16, DType::i8, DType::u8, DType::i64}) {
+        const auto ones = to_vector<float>(Tensor::ones({5}, dt).to(DType::f32));
+        EXPECT_EQ(ones, std::vector<float>(5, 1.0f)) << to_string(dt);
+        const auto r = to_vector<float>(Tensor::arange(5, dt).to(DType::f32));
+        EXPECT_EQ(r, (std::vector<float>{0, 1, 2, 3, 4})) << to_string(dt);
+    }
+    EXPECT_EQ(to_vector<bool>(Tensor::ones({3}, DType::bool_)), std::vector<bool>(3, true));
+    EXPECT_THROW(Tensor::arange(3, DType::bool_), std::runtime_error);
+}
+
+TEST(DType, BinaryOpsOnNewDTypes) {
+    const Tensor a = from<double>({3}, {1.5, -2.0, 1e300}, DType::f64);
+    const Tensor b = from<double>({3}, {0.25, 4.0, 1e10}, DType::f64);
+    EXPECT_EQ(to_vector<double>(ops::mul(a, b)),
+              (std::vector<double>{0.375, -8.0, std::numeric_limits<double>::infinity()}));
+    EXPECT_EQ(to_vector<bool>(ops::lt(a, b)), (std::vector<bool>{false, true, false}));
+
+    // narrow integers wrap.
+    const Tensor c = from<std::int8_t>({3}, {100, -100, 7}, DType::i8);
+    const Tensor d = from<std::int8_t>({3}, {100, 100, -2}, DType::i8);
+    EXPECT_EQ(to_vector<std::int8_t>(ops::add(c, d)), (std::vector<std::int8_t>{-56, 0, 5}));
+    EXPECT_EQ(to_vector<std::int8_t>(ops::div(c, d)), (std::vector<std::int8_t>{1, -1, -3}));
+
+    const Tensor e = from<std::uint8_t>({3}, {250, 3, 2}, DType::u8);
+    const Tensor g = from<std::uint8_t>({3}, {10, 5, 7}, DType::u8);
+    EXPECT_EQ(to_vector<std::uint8_t>(ops::add(e, g)), (std::vector<std::uint8_t>{4, 8, 9}));
+    EXPECT_EQ(to_vector<std::uint8_t>(ops::sub(g, e)), (std::vector<std::uint8_t>{16, 2, 5}));
+    EXPECT_EQ(to_vector<std::uint8_t>(ops::pow(g, from<std::uint8_t>({3}, {2, 1, 3}, DType::u8))),
+              (std::vector<std::uint8_t>{100, 5, 87}));
+
+    const Tensor h = from<std::int64_t>({2}, {std::int64_t{1} << 40, 3}, DType::i64);
+    const Tensor k = from<std::int64_t>({2}, {std::int64_t{1} << 20, -1}, DType::i64);
+    EXPECT_EQ(to_vector<std::int64_t>(ops::mul(h, k)), (std::vector<std::int64_t>{std::int64_t{1} << 60, -3}));
+
+    EXPECT_THROW(ops::add(Tensor::ones({2}, DType::bool_), Tensor::ones({2}, DType::bool_)), std::runtime_error);
+}
+
+TEST(DType, HalfBinaryOpsComputeInF32) {
+    Tensor x = Tensor::arange(3 * 300).view({3, 300});
+    x = ops::sub(ops::mul(x, from<float>({1}, {0.37f}, DType::f32)), from<float>({1}, {150.0f}, DType::f32));
+    const Tensor y = ops::add(Tensor::arange(300), from<float>({1}, {1.0f}, DType::f32));
+
+    using Op = Tensor (*)(const Tensor&, const Tensor&);
+    const Op arithmetic[] = {ops::add, ops::sub, ops::mul, ops::div, ops::maximum};
+    for (DType dt : {DType::f16, DType::bf16}) {
+        const Tensor a = x.to(dt), b = y.to(dt);
+        const Tensor af = a.to(DType::f32), bf = b.to(DType::f32);
+        // the f32 result rounded once, for broadcast, transposed and contiguous operands.
+        for (Op op : arithmetic) {
+            const Tensor r = op(a, b);
+            ASSERT_EQ(r.dtype(), dt);
+            EXPECT_EQ(to_vector<std::uint16_t>(r), to_vector<std::uint16_t>(op(af, bf).to(dt))) << to_string(dt);
+
+            const Tensor rt = op(a.transpose({1, 0}), a.transpose({1, 0}));
+            EXPECT_EQ(to_vector<std::uint16_t>(rt), to_vector<std::uint16_t>(op(af, af).to(dt).transpose({1, 0})));
+        }
+        const Tensor gt = ops::gt(a, b);
+        EXPECT_EQ(gt.dtype(), DType::bool_);
+        EXPECT_EQ(to_vector<bool>(gt), to_vector<bool>(ops::gt(af, bf)));
+
+        Tensor out = Tensor::empty({3, 300}, dt);
+        ops::add_out(a, b, out);
+        EXPECT_EQ(to_vector<std::uint16_t>(out), to_vector<std::uint16_t>(ops::add(a, b)));
+        ops::mul_(out, b);
+        EXPECT_EQ(to_vector<std::uint16_t>(out),
+                  to_vector<std::uint16_t>(ops::mul(ops::add(a, b).to(DType::f32), bf).to(dt)));
+        EXPECT_EQ(ops::add(a, x).dtype(), DType::f32);
+    }
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/expr.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <stdexcept>
+#include <type_traits>
+
+using namespace minidl;
+
+static void expect_equal_f32(const Tensor& got, const Tensor& want) {
+    ASSERT_EQ(got.shape().dims(), want.shape().dims());
+    const auto g = got.contiguous();
+    const auto w = want.contiguous();
+    const auto* pg = static_cast<const float*>(g.data());
+    const auto* pw = static_cast<const float*>(w.data());
+    for (std::size_t i = 0; i < g.numel(); ++i) ASSERT_FLOAT_EQ(pg[i], pw[i]) << i;
+}
+
+TEST(Expr, BuildsWithoutComputing) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    auto a = Tensor::ones({8}, DType::f32, alloc);
+    auto b = Tensor::ones({8}, DType::f32, alloc);
+    const auto before = alloc->total_allocations();
+
+    auto e = expr::lazy(a) * b + a;
+    static_assert(std::decay_t<decltype(e)>::kLeaves == 3);
+    EXPECT_EQ(alloc->total_allocations(), before);
+}
+
+TEST(Expr, FusedChainMatchesEagerOps) {
+    auto a = Tensor::arange(24).view({2, 3, 4});
+    auto b = Tensor::arange(4);                       // broadcast over rows
+    auto c = Tensor::ones({3, 1});                    // broadcast over columns
+    auto d = Tensor::arange(24).view({4, 3, 2}).transpose({2, 1, 0});  // strided
+
+    const auto eager = ops::add(ops::mul(ops::add(a, b), c), d);
+    const auto fused = expr::eval((expr::lazy(a) + b) * c + d);
+    expect_equal_f32(fused, eager);
+    EXPECT_TRUE(fused.is_contiguous());
+}
+
+TEST(Expr, SingleAllocationForChain) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    auto a = Tensor::ones({1000}, DType::i32, alloc);
+    auto b = Tensor::arange(1000, DType::i32, alloc);
+    const auto before = alloc->total_allocations();
+
+    auto r = expr::eval(expr::mul(expr::add(expr::lazy(a), b), b) + a);
+    EXPECT_EQ(alloc->total_allocations(), before + 1);
+
+    const auto* p = static_cast<const std::int32_t*>(r.data());
+    for (std::int32_t i = 0; i < 1000; ++i) ASSERT_EQ(p[i], (1 + i) * i + 1);
+}
+
+TEST(Expr, EvalOutInPlaceAndAliased) {
+    auto x = Tensor::arange(16).view({4, 4});
+    auto y = Tensor::ones({4});
+
+    // same-address aliasing is evaluated directly.
+    const auto want = ops::add(ops::mul(x, x), y);
+    expr::eval_out(expr::lazy(x) * x + y, x);
+    expect_equal_f32(x, want);
+
+    // reading x^T while writing x goes through a temporary.
+    auto z = Tensor::arange(16).view({4, 4});
+    const auto want_t = ops::add(z, z.transpose({1, 0}));
+    const auto zt = z.transpose({1, 0});
+    expr::eval_out(expr::lazy(z) + zt, z);
+    expect_equal_f32(z, want_t);
+}
+
+TEST(Expr, RejectsMismatches) {
+    auto a = Tensor::ones({2, 3});
+    auto i = Tensor::ones({2, 3}, DType::i32);
+    EXPECT_THROW(expr::eval(expr::lazy(a) + i), std::runtime_error);
+
+    auto bad = Tensor::ones({4});
+    EXPECT_THROW(expr::eval(expr::lazy(a) * bad), std::runtime_error);
+
+    auto out = Tensor::zeros({3, 2});
+    EXPECT_THROW(expr::eval_out(expr::lazy(a) + a, out), std::runtime_error);
+}
+
+TEST(Expr, ParallelMatchesSerial) {
+    const auto saved = get_num_threads();
+    set_num_threads(4);
+    auto a = Tensor::arange(3 * 65536).view({3, 65536});
+    auto b = Tensor::arange(65536);
+    const auto eager = ops::mul(ops::add(a, b), b);
+    const auto fused = expr::eval((expr::lazy(a) + b) * b);
+    set_num_threads(saved);
+    expect_equal_f32(fused, eager);
+}
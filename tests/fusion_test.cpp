@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <minidl/graph.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <functional>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace minidl;
+using namespace minidl::test_util;
+
+namespace {
+
+graph::Plan compile(const std::function<Tensor(const Tensor&)>& f, const Shape& shape, bool fuse) {
+    graph::Trace trace;
+    trace.output(f(trace.input(shape)));
+    graph::CompileOptions options;
+    options.fuse = fuse;
+    return trace.compile(nullptr, options);
+}
+
+// fused and unfused plans both match eager, bit for bit.
+void expect_fused_matches(const std::function<Tensor(const Tensor&)>& f, const Shape& shape) {
+    graph::Plan fused = compile(f, shape, true), plain = compile(f, shape, false);
+    for (unsigned seed : {1u, 2u}) {
+        const Tensor in = values(shape, seed);
+        const Tensor ref = f(in);
+        expect_same(fused.run({in})[0], ref);
+        expect_same(plain.run({in})[0], ref);
+    }
+}
+
+}  // namespace
+
+TEST(Fusion, ActivationChainsFuseBetweenSharedValues) {
+    // a normalization-style tail with broadcast rows, both precisions; rows over the block size.
+    const Tensor scale = values({300}, 3), shift = values({300}, 4);
+    for (ops::Precision p : {ops::Precision::fast, ops::Precision::exact}) {
+        const auto f = [&](const Tensor& x) {
+            Tensor h = ops::add(ops::mul(x, scale), shift);
+            h = ops::mul(ops::sigmoid(h, p), h);
+            h = ops::tanh(ops::gelu(h, p), p);
+            return ops::maximum(ops::sub(ops::exp(h, p), Tensor::ones({1})), ops::div(h, scale));
+        };
+        expect_fused_matches(f, {37, 300});
+
+        graph::Plan plan = compile(f, {37, 300}, true);
+        // silu and the last line each read h twice, so the chain splits into three kernels.
+        EXPECT_EQ(plan.num_steps(), 3u);
+        EXPECT_EQ(plan.num_fused(), 7u);
+        EXPECT_LT(plan.arena_bytes(), compile(f, {37, 300}, false).arena_bytes());
+    }
+}
+
+TEST(Fusion, PureChainNeedsOnlyTheOutput) {
+    const Tensor one = Tensor::ones({1});
+    const auto f = [&](const Tensor& x) {
+        Tensor t = ops::exp(x);
+        for (int i = 0; i < 9; ++i) t = (i % 2) ? ops::mul(t, one) : ops::relu(ops::add(t, x));
+        return t;
+    };
+    expect_fused_matches(f, {3, 50000});  // over the parallel grain
+    graph::Plan plan = compile(f, {3, 50000}, true);
+    EXPECT_EQ(plan.num_steps(), 1u);
+    EXPECT_EQ(plan.arena_bytes(), 3 * 50000 * sizeof(float));
+}
+
+TEST(Fusion, BroadcastAndStridedLeaves) {
+    const Tensor col = values({6, 1}, 5), row = values({9}, 6), wide = values({9, 6}, 7);
+    const auto f = [&](const Tensor& x) {
+        // a transposed (strided) constant, a column and a row broadcast, and a strided input view.
+        const Tensor t = ops::mul(ops::add(x, col), wide.transpose({1, 0}));
+        return ops::minimum(ops::sigmoid(ops::sub(t, row)), x.slice(1, 0, 9));
+    };
+    expect_fused_matches(f, {6, 9});
+    EXPECT_EQ(compile(f, {6, 9}, true).num_steps(), 1u);
+}
+
+TEST(Fusion, StopsAtSharedValuesOutputsAndOtherOps) {
+    const Tensor w = values({16, 16}, 8);
+    graph::Trace trace;
+    const Tensor x = trace.input({4, 16});
+    const Tensor a = ops::exp(ops::add(x, x));                 // a is an output
+    const Tensor m = ops::relu(ops::matmul(ops::tanh(a), w));  // matmul is not elementwise
+    const Tensor n = ops::mul(m, m);                           // m is read three times
+    const Tensor b = ops::add(ops::sigmoid(n), m);
+    trace.output(b);
+    trace.output(a);
+    graph::Plan plan = trace.compile();
+    // exp(add) | tanh | matmul | relu | add(sigmoid(mul))
+    EXPECT_EQ(plan.num_steps(), 5u);
+    EXPECT_EQ(plan.num_fused(), 3u);
+
+    const Tensor in = values({4, 16}, 9);
+    const Tensor ra = ops::exp(ops::add(in, in));
+    const Tensor rm = ops::relu(ops::matmul(ops::tanh(ra), w));
+    const std::vector<Tensor>& out = plan.run({in});
+    expect_same(out[0], ops::add(ops::sigmoid(ops::mul(rm, rm)), rm));
+    expect_same(out[1], ra);
+}
+
+TEST(Fusion, LongAndBushyTreesAreSplit) {
+    std::vector<Tensor> leaves;
+    for (unsigned k = 0; k < 64; ++k) leaves.push_back(values({40}, 10 + k));
+    const auto f = [&](const Tensor& x) {
+        // a right-leaning chain longer than one kernel takes, then a balanced sum tree.
+        Tensor t = x;
+        for (std::size_t k = 0; k < 40; ++k) t = ops::sub(leaves[k], t);
+        std::vector<Tensor> level;
+        for (std::size_t k = 0; k < 16; ++k) level.push_back(ops::mul(t, leaves[40 + k]));
+        while (level.size() > 1) {
+            std::vector<Tensor> next;
+            for (std::size_t k = 0; k < level.size(); k += 2) next.push_back(ops::add(level[k], level[k + 1]));
+            level = next;
+        }
+        return level[0];
+    };
+    expect_fused_matches(f, {40});
+    graph::Plan plan = compile(f, {40}, true);
+    EXPECT_GT(plan.num_steps(), 1u);
+    EXPECT_LT(plan.num_steps(), 10u);
+}
+
+TEST(Fusion, OnlyFloatOpsFuse) {
+    const auto f = [](const Tensor& x) { return ops::relu(ops::add(ops::mul(x, x), Tensor::ones({1}, DType::i32))); };
+    graph::Trace trace;
+    trace.output(f(trace.input({8}, DType::i32)));
+    graph::Plan plan = trace.compile();
+    EXPECT_EQ(plan.num_steps(), 3u);
+    Tensor in = Tensor::empty({8}, DType::i32);
+    for (int i = 0; i < 8; ++i) static_cast<std::int32_t*>(in.data())[i] = i - 4;
+    expect_same(plan.run({in})[0], f(in));
+}
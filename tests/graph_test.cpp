@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/expr.h>
+#include <minidl/graph.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace minidl;
+using namespace minidl::test_util;
+
+namespace {
+
+// relu(x @ w + b), then sigmoid(h * h) and h - 1.
+std::vector<Tensor> mlp(const Tensor& x, const Tensor& w, const Tensor& b) {
+    const Tensor h = ops::relu(ops::add(ops::matmul(x, w), b));
+    return {ops::sigmoid(ops::mul(h, h)), ops::sub(h, Tensor::ones({1}))};
+}
+
+}  // namespace
+
+TEST(Graph, ReplayMatchesEager) {
+    const Tensor w = values({8, 16}, 1), b = values({16}, 2);
+    graph::Trace trace;
+    const Tensor x = trace.input({4, 8});
+    for (const Tensor& y : mlp(x, w, b)) trace.output(y);
+    graph::Plan plan = trace.compile();
+
+    for (unsigned seed : {3u, 4u}) {
+        const Tensor in = values({4, 8}, seed);
+        const std::vector<Tensor>& out = plan.run({in});
+        const std::vector<Tensor> ref = mlp(in, w, b);
+        ASSERT_EQ(out.size(), 2u);
+        expect_same(out[0], ref[0]);
+        expect_same(out[1], ref[1]);
+    }
+}
+
+TEST(Graph, ChainsShareTheBufferInPlace) {
+    graph::Trace trace;
+    const Tensor x = trace.input({1024});
+    const Tensor one = Tensor::ones({1024});
+    Tensor t = ops::exp(x);
+    for (int i = 0; i < 9; ++i) t = (i % 2) ? ops::mul(t, one) : ops::add(t, one);
+    trace.output(t);
+    graph::CompileOptions options;
+    options.fuse = false;  // the chain would be one fused step
+    graph::Plan plan = trace.compile(nullptr, options);
+
+    EXPECT_EQ(plan.num_steps(), 10u);
+    EXPECT_EQ(plan.eager_bytes(), 10 * 1024 * sizeof(float));
+    // every op after the first writes over its input.
+    EXPECT_EQ(plan.num_in_place(), 9u);
+    EXPECT_EQ(plan.arena_bytes(), 1024 * sizeof(float));
+
+    const Tensor in = values({1024}, 1);
+    Tensor ref = ops::exp(in);
+    for (int i = 0; i < 9; ++i) ref = (i % 2) ? ops::mul(ref, one) : ops::add(ref, one);
+    expect_same(plan.run({in})[0], ref);
+}
+
+TEST(Graph, LiveValuesNeverShareBytes) {
+    // a diamond with an output in the middle: y1 must survive everything after it.
+    graph::Trace trace;
+    const Tensor x = trace.input({64});
+    const Tensor y1 = ops::exp(x);
+    const Tensor a = ops::mul(y1, y1);
+    const Tensor c = ops::tanh(y1);
+    const Tensor y2 = ops::add(ops::add(a, c), x);
+    trace.output(y2);
+    trace.output(y1);
+    graph::Plan plan = trace.compile();
+    EXPECT_LT(plan.arena_bytes(), plan.eager_bytes());
+
+    const Tensor in = values({64}, 5);
+    const Tensor r1 = ops::exp(in);
+    const std::vector<Tensor>& out = plan.run({in});
+    expect_same(out[0], ops::add(ops::add(ops::mul(r1, r1), ops::tanh(r1)), in));
+    expect_same(out[1], r1);
+}
+
+TEST(Graph, ViewsOfInputsAndIntermediates) {
+    const Tensor w = values({4, 5}, 1);
+    const auto f = [&](const Tensor& x) {
+        const Tensor t = ops::matmul(x.transpose({1, 0}), w);   // [6, 5]
+        const Tensor s = ops::exp(t.slice(0, 1, 6, 2));          // [3, 5]
+        const Tensor r = s.transpose({1, 0}).reshape({15});      // a copy
+        return ops::add(r, x.select(0, 1).slice(0, 0, 1));       // broadcast [1]
+    };
+    graph::Trace trace;
+    const Tensor x = trace.input({4, 6});
+    trace.output(f(x));
+    graph::Plan plan = trace.compile();
+    for (unsigned seed : {2u, 3u}) {
+        const Tensor in = values({4, 6}, seed);
+        expect_same(plan.run({in})[0], f(in));
+    }
+}
+
+TEST(Graph, ReplayAllocatesNothing) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    const Tensor w = values({8, 16}, 1, alloc), b = values({16}, 2, alloc);
+    graph::Trace trace;
+    const Tensor x = trace.input({4, 8});
+    for (const Tensor& y : mlp(x, w, b)) trace.output(y);
+    graph::Plan plan = trace.compile(alloc);
+
+    const Tensor in = values({4, 8}, 3, alloc);
+    const std::size_t before = alloc->total_allocations();
+    for (int i = 0; i < 3; ++i) plan.run({in});
+    EXPECT_EQ(alloc->total_allocations(), before);
+    // eager allocates every intermediate from the operands' allocator.
+    mlp(in, w, b);
+    EXPECT_GT(alloc->total_allocations(), before);
+}
+
+TEST(Graph, ConstantsAreReadOnEveryRun) {
+    Tensor w = values({3}, 1);
+    Tensor m = values({3, 2}, 3);
+    graph::Trace trace;
+    const Tensor x = trace.input({3});
+    trace.output(ops::mul(x, w));
+    // a copy of a weight is replayed, not frozen.
+    trace.output(ops::add(x.reshape({1, 3}), m.transpose({1, 0}).contiguous()));
+    graph::Plan plan = trace.compile();
+    const Tensor in = values({3}, 2);
+    ops::add_(w, Tensor::ones({1}));
+    ops::add_(m, Tensor::ones({1}));
+    const auto& out = plan.run({in});
+    expect_same(out[0], ops::mul(in, w));
+    expect_same(out[1], ops::add(in.reshape({1, 3}), m.transpose({1, 0}).contiguous()));
+}
+
+TEST(Graph, RejectsWhatItCannotReplay) {
+    {
+        graph::Trace trace;
+        const Tensor x = trace.input({4});
+        Tensor y = ops::exp(x);
+        EXPECT_THROW(ops::sum(y), std::runtime_error);
+        EXPECT_THROW(ops::add_(y, Tensor::ones({4})), std::runtime_error);
+        EXPECT_THROW(y.to(DType::f16), std::runtime_error);
+        EXPECT_THROW(expr::eval(expr::lazy(y) * y), std::runtime_error);
+        Tensor z = Tensor::zeros({4});
+        EXPECT_THROW(expr::eval_out(expr::lazy(y) + z, z), std::runtime_error);
+        EXPECT_THROW(graph::Trace(), std::runtime_error);  // one at a time per thread
+        // untraced tensors are left alone, but for to(): a converted weight would be frozen.
+        EXPECT_NO_THROW(ops::sum(Tensor::ones({4})));
+        EXPECT_THROW(Tensor::ones({4}).to(DType::f16), std::runtime_error);
+        trace.output(y);
+        graph::Plan plan = trace.compile();
+        EXPECT_THROW(plan.run({}), std::runtime_error);
+        EXPECT_THROW(plan.run({Tensor::ones({5})}), std::runtime_error);
+        EXPECT_THROW(plan.run({Tensor::ones({4}, DType::i32)}), std::runtime_error);
+        EXPECT_THROW(trace.compile(), std::runtime_error);
+        // recording stopped at compile().
+        EXPECT_NO_THROW(ops::sum(y));
+    }
+    graph::Trace next;  // the thread is free again
+}
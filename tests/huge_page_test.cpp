@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/huge_page_allocator.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+using namespace minidl;
+
+TEST(HugePages, LargeBlocksAreMappedSmallOnesGoUpstream) {
+    auto upstream = std::make_shared<TrackingAllocator>();
+    HugePageAllocator::Options options;
+    options.threshold = std::size_t{1} << 20;
+    HugePageAllocator alloc(options, upstream);
+
+    void* small = alloc.allocate(4096);
+    EXPECT_EQ(upstream->total_allocations(), 1u);
+    alloc.deallocate(small);
+
+    constexpr std::size_t kBytes = (std::size_t{3} << 20) + 100;
+    auto* big = static_cast<unsigned char*>(alloc.allocate(kBytes));
+    ASSERT_NE(big, nullptr);
+    EXPECT_EQ(upstream->total_allocations(), 1u);
+    std::memset(big, 3, kBytes);
+    EXPECT_EQ(big[kBytes - 1], 3);
+#if defined(__linux__)
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(big) % HugePageAllocator::kHugePageSize, 0u);
+    EXPECT_EQ(alloc.stats().transparent_blocks, 1u);
+    // rounding up to whole huge pages must not wrap to a tiny mapping.
+    EXPECT_THROW(alloc.allocate(std::numeric_limits<std::size_t>::max() - 100), std::bad_alloc);
+#endif
+    EXPECT_EQ(alloc.stats().upstream_blocks + alloc.stats().transparent_blocks, 2u);
+    alloc.deallocate(big);
+    EXPECT_EQ(alloc.allocate(0), nullptr);
+    EXPECT_THROW(alloc.allocate(64, 3), std::runtime_error);
+}
+
+TEST(HugePages, HugetlbFallsBackWhenThePoolIsEmpty) {
+    HugePageAllocator::Options options;
+    options.mode = HugePageMode::hugetlb;
+    HugePageAllocator alloc(options);
+    void* p = alloc.allocate(HugePageAllocator::kHugePageSize);
+    ASSERT_NE(p, nullptr);
+    std::memset(p, 1, HugePageAllocator::kHugePageSize);
+    const HugePageStats s = alloc.stats();
+    // one way or another, exactly one block.
+    EXPECT_EQ(s.hugetlb_blocks + s.transparent_blocks + s.upstream_blocks, 1u);
+    alloc.deallocate(p);
+}
+
+TEST(HugePages, TensorsOnHugePages) {
+    auto alloc = std::make_shared<HugePageAllocator>();
+    const Tensor a = Tensor::ones({1024, 1024}, DType::f32, alloc);
+    const Tensor t = ops::add(a, a).transpose({1, 0}).contiguous();
+    EXPECT_EQ(t.storage()->alloc_, alloc);
+    EXPECT_FLOAT_EQ(*static_cast<const float*>(ops::sum(t).data()), 2.0f * 1024 * 1024);
+}
@@ -147,3 +147,20 @@ TEST(OffsetElems, NonContiguousGeneral) {
     EXPECT_EQ(detail::offset_elems({0, 2}, strides), 6u);
     EXPECT_EQ(detail::offset_elems({2, 3}, strides), 11u);
 }
+
+TEST(NdCounterSeek, SeekMatchesNext) {
+    std::vector<std::size_t> shape({3, 2, 4});
+    detail::NdCounter walked(shape);
+    for (std::size_t linear = 0; linear < 24; ++linear, walked.next()) {
+        detail::NdCounter c(shape);
+        c.seek(linear);
+        ASSERT_FALSE(c.done());
+        EXPECT_EQ(c.idx, walked.idx) << "linear=" << linear;
+    }
+}
+
+TEST(NdCounterSeek, SeekPastEndIsDone) {
+    detail::NdCounter c(std::vector<std::size_t>({3, 2}));
+    c.seek(6);
+    EXPECT_TRUE(c.done());
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+using namespace minidl;
+
+namespace {
+
+// deterministic small integers, exact in f32 products and sums for the sizes used here.
+Tensor pattern(const std::vector<std::size_t>& dims, DType dt, std::size_t seed) {
+    Tensor t = Tensor::empty(Shape(dims), dt);
+    for (std::size_t i = 0; i < t.numel(); ++i) {
+        const int v = static_cast<int>((i * 7 + seed * 13) % 11) - 5;
+        if (dt == DType::f32) {
+            static_cast<float*>(t.data())[i] = static_cast<float>(v);
+        } else {
+            static_cast<std::int32_t*>(t.data())[i] = v;
+        }
+    }
+    return t;
+}
+
+double at(const Tensor& t, const std::vector<std::size_t>& idx) {
+    std::size_t off = 0;
+    for (std::size_t d = 0; d < idx.size(); ++d) off += idx[d] * t.strides()[d];
+    if (t.dtype() == DType::f32) return static_cast<const float*>(t.data())[off];
+    return static_cast<const std::int32_t*>(t.data())[off];
+}
+
+// naive product of 2-D views.
+void expect_matmul_2d(const Tensor& a, const Tensor& b, const Tensor& c) {
+    const std::size_t m = a.shape().dims()[0], k = a.shape().dims()[1], n = b.shape().dims()[1];
+    ASSERT_EQ(c.shape().dims(), (std::vector<std::size_t>{m, n}));
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            double ref = 0;
+            for (std::size_t p = 0; p < k; ++p) ref += at(a, {i, p}) * at(b, {p, j});
+            ASSERT_EQ(at(c, {i, j}), ref) << i << "," << j;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(Matmul, Small2D) {
+    auto a = Tensor::arange(6).view({2, 3});
+    auto b = Tensor::arange(12).view({3, 4});
+    auto c = ops::matmul(a, b);
+    expect_matmul_2d(a, b, c);
+    EXPECT_FLOAT_EQ(static_cast<const float*>(c.data())[0], 20.0f);  // 0*0 + 1*4 + 2*8
+}
+
+TEST(Matmul, EdgeTilesAndDeepK) {
+    // sizes off every micro-tile and block multiple, and K spanning several KC blocks.
+    for (DType dt : {DType::f32, DType::i32}) {
+        for (auto [m, n, k] : {std::tuple<std::size_t, std::size_t, std::size_t>{1, 1, 1},
+                               {7, 17, 5},
+                               {13, 33, 300},
+                               {150, 70, 600},
+                               {5, 4100, 3}}) {
+            const auto a = pattern({m, k}, dt, 1);
+            const auto b = pattern({k, n}, dt, 2);
+            expect_matmul_2d(a, b, ops::matmul(a, b));
+        }
+    }
+}
+
+TEST(Matmul, TransposedAndSlicedOperands) {
+    const auto a_t = pattern({40, 30}, DType::f32, 3);  // a = a_t^T is 30x40, column-major
+    const auto b_t = pattern({50, 40}, DType::f32, 4);  // b = b_t^T is 40x50
+    const auto a = a_t.transpose({1, 0});
+    const auto b = b_t.transpose({1, 0});
+    expect_matmul_2d(a, b, ops::matmul(a, b));
+    const auto wide = pattern({50, 80}, DType::f32, 5);
+    const auto b_strided = wide.slice(1, 0, 80, 2).transpose({1, 0});  // 40x50, strides (2, 80)
+    expect_matmul_2d(a, b_strided, ops::matmul(a, b_strided));
+}
+
+TEST(Matmul, BatchedWithBroadcast) {
+    const auto a = pattern({3, 1, 5, 6}, DType::i32, 5);
+    const auto b = pattern({4, 6, 7}, DType::i32, 6);
+    const auto c = ops::matmul(a, b);
+    ASSERT_EQ(c.shape().dims(), (std::vector<std::size_t>{3, 4, 5, 7}));
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) {
+            expect_matmul_2d(a.select(0, i).select(0, 0), b.select(0, j), c.select(0, i).select(0, j));
+        }
+    }
+}
+
+TEST(Matmul, ParallelMatchesSerial) {
+    const std::size_t saved = get_num_threads();
+    const auto a = pattern({257, 300}, DType::f32, 7);
+    const auto b = pattern({300, 513}, DType::f32, 8);
+    const auto batched_a = pattern({6, 33, 20}, DType::f32, 9);
+    const auto batched_b = pattern({20, 45}, DType::f32, 10);
+
+    set_num_threads(1);
+    const auto c1 = ops::matmul(a, b);
+    const auto d1 = ops::matmul(batched_a, batched_b);
+    set_num_threads(4);
+    const auto c4 = ops::matmul(a, b);
+    const auto d4 = ops::matmul(batched_a, batched_b);
+    set_num_threads(saved);
+
+    for (std::size_t i = 0; i < c1.numel(); ++i) {
+        ASSERT_EQ(static_cast<const float*>(c1.data())[i], static_cast<const float*>(c4.data())[i]);
+    }
+    for (std::size_t i = 0; i < d1.numel(); ++i) {
+        ASSERT_EQ(static_cast<const float*>(d1.data())[i], static_cast<const float*>(d4.data())[i]);
+    }
+    expect_matmul_2d(a, b, c4);
+}
+
+TEST(Matmul, OutVariant) {
+    const auto a = pattern({8, 9}, DType::f32, 11);
+    const auto b = pattern({9, 10}, DType::f32, 12);
+
+    auto out = Tensor::zeros({8, 10});
+    const void* data = out.data();
+    EXPECT_EQ(&ops::matmul_out(a, b, out), &out);
+    EXPECT_EQ(out.data(), data);
+    expect_matmul_2d(a, b, out);
+
+    // a transposed out goes through a temporary.
+    auto base = Tensor::zeros({10, 8});
+    auto out_t = base.transpose({1, 0});
+    ops::matmul_out(a, b, out_t);
+    expect_matmul_2d(a, b, out_t);
+
+    // out aliasing an input: x = x @ x.
+    auto x = pattern({6, 6}, DType::i32, 13);
+    const auto expected = ops::matmul(x, x);
+    ops::matmul_out(x, x, x);
+    for (std::size_t i = 0; i < 36; ++i) {
+        EXPECT_EQ(static_cast<const std::int32_t*>(x.data())[i], static_cast<const std::int32_t*>(expected.data())[i]);
+    }
+}
+
+TEST(Matmul, EmptyAndErrors) {
+    auto zk = ops::matmul(Tensor::ones({3, 0}), Tensor::ones({0, 4}));
+    ASSERT_EQ(zk.shape().dims(), (std::vector<std::size_t>{3, 4}));
+    for (std::size_t i = 0; i < 12; ++i) EXPECT_EQ(static_cast<const float*>(zk.data())[i], 0.0f);
+    EXPECT_EQ(ops::matmul(Tensor::ones({0, 3}), Tensor::ones({3, 4})).numel(), 0u);
+
+    EXPECT_THROW(ops::matmul(Tensor::ones({2, 3}), Tensor::ones({4, 5})), std::runtime_error);
+    EXPECT_THROW(ops::matmul(Tensor::ones({3}), Tensor::ones({3, 5})), std::runtime_error);
+    EXPECT_THROW(ops::matmul(Tensor::ones({2, 3}), Tensor::ones({3, 5}, DType::i32)), std::runtime_error);
+    EXPECT_THROW(ops::matmul(Tensor::ones({2, 2, 3}), Tensor::ones({3, 3, 5})), std::runtime_error);
+    auto wrong = Tensor::zeros({2, 4});
+    EXPECT_THROW(ops::matmul_out(Tensor::ones({2, 3}), Tensor::ones({3, 5}), wrong), std::runtime_error);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/numa_allocator.h>
+#include <minidl/numa.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <stdexcept>
+
+using namespace minidl;
+
+TEST(Numa, TopologyCoversTheCpus) {
+    ASSERT_GE(numa_num_nodes(), 1u);
+    std::set<std::size_t> cpus;
+    for (std::size_t node = 0; node < numa_num_nodes(); ++node) {
+        for (std::size_t c : numa_node_cpus(node)) EXPECT_TRUE(cpus.insert(c).second) << "cpu " << c << " twice";
+    }
+    EXPECT_FALSE(cpus.empty());
+    ASSERT_FALSE(numa_cpu_nodes().empty());
+    for (std::size_t node : numa_cpu_nodes()) EXPECT_FALSE(numa_node_cpus(node).empty());
+    EXPECT_THROW(numa_node_cpus(numa_num_nodes()), std::runtime_error);
+
+    // tasks are spread over the CPU nodes in contiguous blocks, first task on the first node.
+    EXPECT_EQ(detail::numa_task_node(0, 8), numa_cpu_nodes().front());
+    EXPECT_EQ(detail::numa_task_node(7, 8), numa_cpu_nodes().back());
+    for (std::size_t t = 1; t < 8; ++t) EXPECT_GE(detail::numa_task_node(t, 8), detail::numa_task_node(t - 1, 8));
+}
+
+TEST(Numa, AllocatorPlacesPagesByPolicy) {
+    for (NumaPolicy policy : {NumaPolicy::bind, NumaPolicy::interleave, NumaPolicy::partitioned}) {
+        NumaAllocator alloc(policy, numa_num_nodes() - 1);
+        constexpr std::size_t kBytes = std::size_t{4} << 20;
+        auto* p = static_cast<unsigned char*>(alloc.allocate(kBytes));
+        ASSERT_NE(p, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % kDefaultAlignment, 0u);
+        std::memset(p, 7, kBytes);
+        EXPECT_EQ(p[kBytes - 1], 7);
+
+        const int first = numa_node_of(p), last = numa_node_of(p + kBytes - 1);
+        if (first >= 0) {  // the kernel reports placement
+            if (policy == NumaPolicy::bind) {
+                EXPECT_EQ(first, static_cast<int>(numa_num_nodes() - 1));
+                EXPECT_EQ(last, first);
+            } else if (policy == NumaPolicy::partitioned) {
+                EXPECT_EQ(first, static_cast<int>(numa_cpu_nodes().front()));
+                EXPECT_EQ(last, static_cast<int>(numa_cpu_nodes().back()));
+                // the middle of each task's slice sits on the node its worker is pinned to.
+                const std::size_t tasks = get_num_threads();
+                for (std::size_t t = 0; t < tasks; ++t) {
+                    EXPECT_EQ(numa_node_of(p + (2 * t + 1) * kBytes / (2 * tasks)),
+                              static_cast<int>(detail::numa_task_node(t, tasks)))
+                        << "task " << t;
+                }
+            }
+        }
+        alloc.deallocate(p);
+    }
+    NumaAllocator alloc(NumaPolicy::interleave);
+    EXPECT_EQ(alloc.allocate(0), nullptr);
+    EXPECT_THROW(alloc.allocate(64, 3), std::runtime_error);
+    EXPECT_THROW(alloc.allocate(64, std::size_t{1} << 30), std::runtime_error);
+    EXPECT_THROW(NumaAllocator(NumaPolicy::bind, numa_num_nodes()), std::runtime_error);
+}
+
+TEST(Numa, PinnedPoolRunsOpsOnPartitionedTensors) {
+    const bool was_pinned = get_thread_pinning();
+    set_thread_pinning(true);
+    EXPECT_TRUE(get_thread_pinning());
+    {
+        auto alloc = std::make_shared<NumaAllocator>(NumaPolicy::partitioned);
+        const Tensor a = Tensor::ones({512, 1024}, DType::f32, alloc);
+        const Tensor b = Tensor::zeros({512, 1024}, DType::f32, alloc);
+        const Tensor c = ops::add(ops::mul(a, a), b);
+        EXPECT_FLOAT_EQ(*static_cast<const float*>(ops::sum(c).data()), 512.0f * 1024.0f);
+    }
+    set_thread_pinning(was_pinned);
+    EXPECT_EQ(get_thread_pinning(), was_pinned);
+}
+
+TEST(Numa, ScopedAffinity) {
+    const std::size_t node = numa_cpu_nodes().front();
+    {
+        ScopedNodeAffinity pin(node);
+        // still usable, whether or not the platform let us pin.
+        EXPECT_FLOAT_EQ(*static_cast<const float*>(ops::sum(Tensor::ones({64})).data()), 64.0f);
+    }
+    EXPECT_THROW(ScopedNodeAffinity{numa_num_nodes()}, std::runtime_error);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <minidl/detail/parallel.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace minidl;
+
+class ParallelTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        prev_ = get_num_threads();
+        set_num_threads(4);
+    }
+    void TearDown() override { set_num_threads(prev_); }
+
+    std::size_t prev_ = 1;
+};
+
+TEST_F(ParallelTest, SetNumThreads) {
+    EXPECT_EQ(get_num_threads(), 4u);
+    set_num_threads(2);
+    EXPECT_EQ(get_num_threads(), 2u);
+    EXPECT_EQ(detail::get_thread_pool().num_threads(), 2u);
+}
+
+TEST_F(ParallelTest, ParallelForVisitsEachIndexOnce) {
+    const std::size_t n = 10 * 1000 + 7;
+    std::vector<std::atomic<int>> hits(n);
+    detail::parallel_for(0, n, 100, [&](std::size_t b, std::size_t e) {
+        EXPECT_LE(e - b, 100u);
+        for (std::size_t i = b; i < e; ++i) hits[i]++;
+    });
+    for (std::size_t i = 0; i < n; ++i) EXPECT_EQ(hits[i].load(), 1) << "i=" << i;
+}
+
+TEST_F(ParallelTest, SmallRangeRunsSerially) {
+    std::size_t calls = 0;
+    detail::parallel_for(0, 50, 100, [&](std::size_t b, std::size_t e) {
+        EXPECT_EQ(b, 0u);
+        EXPECT_EQ(e, 50u);
+        EXPECT_FALSE(detail::in_parallel_region());
+        calls++;
+    });
+    EXPECT_EQ(calls, 1u);
+}
+
+TEST_F(ParallelTest, NestedParallelForRunsSerially) {
+    std::atomic<std::size_t> total{0};
+    detail::parallel_for(0, 8, 1, [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) {
+            detail::parallel_for(0, 100, 1, [&](std::size_t ib, std::size_t ie) { total += ie - ib; });
+        }
+    });
+    EXPECT_EQ(total.load(), 800u);
+}
+
+TEST_F(ParallelTest, ExceptionPropagatesToCaller) {
+    EXPECT_THROW(detail::parallel_for(0, 1000, 10,
+                                      [&](std::size_t b, std::size_t) {
+                                          if (b == 990) throw std::runtime_error("boom");
+                                      }),
+                 std::runtime_error);
+}
+
+TEST_F(ParallelTest, LargeAddAllPaths) {
+    const std::size_t rows = 512, cols = 300;
+
+    // contiguous
+    auto a = Tensor::arange(rows * cols, DType::f32).view({rows, cols});
+    auto b = Tensor::ones({rows, cols}, DType::f32);
+    auto c = ops::add(a, b);
+    const auto* pc = static_cast<const float*>(c.data());
+    for (std::size_t i = 0; i < rows * cols; ++i) ASSERT_FLOAT_EQ(pc[i], static_cast<float>(i) + 1.0f);
+
+    // strided
+    auto at = Tensor::arange(rows * cols, DType::i32).view({cols, rows}).transpose({1, 0});
+    auto bt = Tensor::ones({rows, cols}, DType::i32);
+    auto ct = ops::add(at, bt);
+    const auto* pct = static_cast<const std::int32_t*>(ct.data());
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t k = 0; k < cols; ++k)
+            ASSERT_EQ(pct[r * cols + k], static_cast<std::int32_t>(k * rows + r) + 1);
+
+    // broadcast
+    auto row = Tensor::arange(cols, DType::f32);
+    auto cb = ops::mul(b, row);
+    const auto* pcb = static_cast<const float*>(cb.data());
+    for (std::size_t r = 0; r < rows; ++r)
+        for (std::size_t k = 0; k < cols; ++k) ASSERT_FLOAT_EQ(pcb[r * cols + k], static_cast<float>(k));
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <minidl/ops.h>
+#include <minidl/parallel.h>
+#include <minidl/tensor.h>
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace minidl;
+
+static const float* as_f32(const Tensor& t) { return static_cast<const float*>(t.data()); }
+static const std::int32_t* as_i32(const Tensor& t) { return static_cast<const std::int32_t*>(t.data()); }
+
+TEST(Reduce, SumAllAndPerAxis) {
+    auto x = Tensor::arange(24).view({2, 3, 4});
+
+    auto all = ops::sum(x);
+    EXPECT_EQ(all.shape().dims(), std::vector<std::size_t>{});
+    EXPECT_FLOAT_EQ(as_f32(all)[0], 276.0f);
+
+    auto s1 = ops::sum(x, {1});
+    ASSERT_EQ(s1.shape().dims(), (std::vector<std::size_t>{2, 4}));
+    for (std::size_t i = 0; i < 2; ++i) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            const float ref = float(i * 12 + k) * 3 + 12;  // (i,0,k) + (i,1,k) + (i,2,k)
+            EXPECT_FLOAT_EQ(as_f32(s1)[i * 4 + k], ref);
+        }
+    }
+
+    auto s02 = ops::sum(x, {0, 2}, /*keepdim=*/true);
+    ASSERT_EQ(s02.shape().dims(), (std::vector<std::size_t>{1, 3, 1}));
+    for (std::size_t j = 0; j < 3; ++j) {
+        float ref = 0;
+        for (std::size_t i = 0; i < 2; ++i) {
+            for (std::size_t k = 0; k < 4; ++k) ref += float(i * 12 + j * 4 + k);
+        }
+        EXPECT_FLOAT_EQ(as_f32(s02)[j], ref);
+    }
+}
+
+TEST(Reduce, StridedInputsMatchContiguous) {
+    // a permuted and a sliced view against the same values laid out contiguously.
+    auto base = Tensor::arange(5 * 6 * 7, DType::i32).view({5, 6, 7});
+    auto views = {base.transpose({2, 0, 1}), base.slice(2, 1, 7, 2)};
+    for (const Tensor& v : views) {
+        const Tensor c = v.contiguous();
+        for (std::vector<std::size_t> axes : {std::vector<std::size_t>{0}, {1}, {2}, {0, 2}, {1, 2}, {}}) {
+            for (auto fn : {ops::sum, ops::max, ops::min}) {
+                const Tensor a = fn(v, axes, false);
+                const Tensor b = fn(c, axes, false);
+                ASSERT_EQ(a.shape().dims(), b.shape().dims());
+                for (std::size_t i = 0; i < a.numel(); ++i) EXPECT_EQ(as_i32(a)[i], as_i32(b)[i]);
+            }
+        }
+    }
+}
+
+TEST(Reduce, MaxMinProdMean) {
+    auto x = Tensor::arange(6).view({2, 3});
+    auto mx = ops::max(x, {1});
+    auto mn = ops::min(x, {0});
+    auto pr = ops::prod(ops::add(x, Tensor::ones({3})), {1});
+    auto me = ops::mean(x, {1}, true);
+
+    EXPECT_FLOAT_EQ(as_f32(mx)[0], 2.0f);
+    EXPECT_FLOAT_EQ(as_f32(mx)[1], 5.0f);
+    for (std::size_t j = 0; j < 3; ++j) EXPECT_FLOAT_EQ(as_f32(mn)[j], float(j));
+    EXPECT_FLOAT_EQ(as_f32(pr)[0], 6.0f);
+    EXPECT_FLOAT_EQ(as_f32(pr)[1], 120.0f);
+    ASSERT_EQ(me.shape().dims(), (std::vector<std::size_t>{2, 1}));
+    EXPECT_FLOAT_EQ(as_f32(me)[0], 1.0f);
+    EXPECT_FLOAT_EQ(as_f32(me)[1], 4.0f);
+}
+
+TEST(Reduce, ArgmaxFirstOfTies) {
+    auto x = Tensor::zeros({3, 4}, DType::i32);
+    auto* p = static_cast<std::int32_t*>(x.data());
+    p[1] = 7;
+    p[3] = 7;   // row 0: first max at 1
+    p[4 + 2] = -1;  // row 1: all others 0, first max at 0
+    p[8 + 3] = 9;   // row 2: global max
+
+    auto rows = ops::argmax(x, 1);
+    ASSERT_EQ(rows.dtype(), DType::i32);
+    EXPECT_EQ(as_i32(rows)[0], 1);
+    EXPECT_EQ(as_i32(rows)[1], 0);
+    EXPECT_EQ(as_i32(rows)[2], 3);
+
+    EXPECT_EQ(as_i32(ops::argmax(x))[0], 11);
+    // flat index is logical, not the storage offset of the transposed view.
+    EXPECT_EQ(as_i32(ops::argmax(x.transpose({1, 0})))[0], 3 * 3 + 2);
+}
+
+TEST(Reduce, ContiguousRunTails) {
+    // every length around the vector widths and leaf sizes, with the extremum in the tail.
+    for (std::size_t n : {1, 7, 8, 15, 16, 17, 63, 64, 65, 127, 128, 129, 511, 512, 513, 1000, 2049}) {
+        auto x = Tensor::arange(n, DType::i32);
+        auto* p = static_cast<std::int32_t*>(x.data());
+        p[n - 1] = -5;
+        std::int64_t ref = 0;
+        for (std::size_t i = 0; i < n; ++i) ref += p[i];
+
+        EXPECT_EQ(as_i32(ops::sum(x))[0], ref) << n;
+        EXPECT_EQ(as_i32(ops::min(x))[0], -5) << n;
+        EXPECT_EQ(as_i32(ops::max(x))[0], n == 1 ? -5 : std::int32_t(n - 2)) << n;
+    }
+}
+
+TEST(Reduce, MaxSkipsNaN) {
+    auto x = Tensor::arange(300);
+    static_cast<float*>(x.data())[100] = std::nanf("");
+    EXPECT_FLOAT_EQ(as_f32(ops::max(x))[0], 299.0f);
+    EXPECT_FLOAT_EQ(as_f32(ops::min(x))[0], 0.0f);
+}
+
+TEST(Reduce, PairwiseSumAccuracy) {
+    // 2^24 values of 0.1: a serial f32 sum stalls once the total reaches 2^21.
+    const std::size_t n = std::size_t{1} << 24;
+    auto x = Tensor::empty({n});
+    auto* p = static_cast<float*>(x.data());
+    for (std::size_t i = 0; i < n; ++i) p[i] = 0.1f;
+
+    const double ref = double(0.1f) * double(n);
+    const float s = as_f32(ops::sum(x))[0];
+    EXPECT_LT(std::abs(double(s) - ref) / ref, 1e-6);
+
+    // same along a strided (outer) axis.
+    const float t = as_f32(ops::sum(x.view({n / 16, 16}), {0}))[5];
+    EXPECT_LT(std::abs(double(t) - ref / 16) / (ref / 16), 1e-6);
+}
+
+TEST(Reduce, ParallelMatchesSerial) {
+    const std::size_t saved = get_num_threads();
+    auto x = Tensor::arange(1 << 20, DType::i32);
+    // i % 1000 for the sums, which then stay below 2^31 on every axis.
+    Tensor y = Tensor::empty({1 << 20}, DType::i32);
+    for (std::int32_t i = 0; i < (1 << 20); ++i) static_cast<std::int32_t*>(y.data())[i] = i % 1000;
+    std::vector<std::vector<std::size_t>> shapes = {{1 << 20}, {4, 1 << 18}, {1 << 18, 4}, {1024, 1024}};
+
+    for (const auto& shape : shapes) {
+        auto v = x.view(Shape(shape));
+        auto w = y.view(Shape(shape));
+        for (std::size_t axis = 0; axis < shape.size(); ++axis) {
+            set_num_threads(1);
+            const Tensor s1 = ops::sum(w, {axis});
+            const Tensor m1 = ops::argmax(v, axis);
+            set_num_threads(4);
+            const Tensor s4 = ops::sum(w, {axis});
+            const Tensor m4 = ops::argmax(v, axis);
+            for (std::size_t i = 0; i < s1.numel(); ++i) {
+                EXPECT_EQ(as_i32(s1)[i], as_i32(s4)[i]);
+                EXPECT_EQ(as_i32(m1)[i], as_i32(m4)[i]);
+            }
+            // 1048 full cycles of 0..999, then 0..575.
+            if (shape.size() == 1) EXPECT_EQ(as_i32(s1)[0], 1048 * 499500 + 575 * 576 / 2);
+        }
+    }
+    set_num_threads(4);
+    EXPECT_EQ(as_i32(ops::argmax(x))[0], (1 << 20) - 1);
+    EXPECT_EQ(as_i32(ops::max(x))[0], (1 << 20) - 1);
+    set_num_threads(saved);
+}
+
+TEST(Reduce, EmptyAndErrors) {
+    auto e = Tensor::zeros({2, 0});
+    auto s = ops::sum(e, {1});
+    ASSERT_EQ(s.numel(), 2u);
+    EXPECT_FLOAT_EQ(as_f32(s)[0], 0.0f);
+    EXPECT_FLOAT_EQ(as_f32(ops::prod(e, {1}))[1], 1.0f);
+    EXPECT_EQ(ops::sum(e, {0}).numel(), 0u);
+    EXPECT_THROW(ops::max(e, {1}), std::runtime_error);
+    EXPECT_THROW(ops::argmax(e, 1), std::runtime_error);
+
+    auto x = Tensor::ones({2, 3});
+    EXPECT_THROW(ops::sum(x, {2}), std::runtime_error);
+    EXPECT_THROW(ops::sum(x, {1, 1}), std::runtime_error);
+    EXPECT_THROW(ops::mean(Tensor::ones({2}, DType::i32)), std::runtime_error);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <minidl/ops.h>
+#include <minidl/serialize.h>
+#include <minidl/tensor.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace minidl;
+
+namespace {
+
+std::string temp_path(const std::string& name) { return ::testing::TempDir() + "minidl_" + name + ".bin"; }
+
+std::vector<std::uint8_t> bytes(const Tensor& t) {
+    const Tensor c = t.contiguous();
+    const auto* p = static_cast<const std::uint8_t*>(c.data());
+    return std::vector<std::uint8_t>(p, p + c.nbytes());
+}
+
+std::shared_ptr<const MappedFileAllocator> mapping_of(const Tensor& t) {
+    return std::static_pointer_cast<const MappedFileAllocator>(t.storage()->owner);
+}
+
+}  // namespace
+
+TEST(Serialize, RoundTripsLayoutsAndDTypes) {
+    const NamedTensors saved = {
+        {"w", Tensor::arange(15).view({3, 5})},
+        {"transposed", Tensor::arange(24, DType::i32).view({4, 6}).transpose({1, 0})},
+        {"sliced", Tensor::arange(40).view({8, 5}).slice(0, 1, 8, 3)},
+        {"half", Tensor::arange(1000).to(DType::f16)},
+        {"mask", ops::gt(Tensor::arange(7), Tensor::ones({7}))},
+        {"big", Tensor::arange(5, DType::i64)},
+        {"empty", Tensor::zeros({0, 3})},
+        {"scalar", Tensor::ones(Shape(std::vector<std::size_t>{}), DType::f64)},
+    };
+    const std::string path = temp_path("round_trip");
+    save(path, saved);
+
+    const NamedTensors loaded = load(path);
+    ASSERT_EQ(loaded.size(), saved.size());
+    for (std::size_t i = 0; i < saved.size(); ++i) {
+        const auto& [name, t] = loaded[i];
+        const Tensor& ref = saved[i].second;
+        EXPECT_EQ(name, saved[i].first);
+        EXPECT_EQ(t.dtype(), ref.dtype()) << name;
+        EXPECT_EQ(t.shape().dims(), ref.shape().dims()) << name;
+        EXPECT_EQ(bytes(t), bytes(ref)) << name;
+        if (t.numel() == 0) continue;
+        // zero copy: page-aligned data inside the mapping.
+        const auto file = mapping_of(t);
+        ASSERT_NE(file, nullptr) << name;
+        EXPECT_TRUE(file->contains(t.data())) << name;
+        EXPECT_GE(t.data_alignment(), kTensorFileAlignment) << name;
+    }
+    // a dense permutation keeps its strides; a sparse view is written contiguous.
+    EXPECT_EQ(loaded[1].second.strides(), saved[1].second.strides());
+    EXPECT_TRUE(loaded[2].second.is_contiguous());
+    std::filesystem::remove(path);
+}
+
+TEST(Serialize, OpsOnMappedTensorsAllocateUpstream) {
+    const std::string path = temp_path("ops");
+    save(path, {{"x", Tensor::arange(100)}});
+    const Tensor x = load(path)[0].second;
+    const Tensor y = ops::add(x, x);
+    EXPECT_EQ(bytes(y), bytes(ops::add(Tensor::arange(100), Tensor::arange(100))));
+    EXPECT_FALSE(mapping_of(x)->contains(y.data()));
+    std::filesystem::remove(path);
+}
+
+TEST(Serialize, CopyOnWriteLeavesTheFileAlone) {
+    const std::string path = temp_path("cow");
+    save(path, {{"x", Tensor::arange(64)}});
+    {
+        Tensor x = load(path, MapMode::copy_on_write)[0].second;
+        ops::add_(x, Tensor::ones({64}));
+        EXPECT_EQ(static_cast<const float*>(x.data())[0], 1.0f);
+    }
+    const Tensor again = load(path)[0].second;
+    EXPECT_EQ(bytes(again), bytes(Tensor::arange(64)));
+    std::filesystem::remove(path);
+}
+
+TEST(Serialize, MappingLivesAsLongAsAnyTensor) {
+    const std::string path = temp_path("lifetime");
+    save(path, {{"a", Tensor::arange(10)}, {"b", Tensor::arange(2000)}});
+    Tensor b = Tensor::zeros({1});
+    {
+        NamedTensors all = load(path);
+        b = all[1].second;
+    }
+    std::filesystem::remove(path);  // the mapping keeps the contents reachable
+    EXPECT_EQ(bytes(b), bytes(Tensor::arange(2000)));
+}
+
+TEST(Serialize, ResultsOfMappedTensorsDoNotHoldTheMapping) {
+    const std::string path = temp_path("derived");
+    save(path, {{"x", Tensor::arange(100)}});
+    std::weak_ptr<const MappedFileAllocator> file;
+    Tensor y = Tensor::zeros({1});
+    {
+        const Tensor x = load(path)[0].second;
+        file = mapping_of(x);
+        y = ops::relu(x);
+        const Tensor c = x.contiguous().to(DType::f16);
+        EXPECT_EQ(c.storage()->owner, nullptr);
+        EXPECT_FALSE(file.expired());
+    }
+    EXPECT_TRUE(file.expired());  // unmapped with the last loaded tensor
+    EXPECT_EQ(bytes(y), bytes(Tensor::arange(100)));
+    std::filesystem::remove(path);
+}
+
+TEST(Serialize, RejectsMalformedFiles) {
+    EXPECT_THROW(load(temp_path("missing")), std::runtime_error);
+
+    const std::string junk = temp_path("junk");
+    std::ofstream(junk) << "not a tensor file at all";
+    EXPECT_THROW(load(junk), std::runtime_error);
+    std::filesystem::remove(junk);
+
+    const std::string path = temp_path("truncated");
+    save(path, {{"x", Tensor::arange(4096)}});
+    std::filesystem::resize_file(path, kTensorFileAlignment + 100);  // cuts the payload
+    EXPECT_THROW(load(path), std::runtime_error);
+    std::filesystem::resize_file(path, 30);  // cuts the header
+    EXPECT_THROW(load(path), std::runtime_error);
+    std::filesystem::remove(path);
+
+    // dims {2^32, 2^32} with strides {0, 0}: numel wraps to 0, which must not pass for empty.
+    const std::string huge = temp_path("huge_dims");
+    save(huge, {{"x", Tensor::zeros({2, 2})}});
+    {
+        std::fstream f(huge, std::ios::binary | std::ios::in | std::ios::out);
+        const std::uint64_t fields[4] = {std::uint64_t{1} << 32, std::uint64_t{1} << 32, 0, 0};
+        f.seekp(33);  // magic, version, byte order, count, name length, "x", dtype, rank
+        f.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+    }
+    EXPECT_THROW(load(huge), std::runtime_error);
+    std::filesystem::remove(huge);
+}
+
+TEST(Serialize, FromStorageChecksTheLayout) {
+    const Tensor t = Tensor::arange(12);
+    const Tensor v = Tensor::from_storage(t.storage(), {3, 2}, DType::f32, {4, 1}, 2);
+    EXPECT_EQ(static_cast<const float*>(v.data())[0], 2.0f);
+    EXPECT_EQ(bytes(v.select(0, 2)), bytes(t.slice(0, 10, 12)));
+    EXPECT_THROW(Tensor::from_storage(t.storage(), {3, 2}, DType::f32, {4, 1}, 3), std::runtime_error);
+    EXPECT_THROW(Tensor::from_storage(t.storage(), {2}, DType::f32, {1, 1}), std::runtime_error);
+    EXPECT_THROW(Tensor::from_storage(t.storage(), {3}, DType::f32, {std::size_t{1} << 62}), std::runtime_error);
+    EXPECT_THROW(Tensor::from_storage(t.storage(), {std::size_t{1} << 32, std::size_t{1} << 32}, DType::f32, {0, 0}),
+                 std::runtime_error);
+}
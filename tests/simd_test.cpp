@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <minidl/detail/binary_ops.h>
+#include <minidl/detail/cpu_features.h>
+#include <minidl/detail/kernels_simd.h>
+
+#include <vector>
+
+using namespace minidl;
+
+namespace {
+
+template <typename T, class Op>
+void expect_matches_scalar(kernels::BinaryContigFn<T, Op> fn) {
+    // lengths around the vector widths exercise the unrolled body and the tail.
+    for (std::size_t n : {0, 1, 3, 7, 8, 9, 15, 16, 17, 31, 33, 64, 100, 1000}) {
+        std::vector<T> x(n), y(n), expected(n), z(n + 1, T(-7));
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = static_cast<T>(static_cast<int>(i % 13) - 6);
+            y[i] = static_cast<T>(static_cast<int>(i % 7) + 1);
+        }
+        kernels::binary_contig<T, Op>(expected.data(), x.data(), y.data(), n);
+        fn(z.data(), x.data(), y.data(), n);
+        for (std::size_t i = 0; i < n; ++i) ASSERT_EQ(z[i], expected[i]) << "n=" << n << " i=" << i;
+        EXPECT_EQ(z[n], T(-7)) << "wrote past the end, n=" << n;
+    }
+}
+
+// every combination of element offsets into 64-byte aligned buffers.
+template <typename T, class Op>
+void expect_matches_scalar_misaligned(kernels::BinaryContigFn<T, Op> fn) {
+    const std::size_t n = 77;
+    alignas(64) T xb[n + 16], yb[n + 16], zb[n + 16], expected[n];
+    for (std::size_t i = 0; i < n + 16; ++i) {
+        xb[i] = static_cast<T>(static_cast<int>(i % 11) - 5);
+        yb[i] = static_cast<T>(static_cast<int>(i % 5) + 2);
+    }
+    for (std::size_t zo : {0, 1, 3, 8})
+        for (std::size_t xo : {0, 1, 5})
+            for (std::size_t yo : {0, 2, 8}) {
+                kernels::binary_contig<T, Op>(expected, xb + xo, yb + yo, n);
+                fn(zb + zo, xb + xo, yb + yo, n);
+                for (std::size_t i = 0; i < n; ++i)
+                    ASSERT_EQ(zb[zo + i], expected[i]) << "zo=" << zo << " xo=" << xo << " yo=" << yo << " i=" << i;
+            }
+}
+
+}  // namespace
+
+TEST(CpuFeatures, CapabilityIsStable) {
+    const auto cap = detail::cpu_capability();
+    EXPECT_EQ(cap, detail::cpu_capability());
+    EXPECT_STRNE(detail::to_string(cap), "unknown");
+}
+
+TEST(SimdBinaryContig, SelectedKernelMatchesScalar) {
+    expect_matches_scalar<float, detail::AddOp<float>>(kernels::select_binary_contig<float, detail::AddOp<float>>());
+    expect_matches_scalar_misaligned<float, detail::AddOp<float>>(
+        kernels::select_binary_contig<float, detail::AddOp<float>>());
+    expect_matches_scalar_misaligned<std::int32_t, detail::MulOp<std::int32_t>>(
+        kernels::select_binary_contig<std::int32_t, detail::MulOp<std::int32_t>>());
+    expect_matches_scalar<float, detail::MulOp<float>>(kernels::select_binary_contig<float, detail::MulOp<float>>());
+    expect_matches_scalar<std::int32_t, detail::AddOp<std::int32_t>>(
+        kernels::select_binary_contig<std::int32_t, detail::AddOp<std::int32_t>>());
+    expect_matches_scalar<std::int32_t, detail::MulOp<std::int32_t>>(
+        kernels::select_binary_contig<std::int32_t, detail::MulOp<std::int32_t>>());
+    expect_matches_scalar<float, detail::SubOp<float>>(kernels::select_binary_contig<float, detail::SubOp<float>>());
+    expect_matches_scalar<float, detail::DivOp<float>>(kernels::select_binary_contig<float, detail::DivOp<float>>());
+    expect_matches_scalar<float, detail::MaximumOp<float>>(
+        kernels::select_binary_contig<float, detail::MaximumOp<float>>());
+    expect_matches_scalar<std::int32_t, detail::MinimumOp<std::int32_t>>(
+        kernels::select_binary_contig<std::int32_t, detail::MinimumOp<std::int32_t>>());
+    // not vectorized: the scalar loop is selected.
+    expect_matches_scalar<std::int32_t, detail::DivOp<std::int32_t>>(
+        kernels::select_binary_contig<std::int32_t, detail::DivOp<std::int32_t>>());
+}
+
+#if defined(MINIDL_HAVE_AVX2)
+TEST(SimdBinaryContig, Avx2MatchesScalar) {
+    const auto cap = detail::cpu_capability();
+    if (cap != detail::CpuCapability::avx2 && cap != detail::CpuCapability::avx512) GTEST_SKIP() << "no AVX2";
+    expect_matches_scalar<float, detail::AddOp<float>>(&kernels::avx2::binary_contig<float, detail::AddOp<float>>);
+    expect_matches_scalar_misaligned<float, detail::MulOp<float>>(
+        &kernels::avx2::binary_contig<float, detail::MulOp<float>>);
+    expect_matches_scalar<float, detail::MulOp<float>>(&kernels::avx2::binary_contig<float, detail::MulOp<float>>);
+    expect_matches_scalar<std::int32_t, detail::AddOp<std::int32_t>>(
+        &kernels::avx2::binary_contig<std::int32_t, detail::AddOp<std::int32_t>>);
+    expect_matches_scalar<std::int32_t, detail::MulOp<std::int32_t>>(
+        &kernels::avx2::binary_contig<std::int32_t, detail::MulOp<std::int32_t>>);
+}
+#endif
+
+#if defined(MINIDL_HAVE_AVX512)
+TEST(SimdBinaryContig, Avx512MatchesScalar) {
+    if (detail::cpu_capability() != detail::CpuCapability::avx512) GTEST_SKIP() << "no AVX-512";
+    expect_matches_scalar<float, detail::AddOp<float>>(&kernels::avx512::binary_contig<float, detail::AddOp<float>>);
+    expect_matches_scalar<float, detail::MulOp<float>>(&kernels::avx512::binary_contig<float, detail::MulOp<float>>);
+    expect_matches_scalar<std::int32_t, detail::AddOp<std::int32_t>>(
+        &kernels::avx512::binary_contig<std::int32_t, detail::AddOp<std::int32_t>>);
+    expect_matches_scalar<std::int32_t, detail::MulOp<std::int32_t>>(
+        &kernels::avx512::binary_contig<std::int32_t, detail::MulOp<std::int32_t>>);
+}
+#endif
+
+#if defined(MINIDL_HAVE_NEON)
+TEST(SimdBinaryContig, NeonMatchesScalar) {
+    expect_matches_scalar<float, detail::AddOp<float>>(&kernels::neon::binary_contig<float, detail::AddOp<float>>);
+    expect_matches_scalar<std::int32_t, detail::MulOp<std::int32_t>>(
+        &kernels::neon::binary_contig<std::int32_t, detail::MulOp<std::int32_t>>);
+}
+#endif
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace minidl;
+
+static std::vector<float> to_vec(const Tensor& t) {
+    const Tensor c = t.contiguous();
+    const auto* p = static_cast<const float*>(c.data());
+    return std::vector<float>(p, p + c.numel());
+}
+
+TEST(Slicing, SliceIsAViewWithOffset) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    const auto t = Tensor::arange(24, DType::f32, alloc).view({4, 6});
+    const auto before = alloc->total_allocations();
+
+    const auto rows = t.slice(0, 1, 3);
+    EXPECT_EQ(rows.shape().dims(), (std::vector<std::size_t>{2, 6}));
+    EXPECT_EQ(rows.storage(), t.storage());
+    EXPECT_EQ(rows.storage_offset(), 6u);
+    EXPECT_TRUE(rows.is_contiguous());
+    EXPECT_EQ(static_cast<const float*>(rows.data())[0], 6.0f);
+
+    const auto cols = t.slice(1, 1, 6, 2);  // columns 1, 3, 5
+    EXPECT_EQ(cols.shape().dims(), (std::vector<std::size_t>{4, 3}));
+    EXPECT_EQ(cols.strides(), (std::vector<std::size_t>{6, 2}));
+    EXPECT_FALSE(cols.is_contiguous());
+    EXPECT_EQ(alloc->total_allocations(), before);
+
+    EXPECT_EQ(to_vec(cols), (std::vector<float>{1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23}));
+}
+
+TEST(Slicing, StopIsClampedAndEmptyRangesAreEmpty) {
+    const auto t = Tensor::arange(10);
+    EXPECT_EQ(t.slice(0, 7, 100).numel(), 3u);
+    EXPECT_EQ(t.slice(0, 8, 3).numel(), 0u);
+    EXPECT_EQ(t.slice(0, 3, 10, 4).numel(), 2u);  // 3, 7
+    EXPECT_THROW(t.slice(1, 0, 1), std::runtime_error);
+    EXPECT_THROW(t.slice(0, 0, 1, 0), std::runtime_error);
+}
+
+TEST(Slicing, NarrowAndSelect) {
+    const auto t = Tensor::arange(24).view({2, 3, 4});
+
+    const auto n = t.narrow(2, 1, 2);
+    EXPECT_EQ(n.shape().dims(), (std::vector<std::size_t>{2, 3, 2}));
+    EXPECT_EQ(to_vec(n), (std::vector<float>{1, 2, 5, 6, 9, 10, 13, 14, 17, 18, 21, 22}));
+    EXPECT_THROW(t.narrow(2, 3, 2), std::runtime_error);
+
+    const auto s = t.select(1, 2);
+    EXPECT_EQ(s.shape().dims(), (std::vector<std::size_t>{2, 4}));
+    EXPECT_EQ(s.strides(), (std::vector<std::size_t>{12, 1}));
+    EXPECT_EQ(to_vec(s), (std::vector<float>{8, 9, 10, 11, 20, 21, 22, 23}));
+    EXPECT_THROW(t.select(0, 2), std::runtime_error);
+
+    const auto scalar = t.select(0, 1).select(0, 2).select(0, 3);
+    EXPECT_EQ(scalar.rank(), 0u);
+    EXPECT_EQ(static_cast<const float*>(scalar.data())[0], 23.0f);
+}
+
+TEST(Slicing, SplitAndChunk) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    const auto t = Tensor::arange(10, DType::f32, alloc).view({5, 2});
+    const auto before = alloc->total_allocations();
+
+    const auto parts = t.split(2);
+    ASSERT_EQ(parts.size(), 3u);
+    EXPECT_EQ(parts[2].shape().dims(), (std::vector<std::size_t>{1, 2}));
+    EXPECT_EQ(static_cast<const float*>(parts[2].data())[0], 8.0f);
+
+    const auto chunks = t.chunk(2, 1);
+    ASSERT_EQ(chunks.size(), 2u);
+    EXPECT_EQ(to_vec(chunks[1]), (std::vector<float>{1, 3, 5, 7, 9}));
+
+    EXPECT_EQ(t.chunk(3).size(), 3u);  // 2, 2, 1 rows
+    EXPECT_EQ(t.chunk(7).size(), 5u);  // fewer pieces than asked
+    EXPECT_EQ(alloc->total_allocations(), before + 1);  // only chunks[1]'s contiguous() copy
+}
+
+TEST(Slicing, KernelsRespectOffsets) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    auto buf = Tensor::zeros({8, 4}, DType::f32, alloc);
+    const auto x = Tensor::arange(16, DType::f32, alloc).view({4, 4});
+    const auto before = alloc->total_allocations();
+
+    // write micro-batches into sub-ranges of one preallocated buffer.
+    for (auto& batch : buf.split(2)) {
+        ops::add_out(x.narrow(0, 0, 2), x.narrow(0, 2, 2), batch);
+    }
+    EXPECT_EQ(alloc->total_allocations(), before);
+
+    auto row = buf.select(0, 5);
+    const auto* p = static_cast<const float*>(row.data());
+    for (int j = 0; j < 4; ++j) EXPECT_FLOAT_EQ(p[j], float(4 + j) + float(12 + j));
+
+    // in place through a strided view.
+    auto odd = buf.slice(0, 1, 8, 2);
+    ops::mul_(odd, Tensor::zeros({4}, DType::f32, alloc));
+    EXPECT_FLOAT_EQ(static_cast<const float*>(buf.select(0, 1).data())[0], 0.0f);
+    EXPECT_FLOAT_EQ(static_cast<const float*>(buf.select(0, 2).data())[0], 8.0f);
+}
+
+TEST(Slicing, CopyBetweenSlicesOfOneStorage) {
+    auto t = Tensor::arange(12).view({3, 4});
+    auto dst = t.select(0, 2);
+    dst.copy_(t.select(0, 0));
+    EXPECT_EQ(to_vec(t), (std::vector<float>{0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3}));
+
+    auto u = Tensor::arange(6);
+    auto tail = u.slice(0, 1, 6);
+    tail.copy_(u.slice(0, 0, 5));  // overlapping shift goes through a scratch copy
+    EXPECT_EQ(to_vec(u), (std::vector<float>{0, 0, 1, 2, 3, 4}));
+}
+
+TEST(Slicing, ContiguousOfSliceStartsAtZeroOffset) {
+    const auto t = Tensor::arange(20).view({4, 5});
+    const auto c = t.slice(1, 1, 4).contiguous();
+    EXPECT_EQ(c.storage_offset(), 0u);
+    EXPECT_EQ(to_vec(c), (std::vector<float>{1, 2, 3, 6, 7, 8, 11, 12, 13, 16, 17, 18}));
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/caching_allocator.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <type_traits>
+
+using namespace minidl;
+
+static_assert(!std::is_copy_constructible_v<Storage>);
+static_assert(!std::is_copy_assignable_v<Storage>);
+static_assert(std::is_nothrow_move_constructible_v<Storage>);
+
+TEST(Storage, ReleasesBufferOnDestruction) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    {
+        auto t = Tensor::ones({4, 4}, DType::f32, alloc);
+        EXPECT_EQ(alloc->live_allocations(), 1u);
+        EXPECT_EQ(alloc->live_bytes(), 64u);
+
+        auto v = t.view({16});  // shares the storage
+        auto tt = t.transpose({1, 0});
+        EXPECT_EQ(alloc->live_allocations(), 1u);
+    }
+    EXPECT_EQ(alloc->live_allocations(), 0u);
+    EXPECT_EQ(alloc->live_bytes(), 0u);
+    EXPECT_EQ(alloc->invalid_frees(), 0u);
+}
+
+TEST(Storage, MoveTransfersOwnership) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    {
+        Storage a(alloc);
+        a.data = alloc->allocate(32);
+        a.nbytes = 32;
+
+        Storage b(std::move(a));
+        EXPECT_EQ(a.data, nullptr);
+        EXPECT_EQ(alloc->live_allocations(), 1u);
+
+        Storage c(alloc);
+        c.data = alloc->allocate(8);
+        c = std::move(b);  // frees c's old buffer
+        EXPECT_EQ(alloc->live_allocations(), 1u);
+    }
+    EXPECT_EQ(alloc->live_allocations(), 0u);
+    EXPECT_EQ(alloc->invalid_frees(), 0u);
+}
+
+TEST(Storage, OpPipelineHasNoLeaks) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    {
+        auto a = Tensor::arange(12, DType::f32, alloc).view({3, 4});
+        auto b = Tensor::ones({4}, DType::f32, alloc);
+        auto c = Tensor::zeros({4, 3}, DType::f32, alloc).transpose({1, 0});
+
+        Tensor x = ops::add(a, b);   // broadcast
+        x = ops::mul(x, a);          // contiguous
+        x = ops::add(x, c);          // strided
+        x = x.transpose({1, 0}).reshape({12});  // copy
+        EXPECT_GT(alloc->total_allocations(), 5u);
+    }
+    EXPECT_EQ(alloc->live_allocations(), 0u);
+    EXPECT_EQ(alloc->live_bytes(), 0u);
+    EXPECT_EQ(alloc->invalid_frees(), 0u);
+}
+
+TEST(Storage, CachingAllocatorReusesOpOutputs) {
+    auto alloc = std::make_shared<CachingAllocator>();
+    auto a = Tensor::ones({1024}, DType::f32, alloc);
+    for (int i = 0; i < 10; ++i) {
+        auto c = ops::add(a, a);
+    }
+    const auto s = alloc->stats();
+    EXPECT_EQ(s.num_allocs, 11u);
+    EXPECT_EQ(s.num_cache_hits, 9u);
+}
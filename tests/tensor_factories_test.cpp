@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/parallel.h>
 #include <minidl/tensor.h>
 
 using namespace minidl;
@@ -105,3 +107,58 @@ TEST(Arange, I32Arange) {
     ASSERT_NE(p, nullptr);
     for (int i = 0; i < 5; ++i) EXPECT_EQ(p[i], i);
 }
+
+TEST(Empty, ShapeAndSingleAllocation) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    auto t = Tensor::empty({3, 5}, DType::i32, alloc);
+    EXPECT_EQ(t.dtype(), DType::i32);
+    EXPECT_EQ(t.numel(), 15u);
+    EXPECT_EQ(t.strides(), (std::vector<std::size_t>{5, 1}));
+    EXPECT_TRUE(t.is_contiguous());
+    ASSERT_NE(t.data(), nullptr);
+    EXPECT_EQ(alloc->total_allocations(), 1u);
+    EXPECT_EQ(alloc->live_bytes(), 15 * sizeof(std::int32_t));
+}
+
+TEST(Empty, ZeroSize) {
+    auto t = Tensor::empty({0, 4});
+    EXPECT_EQ(t.numel(), 0u);
+    EXPECT_EQ(t.data(), nullptr);
+}
+
+// sizes spanning several chunks, so the fills run on the pool.
+class ParallelFill : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        saved_ = get_num_threads();
+        set_num_threads(4);
+    }
+    void TearDown() override { set_num_threads(saved_); }
+
+    static constexpr std::size_t kN = 5 * 32768 + 17;
+
+   private:
+    std::size_t saved_ = 1;
+};
+
+TEST_F(ParallelFill, ZerosAndOnes) {
+    auto z = Tensor::zeros({kN}, DType::f32);
+    auto o = Tensor::ones({kN}, DType::i32);
+    const auto* pz = static_cast<const float*>(z.data());
+    const auto* po = static_cast<const std::int32_t*>(o.data());
+    for (std::size_t i = 0; i < kN; ++i) {
+        ASSERT_EQ(pz[i], 0.0f) << i;
+        ASSERT_EQ(po[i], 1) << i;
+    }
+}
+
+TEST_F(ParallelFill, Arange) {
+    auto f = Tensor::arange(kN, DType::f32);
+    auto n = Tensor::arange(kN, DType::i32);
+    const auto* pf = static_cast<const float*>(f.data());
+    const auto* pn = static_cast<const std::int32_t*>(n.data());
+    for (std::size_t i = 0; i < kN; ++i) {
+        ASSERT_EQ(pf[i], static_cast<float>(i)) << i;
+        ASSERT_EQ(pn[i], static_cast<std::int32_t>(i)) << i;
+    }
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <minidl/detail/iter.h>
+#include <minidl/detail/tensor_iterator.h>
+#include <minidl/tensor.h>
+
+#include <vector>
+
+using namespace minidl;
+
+namespace {
+
+// offsets visited by the iterator in order, per operand.
+std::vector<std::vector<std::size_t>> visit(const detail::TensorIterator& it, std::size_t begin, std::size_t end) {
+    std::vector<std::vector<std::size_t>> seen(it.ntensors());
+    it.for_each(begin, end, [&](const std::size_t* off, const std::size_t* st, std::size_t n) {
+        for (std::size_t k = 0; k < it.ntensors(); ++k)
+            for (std::size_t i = 0; i < n; ++i) seen[k].push_back(off[k] + i * st[k]);
+    });
+    return seen;
+}
+
+}  // namespace
+
+TEST(TensorIterator, CoalescesContiguous) {
+    std::vector<std::size_t> shape({2, 3, 4});
+    auto st = detail::default_strides(shape);
+    detail::TensorIterator it(shape, {st, st});
+
+    EXPECT_EQ(it.ndim(), 1u);
+    EXPECT_EQ(it.shape()[0], 24u);
+    EXPECT_EQ(it.stride(0, 0), 1u);
+    EXPECT_EQ(it.stride(1, 0), 1u);
+}
+
+TEST(TensorIterator, DropsSizeOneDims) {
+    std::vector<std::size_t> shape({2, 1, 4});
+    detail::TensorIterator it(shape, {{4, 4, 1}, {4, 99, 1}});
+    EXPECT_EQ(it.ndim(), 1u);
+    EXPECT_EQ(it.numel(), 8u);
+}
+
+TEST(TensorIterator, BroadcastRowKeepsZeroStride) {
+    // [B, N] + [N]
+    std::vector<std::size_t> shape({5, 8});
+    detail::TensorIterator it(shape, {{8, 1}, {8, 1}, {0, 1}});
+
+    ASSERT_EQ(it.ndim(), 2u);
+    EXPECT_EQ(it.shape()[0], 8u);  // inner run is a full row
+    EXPECT_EQ(it.stride(2, 0), 1u);
+    EXPECT_EQ(it.stride(2, 1), 0u);
+}
+
+TEST(TensorIterator, MatchesNdCounterForTranspose) {
+    std::vector<std::size_t> shape({3, 4, 2});
+    std::vector<std::size_t> out = detail::default_strides(shape);
+    std::vector<std::size_t> in({1, 6, 3});  // a permuted view
+
+    detail::TensorIterator it(shape, {out, in});
+    auto seen = visit(it, 0, it.numel());
+
+    detail::NdCounter c(shape);
+    std::size_t i = 0;
+    for (; !c.done(); c.next(), ++i) {
+        ASSERT_EQ(seen[0][i], detail::offset_elems(c.idx, out));
+        ASSERT_EQ(seen[1][i], detail::offset_elems(c.idx, in));
+    }
+    EXPECT_EQ(i, seen[0].size());
+}
+
+TEST(TensorIterator, SubRangesConcatenate) {
+    std::vector<std::size_t> shape({4, 3, 5});
+    std::vector<std::size_t> out = detail::default_strides(shape);
+    std::vector<std::size_t> in({0, 5, 1});
+
+    detail::TensorIterator it(shape, {out, in});
+    auto full = visit(it, 0, it.numel());
+
+    std::vector<std::vector<std::size_t>> parts(2);
+    for (std::size_t b = 0; b < it.numel(); b += 7) {
+        auto p = visit(it, b, std::min(it.numel(), b + 7));
+        for (std::size_t k = 0; k < 2; ++k) parts[k].insert(parts[k].end(), p[k].begin(), p[k].end());
+    }
+    EXPECT_EQ(parts, full);
+}
+
+TEST(TensorIterator, ScalarAndEmpty) {
+    detail::TensorIterator scalar(std::vector<std::size_t>{}, {{}, {}});
+    auto seen = visit(scalar, 0, 1);
+    EXPECT_EQ(seen[0], std::vector<std::size_t>({0}));
+
+    detail::TensorIterator empty(std::vector<std::size_t>{3, 0}, {{0, 1}, {0, 1}});
+    EXPECT_EQ(empty.numel(), 0u);
+    EXPECT_TRUE(visit(empty, 0, 10)[0].empty());
+}
+
+TEST(Contiguous, PermutedCopyMatchesIndexing) {
+    auto x = Tensor::arange(24, DType::i32).view({2, 3, 4});
+    auto y = x.transpose({2, 0, 1}).contiguous();  // shape {4, 2, 3}
+    ASSERT_TRUE(y.is_contiguous());
+
+    const auto* p = static_cast<const std::int32_t*>(y.data());
+    for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < 2; ++j)
+            for (std::size_t k = 0; k < 3; ++k)
+                EXPECT_EQ(p[(i * 2 + j) * 3 + k], static_cast<std::int32_t>(j * 12 + k * 4 + i));
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
+#include <minidl/parallel.h>
 #include <minidl/tensor.h>
 
+#include <utility>
+#include <vector>
+
 using namespace minidl;
 
 TEST(View, ViewCreate) {
@@ -84,4 +88,57 @@ TEST(Contiguous, NoOpOnAlreadyContiguous) {
     auto z = a.contiguous();
     EXPECT_TRUE(z.is_contiguous());
     EXPECT_EQ(z.data(), a.data());  // no copy
-}
\ No newline at end of file
+}
+// reference: element at logical index of `t`, read through its strides.
+template <typename T>
+static T at(const Tensor& t, const std::vector<std::size_t>& idx) {
+    std::size_t off = 0;
+    for (std::size_t d = 0; d < idx.size(); ++d) off += idx[d] * t.strides()[d];
+    return static_cast<const T*>(t.data())[off];
+}
+
+template <typename T>
+static void expect_contiguous_copy(const Tensor& src) {
+    const Tensor c = src.contiguous();
+    ASSERT_TRUE(c.is_contiguous());
+    ASSERT_EQ(c.shape().dims(), src.shape().dims());
+
+    const auto& dims = src.shape().dims();
+    std::vector<std::size_t> idx(dims.size(), 0);
+    const auto* p = static_cast<const T*>(c.data());
+    for (std::size_t i = 0; i < c.numel(); ++i) {
+        ASSERT_EQ(p[i], at<T>(src, idx)) << "i=" << i;
+        for (std::size_t d = dims.size(); d-- > 0;) {
+            if (++idx[d] < dims[d]) break;
+            idx[d] = 0;
+        }
+    }
+}
+
+TEST(Contiguous, Transpose2DTiledEdges) {
+    // sizes around the 8x8 register block and the 64x64 tile.
+    for (auto [r, c] :
+         {std::pair<std::size_t, std::size_t>{8, 8}, {13, 37}, {64, 96}, {65, 129}, {100, 33}, {257, 8}}) {
+        expect_contiguous_copy<float>(Tensor::arange(r * c).view({r, c}).transpose({1, 0}));
+        expect_contiguous_copy<std::int32_t>(Tensor::arange(r * c, DType::i32).view({r, c}).transpose({1, 0}));
+    }
+}
+
+TEST(Contiguous, BatchedAndPermutedTransposes) {
+    const auto t = Tensor::arange(3 * 40 * 24).view({3, 40, 24});
+    expect_contiguous_copy<float>(t.transpose({0, 2, 1}));  // per-batch transpose
+    expect_contiguous_copy<float>(t.transpose({2, 0, 1}));
+    expect_contiguous_copy<float>(t.transpose({1, 2, 0}));
+    expect_contiguous_copy<float>(t.transpose({2, 1, 0}));
+
+    const auto u = Tensor::arange(2 * 9 * 16 * 10, DType::i32).view({2, 9, 16, 10});
+    expect_contiguous_copy<std::int32_t>(u.transpose({0, 3, 1, 2}));
+    expect_contiguous_copy<std::int32_t>(u.transpose({3, 2, 1, 0}));
+}
+
+TEST(Contiguous, ParallelTiledTranspose) {
+    const auto saved = get_num_threads();
+    set_num_threads(4);
+    expect_contiguous_copy<float>(Tensor::arange(300 * 520).view({300, 520}).transpose({1, 0}));
+    set_num_threads(saved);
+}
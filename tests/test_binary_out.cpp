@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <minidl/allocators/tracking_allocator.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <stdexcept>
+
+using namespace minidl;
+
+static float at_f32(const Tensor& t, std::size_t i, std::size_t j) {
+    const auto* p = static_cast<const float*>(t.data());
+    return p[i * t.strides()[0] + j * t.strides()[1]];
+}
+
+TEST(BinaryOut, AddOutMatchesAdd) {
+    auto a = Tensor::arange(12).view({3, 4});
+    auto b = Tensor::arange(4);
+    auto out = Tensor::zeros({3, 4});
+
+    Tensor& r = ops::add_out(a, b, out);
+    EXPECT_EQ(&r, &out);
+
+    const auto ref = ops::add(a, b);
+    const auto* p = static_cast<const float*>(out.data());
+    const auto* q = static_cast<const float*>(ref.data());
+    for (std::size_t i = 0; i < 12; ++i) EXPECT_FLOAT_EQ(p[i], q[i]);
+}
+
+TEST(BinaryOut, MulOutIntoStridedOut) {
+    auto a = Tensor::arange(6, DType::i32).view({2, 3});
+    auto b = Tensor::arange(6, DType::i32).view({2, 3});
+    auto base = Tensor::zeros({3, 2}, DType::i32);
+    auto out = base.transpose({1, 0});
+
+    ops::mul_out(a, b, out);
+    const auto* p = static_cast<const std::int32_t*>(base.data());
+    // base[j][i] = (i * 3 + j)^2
+    for (std::size_t i = 0; i < 2; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            const auto v = static_cast<std::int32_t>(i * 3 + j);
+            EXPECT_EQ(p[j * 2 + i], v * v);
+        }
+    }
+}
+
+TEST(BinaryOut, InPlaceWithBroadcastOther) {
+    auto x = Tensor::arange(12).view({3, 4});
+    const void* data = x.data();
+    auto row = Tensor::ones({4});
+
+    ops::add_(x, row);
+    ops::mul_(x, x);
+    EXPECT_EQ(x.data(), data);
+
+    const auto* p = static_cast<const float*>(x.data());
+    for (std::size_t i = 0; i < 12; ++i) EXPECT_FLOAT_EQ(p[i], float(i + 1) * float(i + 1));
+}
+
+TEST(BinaryOut, InPlaceRejectsShapeGrowth) {
+    auto x = Tensor::ones({4});
+    auto y = Tensor::ones({3, 4});
+    EXPECT_THROW(ops::add_(x, y), std::runtime_error);
+}
+
+TEST(BinaryOut, RejectsBadOut) {
+    auto a = Tensor::ones({2, 3});
+    auto b = Tensor::ones({2, 3});
+
+    auto wrong_shape = Tensor::zeros({3, 2});
+    EXPECT_THROW(ops::add_out(a, b, wrong_shape), std::runtime_error);
+
+    auto wrong_dtype = Tensor::zeros({2, 3}, DType::i32);
+    EXPECT_THROW(ops::add_out(a, b, wrong_dtype), std::runtime_error);
+}
+
+TEST(BinaryOut, PartialAliasingMatchesOutOfPlace) {
+    // out = x + x^T where out is x itself: every write would feed a later read.
+    auto x = Tensor::arange(16).view({4, 4});
+    const auto expected = ops::add(x, x.transpose({1, 0}));
+
+    ops::add_out(x, x.transpose({1, 0}), x);
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) EXPECT_FLOAT_EQ(at_f32(x, i, j), at_f32(expected, i, j));
+    }
+}
+
+TEST(BinaryOut, TransposedViewAsOut) {
+    auto x = Tensor::arange(16).view({4, 4});
+    auto xt = x.transpose({1, 0});
+    const auto expected = ops::mul(x, x);  // writing xt in place would clobber x elements not yet read
+
+    ops::mul_out(x, x, xt);
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) EXPECT_FLOAT_EQ(at_f32(xt, i, j), at_f32(expected, i, j));
+    }
+}
+
+TEST(BinaryOut, SteadyStateDoesNotAllocate) {
+    auto alloc = std::make_shared<TrackingAllocator>();
+    auto a = Tensor::ones({64, 64}, DType::f32, alloc);
+    auto b = Tensor::ones({64}, DType::f32, alloc);
+    auto out = Tensor::zeros({64, 64}, DType::f32, alloc);
+    const auto before = alloc->total_allocations();
+
+    for (int i = 0; i < 10; ++i) {
+        ops::add_out(a, b, out);
+        ops::mul_(out, b);
+        ops::add_(out, a);
+    }
+    EXPECT_EQ(alloc->total_allocations(), before);
+    EXPECT_FLOAT_EQ(at_f32(out, 63, 63), 3.0f);
+}
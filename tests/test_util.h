@@ -0,0 +1,57 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <minidl/allocator.h>
+#include <minidl/tensor.h>
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Fixtures shared by the test files.
+namespace minidl::test_util {
+
+// deterministic f32 values in [-1, 1], different for each seed.
+inline Tensor values(const Shape& shape, unsigned seed, std::shared_ptr<Allocator> alloc = nullptr) {
+    Tensor t = Tensor::empty(shape, DType::f32, std::move(alloc));
+    auto* p = static_cast<float*>(t.data());
+    for (std::size_t i = 0; i < t.numel(); ++i) p[i] = std::sin(static_cast<float>(i * 7 + seed * 13 + 1));
+    return t;
+}
+
+// deterministic values in [lo, lo + 1), a third of them negated when `sign`.
+inline Tensor away_from_zero(const Shape& shape, unsigned seed, float lo = 0.2f, bool sign = true) {
+    Tensor t = Tensor::empty(shape);
+    auto* p = static_cast<float*>(t.data());
+    for (std::size_t i = 0; i < t.numel(); ++i) {
+        const float u = std::fabs(std::sin(static_cast<float>(i * 7 + seed * 13 + 1)));
+        p[i] = (lo + u) * (sign && (i + seed) % 3 == 0 ? -1.0f : 1.0f);
+    }
+    return t;
+}
+
+// a tensor of `dims` holding `v`, whose element type T is the storage type of `dt`.
+template <typename T>
+Tensor from(const std::vector<std::size_t>& dims, const std::vector<T>& v, DType dt) {
+    Tensor t = Tensor::empty(Shape(dims), dt);
+    std::memcpy(t.data(), v.data(), v.size() * sizeof(T));
+    return t;
+}
+
+// the elements of t in row-major order.
+template <typename T>
+std::vector<T> to_vector(const Tensor& t) {
+    const Tensor c = t.contiguous();
+    const auto* p = static_cast<const T*>(c.data());
+    return std::vector<T>(p, p + c.numel());
+}
+
+// same dtype, shape and bytes.
+inline void expect_same(const Tensor& a, const Tensor& b) {
+    ASSERT_EQ(a.dtype(), b.dtype());
+    ASSERT_EQ(a.shape().dims(), b.shape().dims());
+    const Tensor ca = a.contiguous(), cb = b.contiguous();
+    EXPECT_EQ(std::memcmp(ca.data(), cb.data(), ca.nbytes()), 0);
+}
+
+}  // namespace minidl::test_util
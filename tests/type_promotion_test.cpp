@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <minidl/dtype.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace minidl;
+using namespace minidl::test_util;
+
+namespace {
+
+constexpr DType kAll[] = {DType::f32, DType::i32, DType::bool_, DType::f64, DType::f16,
+                          DType::bf16, DType::i8, DType::u8, DType::i64};
+
+// the raw elements, to compare results of any dtype bit for bit.
+std::vector<std::uint8_t> bytes(const Tensor& t) {
+    const Tensor c = t.contiguous();
+    const auto* p = static_cast<const std::uint8_t*>(c.data());
+    return std::vector<std::uint8_t>(p, p + c.numel() * size_of(c.dtype()));
+}
+
+}  // namespace
+
+TEST(TypePromotion, Table) {
+    static_assert(promote_types(DType::i32, DType::f32) == DType::f32);
+    EXPECT_EQ(promote_types(DType::bool_, DType::u8), DType::u8);
+    EXPECT_EQ(promote_types(DType::i8, DType::u8), DType::i32);
+    EXPECT_EQ(promote_types(DType::u8, DType::i32), DType::i32);
+    EXPECT_EQ(promote_types(DType::i32, DType::i64), DType::i64);
+    EXPECT_EQ(promote_types(DType::i64, DType::f16), DType::f16);
+    EXPECT_EQ(promote_types(DType::bf16, DType::f32), DType::f32);
+    EXPECT_EQ(promote_types(DType::f16, DType::bf16), DType::f32);
+    EXPECT_EQ(promote_types(DType::f32, DType::f64), DType::f64);
+    for (DType a : kAll) {
+        EXPECT_EQ(promote_types(a, a), a);
+        for (DType b : kAll) {
+            const DType p = promote_types(a, b);
+            EXPECT_EQ(p, promote_types(b, a)) << to_string(a) << " " << to_string(b);
+            EXPECT_EQ(promote_types(p, a), p);
+            EXPECT_EQ(promote_types(p, b), p);
+        }
+    }
+}
+
+// each operand read in its own dtype gives what converting it to the promoted dtype first
+// gives, for contiguous, transposed and broadcast operands.
+TEST(TypePromotion, MixedOperandsMatchConvertedOperands) {
+    const Tensor base = Tensor::arange(4 * 300).view({4, 300});
+    const Tensor x = ops::sub(base, from<float>({1}, {600.0f}, DType::f32));
+    const Tensor y = ops::add(ops::mul(Tensor::arange(4 * 300).view({300, 4}), from<float>({1}, {0.25f}, DType::f32)),
+                              from<float>({1}, {1.0f}, DType::f32));
+    const Tensor small = from<float>({4, 1}, {-3.0f, 0.0f, 2.0f, 100.0f}, DType::f32);
+
+    using Op = Tensor (*)(const Tensor&, const Tensor&);
+    const Op table[] = {ops::add, ops::sub, ops::mul, ops::div, ops::maximum, ops::lt, ops::eq};
+    const std::pair<DType, DType> pairs[] = {
+        {DType::i32, DType::f32}, {DType::bf16, DType::f32}, {DType::f16, DType::bf16}, {DType::f32, DType::f64},
+        {DType::i8, DType::u8},   {DType::u8, DType::i64},   {DType::bool_, DType::i32}, {DType::i64, DType::f16},
+    };
+    for (const auto& [da, db] : pairs) {
+        const DType p = promote_types(da, db);
+        const std::string what = std::string(to_string(da)) + " " + to_string(db);
+        // the integer operands stay in range of every dtype they meet.
+        const Tensor a = (da == DType::i8 || da == DType::u8 || da == DType::bool_) ? small.to(da) : x.to(da);
+        const Tensor bt = y.to(db).transpose({1, 0});
+        const Tensor bb = small.to(db);
+        for (Op op : table) {
+            if (op == ops::div && !is_floating_point(p)) continue;  // x / 0 is checked elsewhere
+            const Tensor r = op(a, bt);
+            EXPECT_EQ(r.dtype(), op(a.to(p), bt.to(p)).dtype()) << what;
+            EXPECT_EQ(bytes(r), bytes(op(a.to(p), bt.to(p)))) << what;
+            EXPECT_EQ(bytes(op(bt, a)), bytes(op(bt.to(p), a.to(p)))) << what;
+            EXPECT_EQ(bytes(op(a, bb)), bytes(op(a.to(p), bb.to(p)))) << what;
+        }
+    }
+}
+
+TEST(TypePromotion, IntegerResultsWiden) {
+    const Tensor a = from<std::int8_t>({3}, {127, -128, -7}, DType::i8);
+    const Tensor b = from<std::uint8_t>({3}, {255, 255, 2}, DType::u8);
+    const Tensor sum = ops::add(a, b);
+    ASSERT_EQ(sum.dtype(), DType::i32);
+    EXPECT_EQ(to_vector<std::int32_t>(sum), (std::vector<std::int32_t>{382, 127, -5}));
+    EXPECT_EQ(to_vector<std::int32_t>(ops::div(a, b)), (std::vector<std::int32_t>{0, 0, -3}));
+
+    const Tensor flags = from<std::uint8_t>({3}, {1, 0, 1}, DType::bool_);
+    const Tensor big = from<std::int64_t>({3}, {std::int64_t{1} << 40, -1, 5}, DType::i64);
+    EXPECT_EQ(to_vector<std::int64_t>(ops::add(flags, big)),
+              (std::vector<std::int64_t>{(std::int64_t{1} << 40) + 1, -1, 6}));
+    EXPECT_THROW(ops::add(flags, flags), std::runtime_error);
+}
+
+TEST(TypePromotion, OutAndInPlace) {
+    const Tensor i = from<std::int32_t>({2, 3}, {1, 2, 3, 4, 5, 6}, DType::i32);
+    const Tensor h = from<float>({3}, {0.5f, 0.25f, 2.0f}, DType::f32).to(DType::bf16);
+
+    Tensor out = Tensor::empty({2, 3}, DType::bf16);
+    ops::mul_out(i, h, out);
+    EXPECT_EQ(to_vector<float>(out.to(DType::f32)), (std::vector<float>{0.5f, 0.5f, 6.0f, 2.0f, 1.25f, 12.0f}));
+    Tensor wrong = Tensor::empty({2, 3}, DType::f32);
+    EXPECT_THROW(ops::mul_out(i, h, wrong), std::runtime_error);
+
+    // self already has the promoted dtype; other is read as it is.
+    Tensor y = from<float>({2, 3}, {1, 1, 1, 1, 1, 1}, DType::f32);
+    ops::add_(y, i);
+    ops::mul_(y, h);
+    EXPECT_EQ(to_vector<float>(y), (std::vector<float>{1.0f, 0.75f, 8.0f, 2.5f, 1.5f, 14.0f}));
+    Tensor ints = i.contiguous();
+    EXPECT_THROW(ops::add_(ints, y), std::runtime_error);
+
+    // in place on a strided self.
+    Tensor t = from<float>({3, 2}, {0, 0, 0, 0, 0, 0}, DType::f32).transpose({1, 0});
+    ops::sub_(t, i);
+    EXPECT_EQ(to_vector<float>(t), (std::vector<float>{-1, -2, -3, -4, -5, -6}));
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <minidl/ops.h>
+#include <minidl/tensor.h>
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace minidl;
+
+static float* as_f32(Tensor& t) { return static_cast<float*>(t.data()); }
+static const float* as_f32(const Tensor& t) { return static_cast<const float*>(t.data()); }
+
+// |got - ref| in units of the float spacing at ref.
+static double ulp_error(float got, double ref) {
+    if (std::isnan(ref)) return std::isnan(got) ? 0.0 : INFINITY;
+    if (std::isinf(ref)) return got == ref ? 0.0 : INFINITY;
+    const float a = std::max(std::fabs(static_cast<float>(ref)), FLT_MIN);
+    return std::fabs(got - ref) / (std::nextafter(a, INFINITY) - a);
+}
+
+// n evenly spaced values in [lo, hi].
+static Tensor linspace(float lo, float hi, std::size_t n) {
+    Tensor t = Tensor::empty({n});
+    for (std::size_t i = 0; i < n; ++i) as_f32(t)[i] = lo + (hi - lo) * float(i) / float(n - 1);
+    return t;
+}
+
+struct Case {
+    const char* name;
+    Tensor (*op)(const Tensor&, ops::Precision);
+    double (*ref)(double);
+    float lo, hi;
+    double max_ulp;  // the bounds documented in detail/simd/math_vec.h
+};
+
+static const Case kCases[] = {
+    {"exp", ops::exp, [](double x) { return std::exp(x); }, -87.0f, 88.7f, 2},
+    {"log", ops::log, [](double x) { return std::log(x); }, 1e-30f, 1e30f, 1},
+    {"tanh", ops::tanh, [](double x) { return std::tanh(x); }, -10.0f, 10.0f, 6},
+    {"sigmoid", ops::sigmoid, [](double x) { return 1.0 / (1.0 + std::exp(-x)); }, -87.0f, 40.0f, 4},
+    {"gelu", ops::gelu, [](double x) { return 0.5 * x * (1.0 + std::erf(x / std::sqrt(2.0))); }, -1.0f, 20.0f, 8},
+};
+
+TEST(Unary, FastIsWithinDocumentedUlp) {
+    for (const Case& c : kCases) {
+        // 2-D so the transposed view runs the strided (one element at a time) path.
+        const Tensor x = linspace(c.lo, c.hi, 512 * 511).view({512, 511});
+        for (const Tensor& in : {x, x.transpose({1, 0})}) {
+            const Tensor y = c.op(in, ops::Precision::fast);
+            const Tensor xc = in.contiguous();
+            const Tensor yc = y.contiguous();
+            double worst = 0;
+            for (std::size_t i = 0; i < xc.numel(); ++i) {
+                worst = std::max(worst, ulp_error(as_f32(yc)[i], c.ref(as_f32(xc)[i])));
+            }
+            EXPECT_LE(worst, c.max_ulp) << c.name << (in.is_contiguous() ? " contiguous" : " strided");
+        }
+    }
+}
+
+TEST(Unary, GeluAbsoluteErrorForNegativeInputs) {
+    const Tensor x = linspace(-20.0f, -1.0f, 100000);
+    const Tensor y = ops::gelu(x);
+    for (std::size_t i = 0; i < x.numel(); ++i) {
+        const double v = as_f32(x)[i];
+        EXPECT_NEAR(as_f32(y)[i], 0.5 * v * (1.0 + std::erf(v / std::sqrt(2.0))), 2e-6) << v;
+    }
+}
+
+TEST(Unary, ExactMatchesLibm) {
+    const Tensor x = linspace(-20.0f, 20.0f, 4099);
+    const Tensor e = ops::exp(x, ops::Precision::exact);
+    const Tensor t = ops::tanh(x, ops::Precision::exact);
+    const Tensor l = ops::log(ops::exp(x, ops::Precision::exact), ops::Precision::exact);
+    for (std::size_t i = 0; i < x.numel(); ++i) {
+        const float v = as_f32(x)[i];
+        EXPECT_EQ(as_f32(e)[i], std::exp(v));
+        EXPECT_EQ(as_f32(t)[i], std::tanh(v));
+        EXPECT_EQ(as_f32(l)[i], std::log(std::exp(v)));
+    }
+}
+
+TEST(Unary, SpecialValues) {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    Tensor x = Tensor::empty({8});
+    const float in[8] = {nan, inf, -inf, 0.0f, -0.0f, -1.0f, 100.0f, -100.0f};
+    for (std::size_t i = 0; i < 8; ++i) as_f32(x)[i] = in[i];
+
+    for (auto p : {ops::Precision::fast, ops::Precision::exact}) {
+        const Tensor e = ops::exp(x, p);
+        EXPECT_TRUE(std::isnan(as_f32(e)[0]));
+        EXPECT_EQ(as_f32(e)[1], inf);
+        EXPECT_EQ(as_f32(e)[2], 0.0f);
+        EXPECT_EQ(as_f32(e)[3], 1.0f);
+        EXPECT_EQ(as_f32(e)[6], inf);
+        // below FLT_MIN the fast form flushes to 0.
+        EXPECT_EQ(as_f32(e)[7], p == ops::Precision::fast ? 0.0f : std::exp(-100.0f));
+
+        const Tensor l = ops::log(x, p);
+        EXPECT_TRUE(std::isnan(as_f32(l)[0]));
+        EXPECT_EQ(as_f32(l)[1], inf);
+        EXPECT_TRUE(std::isnan(as_f32(l)[2]));
+        EXPECT_EQ(as_f32(l)[3], -inf);
+        EXPECT_EQ(as_f32(l)[4], -inf);
+        EXPECT_TRUE(std::isnan(as_f32(l)[5]));
+
+        const Tensor t = ops::tanh(x, p);
+        EXPECT_TRUE(std::isnan(as_f32(t)[0]));
+        EXPECT_EQ(as_f32(t)[1], 1.0f);
+        EXPECT_EQ(as_f32(t)[2], -1.0f);
+        EXPECT_EQ(as_f32(t)[3], 0.0f);
+
+        const Tensor s = ops::sigmoid(x, p);
+        EXPECT_TRUE(std::isnan(as_f32(s)[0]));
+        EXPECT_EQ(as_f32(s)[1], 1.0f);
+        EXPECT_EQ(as_f32(s)[2], 0.0f);
+        EXPECT_EQ(as_f32(s)[3], 0.5f);
+
+        const Tensor g = ops::gelu(x, p);
+        EXPECT_TRUE(std::isnan(as_f32(g)[0]));
+        EXPECT_EQ(as_f32(g)[3], 0.0f);
+        EXPECT_EQ(as_f32(g)[6], 100.0f);
+    }
+}
+
+TEST(Unary, Relu) {
+    Tensor f = linspace(-4.5f, 4.5f, 10);
+    as_f32(f)[9] = std::numeric_limits<float>::quiet_NaN();
+    const Tensor r = ops::relu(f);
+    for (std::size_t i = 0; i < 9; ++i) EXPECT_EQ(as_f32(r)[i], std::max(float(i) - 4.5f, 0.0f));
+    EXPECT_TRUE(std::isnan(as_f32(r)[9]));
+
+    Tensor n = Tensor::empty({2, 20}, DType::i32);
+    auto* pn = static_cast<std::int32_t*>(n.data());
+    for (std::int32_t i = 0; i < 40; ++i) pn[i] = i - 20;
+    const Tensor ri = ops::relu(n.transpose({1, 0})).contiguous();
+    ASSERT_EQ(ri.shape().dims(), (std::vector<std::size_t>{20, 2}));
+    const auto* pr = static_cast<const std::int32_t*>(ri.data());
+    for (std::size_t j = 0; j < 20; ++j) {
+        for (std::size_t i = 0; i < 2; ++i) EXPECT_EQ(pr[j * 2 + i], std::max(pn[i * 20 + j], 0));
+    }
+}
+
+TEST(Unary, OutVariants) {
+    Tensor x = linspace(-3.0f, 3.0f, 1000).view({10, 100});
+    const Tensor ref = ops::sigmoid(x);
+
+    Tensor out = Tensor::empty({10, 100});
+    ops::sigmoid_out(x, out);
+    for (std::size_t i = 0; i < 1000; ++i) EXPECT_EQ(as_f32(out)[i], as_f32(ref)[i]);
+
+    // in place, and into a transposed out.
+    Tensor y = Tensor::empty({10, 100});
+    y.copy_(x);
+    ops::sigmoid_out(y, y);
+    for (std::size_t i = 0; i < 1000; ++i) EXPECT_EQ(as_f32(y)[i], as_f32(ref)[i]);
+    Tensor t = Tensor::empty({100, 10}).transpose({1, 0});
+    ops::sigmoid_out(x, t);
+    const Tensor tc = t.contiguous();
+    for (std::size_t i = 0; i < 1000; ++i) EXPECT_EQ(as_f32(tc)[i], as_f32(ref)[i]);
+
+    // partial overlap: out is x shifted by one element.
+    Tensor buf = linspace(-3.0f, 3.0f, 1001);
+    const Tensor src = buf.narrow(0, 0, 1000);
+    const Tensor expect = ops::relu(src);
+    Tensor dst = buf.narrow(0, 1, 1000);
+    ops::relu_out(src, dst);
+    for (std::size_t i = 0; i < 1000; ++i) EXPECT_EQ(as_f32(dst)[i], as_f32(expect)[i]);
+
+    Tensor wrong = Tensor::empty({100, 10});
+    EXPECT_THROW(ops::exp_out(x, wrong), std::runtime_error);
+    EXPECT_THROW(ops::exp(Tensor::arange(4, DType::i32)), std::runtime_error);
+}